@@ -0,0 +1,195 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "hdgnss_config.h"
+#include "hdgnss/IConfigurablePlugin.h"
+#include "src/batch/BatchDecoder.h"
+#include "src/core/AppSettings.h"
+#include "src/core/ProtocolPluginLoader.h"
+
+namespace {
+
+enum ExitCode {
+    ExitOk = 0,
+    ExitFileErrors = 1,
+    ExitUsage = 2
+};
+
+void loadProtocolPlugins(hdgnss::ProtocolPluginLoader &loader,
+                         hdgnss::BatchDecoder &decoder,
+                         const hdgnss::AppSettings &settings,
+                         const QString &pluginDirectoryOverride) {
+    if (!settings.pluginsEnabled() && pluginDirectoryOverride.isEmpty()) {
+        return;
+    }
+    const QString userPluginDirectory = pluginDirectoryOverride.isEmpty()
+        ? settings.pluginDirectory()
+        : pluginDirectoryOverride;
+    loader.loadFromDirectories(hdgnss::ProtocolPluginLoader::defaultSearchPaths(
+        QCoreApplication::applicationDirPath(), userPluginDirectory));
+    for (const QString &error : loader.errors()) {
+        qWarning().noquote() << "Protocol plugin load error:" << error;
+    }
+
+    // Same enable/settings rules as AppController::reloadProtocolPlugins so a
+    // batch run decodes exactly what the GUI would.
+    const QList<hdgnss::IProtocolPlugin *> loaded = loader.plugins();
+    const QList<QObject *> loadedObjects = loader.pluginObjects();
+    QList<hdgnss::IProtocolPlugin *> plugins;
+    QList<QObject *> objects;
+    for (int index = 0; index < loaded.size() && index < loadedObjects.size(); ++index) {
+        QObject *object = loadedObjects.at(index);
+        if (auto *configurable = qobject_cast<hdgnss::IConfigurablePlugin *>(object)) {
+            const QString pluginId = configurable->settingsId().trimmed();
+            configurable->applySettings(settings.pluginPrivateSettings(pluginId));
+            if (!settings.pluginEnabled(pluginId)) {
+                continue;
+            }
+        }
+        plugins.append(loaded.at(index));
+        objects.append(object);
+    }
+    decoder.setPlugins(plugins, objects);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    // Shares QSettings with the GUI so plugin selection and settings carry over.
+    QCoreApplication::setApplicationName("GnssView");
+    QCoreApplication::setApplicationVersion(QStringLiteral(HDGNSS_APP_VERSION));
+    QCoreApplication::setOrganizationName("hdgnss");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+        "Decodes GnssView raw captures without the UI and writes one summary row per file."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(QStringLiteral("inputs"),
+                                 QStringLiteral("Capture files or directories to scan."),
+                                 QStringLiteral("<file|dir>..."));
+    const QCommandLineOption outputOption({QStringLiteral("o"), QStringLiteral("output")},
+                                          QStringLiteral("Write summaries to <path> instead of stdout."),
+                                          QStringLiteral("path"));
+    const QCommandLineOption formatOption({QStringLiteral("f"), QStringLiteral("format")},
+                                          QStringLiteral("Summary format: csv or jsonl. Defaults from the output extension, else csv."),
+                                          QStringLiteral("format"));
+    const QCommandLineOption jobsOption({QStringLiteral("j"), QStringLiteral("jobs")},
+                                        QStringLiteral("Files decoded in parallel. Defaults to the CPU count."),
+                                        QStringLiteral("n"));
+    const QCommandLineOption patternOption(QStringLiteral("pattern"),
+                                           QStringLiteral("File name filter for directories; repeatable. Default *.raw.bin."),
+                                           QStringLiteral("glob"));
+    const QCommandLineOption noRecurseOption(QStringLiteral("no-recurse"),
+                                             QStringLiteral("Do not descend into subdirectories."));
+    const QCommandLineOption pluginDirOption(QStringLiteral("plugin-dir"),
+                                             QStringLiteral("Load protocol plugins from <dir> instead of the configured plugin directory."),
+                                             QStringLiteral("dir"));
+    const QCommandLineOption noPluginsOption(QStringLiteral("no-plugins"),
+                                             QStringLiteral("Decode with the built-in NMEA parser only."));
+    parser.addOptions({outputOption, formatOption, jobsOption, patternOption, noRecurseOption,
+                       pluginDirOption, noPluginsOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty()) {
+        err << parser.helpText();
+        return ExitUsage;
+    }
+
+    const QString outputPath = parser.value(outputOption);
+    QString format = parser.value(formatOption).toLower();
+    if (format.isEmpty()) {
+        format = outputPath.endsWith(QStringLiteral(".jsonl"), Qt::CaseInsensitive)
+            ? QStringLiteral("jsonl")
+            : QStringLiteral("csv");
+    }
+    if (format != QStringLiteral("csv") && format != QStringLiteral("jsonl")) {
+        err << "Unknown format: " << format << Qt::endl;
+        return ExitUsage;
+    }
+
+    int jobs = 0;
+    if (parser.isSet(jobsOption)) {
+        bool ok = false;
+        jobs = parser.value(jobsOption).toInt(&ok);
+        if (!ok || jobs < 1) {
+            err << "Invalid job count: " << parser.value(jobsOption) << Qt::endl;
+            return ExitUsage;
+        }
+    }
+
+    QStringList patterns = parser.values(patternOption);
+    if (patterns.isEmpty()) {
+        patterns = {QStringLiteral("*.raw.bin")};
+    }
+    const QStringList files = hdgnss::BatchDecoder::collectCaptures(inputs, patterns, !parser.isSet(noRecurseOption));
+    if (files.isEmpty()) {
+        err << "No captures matched." << Qt::endl;
+        return ExitUsage;
+    }
+
+    hdgnss::AppSettings settings;
+    hdgnss::ProtocolPluginLoader loader;
+    hdgnss::BatchDecoder decoder;
+    if (!parser.isSet(noPluginsOption)) {
+        loadProtocolPlugins(loader, decoder, settings, parser.value(pluginDirOption));
+    }
+    const int threads = decoder.threadCount(jobs);
+    if (!decoder.parallelSafe() && (jobs > 1 || (jobs == 0 && files.size() > 1))) {
+        err << "Loaded protocol plugins do not provide per-thread instances; decoding serially." << Qt::endl;
+    }
+
+    QFile output;
+    bool opened = false;
+    if (outputPath.isEmpty()) {
+        opened = output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputPath);
+        opened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!opened) {
+        err << "Cannot open output " << outputPath << ": " << output.errorString() << Qt::endl;
+        return ExitUsage;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const std::vector<hdgnss::CaptureSummary> summaries = decoder.run(files, jobs);
+    const qint64 elapsedMs = timer.elapsed();
+
+    const bool csv = format == QStringLiteral("csv");
+    if (csv) {
+        output.write(hdgnss::CaptureSummary::csvHeader());
+    }
+    qint64 totalBytes = 0;
+    int failures = 0;
+    for (const hdgnss::CaptureSummary &summary : summaries) {
+        output.write(csv ? summary.toCsvRow() : summary.toJsonLine());
+        totalBytes += summary.bytes;
+        if (!summary.error.isEmpty()) {
+            ++failures;
+            err << summary.filePath << ": " << summary.error << Qt::endl;
+        }
+    }
+    output.close();
+
+    const double seconds = std::max<qint64>(elapsedMs, 1) / 1000.0;
+    err << QStringLiteral("Decoded %1 file(s), %2 MiB in %3 s (%4 MiB/s, %5 thread(s))")
+               .arg(summaries.size())
+               .arg(totalBytes / (1024.0 * 1024.0), 0, 'f', 1)
+               .arg(seconds, 0, 'f', 2)
+               .arg(totalBytes / (1024.0 * 1024.0) / seconds, 0, 'f', 1)
+               .arg(threads)
+        << Qt::endl;
+    return failures > 0 ? ExitFileErrors : ExitOk;
+}
@@ -6,6 +6,7 @@
 #include <QIcon>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickStyle>
 #include <QTimer>
 #include <QWindow>
@@ -17,10 +18,14 @@
 #include "src/core/UpdateChecker.h"
 #include "src/models/CommandButtonModel.h"
 #include "src/models/DeviationMapModel.h"
+#include "src/models/RawLogFilterModel.h"
 #include "src/models/RawLogModel.h"
 #include "src/models/SatelliteModel.h"
+#include "src/models/SignalBandFilterModel.h"
 #include "src/models/SignalModel.h"
 #include "src/tec/TecMapOverlayModel.h"
+#include "src/ui/DeviationPointCloudItem.h"
+#include "src/ui/TecOverlayImageProvider.h"
 
 namespace {
 QString pickFontFamily(const QStringList &candidates, const QString &fallback) {
@@ -89,7 +94,13 @@ int main(int argc, char *argv[]) {
     hdgnss::UpdateChecker updateChecker;
     const bool rawDataScrollDebug = qEnvironmentVariableIntValue("HDGNSS_RAWDATA_SCROLL_DEBUG") > 0;
 
+    qmlRegisterType<hdgnss::DeviationPointCloudItem>("GnssView", 1, 0, "DeviationPointCloud");
+    qmlRegisterType<hdgnss::SignalBandFilterModel>("GnssView", 1, 0, "SignalBandFilter");
+
     QQmlApplicationEngine engine;
+    // The engine takes ownership; the controller it reads from outlives it.
+    engine.addImageProvider(QLatin1String(hdgnss::TecMapOverlayModel::kOverlayImageProviderId),
+                            new hdgnss::TecOverlayImageProvider(controller.tecMapOverlayModel()));
     engine.rootContext()->setContextProperty("uiBodyFontFamily", bodyFontFamily);
     engine.rootContext()->setContextProperty("uiMonoFontFamily", monoFontFamily);
     engine.rootContext()->setContextProperty("rawDataScrollDebug", rawDataScrollDebug);
@@ -98,8 +109,11 @@ int main(int argc, char *argv[]) {
     engine.rootContext()->setContextProperty("updateChecker", &updateChecker);
     engine.rootContext()->setContextProperty("transportViewModel", controller.transportViewModel());
     engine.rootContext()->setContextProperty("rawLogModel", controller.rawLogModel());
+    engine.rootContext()->setContextProperty("rawLogFilterModel", controller.rawLogFilterModel());
     engine.rootContext()->setContextProperty("satelliteModel", controller.satelliteModel());
     engine.rootContext()->setContextProperty("signalModel", controller.signalModel());
+    engine.rootContext()->setContextProperty("satelliteStatsModel", controller.satelliteStatsModel());
+    engine.rootContext()->setContextProperty("satelliteHistoryModel", controller.satelliteHistoryModel());
     engine.rootContext()->setContextProperty("commandButtonModel", controller.commandButtonModel());
     engine.rootContext()->setContextProperty("deviationMapModel", controller.deviationMapModel());
     engine.rootContext()->setContextProperty("tecMapOverlayModel", controller.tecMapOverlayModel());
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <array>
 #include <limits>
 
 #include <QByteArray>
 #include <QDateTime>
 #include <QList>
 #include <QString>
+#include <QStringView>
 #include <QVariant>
 #include <QVariantMap>
 
@@ -98,6 +100,23 @@ struct GnssLocation {
     int satellitesInView = 0;
 };
 
+// Signal group a satellite's band falls into on the signal tabs. Unresolved
+// marks a SatelliteInfo that has not been classified yet.
+enum class SignalGroup : quint8 {
+    Unresolved,
+    Unknown,
+    L1,
+    L1C,
+    B1,
+    E1,
+    L2,
+    L5,
+    B2,
+    E5,
+    B3,
+    Count
+};
+
 struct SatelliteInfo {
     QString key;
     QString constellation;
@@ -108,75 +127,138 @@ struct SatelliteInfo {
     int elevation = 0;
     int cn0 = 0;
     bool usedInFix = false;
+    // Derived from band, constellation and signalId by resolveSignalGroup().
+    SignalGroup signalGroup = SignalGroup::Unresolved;
+    // Set by the host once the signal has not been reported for a while. Its
+    // last values are kept so views can fade it out before it is dropped.
+    bool stale = false;
 };
 
 inline bool satelliteHasVisibleSignal(const SatelliteInfo &sat) {
     return sat.cn0 > 0;
 }
 
-inline QString satelliteSignalGroup(const SatelliteInfo &sat) {
-    const QString bandName = sat.band.trimmed().toUpper();
-    const QString constellationName = sat.constellation.trimmed().toUpper();
+// A visible signal that is still being reported.
+inline bool satelliteHasLiveSignal(const SatelliteInfo &sat) {
+    return satelliteHasVisibleSignal(sat) && !sat.stale;
+}
 
-    if (bandName.startsWith(QStringLiteral("B2"))
-        || (bandName == QStringLiteral("L5") && constellationName == QStringLiteral("BEIDOU"))) {
-        return QStringLiteral("B2");
+inline SignalGroup classifySignalGroup(const SatelliteInfo &sat) {
+    const QStringView band = QStringView(sat.band).trimmed();
+    const QStringView constellation = QStringView(sat.constellation).trimmed();
+    const auto bandStartsWith = [band](const char *prefix) {
+        return band.startsWith(QLatin1StringView(prefix), Qt::CaseInsensitive);
+    };
+    const auto bandIs = [band](const char *name) {
+        return band.compare(QLatin1StringView(name), Qt::CaseInsensitive) == 0;
+    };
+    const auto constellationIs = [constellation](const char *name) {
+        return constellation.compare(QLatin1StringView(name), Qt::CaseInsensitive) == 0;
+    };
+
+    if (bandStartsWith("B2") || (bandIs("L5") && constellationIs("BEIDOU"))) {
+        return SignalGroup::B2;
     }
-    if (bandName.startsWith(QStringLiteral("E5"))
-        || (bandName == QStringLiteral("L5") && constellationName == QStringLiteral("GALILEO"))) {
-        return QStringLiteral("E5");
+    if (bandStartsWith("E5") || (bandIs("L5") && constellationIs("GALILEO"))) {
+        return SignalGroup::E5;
     }
-    if (bandName == QStringLiteral("L5") || bandName.startsWith(QStringLiteral("L5"))) {
-        return QStringLiteral("L5");
+    if (bandStartsWith("L5")) {
+        return SignalGroup::L5;
     }
-    if (bandName == QStringLiteral("B1") || bandName.startsWith(QStringLiteral("B1"))
-        || (bandName == QStringLiteral("L1") && constellationName == QStringLiteral("BEIDOU"))) {
-        return QStringLiteral("B1");
+    if (bandStartsWith("B1") || (bandIs("L1") && constellationIs("BEIDOU"))) {
+        return SignalGroup::B1;
     }
-    if (bandName == QStringLiteral("E1") || bandName.startsWith(QStringLiteral("E1"))
-        || (bandName == QStringLiteral("L1") && constellationName == QStringLiteral("GALILEO"))) {
-        return QStringLiteral("E1");
+    if (bandStartsWith("E1") || (bandIs("L1") && constellationIs("GALILEO"))) {
+        return SignalGroup::E1;
     }
-    if (bandName == QStringLiteral("L1C") || bandName.startsWith(QStringLiteral("L1C"))
-        || (bandName == QStringLiteral("L1")
-            && constellationName == QStringLiteral("QZSS")
-            && (sat.signalId == 2 || sat.signalId == 3))) {
-        return QStringLiteral("L1C");
+    if (bandStartsWith("L1C")
+        || (bandIs("L1") && constellationIs("QZSS") && (sat.signalId == 2 || sat.signalId == 3))) {
+        return SignalGroup::L1C;
     }
-    if (bandName == QStringLiteral("L1") || bandName.startsWith(QStringLiteral("L1"))) {
-        return QStringLiteral("L1");
+    if (bandStartsWith("L1")) {
+        return SignalGroup::L1;
     }
-    if (bandName == QStringLiteral("L2") || bandName.startsWith(QStringLiteral("L2"))
-        || bandName == QStringLiteral("G2") || bandName.startsWith(QStringLiteral("G2"))) {
-        return QStringLiteral("L2");
+    if (bandStartsWith("L2") || bandStartsWith("G2")) {
+        return SignalGroup::L2;
     }
-    if (bandName == QStringLiteral("L6") || bandName.startsWith(QStringLiteral("L6"))
-        || bandName.startsWith(QStringLiteral("E6"))
-        || bandName.startsWith(QStringLiteral("B3"))
-        || bandName.startsWith(QStringLiteral("G3"))) {
-        return QStringLiteral("B3");
+    if (bandStartsWith("L6") || bandStartsWith("E6") || bandStartsWith("B3") || bandStartsWith("G3")) {
+        return SignalGroup::B3;
     }
-    return QStringLiteral("UN");
+    return SignalGroup::Unknown;
 }
 
-inline bool satelliteMatchesSignalTab(const SatelliteInfo &sat, const QString &tabBand) {
-    const QString signalGroup = satelliteSignalGroup(sat);
-    const QString tab = tabBand.trimmed().toUpper();
-    if (tab == QStringLiteral("L1")) {
-        return signalGroup == QStringLiteral("L1")
-            || signalGroup == QStringLiteral("B1")
-            || signalGroup == QStringLiteral("E1")
-            || signalGroup == QStringLiteral("L1C");
-    }
-    if (tab == QStringLiteral("L5")) {
-        return signalGroup == QStringLiteral("L5")
-            || signalGroup == QStringLiteral("B2")
-            || signalGroup == QStringLiteral("E5");
+// Classifies sat once; call again after changing its band, constellation or
+// signal id.
+inline void resolveSignalGroup(SatelliteInfo &sat) {
+    sat.signalGroup = classifySignalGroup(sat);
+}
+
+inline SignalGroup resolvedSignalGroup(const SatelliteInfo &sat) {
+    return sat.signalGroup == SignalGroup::Unresolved ? classifySignalGroup(sat) : sat.signalGroup;
+}
+
+inline QString signalGroupName(SignalGroup group) {
+    switch (group) {
+    case SignalGroup::L1: return QStringLiteral("L1");
+    case SignalGroup::L1C: return QStringLiteral("L1C");
+    case SignalGroup::B1: return QStringLiteral("B1");
+    case SignalGroup::E1: return QStringLiteral("E1");
+    case SignalGroup::L2: return QStringLiteral("L2");
+    case SignalGroup::L5: return QStringLiteral("L5");
+    case SignalGroup::B2: return QStringLiteral("B2");
+    case SignalGroup::E5: return QStringLiteral("E5");
+    case SignalGroup::B3: return QStringLiteral("B3");
+    case SignalGroup::Unresolved:
+    case SignalGroup::Unknown:
+        break;
     }
-    if (tab == QStringLiteral("L6")) {
-        return signalGroup == QStringLiteral("B3");
+    return QStringLiteral("UN");
+}
+
+inline QString satelliteSignalGroup(const SatelliteInfo &sat) {
+    return signalGroupName(resolvedSignalGroup(sat));
+}
+
+constexpr quint32 signalGroupBit(SignalGroup group) {
+    return 1u << static_cast<int>(group);
+}
+
+struct SignalTab {
+    const char *name;
+    quint32 groups;
+};
+
+// The L1, L5 and L6 tabs gather the matching groups of every constellation;
+// any other tab name selects the group of that name.
+inline constexpr std::array<SignalTab, 11> kSignalTabs = {{
+    {"L1", signalGroupBit(SignalGroup::L1) | signalGroupBit(SignalGroup::B1) | signalGroupBit(SignalGroup::E1)
+               | signalGroupBit(SignalGroup::L1C)},
+    {"L5", signalGroupBit(SignalGroup::L5) | signalGroupBit(SignalGroup::B2) | signalGroupBit(SignalGroup::E5)},
+    {"L6", signalGroupBit(SignalGroup::B3)},
+    {"L1C", signalGroupBit(SignalGroup::L1C)},
+    {"B1", signalGroupBit(SignalGroup::B1)},
+    {"E1", signalGroupBit(SignalGroup::E1)},
+    {"L2", signalGroupBit(SignalGroup::L2)},
+    {"B2", signalGroupBit(SignalGroup::B2)},
+    {"E5", signalGroupBit(SignalGroup::E5)},
+    {"B3", signalGroupBit(SignalGroup::B3)},
+    {"UN", signalGroupBit(SignalGroup::Unknown)},
+}};
+
+// Bitmask of signalGroupBit() values shown on a signal tab; 0 if the name is
+// not a tab.
+inline quint32 signalTabGroups(QStringView tabBand) {
+    const QStringView tab = tabBand.trimmed();
+    for (const SignalTab &entry : kSignalTabs) {
+        if (tab.compare(QLatin1StringView(entry.name), Qt::CaseInsensitive) == 0) {
+            return entry.groups;
+        }
     }
-    return signalGroup == tab;
+    return 0;
+}
+
+inline bool satelliteMatchesSignalTab(const SatelliteInfo &sat, const QString &tabBand) {
+    return (signalTabGroups(tabBand) & signalGroupBit(resolvedSignalGroup(sat))) != 0;
 }
 
 }  // namespace hdgnss
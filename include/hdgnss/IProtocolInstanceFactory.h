@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtPlugin>
+
+#include "hdgnss/IProtocolPlugin.h"
+
+namespace hdgnss {
+
+// Optional companion to IProtocolPlugin. QPluginLoader hands out one plugin
+// object per process and feed() keeps stream state in it, so tools that decode
+// several captures at once ask for private decoder instances instead.
+class IProtocolInstanceFactory {
+public:
+    virtual ~IProtocolInstanceFactory() = default;
+
+    // Returns a decoder with fresh stream state and the settings last applied
+    // through IConfigurablePlugin; the caller owns it. Called from worker
+    // threads, possibly concurrently.
+    virtual IProtocolPlugin *createProtocolInstance() const = 0;
+
+    // Byte patterns that always start a frame of this protocol. A large capture
+    // may be split at them and its parts decoded concurrently; return nothing
+    // when frames cannot be located without earlier context.
+    virtual QList<QByteArray> syncWords() const {
+        return {};
+    }
+};
+
+}  // namespace hdgnss
+
+#define HDGNSS_PROTOCOL_INSTANCE_FACTORY_IID "com.hdgnss.IProtocolInstanceFactory/1.0"
+Q_DECLARE_INTERFACE(hdgnss::IProtocolInstanceFactory, HDGNSS_PROTOCOL_INSTANCE_FACTORY_IID)
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QByteArray>
+#include <QtPlugin>
+
+namespace hdgnss {
+
+// Optional companion to IProtocolPlugin. Recorded sessions store periodic
+// receiver keyframes so replay can seek without decoding everything before the
+// target; plugins that implement this have their stream state restored with
+// the keyframe instead of rebuilding it from the bytes after it.
+class IProtocolStateSnapshot {
+public:
+    virtual ~IProtocolStateSnapshot() = default;
+
+    // Opaque blob with everything feed() needs to continue the stream. Only
+    // the same plugin build reads it back, so the format is the plugin's own.
+    virtual QByteArray saveProtocolState() const = 0;
+    // Returns false and leaves the state reset when the blob is not usable.
+    virtual bool restoreProtocolState(const QByteArray &state) = 0;
+};
+
+}  // namespace hdgnss
+
+#define HDGNSS_PROTOCOL_STATE_SNAPSHOT_IID "com.hdgnss.IProtocolStateSnapshot/1.0"
+Q_DECLARE_INTERFACE(hdgnss::IProtocolStateSnapshot, HDGNSS_PROTOCOL_STATE_SNAPSHOT_IID)
@@ -0,0 +1,224 @@
+#include "BatchDecoder.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+
+#include "src/batch/CaptureStream.h"
+#include "src/batch/ParallelCaptureDecoder.h"
+#include "src/core/CaptureDecoder.h"
+
+namespace hdgnss {
+
+namespace {
+
+// Captures this large are spread over all workers instead of taking one.
+constexpr qint64 kSplitThresholdBytes = 2 * ParallelCaptureDecoder::kDefaultRegionBytes;
+
+QList<IProtocolPlugin *> createInstances(const QList<IProtocolPlugin *> &shared,
+                                         const QList<IProtocolInstanceFactory *> &factories,
+                                         std::vector<std::unique_ptr<IProtocolPlugin>> &owned) {
+    QList<IProtocolPlugin *> plugins;
+    for (qsizetype index = 0; index < shared.size(); ++index) {
+        if (IProtocolInstanceFactory *factory = factories.value(index)) {
+            owned.emplace_back(factory->createProtocolInstance());
+            plugins.append(owned.back().get());
+        } else {
+            plugins.append(shared.at(index));
+        }
+    }
+    return plugins;
+}
+
+void decodeInto(CaptureSummary &summary, CaptureDecoder &decoder, const QByteArray &slice) {
+    const QList<ProtocolMessage> messages = decoder.decode(slice);
+    for (const ProtocolMessage &message : messages) {
+        summary.addMessage(message);
+    }
+}
+
+}  // namespace
+
+QStringList BatchDecoder::collectCaptures(const QStringList &inputs, const QStringList &nameFilters, bool recursive) {
+    QStringList files;
+    QSet<QString> seen;
+    auto append = [&files, &seen](const QString &path) {
+        const QString canonical = QFileInfo(path).canonicalFilePath();
+        const QString key = canonical.isEmpty() ? QDir::cleanPath(path) : canonical;
+        if (!seen.contains(key)) {
+            seen.insert(key);
+            files.append(QDir::cleanPath(path));
+        }
+    };
+
+    for (const QString &input : inputs) {
+        const QFileInfo info(input);
+        if (!info.isDir()) {
+            // Explicit files are taken as-is so a missing path is reported per
+            // file instead of silently dropped.
+            append(input);
+            continue;
+        }
+        QStringList found;
+        QDirIterator it(input, nameFilters, QDir::Files | QDir::Readable,
+                        recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+        while (it.hasNext()) {
+            found.append(it.next());
+        }
+        std::sort(found.begin(), found.end());
+        for (const QString &path : std::as_const(found)) {
+            append(path);
+        }
+    }
+    return files;
+}
+
+CaptureSummary BatchDecoder::decodeFile(const QString &path, const QList<IProtocolPlugin *> &plugins) {
+    CaptureSummary summary;
+    summary.filePath = path;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        summary.error = file.errorString();
+        return summary;
+    }
+    summary.bytes = file.size();
+
+    QElapsedTimer timer;
+    timer.start();
+    // TX writes share the capture file; only the receiver's bytes are decoded.
+    const CaptureStream stream = CaptureStream::fromCapture(path, summary.bytes);
+    CaptureDecoder decoder(plugins);
+    if (stream.size() > 0) {
+        const uchar *data = file.map(0, summary.bytes);
+        for (qint64 offset = 0; offset < stream.size(); offset += CaptureDecoder::kSliceBytes) {
+            const qint64 end = std::min(stream.size(), offset + CaptureDecoder::kSliceBytes);
+            if (data) {
+                decodeInto(summary, decoder, stream.slice(reinterpret_cast<const char *>(data), offset, end));
+                continue;
+            }
+            // Some filesystems refuse mmap; fall back to buffered reads.
+            const QByteArray slice = stream.read(file, offset, end);
+            if (slice.size() != end - offset) {
+                summary.error = file.errorString();
+                break;
+            }
+            decodeInto(summary, decoder, slice);
+        }
+        if (data) {
+            file.unmap(const_cast<uchar *>(data));
+        }
+    }
+    summary.decodeMs = timer.elapsed();
+    return summary;
+}
+
+void BatchDecoder::setPlugins(const QList<IProtocolPlugin *> &plugins, const QList<QObject *> &objects) {
+    m_plugins.clear();
+    m_factories.clear();
+    for (int index = 0; index < plugins.size(); ++index) {
+        IProtocolPlugin *plugin = plugins.at(index);
+        if (!plugin) {
+            continue;
+        }
+        m_plugins.append(plugin);
+        QObject *object = index < objects.size() ? objects.at(index) : nullptr;
+        m_factories.append(object ? qobject_cast<IProtocolInstanceFactory *>(object) : nullptr);
+    }
+}
+
+bool BatchDecoder::parallelSafe() const {
+    return std::none_of(m_factories.cbegin(), m_factories.cend(), [](IProtocolInstanceFactory *factory) {
+        return factory == nullptr;
+    });
+}
+
+int BatchDecoder::threadCount(int requestedJobs) const {
+    if (!parallelSafe()) {
+        return 1;
+    }
+    return std::max(1, requestedJobs > 0 ? requestedJobs : QThread::idealThreadCount());
+}
+
+int BatchDecoder::workerCount(int requestedJobs, int fileCount) const {
+    return std::clamp(threadCount(requestedJobs), 1, std::max(1, fileCount));
+}
+
+CaptureSummary BatchDecoder::decodeFileInRegions(const QString &path, int threads) const {
+    QFile file(path);
+    const uchar *data = file.open(QIODevice::ReadOnly) ? file.map(0, file.size()) : nullptr;
+    if (!data) {
+        std::vector<std::unique_ptr<IProtocolPlugin>> owned;
+        return decodeFile(path, createInstances(m_plugins, m_factories, owned));
+    }
+
+    CaptureSummary summary;
+    summary.filePath = path;
+    summary.bytes = file.size();
+    QElapsedTimer timer;
+    timer.start();
+    // Regions are cut from the RX stream, so TX writes never reach a worker.
+    const CaptureStream stream = CaptureStream::fromCapture(path, summary.bytes);
+    ParallelCaptureDecoder decoder(m_factories);
+    decoder.setJobs(threads);
+    decoder.decode(reinterpret_cast<const char *>(data), stream, [&summary](const ProtocolMessage &message) {
+        summary.addMessage(message);
+    });
+    summary.decodeMs = timer.elapsed();
+    file.unmap(const_cast<uchar *>(data));
+    return summary;
+}
+
+std::vector<CaptureSummary> BatchDecoder::run(const QStringList &files, int requestedJobs) {
+    std::vector<CaptureSummary> results(static_cast<size_t>(files.size()));
+    const int threads = threadCount(requestedJobs);
+    QList<int> whole;
+    QList<int> split;
+    for (int index = 0; index < files.size(); ++index) {
+        if (threads > 1 && QFileInfo(files.at(index)).size() >= kSplitThresholdBytes) {
+            split.append(index);
+        } else {
+            whole.append(index);
+        }
+    }
+
+    if (threads <= 1 || whole.size() <= 1) {
+        for (int index : std::as_const(whole)) {
+            // Factories still give each capture clean plugin state; plugins
+            // without one carry theirs over, as they do across live sessions.
+            std::vector<std::unique_ptr<IProtocolPlugin>> owned;
+            results[static_cast<size_t>(index)] =
+                decodeFile(files.at(index), createInstances(m_plugins, m_factories, owned));
+        }
+    } else {
+        QThreadPool pool;
+        pool.setMaxThreadCount(std::min<int>(threads, whole.size()));
+        const QList<IProtocolPlugin *> shared = m_plugins;
+        const QList<IProtocolInstanceFactory *> factories = m_factories;
+        for (int index : std::as_const(whole)) {
+            const QString path = files.at(index);
+            CaptureSummary *slot = &results[static_cast<size_t>(index)];
+            pool.start([path, slot, shared, factories]() {
+                std::vector<std::unique_ptr<IProtocolPlugin>> owned;
+                *slot = decodeFile(path, createInstances(shared, factories, owned));
+            });
+        }
+        pool.waitForDone();
+    }
+
+    // Large captures go one at a time, each split across every worker.
+    for (int index : std::as_const(split)) {
+        results[static_cast<size_t>(index)] = decodeFileInRegions(files.at(index), threads);
+    }
+    return results;
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "hdgnss/IProtocolInstanceFactory.h"
+#include "src/batch/CaptureSummary.h"
+#include "src/protocols/IProtocolPlugin.h"
+
+namespace hdgnss {
+
+// Decodes whole capture files headlessly, one file per worker thread. Only
+// the RX bytes of a capture are decoded (see CaptureStream). Each worker gets
+// its own CaptureDecoder; protocol plugins are shared only when decoding
+// serially, otherwise every file gets private instances from the plugin's
+// IProtocolInstanceFactory. Captures of several regions' worth are instead
+// decoded one at a time with ParallelCaptureDecoder.
+class BatchDecoder {
+public:
+    static QStringList collectCaptures(const QStringList &inputs,
+                                       const QStringList &nameFilters = {QStringLiteral("*.raw.bin")},
+                                       bool recursive = true);
+    static CaptureSummary decodeFile(const QString &path, const QList<IProtocolPlugin *> &plugins = {});
+
+    // objects[i] is the QObject behind plugins[i], as ProtocolPluginLoader
+    // returns them.
+    void setPlugins(const QList<IProtocolPlugin *> &plugins, const QList<QObject *> &objects);
+    // Plugins without an IProtocolInstanceFactory carry stream state that
+    // cannot be shared across threads, so they pin the batch to one worker.
+    bool parallelSafe() const;
+    int threadCount(int requestedJobs) const;
+    int workerCount(int requestedJobs, int fileCount) const;
+
+    std::vector<CaptureSummary> run(const QStringList &files, int requestedJobs);
+
+private:
+    CaptureSummary decodeFileInRegions(const QString &path, int threads) const;
+
+    QList<IProtocolPlugin *> m_plugins;
+    QList<IProtocolInstanceFactory *> m_factories;
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,135 @@
+#include "CaptureStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QFile>
+
+#include "src/storage/CaptureIndex.h"
+
+namespace hdgnss {
+
+CaptureStream CaptureStream::wholeFile(qint64 fileSize) {
+    CaptureStream stream;
+    stream.m_fileSize = std::max<qint64>(0, fileSize);
+    stream.appendFileRange(0, stream.m_fileSize);
+    return stream;
+}
+
+CaptureStream CaptureStream::fromCapture(const QString &capturePath, qint64 fileSize) {
+    QList<CaptureIndexRecord> records;
+    QFile indexFile(CaptureIndex::indexPathForCapture(capturePath));
+    if (indexFile.open(QIODevice::ReadOnly)) {
+        const qint64 indexSize = indexFile.size();
+        if (uchar *indexData = indexSize > 0 ? indexFile.map(0, indexSize) : nullptr) {
+            records = CaptureIndex::parse(indexData, indexSize);
+            indexFile.unmap(indexData);
+        } else if (indexSize > 0) {
+            const QByteArray bytes = indexFile.readAll();
+            records = CaptureIndex::parse(reinterpret_cast<const uchar *>(bytes.constData()), bytes.size());
+        }
+    }
+    // Same checks as replay: an index that runs past the capture belongs to
+    // another session.
+    if (records.isEmpty() || records.constLast().offset + records.constLast().length > fileSize) {
+        return wholeFile(fileSize);
+    }
+
+    CaptureStream stream;
+    stream.m_fileSize = fileSize;
+    qint64 position = 0;
+    for (const CaptureIndexRecord &record : std::as_const(records)) {
+        const qint64 begin = std::max(record.offset, position);
+        const qint64 end = std::min(record.offset + record.length, fileSize);
+        if (begin >= end) {
+            continue;
+        }
+        position = end;
+        if (record.direction == DataDirection::Rx) {
+            stream.appendFileRange(begin, end - begin);
+        }
+    }
+    // Bytes written after the last index record (recorder stopped mid-write).
+    stream.appendFileRange(position, fileSize - position);
+    return stream;
+}
+
+qint64 CaptureStream::size() const {
+    return m_size;
+}
+
+qint64 CaptureStream::skippedBytes() const {
+    return m_fileSize - m_size;
+}
+
+const QList<CaptureStream::Range> &CaptureStream::ranges() const {
+    return m_ranges;
+}
+
+qsizetype CaptureStream::rangeAt(qint64 streamOffset) const {
+    const auto it = std::upper_bound(m_ranges.cbegin(), m_ranges.cend(), streamOffset,
+                                     [](qint64 value, const Range &range) {
+                                         return value < range.streamOffset + range.length;
+                                     });
+    return it - m_ranges.cbegin();
+}
+
+QByteArray CaptureStream::slice(const char *data, qint64 begin, qint64 end) const {
+    end = std::min(end, m_size);
+    if (begin >= end) {
+        return {};
+    }
+    qsizetype index = rangeAt(begin);
+    const Range &first = m_ranges.at(index);
+    if (end <= first.streamOffset + first.length) {
+        return QByteArray::fromRawData(data + first.fileOffset + (begin - first.streamOffset), end - begin);
+    }
+
+    QByteArray out(end - begin, Qt::Uninitialized);
+    char *cursor = out.data();
+    for (qint64 position = begin; position < end; ++index) {
+        const Range &range = m_ranges.at(index);
+        const qint64 length = std::min(end, range.streamOffset + range.length) - position;
+        std::memcpy(cursor, data + range.fileOffset + (position - range.streamOffset), static_cast<size_t>(length));
+        cursor += length;
+        position += length;
+    }
+    return out;
+}
+
+QByteArray CaptureStream::read(QFile &file, qint64 begin, qint64 end) const {
+    end = std::min(end, m_size);
+    QByteArray out;
+    for (qsizetype index = rangeAt(begin); begin < end && index < m_ranges.size(); ++index) {
+        const Range &range = m_ranges.at(index);
+        const qint64 length = std::min(end, range.streamOffset + range.length) - begin;
+        if (!file.seek(range.fileOffset + (begin - range.streamOffset))) {
+            break;
+        }
+        const QByteArray part = file.read(length);
+        out += part;
+        if (part.size() != length) {
+            break;
+        }
+        begin += length;
+    }
+    return out;
+}
+
+void CaptureStream::appendFileRange(qint64 fileOffset, qint64 length) {
+    if (length <= 0) {
+        return;
+    }
+    if (!m_ranges.isEmpty()) {
+        Range &last = m_ranges.last();
+        if (last.fileOffset + last.length == fileOffset) {
+            last.length += length;
+            m_size += length;
+            return;
+        }
+    }
+    m_ranges.append(Range{m_size, fileOffset, length});
+    m_size += length;
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+class QFile;
+
+namespace hdgnss {
+
+// The receiver output of a raw capture. "<stem>.raw.bin" interleaves RX and
+// TX writes; with a matching .raw.idx sidecar the TX writes are left out and
+// the RX writes read as one contiguous stream, the bytes live decoding saw.
+// Without an index, or with one from another session, the whole file is
+// taken as RX, as ReplayTransport does. Offsets are stream offsets unless
+// named otherwise.
+class CaptureStream {
+public:
+    struct Range {
+        qint64 streamOffset = 0;
+        qint64 fileOffset = 0;
+        qint64 length = 0;
+    };
+
+    static CaptureStream wholeFile(qint64 fileSize);
+    static CaptureStream fromCapture(const QString &capturePath, qint64 fileSize);
+
+    qint64 size() const;
+    // Capture bytes left out of the stream: TX writes and unindexed gaps.
+    qint64 skippedBytes() const;
+    const QList<Range> &ranges() const;
+    // Index of the range holding streamOffset, or ranges().size() past the end.
+    qsizetype rangeAt(qint64 streamOffset) const;
+
+    // Bytes [begin, end) of the stream from the mapped capture. They point
+    // into `data` when they lie in one range and are copied otherwise.
+    QByteArray slice(const char *data, qint64 begin, qint64 end) const;
+    // Same, read from a capture that could not be mapped.
+    QByteArray read(QFile &file, qint64 begin, qint64 end) const;
+
+private:
+    void appendFileRange(qint64 fileOffset, qint64 length);
+
+    QList<Range> m_ranges;
+    qint64 m_size = 0;
+    qint64 m_fileSize = 0;
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,262 @@
+#include "CaptureSummary.h"
+
+#include <QTimeZone>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <cmath>
+
+#include "src/storage/JsonStreamWriter.h"
+
+namespace hdgnss {
+
+namespace {
+
+void addPositive(CaptureSummary::ValueStats &stats, const QVariantMap &fields, const QString &key) {
+    const auto it = fields.constFind(key);
+    if (it == fields.cend()) {
+        return;
+    }
+    const double value = it->toDouble();
+    if (std::isfinite(value) && value > 0.0) {
+        stats.add(value);
+    }
+}
+
+QString formatUtc(const QDateTime &utc) {
+    return utc.isValid() ? utc.toString(Qt::ISODateWithMs) : QString();
+}
+
+void appendCsvField(QByteArray &out, const QString &value) {
+    const QByteArray utf8 = value.toUtf8();
+    if (!utf8.contains(',') && !utf8.contains('"') && !utf8.contains('\n') && !utf8.contains('\r')) {
+        out.append(utf8);
+        return;
+    }
+    out.append('"');
+    for (const char ch : utf8) {
+        if (ch == '"') {
+            out.append('"');
+        }
+        out.append(ch);
+    }
+    out.append('"');
+}
+
+void appendCsvNumber(QByteArray &out, double value, int precision) {
+    if (std::isfinite(value)) {
+        out.append(QByteArray::number(value, 'f', precision));
+    }
+}
+
+void writeStats(JsonStreamWriter &json, QLatin1StringView key, const CaptureSummary::ValueStats &stats) {
+    json.writeKey(key);
+    if (stats.count == 0) {
+        json.writeNull();
+        return;
+    }
+    json.beginObject();
+    json.writeKey(QLatin1StringView("count"));
+    json.writeInteger(stats.count);
+    json.writeKey(QLatin1StringView("min"));
+    json.writeDouble(stats.min);
+    json.writeKey(QLatin1StringView("mean"));
+    json.writeDouble(stats.mean());
+    json.writeKey(QLatin1StringView("max"));
+    json.writeDouble(stats.max);
+    json.endObject();
+}
+
+}  // namespace
+
+void CaptureSummary::ValueStats::add(double value) {
+    min = count == 0 ? value : std::min(min, value);
+    max = count == 0 ? value : std::max(max, value);
+    sum += value;
+    ++count;
+}
+
+double CaptureSummary::ValueStats::mean() const {
+    return count > 0 ? sum / static_cast<double>(count) : std::nan("");
+}
+
+void CaptureSummary::addMessage(const ProtocolMessage &message) {
+    ++messages;
+    ++messageCounts[message.protocol + QLatin1Char('/') + message.messageName];
+
+    const QVariantMap &fields = message.fields;
+    addPositive(hdop, fields, QStringLiteral("hdop"));
+    addPositive(vdop, fields, QStringLiteral("vdop"));
+    addPositive(pdop, fields, QStringLiteral("pdop"));
+
+    if (const auto it = fields.constFind(QStringLiteral("satellites")); it != fields.cend()) {
+        const QVariantList satellites = it->toList();
+        for (const QVariant &value : satellites) {
+            const QVariantMap satellite = value.toMap();
+            // One entry per space vehicle, whatever signals it was tracked on.
+            satelliteKeys.insert(QStringLiteral("%1-%2")
+                                     .arg(satellite.value(QStringLiteral("constellation")).toString())
+                                     .arg(satellite.value(QStringLiteral("svid")).toInt()));
+        }
+    }
+
+    QDateTime utc = fields.value(QStringLiteral("utcTime")).toDateTime();
+    if (utc.isValid()) {
+        if (message.messageName == QStringLiteral("RMC") || message.messageName == QStringLiteral("ZDA")) {
+            m_utcDate = utc.date();
+        } else if (m_utcDate.isValid()) {
+            utc = QDateTime(m_utcDate, utc.time(), QTimeZone::UTC);
+        }
+    }
+
+    if (!fields.contains(QStringLiteral("latitude")) || !fields.contains(QStringLiteral("longitude"))) {
+        return;
+    }
+    if (const auto it = fields.constFind(QStringLiteral("satellitesUsed")); it != fields.cend()) {
+        satellitesUsed.add(it->toDouble());
+    }
+
+    const int epochMs = utc.isValid() ? utc.time().msecsSinceStartOfDay() : -1;
+    if (epochMs < 0 || epochMs != m_lastEpochMs) {
+        ++epochs;
+        m_lastEpochMs = epochMs;
+        m_lastEpochHasFix = false;
+    }
+    if (!fields.value(QStringLiteral("validFix")).toBool()) {
+        return;
+    }
+    if (!m_lastEpochHasFix) {
+        ++fixEpochs;
+        m_lastEpochHasFix = true;
+    }
+    lastLatitude = fields.value(QStringLiteral("latitude")).toDouble();
+    lastLongitude = fields.value(QStringLiteral("longitude")).toDouble();
+    if (const auto it = fields.constFind(QStringLiteral("altitudeMeters")); it != fields.cend()) {
+        const double altitude = it->toDouble();
+        if (std::isfinite(altitude)) {
+            lastAltitudeMeters = altitude;
+        }
+    }
+    if (utc.isValid()) {
+        // Later sentences of the first fix epoch may still supply the date.
+        if (fixEpochs == 1) {
+            firstFixUtc = utc;
+        }
+        lastFixUtc = utc;
+    }
+}
+
+QByteArray CaptureSummary::csvHeader() {
+    return QByteArrayLiteral(
+        "file,bytes,decode_ms,error,messages,epochs,fix_epochs,first_fix_utc,last_fix_utc,"
+        "last_latitude,last_longitude,last_altitude_m,hdop_mean,hdop_max,vdop_mean,vdop_max,"
+        "pdop_mean,pdop_max,sats_used_mean,satellites_seen,message_counts\n");
+}
+
+QByteArray CaptureSummary::toCsvRow() const {
+    QByteArray out;
+    out.reserve(256);
+    appendCsvField(out, filePath);
+    out.append(',').append(QByteArray::number(bytes));
+    out.append(',').append(QByteArray::number(decodeMs));
+    out.append(',');
+    appendCsvField(out, error);
+    out.append(',').append(QByteArray::number(messages));
+    out.append(',').append(QByteArray::number(epochs));
+    out.append(',').append(QByteArray::number(fixEpochs));
+    out.append(',').append(formatUtc(firstFixUtc).toLatin1());
+    out.append(',').append(formatUtc(lastFixUtc).toLatin1());
+    const bool hasFix = fixEpochs > 0;
+    out.append(',');
+    if (hasFix) {
+        appendCsvNumber(out, lastLatitude, 9);
+    }
+    out.append(',');
+    if (hasFix) {
+        appendCsvNumber(out, lastLongitude, 9);
+    }
+    out.append(',');
+    if (hasFix) {
+        appendCsvNumber(out, lastAltitudeMeters, 3);
+    }
+    for (const ValueStats *stats : {&hdop, &vdop, &pdop}) {
+        out.append(',');
+        appendCsvNumber(out, stats->mean(), 2);
+        out.append(',');
+        if (stats->count > 0) {
+            appendCsvNumber(out, stats->max, 2);
+        }
+    }
+    out.append(',');
+    appendCsvNumber(out, satellitesUsed.mean(), 1);
+    out.append(',').append(QByteArray::number(satelliteKeys.size()));
+
+    QString counts;
+    for (auto it = messageCounts.cbegin(); it != messageCounts.cend(); ++it) {
+        if (!counts.isEmpty()) {
+            counts.append(QLatin1Char(';'));
+        }
+        counts.append(it.key()).append(QLatin1Char(':')).append(QString::number(it.value()));
+    }
+    out.append(',');
+    appendCsvField(out, counts);
+    out.append('\n');
+    return out;
+}
+
+QByteArray CaptureSummary::toJsonLine() const {
+    QByteArray out;
+    out.reserve(512);
+    JsonStreamWriter json(&out);
+    json.beginObject();
+    json.writeKey(QLatin1StringView("file"));
+    json.writeString(filePath);
+    json.writeKey(QLatin1StringView("bytes"));
+    json.writeInteger(bytes);
+    json.writeKey(QLatin1StringView("decodeMs"));
+    json.writeInteger(decodeMs);
+    if (!error.isEmpty()) {
+        json.writeKey(QLatin1StringView("error"));
+        json.writeString(error);
+    }
+    json.writeKey(QLatin1StringView("messages"));
+    json.writeInteger(messages);
+    json.writeKey(QLatin1StringView("epochs"));
+    json.writeInteger(epochs);
+    json.writeKey(QLatin1StringView("fixEpochs"));
+    json.writeInteger(fixEpochs);
+    if (fixEpochs > 0) {
+        json.writeKey(QLatin1StringView("firstFixUtc"));
+        json.writeString(formatUtc(firstFixUtc));
+        json.writeKey(QLatin1StringView("lastFixUtc"));
+        json.writeString(formatUtc(lastFixUtc));
+        json.writeKey(QLatin1StringView("lastPosition"));
+        json.beginObject();
+        json.writeKey(QLatin1StringView("latitude"));
+        json.writeDouble(lastLatitude);
+        json.writeKey(QLatin1StringView("longitude"));
+        json.writeDouble(lastLongitude);
+        json.writeKey(QLatin1StringView("altitudeMeters"));
+        json.writeDouble(lastAltitudeMeters);
+        json.endObject();
+    }
+    writeStats(json, QLatin1StringView("hdop"), hdop);
+    writeStats(json, QLatin1StringView("vdop"), vdop);
+    writeStats(json, QLatin1StringView("pdop"), pdop);
+    writeStats(json, QLatin1StringView("satellitesUsed"), satellitesUsed);
+    json.writeKey(QLatin1StringView("satellitesSeen"));
+    json.writeInteger(satelliteKeys.size());
+    json.writeKey(QLatin1StringView("messageCounts"));
+    json.beginObject();
+    for (auto it = messageCounts.cbegin(); it != messageCounts.cend(); ++it) {
+        json.writeKey(it.key());
+        json.writeInteger(it.value());
+    }
+    json.endObject();
+    json.endObject();
+    out.append('\n');
+    return out;
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QMap>
+#include <QSet>
+#include <QString>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// Per-capture statistics for batch decoding: fixes, DOP, satellites and
+// message counts. Fed one decoded message at a time, in stream order.
+class CaptureSummary {
+public:
+    struct ValueStats {
+        qint64 count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+
+        void add(double value);
+        double mean() const;
+    };
+
+    void addMessage(const ProtocolMessage &message);
+
+    static QByteArray csvHeader();
+    QByteArray toCsvRow() const;
+    QByteArray toJsonLine() const;
+
+    QString filePath;
+    qint64 bytes = 0;
+    qint64 decodeMs = 0;
+    QString error;
+
+    qint64 messages = 0;
+    QMap<QString, qint64> messageCounts;
+    // Position epochs are keyed by UTC time of day so GGA and RMC for the same
+    // epoch count once.
+    qint64 epochs = 0;
+    qint64 fixEpochs = 0;
+    QDateTime firstFixUtc;
+    QDateTime lastFixUtc;
+    double lastLatitude = 0.0;
+    double lastLongitude = 0.0;
+    double lastAltitudeMeters = 0.0;
+    ValueStats hdop;
+    ValueStats vdop;
+    ValueStats pdop;
+    ValueStats satellitesUsed;
+    QSet<QString> satelliteKeys;
+
+private:
+    // GGA and GLL carry only a time of day; the date comes from RMC/ZDA.
+    QDate m_utcDate;
+    int m_lastEpochMs = -1;
+    bool m_lastEpochHasFix = false;
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,315 @@
+#include "ParallelCaptureDecoder.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <QByteArrayView>
+#include <QThread>
+#include <QThreadPool>
+
+#include "src/core/CaptureDecoder.h"
+#include "src/storage/JsonStreamWriter.h"
+
+namespace hdgnss {
+
+struct ParallelCaptureDecoder::Region {
+    qint64 lead = 0;
+    qint64 start = 0;
+    qint64 end = 0;
+    // Offset of the first chunk at or after end, or the stream size.
+    qint64 handoff = 0;
+    // Every chunk in [lead, handoff), warm-up included.
+    QList<CaptureDecoder::DecodedChunk> chunks;
+};
+
+namespace {
+
+bool sameChunk(const CaptureDecoder::DecodedChunk &left, const CaptureDecoder::DecodedChunk &right) {
+    if (left.offset != right.offset || left.messages.size() != right.messages.size()) {
+        return false;
+    }
+    for (qsizetype index = 0; index < left.messages.size(); ++index) {
+        if (ParallelCaptureDecoder::messageFingerprint(left.messages.at(index))
+            != ParallelCaptureDecoder::messageFingerprint(right.messages.at(index))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QList<CaptureDecoder::DecodedChunk>::const_iterator firstChunkAtOrAfter(
+    const QList<CaptureDecoder::DecodedChunk> &chunks, qint64 offset) {
+    return std::lower_bound(chunks.cbegin(), chunks.cend(), offset,
+                            [](const CaptureDecoder::DecodedChunk &chunk, qint64 value) {
+                                return chunk.offset < value;
+                            });
+}
+
+}  // namespace
+
+ParallelCaptureDecoder::ParallelCaptureDecoder(const QList<IProtocolInstanceFactory *> &factories)
+    : m_factories(factories) {
+    for (IProtocolInstanceFactory *factory : factories) {
+        for (const QByteArray &word : factory->syncWords()) {
+            if (!word.isEmpty() && !m_syncWords.contains(word)) {
+                m_syncWords.append(word);
+            }
+        }
+    }
+}
+
+void ParallelCaptureDecoder::setJobs(int jobs) {
+    m_jobs = jobs;
+}
+
+void ParallelCaptureDecoder::setRegionBytes(qint64 bytes) {
+    m_regionBytes = bytes;
+}
+
+void ParallelCaptureDecoder::setWarmupBytes(qint64 bytes) {
+    m_warmupBytes = std::max<qint64>(bytes, 1);
+}
+
+int ParallelCaptureDecoder::redecodedRegions() const {
+    return m_redecodedRegions;
+}
+
+QByteArray ParallelCaptureDecoder::messageFingerprint(const ProtocolMessage &message) {
+    QByteArray out;
+    JsonStreamWriter json(&out);
+    json.beginArray();
+    json.writeString(message.protocol);
+    json.writeString(message.messageName);
+    json.writeString(QString::fromLatin1(message.rawFrame.toHex()));
+    json.writeString(message.logDecodeText);
+    json.writeVariant(message.fields);
+    json.endArray();
+    return out;
+}
+
+qint64 ParallelCaptureDecoder::nextSyncPoint(const char *data, const CaptureStream &stream, qint64 from,
+                                             qint64 limit) const {
+    const qint64 size = stream.size();
+    limit = std::min(limit, size);
+    if (from >= limit) {
+        return -1;
+    }
+    const QList<CaptureStream::Range> &ranges = stream.ranges();
+    if (from == 0 && data[ranges.constFirst().fileOffset] == '$') {
+        return 0;
+    }
+
+    // Each RX range is scanned where it lies in the capture. A pattern split
+    // by a TX write is missed, which only moves the sync point further on.
+    const qint64 scanFrom = std::max<qint64>(from - 1, 0);
+    for (qsizetype index = stream.rangeAt(scanFrom); index < ranges.size(); ++index) {
+        const CaptureStream::Range &range = ranges.at(index);
+        const qint64 rangeEnd = range.streamOffset + range.length;
+        if (range.streamOffset >= limit) {
+            break;
+        }
+        auto bytesAt = [&](qint64 offset) {
+            return data + range.fileOffset + (offset - range.streamOffset);
+        };
+
+        // An NMEA sentence start: '$' right after a line break.
+        qint64 best = -1;
+        const qint64 lineFrom = std::max(scanFrom, range.streamOffset);
+        const qint64 lineEnd = std::min(limit, rangeEnd);
+        if (lineFrom < lineEnd) {
+            const qsizetype lineStart =
+                QByteArrayView(bytesAt(lineFrom), lineEnd - lineFrom).indexOf(QByteArrayView("\n$"));
+            if (lineStart >= 0) {
+                best = lineFrom + lineStart + 1;
+            }
+        }
+        const qint64 wordFrom = std::max(from, range.streamOffset);
+        for (const QByteArray &word : m_syncWords) {
+            const qint64 scanEnd = std::min(rangeEnd, limit + word.size() - 1);
+            if (wordFrom >= scanEnd) {
+                continue;
+            }
+            const qsizetype found = QByteArrayView(bytesAt(wordFrom), scanEnd - wordFrom).indexOf(word);
+            if (found >= 0 && (best < 0 || wordFrom + found < best)) {
+                best = wordFrom + found;
+            }
+        }
+        if (best >= 0) {
+            return best;
+        }
+    }
+    return -1;
+}
+
+qint64 ParallelCaptureDecoder::leadInFor(const char *data, const CaptureStream &stream, qint64 start,
+                                         qint64 warmup) const {
+    for (qint64 distance = std::max<qint64>(warmup, 1);; distance *= 2) {
+        if (distance >= start) {
+            return 0;
+        }
+        const qint64 lead = nextSyncPoint(data, stream, start - distance, start);
+        if (lead >= 0) {
+            return lead;
+        }
+    }
+}
+
+QList<qint64> ParallelCaptureDecoder::regionStarts(const char *data, qint64 size) const {
+    return regionStarts(data, CaptureStream::wholeFile(size));
+}
+
+QList<qint64> ParallelCaptureDecoder::regionStarts(const char *data, const CaptureStream &stream) const {
+    const qint64 size = stream.size();
+    QList<qint64> starts{0};
+    if (m_regionBytes <= 0) {
+        return starts;
+    }
+    qint64 target = m_regionBytes;
+    while (target < size) {
+        const qint64 limit = std::min(size, target + m_regionBytes);
+        const qint64 sync = nextSyncPoint(data, stream, target, limit);
+        if (sync < 0) {
+            target = limit;
+            continue;
+        }
+        starts.append(sync);
+        target = sync + m_regionBytes;
+    }
+    return starts;
+}
+
+ParallelCaptureDecoder::Region ParallelCaptureDecoder::decodeRegion(const char *data, const CaptureStream &stream,
+                                                                    qint64 lead, qint64 start, qint64 end) const {
+    const qint64 size = stream.size();
+    Region region;
+    region.lead = lead;
+    region.start = start;
+    region.end = end;
+    region.handoff = size;
+
+    std::vector<std::unique_ptr<IProtocolPlugin>> owned;
+    QList<IProtocolPlugin *> plugins;
+    for (IProtocolInstanceFactory *factory : m_factories) {
+        owned.emplace_back(factory->createProtocolInstance());
+        plugins.append(owned.back().get());
+    }
+    CaptureDecoder decoder(plugins);
+    decoder.setStreamOffset(lead);
+
+    // Slices stay on the same grid as a sequential decode; only the first one
+    // is short.
+    qint64 position = lead;
+    while (position < size) {
+        const qint64 sliceEnd = std::min(size, (position / CaptureDecoder::kSliceBytes + 1) * CaptureDecoder::kSliceBytes);
+        QList<CaptureDecoder::DecodedChunk> chunks = decoder.decodeChunks(stream.slice(data, position, sliceEnd));
+        position = sliceEnd;
+        for (CaptureDecoder::DecodedChunk &chunk : chunks) {
+            if (chunk.offset >= end) {
+                region.handoff = chunk.offset;
+                return region;
+            }
+            region.chunks.append(std::move(chunk));
+        }
+    }
+    return region;
+}
+
+qint64 ParallelCaptureDecoder::agreementStart(const Region &previous, qint64 verifiedFrom, qint64 handoff,
+                                              const Region &next) const {
+    // Skip the first half of the warm-up, where the chunker and parsers are
+    // still settling, then line both regions up on their first common chunk.
+    const qint64 compareFrom = std::max(verifiedFrom, next.lead + (next.start - next.lead) / 2);
+    auto previousIt = firstChunkAtOrAfter(previous.chunks, compareFrom);
+    auto nextIt = next.chunks.cend();
+    for (; previousIt != previous.chunks.cend() && previousIt->offset < handoff; ++previousIt) {
+        nextIt = firstChunkAtOrAfter(next.chunks, previousIt->offset);
+        if (nextIt != next.chunks.cend() && nextIt->offset == previousIt->offset) {
+            break;
+        }
+    }
+    if (previousIt == previous.chunks.cend() || previousIt->offset >= handoff) {
+        return -1;
+    }
+
+    const qint64 agreedFrom = previousIt->offset;
+    for (; previousIt != previous.chunks.cend() && previousIt->offset < handoff; ++previousIt, ++nextIt) {
+        if (nextIt == next.chunks.cend() || !sameChunk(*previousIt, *nextIt)) {
+            return -1;
+        }
+    }
+    // The next region's own output has to begin exactly at the handoff.
+    const bool alignedAtHandoff = nextIt != next.chunks.cend() ? nextIt->offset == handoff
+                                                                : next.handoff == handoff;
+    return alignedAtHandoff ? agreedFrom : -1;
+}
+
+void ParallelCaptureDecoder::decode(const char *data, qint64 size, const MessageSink &sink) {
+    decode(data, CaptureStream::wholeFile(size), sink);
+}
+
+void ParallelCaptureDecoder::decode(const char *data, const CaptureStream &stream, const MessageSink &sink) {
+    m_redecodedRegions = 0;
+    const qint64 size = stream.size();
+    if (size <= 0) {
+        return;
+    }
+    const QList<qint64> starts = regionStarts(data, stream);
+    const int jobs = std::max(1, m_jobs > 0 ? m_jobs : QThread::idealThreadCount());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    Region previous;
+    bool havePrevious = false;
+    qint64 handoff = 0;
+    qint64 verifiedFrom = 0;
+
+    // Regions are decoded a wave at a time so only `jobs` regions of decoded
+    // messages are held in memory.
+    for (qsizetype waveStart = 0; waveStart < starts.size(); waveStart += jobs) {
+        const qsizetype waveEnd = std::min<qsizetype>(starts.size(), waveStart + jobs);
+        std::vector<Region> wave(static_cast<size_t>(waveEnd - waveStart));
+        for (qsizetype index = waveStart; index < waveEnd; ++index) {
+            const qint64 start = starts.at(index);
+            const qint64 end = index + 1 < starts.size() ? starts.at(index + 1) : size;
+            Region *slot = &wave[static_cast<size_t>(index - waveStart)];
+            pool.start([this, data, &stream, start, end, slot]() {
+                *slot = decodeRegion(data, stream, leadInFor(data, stream, start, m_warmupBytes), start, end);
+            });
+        }
+        pool.waitForDone();
+
+        for (Region &region : wave) {
+            if (havePrevious) {
+                // A chunk from the previous region already covers this one.
+                if (handoff >= region.end) {
+                    continue;
+                }
+                qint64 agreedFrom = -1;
+                qint64 warmup = region.start - region.lead;
+                while (region.lead > 0 && (agreedFrom = agreementStart(previous, verifiedFrom, handoff, region)) < 0) {
+                    qint64 lead = region.lead;
+                    while (lead >= region.lead) {
+                        warmup = std::max({warmup * 2, m_warmupBytes, CaptureDecoder::kSliceBytes});
+                        lead = leadInFor(data, stream, region.start, warmup);
+                    }
+                    region = decodeRegion(data, stream, lead, region.start, region.end);
+                    ++m_redecodedRegions;
+                }
+                // Decoding from the start of the file is the sequential decode.
+                verifiedFrom = region.lead == 0 ? 0 : agreedFrom;
+            }
+
+            for (auto it = firstChunkAtOrAfter(region.chunks, handoff); it != region.chunks.cend(); ++it) {
+                for (const ProtocolMessage &message : it->messages) {
+                    sink(message);
+                }
+            }
+            handoff = region.handoff;
+            previous = std::move(region);
+            havePrevious = true;
+        }
+    }
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+
+#include <QByteArray>
+#include <QList>
+
+#include "hdgnss/IProtocolInstanceFactory.h"
+#include "src/batch/CaptureStream.h"
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// Decodes one large capture on several threads. The RX stream of the capture
+// (see CaptureStream) is cut into regions at resynchronization points (NMEA
+// line starts and plugin sync words). Each region gets fresh decoder and plugin state and starts a warm-up
+// distance early so stream state has settled by the time it reaches its own
+// bytes. Stitching hands over at a chunk boundary both neighbours agree on and
+// checks that the warm-up reproduced the previous region's output; a region
+// that did not is decoded again with a longer warm-up, down to the start of the
+// file. Messages reach the sink once each, in capture order, matching a
+// sequential CaptureDecoder run.
+class ParallelCaptureDecoder {
+public:
+    using MessageSink = std::function<void(const ProtocolMessage &)>;
+
+    static constexpr qint64 kDefaultRegionBytes = 4 * 1024 * 1024;
+    static constexpr qint64 kDefaultWarmupBytes = 64 * 1024;
+
+    // Every factory must be non-null; instances are created per region.
+    explicit ParallelCaptureDecoder(const QList<IProtocolInstanceFactory *> &factories = {});
+
+    void setJobs(int jobs);
+    void setRegionBytes(qint64 bytes);
+    void setWarmupBytes(qint64 bytes);
+
+    // Field maps hold NaN for absent optional values, which QVariant never
+    // compares equal, so decoded messages are compared through this JSON form.
+    static QByteArray messageFingerprint(const ProtocolMessage &message);
+
+    // Region start offsets in the stream; the first is always 0. `data` is
+    // the mapped capture the stream's ranges point into.
+    QList<qint64> regionStarts(const char *data, const CaptureStream &stream) const;
+    void decode(const char *data, const CaptureStream &stream, const MessageSink &sink);
+    // Same, taking all of data[0, size) as RX.
+    QList<qint64> regionStarts(const char *data, qint64 size) const;
+    void decode(const char *data, qint64 size, const MessageSink &sink);
+
+    // Regions decoded again during the last decode() because their warm-up
+    // had not converged.
+    int redecodedRegions() const;
+
+private:
+    struct Region;
+
+    qint64 nextSyncPoint(const char *data, const CaptureStream &stream, qint64 from, qint64 limit) const;
+    qint64 leadInFor(const char *data, const CaptureStream &stream, qint64 start, qint64 warmup) const;
+    Region decodeRegion(const char *data, const CaptureStream &stream, qint64 lead, qint64 start, qint64 end) const;
+    // Offset from which `next` reproduces `previous` chunk for chunk up to the
+    // handoff, or -1 if its warm-up has not converged.
+    qint64 agreementStart(const Region &previous, qint64 verifiedFrom, qint64 handoff, const Region &next) const;
+
+    QList<IProtocolInstanceFactory *> m_factories;
+    QList<QByteArray> m_syncWords;
+    int m_jobs = 0;
+    qint64 m_regionBytes = kDefaultRegionBytes;
+    qint64 m_warmupBytes = kDefaultWarmupBytes;
+    int m_redecodedRegions = 0;
+};
+
+}  // namespace hdgnss
@@ -17,7 +17,9 @@
 
 #include "hdgnss/IConfigurablePlugin.h"
 #include "hdgnss/IAutomationPlugin.h"
+#include "hdgnss/IProtocolStateSnapshot.h"
 #include "src/core/PluginMetadata.h"
+#include "src/core/ReceiverKeyframe.h"
 #include "src/tec/TecMapOverlayModel.h"
 #include "src/utils/ByteUtils.h"
 
@@ -155,10 +157,14 @@ AppController::AppController(AppSettings *settings, QObject *parent)
     if (m_settings) {
         m_rawRecorder.setRecordRawEnabled(m_settings->recordRawData());
         m_rawRecorder.setRecordDecodeEnabled(m_settings->recordDecodeLog());
+        m_rawRecorder.setRecordJsonlEnabled(m_settings->recordDecodeJsonl());
         m_rawRecorder.setLogRootDirectory(m_settings->logDirectory());
         m_deviationMapModel.setFixedCenterEnabled(m_settings->useFixedDeviationCenter());
         m_deviationMapModel.setFixedCenter(m_settings->fixedDeviationLatitude(),
                                            m_settings->fixedDeviationLongitude());
+        m_deviationMapModel.setMemoryBudget(static_cast<qint64>(m_settings->deviationMemoryMb()) * 1024 * 1024);
+        applyRawLogRetention();
+        applySatelliteHistoryBudget();
 
         connect(m_settings, &AppSettings::recordRawDataChanged, this, [this]() {
             m_rawRecorder.setRecordRawEnabled(m_settings->recordRawData());
@@ -166,6 +172,9 @@ AppController::AppController(AppSettings *settings, QObject *parent)
         connect(m_settings, &AppSettings::recordDecodeLogChanged, this, [this]() {
             m_rawRecorder.setRecordDecodeEnabled(m_settings->recordDecodeLog());
         });
+        connect(m_settings, &AppSettings::recordDecodeJsonlChanged, this, [this]() {
+            m_rawRecorder.setRecordJsonlEnabled(m_settings->recordDecodeJsonl());
+        });
         connect(m_settings, &AppSettings::logDirectoryChanged, this, [this]() {
             m_rawRecorder.setLogRootDirectory(m_settings->logDirectory());
         });
@@ -186,6 +195,13 @@ AppController::AppController(AppSettings *settings, QObject *parent)
         connect(m_settings, &AppSettings::pluginAvailabilityChanged, this, [this]() {
             QMetaObject::invokeMethod(this, &AppController::reloadAutomationPlugins, Qt::QueuedConnection);
         });
+        connect(m_settings, &AppSettings::rawLogMaxRowsChanged, this, &AppController::applyRawLogRetention);
+        connect(m_settings, &AppSettings::rawLogMemoryBudgetMbChanged, this, &AppController::applyRawLogRetention);
+        connect(m_settings, &AppSettings::rawLogScrollbackChanged, this, &AppController::applyRawLogRetention);
+        connect(m_settings, &AppSettings::satelliteHistoryMemoryMbChanged, this, &AppController::applySatelliteHistoryBudget);
+        connect(m_settings, &AppSettings::deviationMemoryMbChanged, this, [this]() {
+            m_deviationMapModel.setMemoryBudget(static_cast<qint64>(m_settings->deviationMemoryMb()) * 1024 * 1024);
+        });
         connect(m_settings, &AppSettings::useFixedDeviationCenterChanged, this, [this]() {
             m_deviationMapModel.setFixedCenterEnabled(m_settings->useFixedDeviationCenter());
         });
@@ -205,6 +221,15 @@ AppController::AppController(AppSettings *settings, QObject *parent)
         attachTransport(transport);
     }
     connect(&m_transportViewModel, &TransportViewModel::transportRegistered, this, &AppController::attachTransport);
+    connect(m_transportViewModel.replayTransport(), &ReplayTransport::seeked, this, [this](const QByteArray &keyframe) {
+        const QString transportName = m_transportViewModel.replayTransport()->name();
+        resetTransportState(transportName);
+        m_nmea.resetState();
+        if (!keyframe.isEmpty()
+            && !restoreReceiverKeyframe(QStringLiteral("%1:RX").arg(transportName), keyframe)) {
+            emit statusMessage(QStringLiteral("Replay keyframe unreadable; decoding from the seek position"));
+        }
+    });
 }
 
 AppController::~AppController() {
@@ -243,6 +268,10 @@ RawLogModel *AppController::rawLogModel() {
     return &m_rawLogModel;
 }
 
+RawLogFilterModel *AppController::rawLogFilterModel() {
+    return &m_rawLogFilterModel;
+}
+
 SatelliteModel *AppController::satelliteModel() {
     return &m_satelliteModel;
 }
@@ -251,6 +280,14 @@ SignalModel *AppController::signalModel() {
     return &m_signalModel;
 }
 
+SatelliteStatsModel *AppController::satelliteStatsModel() {
+    return &m_satelliteStatsModel;
+}
+
+SatelliteHistoryModel *AppController::satelliteHistoryModel() {
+    return &m_satelliteHistoryModel;
+}
+
 CommandButtonModel *AppController::commandButtonModel() {
     return &m_commandButtonModel;
 }
@@ -404,37 +441,31 @@ QString AppController::utcText() const {
 }
 
 int AppController::satellitesInView() const {
-    int count = 0;
-    for (const SatelliteInfo &sat : m_satellites) {
-        if (satelliteHasVisibleSignal(sat)) {
-            ++count;
-        }
-    }
-    return count;
+    return m_satelliteStatsModel.visibleSignals(QStringLiteral("ALL"));
 }
 
 QString AppController::satelliteUsage() const {
-    return signalUsageText(QStringLiteral("ALL"));
+    return m_satelliteStatsModel.usageText(QStringLiteral("ALL"));
 }
 
 QString AppController::gpsSignals() const {
-    return signalUsageText(QStringLiteral("GPS"));
+    return m_satelliteStatsModel.usageText(QStringLiteral("GPS"));
 }
 
 QString AppController::glonassSignals() const {
-    return signalUsageText(QStringLiteral("GLONASS"));
+    return m_satelliteStatsModel.usageText(QStringLiteral("GLONASS"));
 }
 
 QString AppController::beidouSignals() const {
-    return signalUsageText(QStringLiteral("BEIDOU"));
+    return m_satelliteStatsModel.usageText(QStringLiteral("BEIDOU"));
 }
 
 QString AppController::galileoSignals() const {
-    return signalUsageText(QStringLiteral("GALILEO"));
+    return m_satelliteStatsModel.usageText(QStringLiteral("GALILEO"));
 }
 
 QString AppController::otherSignals() const {
-    return signalUsageText(QStringLiteral("OTHER"));
+    return m_satelliteStatsModel.usageText(QStringLiteral("OTHER"));
 }
 
 QString AppController::sessionDirectory() const {
@@ -742,12 +773,91 @@ void AppController::resetAllStreamState(bool clearUi) {
     emit diagnosticsChanged();
 }
 
+QByteArray AppController::saveReceiverKeyframe(const QString &streamKey) const {
+    ReceiverKeyframe keyframe;
+    keyframe.location = m_location;
+    keyframe.satellites = m_satellites.values();
+    keyframe.nmeaState = m_nmea.saveState();
+    keyframe.chunkerPending = m_streamBuffers.value(streamKey).bufferedData();
+    keyframe.dispatcherState = m_protocolDispatcher.saveStream(streamKey);
+    const QList<IProtocolPlugin *> plugins = m_protocolPluginLoader.plugins();
+    const QList<QObject *> pluginObjects = m_protocolPluginLoader.pluginObjects();
+    for (int index = 0; index < plugins.size() && index < pluginObjects.size(); ++index) {
+        if (auto *snapshot = qobject_cast<IProtocolStateSnapshot *>(pluginObjects.at(index))) {
+            keyframe.pluginStates.insert(plugins.at(index)->protocolName(), snapshot->saveProtocolState());
+        }
+    }
+    return keyframe.serialize();
+}
+
+bool AppController::restoreReceiverKeyframe(const QString &streamKey, const QByteArray &state) {
+    ReceiverKeyframe keyframe;
+    if (!ReceiverKeyframe::deserialize(state, &keyframe)
+        || !m_nmea.restoreState(keyframe.nmeaState)
+        || !m_protocolDispatcher.restoreStream(streamKey, keyframe.dispatcherState)) {
+        m_nmea.resetState();
+        m_protocolDispatcher.resetStream(streamKey);
+        return false;
+    }
+
+    // Plugins without snapshot support, or whose state is missing from the
+    // keyframe, resynchronize on their own from the bytes that follow.
+    const QList<IProtocolPlugin *> plugins = m_protocolPluginLoader.plugins();
+    const QList<QObject *> pluginObjects = m_protocolPluginLoader.pluginObjects();
+    for (int index = 0; index < plugins.size() && index < pluginObjects.size(); ++index) {
+        auto *snapshot = qobject_cast<IProtocolStateSnapshot *>(pluginObjects.at(index));
+        const auto it = keyframe.pluginStates.constFind(plugins.at(index)->protocolName());
+        if (snapshot && it != keyframe.pluginStates.cend()) {
+            snapshot->restoreProtocolState(*it);
+        }
+    }
+
+    m_streamBuffers[streamKey].append(keyframe.chunkerPending);
+    m_location = keyframe.location;
+    m_satellites.clear();
+    m_satelliteStatsModel.clear();
+    // The capture position jumped, so the series would splice two times.
+    m_satelliteHistoryModel.clear();
+    m_satelliteAgeing.clear();
+    for (const SatelliteInfo &sat : std::as_const(keyframe.satellites)) {
+        m_satellites.insert(sat.key, sat);
+        m_satelliteStatsModel.addSatellite(sat);
+        m_satelliteAgeing.touch(sat.key, satelliteEpochMs());
+    }
+    if (m_tecMapOverlayModel) {
+        m_tecMapOverlayModel->setObservationTime(m_location.utcTime);
+    }
+    m_locationDirty = true;
+    m_satellitesDirty = true;
+    scheduleUiRefresh();
+    return true;
+}
+
+void AppController::applyRawLogRetention() {
+    if (!m_settings) {
+        return;
+    }
+    m_rawLogModel.setRetention(m_settings->rawLogMaxRows(),
+                               static_cast<qint64>(m_settings->rawLogMemoryBudgetMb()) * 1024 * 1024);
+    m_rawLogModel.setScrollbackEnabled(m_settings->rawLogScrollback());
+}
+
+void AppController::applySatelliteHistoryBudget() {
+    if (!m_settings) {
+        return;
+    }
+    m_satelliteHistoryModel.setMemoryBudget(static_cast<qint64>(m_settings->satelliteHistoryMemoryMb()) * 1024 * 1024);
+    m_satelliteHistoryModel.publish();
+}
+
 void AppController::clearUiState() {
     m_location = GnssLocation{};
     m_satellites.clear();
+    m_satelliteStatsModel.clear();
+    m_satelliteHistoryModel.clear();
+    m_satelliteAgeing.clear();
     m_rawLogModel.clear();
-    m_satelliteModel.setSatellites({});
-    m_signalModel.setSatellites({});
+    refreshSatellites();
     m_deviationMapModel.clear();
     m_lastDeviationSampleUtcTime = {};
     m_lastDeviationSamplePriority = -1;
@@ -1200,6 +1310,11 @@ void AppController::handleIncomingBytes(const QString &transportName, const QByt
     entry.direction = direction;
     entry.transportName = transportName;
     entry.payload = bytes;
+    // Taken before these bytes reach the recorder or the parsers, so the
+    // keyframe describes the stream exactly at the offset they start at.
+    if (isRx && m_rawRecorder.keyframeDue(entry.timestampUtc)) {
+        m_rawRecorder.recordKeyframe(entry.timestampUtc, saveReceiverKeyframe(streamKey));
+    }
     m_rawRecorder.recordRaw(entry);
     m_diagnosticsDirty = true;
     scheduleUiRefresh();
@@ -1228,12 +1343,9 @@ void AppController::handleIncomingBytes(const QString &transportName, const QByt
             }
             m_rawRecorder.recordChunk(entry.timestampUtc, direction, chunk, decodedLines);
         }
-        if (messages.isEmpty()) {
-            m_rawLogModel.appendChunk(entry.timestampUtc, direction, transportName, chunk.kindName(), chunk.payload);
-            continue;
-        }
+        m_rawLogModel.appendChunk(entry.timestampUtc, direction, transportName, chunk, messages);
         for (const ProtocolMessage &message : messages) {
-            m_rawLogModel.appendProtocolMessage(entry.timestampUtc, direction, transportName, chunk.kindName(), message);
+            m_rawRecorder.recordMessage(entry.timestampUtc, direction, transportName, message);
             applyProtocolMessage(message);
         }
     }
@@ -1293,6 +1405,7 @@ void AppController::applyProtocolMessage(const ProtocolMessage &message) {
     }
     if (fields.contains(QStringLiteral("satellites"))) {
         const QVariantList sats = fields.value(QStringLiteral("satellites")).toList();
+        const qint64 epochMs = satelliteEpochMs();
         for (const QVariant &value : sats) {
             const QVariantMap satMap = value.toMap();
             SatelliteInfo sat;
@@ -1310,10 +1423,18 @@ void AppController::applyProtocolMessage(const ProtocolMessage &message) {
             sat.elevation = satMap.value(QStringLiteral("elevation")).toInt();
             sat.cn0 = satMap.value(QStringLiteral("cn0")).toInt();
             sat.usedInFix = satMap.value(QStringLiteral("usedInFix")).toBool();
+            resolveSignalGroup(sat);
+            const auto existing = m_satellites.constFind(sat.key);
+            if (existing != m_satellites.cend()) {
+                m_satelliteStatsModel.removeSatellite(*existing);
+            }
+            m_satelliteStatsModel.addSatellite(sat);
+            m_satelliteAgeing.touch(sat.key, epochMs);
             m_satellites.insert(sat.key, sat);
         }
         m_satellitesDirty = true;
     }
+    ageSatellites();
 
     for (ProtocolInfoPanelState &panel : m_protocolInfoPanels) {
         const QString panelTargetId = fields.value(QStringLiteral("infoPanelId")).toString();
@@ -1398,6 +1519,7 @@ void AppController::scheduleUiRefresh() {
 }
 
 void AppController::flushUiRefresh() {
+    m_rawLogModel.publishPending();
     if (m_satellitesDirty) {
         refreshSatellites();
         m_satellitesDirty = false;
@@ -1417,9 +1539,43 @@ void AppController::flushUiRefresh() {
 }
 
 void AppController::refreshSatellites() {
-    const QList<SatelliteInfo> satellites = m_satellites.values();
-    m_satelliteModel.setSatellites(satellites);
-    m_signalModel.setSatellites(satellites);
+    m_satelliteModel.setSatellites(m_satellites);
+    m_signalModel.setSatellites(m_satellites);
+    if (m_satelliteStatsModel.publish()) {
+        emit satelliteStatsChanged();
+    }
+    // A refresh within the same epoch replaces that epoch's samples.
+    m_satelliteHistoryModel.appendEpoch(satelliteEpochMs(), m_satellites);
+    m_satelliteHistoryModel.publish();
+}
+
+qint64 AppController::satelliteEpochMs() const {
+    // Receiver time keeps replayed captures on their own timeline.
+    return m_location.utcTime.isValid() ? m_location.utcTime.toMSecsSinceEpoch()
+                                        : QDateTime::currentMSecsSinceEpoch();
+}
+
+void AppController::ageSatellites() {
+    const SatelliteAgeing::Transitions transitions = m_satelliteAgeing.advance(satelliteEpochMs());
+    // Stale signals stay listed, faded, but leave the counts; a stale
+    // satellite is not counted, so removing it again later is a no-op.
+    for (const QString &key : transitions.stale) {
+        const auto it = m_satellites.find(key);
+        if (it != m_satellites.end()) {
+            m_satelliteStatsModel.removeSatellite(*it);
+            it->stale = true;
+        }
+    }
+    for (const QString &key : transitions.expired) {
+        const auto it = m_satellites.find(key);
+        if (it != m_satellites.end()) {
+            m_satelliteStatsModel.removeSatellite(*it);
+            m_satellites.erase(it);
+        }
+    }
+    if (!transitions.stale.isEmpty() || !transitions.expired.isEmpty()) {
+        m_satellitesDirty = true;
+    }
 }
 
 QVariantMap AppController::streamCountersMap(const QString &transportName, const StreamCounters &counters) const {
@@ -1495,35 +1651,4 @@ QString AppController::formatProtocolInfoValue(const ProtocolInfoField &field, c
     return rendered;
 }
 
-QString AppController::signalUsageText(const QString &group) const {
-    auto belongsToGroup = [&group](const QString &constellation) {
-        if (group.isEmpty() || group == QStringLiteral("ALL")) {
-            return true;
-        }
-        if (group == QStringLiteral("OTHER")) {
-            return constellation != QStringLiteral("GPS")
-                && constellation != QStringLiteral("GLONASS")
-                && constellation != QStringLiteral("BEIDOU")
-                && constellation != QStringLiteral("GALILEO");
-        }
-        return constellation == group;
-    };
-
-    int used = 0;
-    QSet<QString> visibleSatellites;
-    QSet<QString> usedSatellites;
-    for (auto it = m_satellites.cbegin(); it != m_satellites.cend(); ++it) {
-        if (!satelliteHasVisibleSignal(*it) || !belongsToGroup(it->constellation)) {
-            continue;
-        }
-        const QString satelliteKey = QStringLiteral("%1|%2").arg(it->constellation).arg(it->svid);
-        visibleSatellites.insert(satelliteKey);
-        if (it->usedInFix) {
-            usedSatellites.insert(satelliteKey);
-        }
-    }
-    used = usedSatellites.size();
-    return QStringLiteral("%1 / %2").arg(used).arg(visibleSatellites.size());
-}
-
 }  // namespace hdgnss
@@ -13,12 +13,16 @@
 #include "src/core/FilePacketizer.h"
 #include "src/core/ProtocolDispatcher.h"
 #include "src/core/ProtocolPluginLoader.h"
+#include "src/core/SatelliteAgeing.h"
 #include "src/core/StreamChunker.h"
 #include "src/core/TransportViewModel.h"
 #include "src/models/CommandButtonModel.h"
 #include "src/models/DeviationMapModel.h"
+#include "src/models/RawLogFilterModel.h"
 #include "src/models/RawLogModel.h"
+#include "src/models/SatelliteHistoryModel.h"
 #include "src/models/SatelliteModel.h"
+#include "src/models/SatelliteStatsModel.h"
 #include "src/models/SignalModel.h"
 #include "src/protocols/NmeaProtocolPlugin.h"
 #include "src/storage/RawRecorder.h"
@@ -46,7 +50,7 @@ class AppController : public QObject {
     Q_PROPERTY(QString utcTime READ utcTime NOTIFY locationChanged)
     Q_PROPERTY(QString utcDate READ utcDate NOTIFY locationChanged)
     Q_PROPERTY(QString utcClock READ utcClock NOTIFY locationChanged)
-    Q_PROPERTY(int satelliteCount READ satelliteCount NOTIFY locationChanged)
+    Q_PROPERTY(int satelliteCount READ satelliteCount NOTIFY satelliteStatsChanged)
     Q_PROPERTY(int satellitesUsed READ satellitesUsed NOTIFY locationChanged)
     Q_PROPERTY(double age READ age NOTIFY locationChanged)
     Q_PROPERTY(double hdop READ hdop NOTIFY locationChanged)
@@ -60,13 +64,13 @@ class AppController : public QObject {
     Q_PROPERTY(QString velocityText READ velocityText NOTIFY locationChanged)
     Q_PROPERTY(QString fixText READ fixText NOTIFY locationChanged)
     Q_PROPERTY(QString utcText READ utcText NOTIFY locationChanged)
-    Q_PROPERTY(int satellitesInView READ satellitesInView NOTIFY locationChanged)
-    Q_PROPERTY(QString satelliteUsage READ satelliteUsage NOTIFY locationChanged)
-    Q_PROPERTY(QString gpsSignals READ gpsSignals NOTIFY locationChanged)
-    Q_PROPERTY(QString glonassSignals READ glonassSignals NOTIFY locationChanged)
-    Q_PROPERTY(QString beidouSignals READ beidouSignals NOTIFY locationChanged)
-    Q_PROPERTY(QString galileoSignals READ galileoSignals NOTIFY locationChanged)
-    Q_PROPERTY(QString otherSignals READ otherSignals NOTIFY locationChanged)
+    Q_PROPERTY(int satellitesInView READ satellitesInView NOTIFY satelliteStatsChanged)
+    Q_PROPERTY(QString satelliteUsage READ satelliteUsage NOTIFY satelliteStatsChanged)
+    Q_PROPERTY(QString gpsSignals READ gpsSignals NOTIFY satelliteStatsChanged)
+    Q_PROPERTY(QString glonassSignals READ glonassSignals NOTIFY satelliteStatsChanged)
+    Q_PROPERTY(QString beidouSignals READ beidouSignals NOTIFY satelliteStatsChanged)
+    Q_PROPERTY(QString galileoSignals READ galileoSignals NOTIFY satelliteStatsChanged)
+    Q_PROPERTY(QString otherSignals READ otherSignals NOTIFY satelliteStatsChanged)
     Q_PROPERTY(QString sessionDirectory READ sessionDirectory NOTIFY sessionDirectoryChanged)
     Q_PROPERTY(qulonglong totalRecordedBytes READ totalRecordedBytes NOTIFY diagnosticsChanged)
     Q_PROPERTY(QStringList fileSendDecoders READ fileSendDecoders NOTIFY fileSendDecodersChanged)
@@ -91,8 +95,11 @@ public:
     // Contains "type" (qmlSource|qmlFile) and "qmlSource" or "qmlFile" keys.
     Q_INVOKABLE QVariantMap automationPanelUiConfig() const;
     RawLogModel *rawLogModel();
+    RawLogFilterModel *rawLogFilterModel();
     SatelliteModel *satelliteModel();
     SignalModel *signalModel();
+    SatelliteStatsModel *satelliteStatsModel();
+    SatelliteHistoryModel *satelliteHistoryModel();
     CommandButtonModel *commandButtonModel();
     DeviationMapModel *deviationMapModel();
     TecMapOverlayModel *tecMapOverlayModel();
@@ -164,6 +171,7 @@ public:
 
 signals:
     void locationChanged();
+    void satelliteStatsChanged();
     void statusMessage(const QString &message);
     void sessionDirectoryChanged();
     void diagnosticsChanged();
@@ -210,7 +218,11 @@ private:
     void startTransportSession(ITransport *transport);
     void resetTransportState(const QString &transportName);
     void resetAllStreamState(bool clearUi);
+    QByteArray saveReceiverKeyframe(const QString &streamKey) const;
+    bool restoreReceiverKeyframe(const QString &streamKey, const QByteArray &state);
     void clearUiState();
+    void applyRawLogRetention();
+    void applySatelliteHistoryBudget();
     void reloadProtocolPlugins();
     void reloadAutomationPlugins();
     void registerProtocolPlugin(IProtocolPlugin &plugin);
@@ -230,17 +242,23 @@ private:
     void scheduleUiRefresh();
     void flushUiRefresh();
     void refreshSatellites();
+    // Receiver time of the current epoch, or the wall clock before the
+    // receiver reports one.
+    qint64 satelliteEpochMs() const;
+    void ageSatellites();
     QVariantMap streamCountersMap(const QString &transportName, const StreamCounters &counters) const;
     QVariantMap protocolInfoPanelMap(const ProtocolInfoPanelState &panel) const;
     QVariantList protocolInfoPanelItems(const ProtocolInfoPanelState &panel) const;
     QString formatProtocolInfoValue(const ProtocolInfoField &field, const QVariant &value) const;
-    QString signalUsageText(const QString &group) const;
     static int deviationSamplePriority(const QString &messageName);
 
     TransportViewModel m_transportViewModel;
     RawLogModel m_rawLogModel;
+    RawLogFilterModel m_rawLogFilterModel{&m_rawLogModel};
     SatelliteModel m_satelliteModel;
     SignalModel m_signalModel;
+    SatelliteStatsModel m_satelliteStatsModel;
+    SatelliteHistoryModel m_satelliteHistoryModel;
     CommandButtonModel m_commandButtonModel;
     DeviationMapModel m_deviationMapModel;
     AppSettings *m_settings = nullptr;
@@ -262,6 +280,7 @@ private:
     QHash<QString, QVariantMap> m_protocolBuildMessageDefinitions;
     GnssLocation m_location;
     QHash<QString, SatelliteInfo> m_satellites;
+    SatelliteAgeing m_satelliteAgeing;
     QHash<QString, StreamCounters> m_streamCounters;
     QList<StreamChunker::BinaryFramer> m_binaryFramers;
     QHash<QString, StreamChunker> m_streamBuffers;
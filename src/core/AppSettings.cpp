@@ -13,6 +13,15 @@ namespace hdgnss {
 
 namespace {
 
+constexpr int kMinRawLogRows = 1000;
+constexpr int kMaxRawLogRows = 10000000;
+constexpr int kMinRawLogMemoryMb = 16;
+constexpr int kMaxRawLogMemoryMb = 8192;
+constexpr int kMinSatelliteHistoryMemoryMb = 4;
+constexpr int kMaxSatelliteHistoryMemoryMb = 1024;
+constexpr int kMinDeviationMemoryMb = 8;
+constexpr int kMaxDeviationMemoryMb = 4096;
+
 QString chooseDefaultLogDirectory() {
     const QString appData = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     if (!appData.isEmpty()) {
@@ -47,6 +56,10 @@ bool AppSettings::recordDecodeLog() const {
     return m_recordDecodeLog;
 }
 
+bool AppSettings::recordDecodeJsonl() const {
+    return m_recordDecodeJsonl;
+}
+
 QString AppSettings::logDirectory() const {
     return m_logDirectory;
 }
@@ -91,6 +104,26 @@ double AppSettings::fixedDeviationLongitude() const {
     return m_fixedDeviationLongitude;
 }
 
+int AppSettings::deviationMemoryMb() const {
+    return m_deviationMemoryMb;
+}
+
+int AppSettings::rawLogMaxRows() const {
+    return m_rawLogMaxRows;
+}
+
+int AppSettings::rawLogMemoryBudgetMb() const {
+    return m_rawLogMemoryBudgetMb;
+}
+
+bool AppSettings::rawLogScrollback() const {
+    return m_rawLogScrollback;
+}
+
+int AppSettings::satelliteHistoryMemoryMb() const {
+    return m_satelliteHistoryMemoryMb;
+}
+
 bool AppSettings::pluginEnabled(const QString &pluginId) const {
     const QString cleaned = pluginId.trimmed();
     if (cleaned.isEmpty()) {
@@ -140,6 +173,18 @@ void AppSettings::setRecordDecodeLog(bool enabled) {
     emit recordDecodeLogChanged();
 }
 
+void AppSettings::setRecordDecodeJsonl(bool enabled) {
+    if (enabled && m_logDirectory.trimmed().isEmpty()) {
+        return;
+    }
+    if (m_recordDecodeJsonl == enabled) {
+        return;
+    }
+    m_recordDecodeJsonl = enabled;
+    storeValue(QStringLiteral("logging/recordDecodeJsonl"), enabled);
+    emit recordDecodeJsonlChanged();
+}
+
 void AppSettings::setLogDirectory(const QString &directory) {
     const QString cleaned = cleanedDirectory(directory);
     if (m_logDirectory == cleaned) {
@@ -159,6 +204,11 @@ void AppSettings::setLogDirectory(const QString &directory) {
             storeValue(QStringLiteral("logging/recordDecodeLog"), false);
             emit recordDecodeLogChanged();
         }
+        if (m_recordDecodeJsonl) {
+            m_recordDecodeJsonl = false;
+            storeValue(QStringLiteral("logging/recordDecodeJsonl"), false);
+            emit recordDecodeJsonlChanged();
+        }
     }
 }
 
@@ -235,6 +285,55 @@ void AppSettings::setFixedDeviationLongitude(double longitude) {
     emit fixedDeviationLongitudeChanged();
 }
 
+void AppSettings::setDeviationMemoryMb(int megabytes) {
+    const int clamped = qBound(kMinDeviationMemoryMb, megabytes, kMaxDeviationMemoryMb);
+    if (m_deviationMemoryMb == clamped) {
+        return;
+    }
+    m_deviationMemoryMb = clamped;
+    storeValue(QStringLiteral("deviation/memoryBudgetMb"), clamped);
+    emit deviationMemoryMbChanged();
+}
+
+void AppSettings::setRawLogMaxRows(int rows) {
+    const int clamped = qBound(kMinRawLogRows, rows, kMaxRawLogRows);
+    if (m_rawLogMaxRows == clamped) {
+        return;
+    }
+    m_rawLogMaxRows = clamped;
+    storeValue(QStringLiteral("rawLog/maxRows"), clamped);
+    emit rawLogMaxRowsChanged();
+}
+
+void AppSettings::setRawLogMemoryBudgetMb(int megabytes) {
+    const int clamped = qBound(kMinRawLogMemoryMb, megabytes, kMaxRawLogMemoryMb);
+    if (m_rawLogMemoryBudgetMb == clamped) {
+        return;
+    }
+    m_rawLogMemoryBudgetMb = clamped;
+    storeValue(QStringLiteral("rawLog/memoryBudgetMb"), clamped);
+    emit rawLogMemoryBudgetMbChanged();
+}
+
+void AppSettings::setRawLogScrollback(bool enabled) {
+    if (m_rawLogScrollback == enabled) {
+        return;
+    }
+    m_rawLogScrollback = enabled;
+    storeValue(QStringLiteral("rawLog/scrollback"), enabled);
+    emit rawLogScrollbackChanged();
+}
+
+void AppSettings::setSatelliteHistoryMemoryMb(int megabytes) {
+    const int clamped = qBound(kMinSatelliteHistoryMemoryMb, megabytes, kMaxSatelliteHistoryMemoryMb);
+    if (m_satelliteHistoryMemoryMb == clamped) {
+        return;
+    }
+    m_satelliteHistoryMemoryMb = clamped;
+    storeValue(QStringLiteral("satelliteHistory/memoryBudgetMb"), clamped);
+    emit satelliteHistoryMemoryMbChanged();
+}
+
 void AppSettings::setPluginEnabled(const QString &pluginId, bool enabled) {
     const QString cleaned = pluginId.trimmed();
     if (cleaned.isEmpty() || pluginEnabled(cleaned) == enabled) {
@@ -335,10 +434,12 @@ void AppSettings::load() {
     QSettings settings;
     m_recordRawData = settings.value(QStringLiteral("logging/recordRawData"), false).toBool();
     m_recordDecodeLog = settings.value(QStringLiteral("logging/recordDecodeLog"), false).toBool();
+    m_recordDecodeJsonl = settings.value(QStringLiteral("logging/recordDecodeJsonl"), false).toBool();
     m_logDirectory = cleanedDirectory(settings.value(QStringLiteral("logging/logDirectory")).toString());
     if (m_logDirectory.isEmpty()) {
         m_recordRawData = false;
         m_recordDecodeLog = false;
+        m_recordDecodeJsonl = false;
     }
 
     m_pluginsEnabled = settings.value(QStringLiteral("plugins/enabled"), true).toBool();
@@ -353,6 +454,19 @@ void AppSettings::load() {
     m_useFixedDeviationCenter = settings.value(QStringLiteral("deviation/useFixedCenter"), false).toBool();
     m_fixedDeviationLatitude = settings.value(QStringLiteral("deviation/fixedLatitude"), 0.0).toDouble();
     m_fixedDeviationLongitude = settings.value(QStringLiteral("deviation/fixedLongitude"), 0.0).toDouble();
+    m_deviationMemoryMb = qBound(kMinDeviationMemoryMb,
+                                 settings.value(QStringLiteral("deviation/memoryBudgetMb"), 64).toInt(),
+                                 kMaxDeviationMemoryMb);
+    m_rawLogMaxRows = qBound(kMinRawLogRows,
+                             settings.value(QStringLiteral("rawLog/maxRows"), 200000).toInt(),
+                             kMaxRawLogRows);
+    m_rawLogMemoryBudgetMb = qBound(kMinRawLogMemoryMb,
+                                    settings.value(QStringLiteral("rawLog/memoryBudgetMb"), 256).toInt(),
+                                    kMaxRawLogMemoryMb);
+    m_rawLogScrollback = settings.value(QStringLiteral("rawLog/scrollback"), false).toBool();
+    m_satelliteHistoryMemoryMb = qBound(kMinSatelliteHistoryMemoryMb,
+                                        settings.value(QStringLiteral("satelliteHistory/memoryBudgetMb"), 32).toInt(),
+                                        kMaxSatelliteHistoryMemoryMb);
 
     m_pluginEnabled.clear();
     m_pluginPrivateSettings.clear();
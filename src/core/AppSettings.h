@@ -13,6 +13,7 @@ class AppSettings : public QObject {
     Q_OBJECT
     Q_PROPERTY(bool recordRawData READ recordRawData WRITE setRecordRawData NOTIFY recordRawDataChanged)
     Q_PROPERTY(bool recordDecodeLog READ recordDecodeLog WRITE setRecordDecodeLog NOTIFY recordDecodeLogChanged)
+    Q_PROPERTY(bool recordDecodeJsonl READ recordDecodeJsonl WRITE setRecordDecodeJsonl NOTIFY recordDecodeJsonlChanged)
     Q_PROPERTY(QString logDirectory READ logDirectory WRITE setLogDirectory NOTIFY logDirectoryChanged)
     Q_PROPERTY(QString defaultLogDirectory READ defaultLogDirectory CONSTANT)
     Q_PROPERTY(bool pluginsEnabled READ pluginsEnabled WRITE setPluginsEnabled NOTIFY pluginsEnabledChanged)
@@ -24,12 +25,18 @@ class AppSettings : public QObject {
     Q_PROPERTY(bool useFixedDeviationCenter READ useFixedDeviationCenter WRITE setUseFixedDeviationCenter NOTIFY useFixedDeviationCenterChanged)
     Q_PROPERTY(double fixedDeviationLatitude READ fixedDeviationLatitude WRITE setFixedDeviationLatitude NOTIFY fixedDeviationLatitudeChanged)
     Q_PROPERTY(double fixedDeviationLongitude READ fixedDeviationLongitude WRITE setFixedDeviationLongitude NOTIFY fixedDeviationLongitudeChanged)
+    Q_PROPERTY(int deviationMemoryMb READ deviationMemoryMb WRITE setDeviationMemoryMb NOTIFY deviationMemoryMbChanged)
+    Q_PROPERTY(int rawLogMaxRows READ rawLogMaxRows WRITE setRawLogMaxRows NOTIFY rawLogMaxRowsChanged)
+    Q_PROPERTY(int rawLogMemoryBudgetMb READ rawLogMemoryBudgetMb WRITE setRawLogMemoryBudgetMb NOTIFY rawLogMemoryBudgetMbChanged)
+    Q_PROPERTY(bool rawLogScrollback READ rawLogScrollback WRITE setRawLogScrollback NOTIFY rawLogScrollbackChanged)
+    Q_PROPERTY(int satelliteHistoryMemoryMb READ satelliteHistoryMemoryMb WRITE setSatelliteHistoryMemoryMb NOTIFY satelliteHistoryMemoryMbChanged)
 
 public:
     explicit AppSettings(QObject *parent = nullptr);
 
     bool recordRawData() const;
     bool recordDecodeLog() const;
+    bool recordDecodeJsonl() const;
     QString logDirectory() const;
     QString defaultLogDirectory() const;
     bool pluginsEnabled() const;
@@ -41,6 +48,11 @@ public:
     bool useFixedDeviationCenter() const;
     double fixedDeviationLatitude() const;
     double fixedDeviationLongitude() const;
+    int deviationMemoryMb() const;
+    int rawLogMaxRows() const;
+    int rawLogMemoryBudgetMb() const;
+    bool rawLogScrollback() const;
+    int satelliteHistoryMemoryMb() const;
     Q_INVOKABLE bool pluginEnabled(const QString &pluginId) const;
     Q_INVOKABLE QVariantMap pluginPrivateSettings(const QString &pluginId) const;
     Q_INVOKABLE QVariant pluginSettingValue(const QString &pluginId,
@@ -50,6 +62,7 @@ public:
 public slots:
     void setRecordRawData(bool enabled);
     void setRecordDecodeLog(bool enabled);
+    void setRecordDecodeJsonl(bool enabled);
     void setLogDirectory(const QString &directory);
     void setPluginsEnabled(bool enabled);
     void setPluginDirectory(const QString &directory);
@@ -59,6 +72,11 @@ public slots:
     void setUseFixedDeviationCenter(bool enabled);
     void setFixedDeviationLatitude(double latitude);
     void setFixedDeviationLongitude(double longitude);
+    void setDeviationMemoryMb(int megabytes);
+    void setRawLogMaxRows(int rows);
+    void setRawLogMemoryBudgetMb(int megabytes);
+    void setRawLogScrollback(bool enabled);
+    void setSatelliteHistoryMemoryMb(int megabytes);
     void setPluginEnabled(const QString &pluginId, bool enabled);
     Q_INVOKABLE void setExclusivePluginEnabled(const QVariantList &pluginIds,
                                                const QString &pluginId,
@@ -69,6 +87,7 @@ public slots:
 signals:
     void recordRawDataChanged();
     void recordDecodeLogChanged();
+    void recordDecodeJsonlChanged();
     void logDirectoryChanged();
     void pluginsEnabledChanged();
     void pluginDirectoryChanged();
@@ -78,6 +97,11 @@ signals:
     void useFixedDeviationCenterChanged();
     void fixedDeviationLatitudeChanged();
     void fixedDeviationLongitudeChanged();
+    void deviationMemoryMbChanged();
+    void rawLogMaxRowsChanged();
+    void rawLogMemoryBudgetMbChanged();
+    void rawLogScrollbackChanged();
+    void satelliteHistoryMemoryMbChanged();
     void pluginSettingsChanged();
     void pluginAvailabilityChanged();
 
@@ -90,6 +114,7 @@ private:
 
     bool m_recordRawData = false;
     bool m_recordDecodeLog = false;
+    bool m_recordDecodeJsonl = false;
     QString m_logDirectory;
     bool m_pluginsEnabled = true;
     QString m_pluginDirectory;
@@ -99,6 +124,11 @@ private:
     bool m_useFixedDeviationCenter = false;
     double m_fixedDeviationLatitude = 0.0;
     double m_fixedDeviationLongitude = 0.0;
+    int m_deviationMemoryMb = 64;
+    int m_rawLogMaxRows = 200000;
+    int m_rawLogMemoryBudgetMb = 256;
+    bool m_rawLogScrollback = false;
+    int m_satelliteHistoryMemoryMb = 32;
     QHash<QString, bool> m_pluginEnabled;
     QHash<QString, QVariantMap> m_pluginPrivateSettings;
 };
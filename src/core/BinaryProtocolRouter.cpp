@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include <QDataStream>
+
 namespace hdgnss {
 
 void BinaryProtocolRouter::registerProtocol(BinaryProtocolRegistration registration) {
@@ -76,4 +78,44 @@ void BinaryProtocolRouter::resetAllStreams() {
     m_streamStates.clear();
 }
 
+QByteArray BinaryProtocolRouter::saveStream(const QString &streamKey) const {
+    const StreamState state = m_streamStates.value(streamKey);
+    const QString activeProtocol = state.activeProtocolIndex >= 0 && state.activeProtocolIndex < m_protocols.size()
+        ? m_protocols.at(state.activeProtocolIndex).name
+        : QString();
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << state.pending << activeProtocol;
+    return out;
+}
+
+bool BinaryProtocolRouter::restoreStream(const QString &streamKey, const QByteArray &state) {
+    m_streamStates.remove(streamKey);
+    QByteArray pending;
+    QString activeProtocol;
+    QDataStream stream(state);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream >> pending >> activeProtocol;
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    StreamState restored;
+    restored.pending = pending;
+    if (!activeProtocol.isEmpty()) {
+        for (int i = 0; i < m_protocols.size(); ++i) {
+            if (m_protocols.at(i).name == activeProtocol) {
+                restored.activeProtocolIndex = i;
+                break;
+            }
+        }
+        if (restored.activeProtocolIndex < 0) {
+            return false;
+        }
+    }
+    m_streamStates.insert(streamKey, restored);
+    return true;
+}
+
 }  // namespace hdgnss
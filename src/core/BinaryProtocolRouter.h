@@ -26,6 +26,10 @@ public:
     QList<CommandTemplate> commandTemplates() const;
     void resetStream(const QString &streamKey);
     void resetAllStreams();
+    // Pending probe bytes and the locked-in protocol of one stream, by name so
+    // a restore survives plugins being registered in another order.
+    QByteArray saveStream(const QString &streamKey) const;
+    bool restoreStream(const QString &streamKey, const QByteArray &state);
 
 private:
     struct StreamState {
@@ -0,0 +1,67 @@
+#include "CaptureDecoder.h"
+
+#include "src/core/BuiltinProtocolRegistry.h"
+
+namespace hdgnss {
+
+namespace {
+
+const QString kStreamKey = QStringLiteral("Capture:RX");
+
+}  // namespace
+
+CaptureDecoder::CaptureDecoder(const QList<IProtocolPlugin *> &plugins) {
+    BuiltinProtocolRegistry::registerProtocols(m_dispatcher, m_nmea);
+    for (IProtocolPlugin *plugin : plugins) {
+        if (!plugin) {
+            continue;
+        }
+        m_dispatcher.registerPlugin(*plugin);
+        if (plugin->pluginKinds().contains(ProtocolPluginKind::Binary)) {
+            m_binaryFramers.append([plugin](const QByteArray &buffer) {
+                return plugin->parseBinaryFrame(buffer);
+            });
+        }
+    }
+}
+
+void CaptureDecoder::setStreamOffset(qint64 offset) {
+    m_streamOffset = offset;
+}
+
+qint64 CaptureDecoder::streamOffset() const {
+    return m_streamOffset;
+}
+
+QList<ProtocolMessage> CaptureDecoder::decode(const QByteArray &bytes) {
+    QList<ProtocolMessage> messages;
+    m_streamOffset += bytes.size();
+    m_chunker.append(bytes);
+    const QList<StreamChunk> chunks = m_chunker.takeAvailableChunks(m_binaryFramers);
+    for (const StreamChunk &chunk : chunks) {
+        messages.append(m_dispatcher.routeChunk(kStreamKey, chunk));
+    }
+    return messages;
+}
+
+QList<CaptureDecoder::DecodedChunk> CaptureDecoder::decodeChunks(const QByteArray &bytes) {
+    m_streamOffset += bytes.size();
+    m_chunker.append(bytes);
+    const QList<StreamChunk> chunks = m_chunker.takeAvailableChunks(m_binaryFramers);
+
+    // Chunks are contiguous and end where the still-buffered bytes begin, so
+    // offsets are assigned backwards; bytes the chunker dropped on overflow
+    // never shift them.
+    QList<DecodedChunk> decoded(chunks.size());
+    qint64 end = m_streamOffset - m_chunker.bufferedBytes();
+    for (qsizetype index = chunks.size() - 1; index >= 0; --index) {
+        end -= chunks.at(index).payload.size();
+        decoded[index].offset = end;
+    }
+    for (qsizetype index = 0; index < chunks.size(); ++index) {
+        decoded[index].messages = m_dispatcher.routeChunk(kStreamKey, chunks.at(index));
+    }
+    return decoded;
+}
+
+}  // namespace hdgnss
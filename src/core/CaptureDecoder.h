@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+
+#include "src/core/ProtocolDispatcher.h"
+#include "src/core/StreamChunker.h"
+#include "src/protocols/GnssTypes.h"
+#include "src/protocols/NmeaProtocolPlugin.h"
+
+namespace hdgnss {
+
+// The decode half of AppController::handleIncomingBytes without any UI state:
+// StreamChunker -> ProtocolDispatcher with the built-in NMEA parser and the
+// given protocol plugins. Plugins are borrowed and must not be fed by anyone
+// else while this decoder is in use. One instance per thread.
+class CaptureDecoder {
+public:
+    // Captures are fed in slices of this size, aligned to the start of the
+    // RX stream, so every decode of the same bytes sees the same chunk
+    // boundaries.
+    static constexpr qint64 kSliceBytes = 64 * 1024;
+
+    struct DecodedChunk {
+        qint64 offset = 0;
+        QList<ProtocolMessage> messages;
+    };
+
+    explicit CaptureDecoder(const QList<IProtocolPlugin *> &plugins = {});
+
+    CaptureDecoder(const CaptureDecoder &) = delete;
+    CaptureDecoder &operator=(const CaptureDecoder &) = delete;
+
+    // Capture offset of the next byte passed to decode(); defaults to 0.
+    void setStreamOffset(qint64 offset);
+    qint64 streamOffset() const;
+
+    QList<ProtocolMessage> decode(const QByteArray &bytes);
+    // Same as decode() but keeps the capture offset of every chunk, including
+    // chunks no protocol recognised.
+    QList<DecodedChunk> decodeChunks(const QByteArray &bytes);
+
+private:
+    NmeaProtocolPlugin m_nmea;
+    ProtocolDispatcher m_dispatcher;
+    QList<StreamChunker::BinaryFramer> m_binaryFramers;
+    StreamChunker m_chunker;
+    qint64 m_streamOffset = 0;
+};
+
+}  // namespace hdgnss
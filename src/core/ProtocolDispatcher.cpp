@@ -92,4 +92,12 @@ void ProtocolDispatcher::resetAllStreams() {
     m_binaryRouter.resetAllStreams();
 }
 
+QByteArray ProtocolDispatcher::saveStream(const QString &streamKey) const {
+    return m_binaryRouter.saveStream(streamKey);
+}
+
+bool ProtocolDispatcher::restoreStream(const QString &streamKey, const QByteArray &state) {
+    return m_binaryRouter.restoreStream(streamKey, state);
+}
+
 }  // namespace hdgnss
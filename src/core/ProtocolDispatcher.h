@@ -31,6 +31,8 @@ public:
     QList<CommandTemplate> commandTemplates() const;
     void resetStream(const QString &streamKey);
     void resetAllStreams();
+    QByteArray saveStream(const QString &streamKey) const;
+    bool restoreStream(const QString &streamKey, const QByteArray &state);
 
 private:
     QList<ChunkProtocolRegistration> m_chunkProtocols;
@@ -0,0 +1,38 @@
+#include "ReceiverKeyframe.h"
+
+#include <QDataStream>
+
+#include "src/protocols/GnssTypesStream.h"
+
+namespace hdgnss {
+
+QByteArray ReceiverKeyframe::serialize() const {
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << kVersion << location << satellites << nmeaState << chunkerPending << dispatcherState << pluginStates;
+    return out;
+}
+
+bool ReceiverKeyframe::deserialize(const QByteArray &bytes, ReceiverKeyframe *out) {
+    if (!out) {
+        return false;
+    }
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_5);
+    quint32 version = 0;
+    stream >> version;
+    if (stream.status() != QDataStream::Ok || version != kVersion) {
+        return false;
+    }
+    ReceiverKeyframe keyframe;
+    stream >> keyframe.location >> keyframe.satellites >> keyframe.nmeaState >> keyframe.chunkerPending
+        >> keyframe.dispatcherState >> keyframe.pluginStates;
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+    *out = std::move(keyframe);
+    return true;
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// Receiver state AppController needs to continue decoding one RX stream from
+// the middle of a capture: the location and satellite table shown in the UI,
+// plus every parser state that would otherwise be rebuilt from earlier bytes.
+struct ReceiverKeyframe {
+    static constexpr quint32 kVersion = 1;
+
+    GnssLocation location;
+    QList<SatelliteInfo> satellites;
+    QByteArray nmeaState;
+    QByteArray chunkerPending;
+    QByteArray dispatcherState;
+    // Keyed by IProtocolPlugin::protocolName().
+    QHash<QString, QByteArray> pluginStates;
+
+    QByteArray serialize() const;
+    // Returns false for blobs from another format version or truncated data.
+    static bool deserialize(const QByteArray &bytes, ReceiverKeyframe *out);
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,189 @@
+#include "SatelliteAgeing.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace hdgnss {
+
+SatelliteAgeing::SatelliteAgeing() = default;
+
+void SatelliteAgeing::setTimeouts(qint64 staleAfterMs, qint64 expireAfterMs) {
+    m_staleAfterMs = std::max(staleAfterMs, kTickMs);
+    m_expireAfterMs = std::max(expireAfterMs, m_staleAfterMs);
+    // Re-file every signal at its deadline under the new timeouts; whatever
+    // is already due is reported by the next advance().
+    clearWheel();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        const qint64 timeoutMs = it->stale ? m_expireAfterMs : m_staleAfterMs;
+        schedule(it.key(), *it, tickAtOrAfter(it->lastSeenMs + timeoutMs));
+    }
+}
+
+qint64 SatelliteAgeing::staleAfterMs() const {
+    return m_staleAfterMs;
+}
+
+qint64 SatelliteAgeing::expireAfterMs() const {
+    return m_expireAfterMs;
+}
+
+void SatelliteAgeing::touch(const QString &key, qint64 nowMs) {
+    if (!m_started) {
+        m_currentTick = nowMs / kTickMs;
+        m_started = true;
+    }
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        it = m_entries.insert(key, Entry{});
+        it->lastSeenMs = nowMs;
+        schedule(key, *it, tickAtOrAfter(nowMs + m_staleAfterMs));
+        return;
+    }
+    it->lastSeenMs = nowMs;
+    if (it->stale) {
+        // Its timer is filed at the expiry deadline, which is later than the
+        // one it has now.
+        it->stale = false;
+        schedule(key, *it, tickAtOrAfter(nowMs + m_staleAfterMs));
+    }
+}
+
+void SatelliteAgeing::remove(const QString &key) {
+    m_entries.remove(key);
+}
+
+void SatelliteAgeing::clear() {
+    clearWheel();
+    m_entries.clear();
+    m_currentTick = 0;
+    m_started = false;
+}
+
+SatelliteAgeing::Transitions SatelliteAgeing::advance(qint64 nowMs) {
+    Transitions transitions;
+    const qint64 tick = nowMs / kTickMs;
+    if (!m_started) {
+        m_currentTick = tick;
+        m_started = true;
+        return transitions;
+    }
+    if (tick < m_currentTick || tick - m_currentTick > (qint64(1) << (2 * kSlotBits)) || m_entries.isEmpty()) {
+        if (tick != m_currentTick) {
+            rebase(nowMs, transitions);
+        }
+        return transitions;
+    }
+    while (m_currentTick < tick) {
+        step(transitions);
+    }
+    return transitions;
+}
+
+int SatelliteAgeing::trackedCount() const {
+    return static_cast<int>(m_entries.size());
+}
+
+bool SatelliteAgeing::isTracked(const QString &key) const {
+    return m_entries.contains(key);
+}
+
+bool SatelliteAgeing::isStale(const QString &key) const {
+    const auto it = m_entries.constFind(key);
+    return it != m_entries.cend() && it->stale;
+}
+
+qint64 SatelliteAgeing::tickAtOrAfter(qint64 ms) {
+    const qint64 tick = ms / kTickMs;
+    return tick * kTickMs < ms ? tick + 1 : tick;
+}
+
+void SatelliteAgeing::schedule(const QString &key, Entry &entry, qint64 deadlineTick) {
+    const qint64 horizon = m_currentTick + (qint64(1) << (kSlotBits * kLevels)) - 1;
+    entry.timerTick = std::clamp(deadlineTick, m_currentTick + 1, horizon);
+    place(key, entry.timerTick);
+}
+
+void SatelliteAgeing::place(const QString &key, qint64 tick) {
+    const qint64 delta = tick - m_currentTick;
+    int level = 0;
+    while (level < kLevels - 1 && delta >= (qint64(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    const qint64 slot = (tick >> (kSlotBits * level)) & (kSlots - 1);
+    m_wheel[level][slot].append(Timer{key, tick});
+}
+
+bool SatelliteAgeing::settle(const QString &key, Entry &entry, qint64 tick, Transitions &transitions) {
+    if (!entry.stale) {
+        const qint64 staleTick = tickAtOrAfter(entry.lastSeenMs + m_staleAfterMs);
+        if (staleTick > tick) {
+            schedule(key, entry, staleTick);
+            return true;
+        }
+        entry.stale = true;
+        transitions.stale.append(key);
+    }
+    const qint64 expireTick = tickAtOrAfter(entry.lastSeenMs + m_expireAfterMs);
+    if (expireTick > tick) {
+        schedule(key, entry, expireTick);
+        return true;
+    }
+    transitions.expired.append(key);
+    return false;
+}
+
+void SatelliteAgeing::step(Transitions &transitions) {
+    ++m_currentTick;
+    // Outer slots whose span starts at this tick move their timers inward,
+    // outermost first, so a timer can drop several levels in one step.
+    for (int level = kLevels - 1; level > 0; --level) {
+        if ((m_currentTick & ((qint64(1) << (kSlotBits * level)) - 1)) != 0) {
+            continue;
+        }
+        const qint64 slot = (m_currentTick >> (kSlotBits * level)) & (kSlots - 1);
+        const QList<Timer> due = std::exchange(m_wheel[level][slot], {});
+        for (const Timer &timer : due) {
+            const auto it = m_entries.constFind(timer.key);
+            if (it != m_entries.cend() && it->timerTick == timer.tick) {
+                place(timer.key, timer.tick);
+            }
+        }
+    }
+
+    const QList<Timer> due = std::exchange(m_wheel[0][m_currentTick & (kSlots - 1)], {});
+    for (const Timer &timer : due) {
+        const auto it = m_entries.find(timer.key);
+        if (it == m_entries.end() || it->timerTick != timer.tick) {
+            continue;
+        }
+        if (!settle(timer.key, *it, m_currentTick, transitions)) {
+            m_entries.erase(it);
+        }
+    }
+}
+
+void SatelliteAgeing::clearWheel() {
+    for (auto &slots : m_wheel) {
+        for (QList<Timer> &slot : slots) {
+            slot.clear();
+        }
+    }
+}
+
+void SatelliteAgeing::rebase(qint64 nowMs, Transitions &transitions) {
+    const qint64 tick = nowMs / kTickMs;
+    clearWheel();
+    m_currentTick = tick;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        // A report from the future would hold its deadline back until the
+        // clock caught up with it.
+        it->lastSeenMs = std::min(it->lastSeenMs, nowMs);
+        if (settle(it.key(), *it, tick, transitions)) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+        }
+    }
+}
+
+}  // namespace hdgnss
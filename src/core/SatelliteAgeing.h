@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <array>
+
+namespace hdgnss {
+
+// Tracks when each satellite signal was last reported and tells the caller
+// when one goes stale and, later, when it expires. Deadlines sit in a
+// hierarchical timer wheel of kLevels levels with kSlots slots each, so
+// touching a signal, advancing the clock and retiring a signal are all O(1)
+// amortized however many signals are tracked. A touch only records the time;
+// the signal's timer is checked lazily when its slot comes due and moved to
+// the new deadline if the signal was seen since.
+class SatelliteAgeing {
+public:
+    static constexpr qint64 kTickMs = 250;
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+    // 16 s, 17 min, 18 h and 48 days of ticks; later deadlines are rechecked
+    // when the outermost level comes round.
+    static constexpr int kLevels = 4;
+    static constexpr qint64 kDefaultStaleAfterMs = 10 * 1000;
+    static constexpr qint64 kDefaultExpireAfterMs = 60 * 1000;
+
+    struct Transitions {
+        // Signals that were not reported for staleAfterMs.
+        QStringList stale;
+        // Signals that were not reported for expireAfterMs; they are no
+        // longer tracked.
+        QStringList expired;
+    };
+
+    SatelliteAgeing();
+
+    // Expiry is never earlier than going stale.
+    void setTimeouts(qint64 staleAfterMs, qint64 expireAfterMs);
+    qint64 staleAfterMs() const;
+    qint64 expireAfterMs() const;
+
+    // Records that a signal was reported at nowMs. A stale signal becomes
+    // fresh again.
+    void touch(const QString &key, qint64 nowMs);
+    void remove(const QString &key);
+    void clear();
+
+    // Moves the clock to nowMs and returns the signals that went stale or
+    // expired on the way. A clock that goes back, or jumps further ahead
+    // than a turn of the second level, re-files every signal once instead
+    // of stepping through the ticks in between. Signals last reported after
+    // a clock that went back count as reported at nowMs, so they still age.
+    Transitions advance(qint64 nowMs);
+
+    int trackedCount() const;
+    bool isTracked(const QString &key) const;
+    bool isStale(const QString &key) const;
+
+private:
+    struct Entry {
+        qint64 lastSeenMs = 0;
+        // Tick the entry's live timer fires at; timers filed under any other
+        // tick are leftovers and are dropped when their slot comes due.
+        qint64 timerTick = 0;
+        bool stale = false;
+    };
+
+    struct Timer {
+        QString key;
+        qint64 tick = 0;
+    };
+
+    static qint64 tickAtOrAfter(qint64 ms);
+    // Files a timer for entry at the deadline, or at the next tick if the
+    // deadline already passed.
+    void schedule(const QString &key, Entry &entry, qint64 deadlineTick);
+    void place(const QString &key, qint64 tick);
+    // Marks the entry stale or expired if its deadline passed by tick, and
+    // otherwise files its next deadline. Returns false once it expired.
+    bool settle(const QString &key, Entry &entry, qint64 tick, Transitions &transitions);
+    void step(Transitions &transitions);
+    void clearWheel();
+    void rebase(qint64 nowMs, Transitions &transitions);
+
+    std::array<std::array<QList<Timer>, kSlots>, kLevels> m_wheel;
+    QHash<QString, Entry> m_entries;
+    qint64 m_staleAfterMs = kDefaultStaleAfterMs;
+    qint64 m_expireAfterMs = kDefaultExpireAfterMs;
+    qint64 m_currentTick = 0;
+    bool m_started = false;
+};
+
+}  // namespace hdgnss
@@ -272,4 +272,8 @@ int StreamChunker::bufferedBytes() const {
     return m_buffer.size();
 }
 
+QByteArray StreamChunker::bufferedData() const {
+    return m_buffer;
+}
+
 }  // namespace hdgnss
@@ -31,6 +31,8 @@ public:
     void append(const QByteArray &bytes);
     QList<StreamChunk> takeAvailableChunks(const QList<BinaryFramer> &framers = {});
     int bufferedBytes() const;
+    // Bytes held back for the next call, e.g. a partial sentence.
+    QByteArray bufferedData() const;
 
 private:
     int m_capacityBytes = 0;
@@ -29,10 +29,12 @@ TransportViewModel::TransportViewModel(QObject *parent)
           {QStringLiteral("UART"), QStringLiteral("UART"), m_serial.capabilities(), &m_serial},
           {QStringLiteral("TCP"), QStringLiteral("TCP"), m_tcp.capabilities(), &m_tcp},
           {QStringLiteral("UDP"), QStringLiteral("UDP"), m_udp.capabilities(), &m_udp},
+          {QStringLiteral("Replay"), QStringLiteral("Replay"), m_replay.capabilities(), &m_replay},
       }) {
     hookTransport(&m_serial);
     hookTransport(&m_tcp);
     hookTransport(&m_udp);
+    hookTransport(&m_replay);
     refreshSerialPorts();
     reloadTransportPlugins();
 }
@@ -122,6 +124,10 @@ UdpServerTransport *TransportViewModel::udpTransport() {
     return &m_udp;
 }
 
+ReplayTransport *TransportViewModel::replayTransport() {
+    return &m_replay;
+}
+
 QList<ITransport *> TransportViewModel::allTransports() const {
     QList<ITransport *> transports;
     transports.reserve(m_builtinTransports.size() + m_pluginTransports.size());
@@ -395,6 +401,17 @@ void TransportViewModel::closeUdpServer() {
     closeUdp();
 }
 
+bool TransportViewModel::openReplay(const QString &path, double speed) {
+    return openTransport(QStringLiteral("Replay"), {
+        {QStringLiteral("path"), path},
+        {QStringLiteral("speed"), speed}
+    });
+}
+
+void TransportViewModel::closeReplay() {
+    closeTransport(QStringLiteral("Replay"));
+}
+
 bool TransportViewModel::send(const QByteArray &payload, const QString &target) {
     const QString resolved = (target == QStringLiteral("Active") || target == QStringLiteral("Default"))
         ? m_activeTransport
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "src/core/TransportPluginLoader.h"
+#include "src/transports/ReplayTransport.h"
 #include "src/transports/SerialTransport.h"
 #include "src/transports/TcpClientTransport.h"
 #include "src/transports/UdpServerTransport.h"
@@ -29,6 +30,7 @@ class TransportViewModel : public QObject {
     Q_PROPERTY(QVariantList availableTransports READ availableTransports NOTIFY availableTransportsChanged)
     Q_PROPERTY(QStringList transportPluginLoadErrors READ transportPluginLoadErrors NOTIFY availableTransportsChanged)
     Q_PROPERTY(QStringList transportPluginSearchPaths READ transportPluginSearchPaths NOTIFY availableTransportsChanged)
+    Q_PROPERTY(hdgnss::ReplayTransport *replay READ replayTransport CONSTANT)
 
 public:
     explicit TransportViewModel(QObject *parent = nullptr);
@@ -48,6 +50,7 @@ public:
     SerialTransport *serialTransport();
     TcpClientTransport *tcpTransport();
     UdpServerTransport *udpTransport();
+    ReplayTransport *replayTransport();
     QList<ITransport *> allTransports() const;
 
     Q_INVOKABLE QVariantMap transportDescriptor(const QString &transportName) const;
@@ -71,6 +74,8 @@ public:
     Q_INVOKABLE bool openUdpServer(const QString &address, int port);
     Q_INVOKABLE void closeUdp();
     Q_INVOKABLE void closeUdpServer();
+    Q_INVOKABLE bool openReplay(const QString &path, double speed);
+    Q_INVOKABLE void closeReplay();
     Q_INVOKABLE bool send(const QByteArray &payload, const QString &target = QStringLiteral("Active"));
 
 signals:
@@ -120,6 +125,7 @@ private:
     SerialTransport m_serial;
     TcpClientTransport m_tcp;
     UdpServerTransport m_udp;
+    ReplayTransport m_replay;
     QList<BuiltinTransportEntry> m_builtinTransports;
     QList<PluginTransportEntry> m_pluginTransports;
     TransportPluginLoader m_transportPluginLoader;
@@ -0,0 +1,118 @@
+#include "DeviationDensityGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hdgnss {
+
+namespace {
+
+int binIndex(double meters, double binMeters) {
+    return static_cast<int>(std::floor(meters / binMeters));
+}
+
+}  // namespace
+
+double DeviationDensityGrid::binMeters(int level) {
+    return std::ldexp(kFinestBinMeters, level);
+}
+
+quint64 DeviationDensityGrid::binKey(int x, int y) {
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+int DeviationDensityGrid::binX(quint64 key) {
+    return static_cast<int>(quint32(key >> 32));
+}
+
+int DeviationDensityGrid::binY(quint64 key) {
+    return static_cast<int>(quint32(key));
+}
+
+void DeviationDensityGrid::clear() {
+    for (Level &level : m_levels) {
+        level = Level{};
+    }
+    m_sampleCount = 0;
+    ++m_revision;
+}
+
+void DeviationDensityGrid::setMaxBinsPerLevel(qsizetype bins) {
+    m_maxBinsPerLevel = std::max<qsizetype>(1, bins);
+}
+
+qsizetype DeviationDensityGrid::maxBinsPerLevel() const {
+    return m_maxBinsPerLevel;
+}
+
+void DeviationDensityGrid::add(double eastMeters, double northMeters) {
+    for (int index = 0; index < kLevels; ++index) {
+        Level &level = m_levels[index];
+        if (level.dropped) {
+            continue;
+        }
+        const double size = binMeters(index);
+        const int x = binIndex(eastMeters, size);
+        const int y = binIndex(northMeters, size);
+        ++level.bins[binKey(x, y)];
+        level.bounds |= QRect(x, y, 1, 1);
+        if (level.bins.size() > m_maxBinsPerLevel) {
+            level = Level{};
+            level.dropped = true;
+        }
+    }
+    ++m_sampleCount;
+    ++m_revision;
+}
+
+void DeviationDensityGrid::remove(double eastMeters, double northMeters) {
+    for (int index = 0; index < kLevels; ++index) {
+        Level &level = m_levels[index];
+        const double size = binMeters(index);
+        const auto it = level.bins.find(binKey(binIndex(eastMeters, size), binIndex(northMeters, size)));
+        if (it == level.bins.end()) {
+            continue;
+        }
+        if (--*it == 0) {
+            level.bins.erase(it);
+        }
+    }
+    if (m_sampleCount > 0) {
+        --m_sampleCount;
+    }
+    ++m_revision;
+}
+
+qint64 DeviationDensityGrid::sampleCount() const {
+    return m_sampleCount;
+}
+
+bool DeviationDensityGrid::hasLevel(int level) const {
+    return level >= 0 && level < kLevels && !m_levels[level].dropped;
+}
+
+QRect DeviationDensityGrid::bounds(int level) const {
+    return level >= 0 && level < kLevels ? m_levels[level].bounds : QRect();
+}
+
+const QHash<quint64, quint32> &DeviationDensityGrid::bins(int level) const {
+    static const QHash<quint64, quint32> empty;
+    return level >= 0 && level < kLevels ? m_levels[level].bins : empty;
+}
+
+quint64 DeviationDensityGrid::revision() const {
+    return m_revision;
+}
+
+qint64 DeviationDensityGrid::memoryBytes() const {
+    // A QHash keeps one offset byte per bucket and stores its 16 byte
+    // key/count entries in spans that hold up to half as many again spare.
+    constexpr qint64 kEntryBytes = 16 * 3 / 2;
+    qint64 bytes = 0;
+    for (const Level &level : m_levels) {
+        bytes += level.bins.capacity() + level.bins.size() * kEntryBytes;
+    }
+    return bytes;
+}
+
+}  // namespace hdgnss
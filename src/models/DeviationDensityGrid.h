@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QHash>
+#include <QRect>
+
+#include <array>
+
+namespace hdgnss {
+
+// How many samples fall in each square bin of a fixed east/north frame, at
+// kLevels resolutions from kFinestBinMeters up, each level's bins twice the
+// size of the previous level's. Adding or removing a sample touches one bin
+// per level. Only occupied bins are stored; a level that outgrows
+// maxBinsPerLevel() is finer than any view can show and is dropped until the
+// next clear(), which bounds the memory of the fine levels under noisy data.
+class DeviationDensityGrid {
+public:
+    static constexpr double kFinestBinMeters = 0.001;
+    // 1 mm to 32.768 m bins.
+    static constexpr int kLevels = 16;
+    static constexpr qsizetype kDefaultMaxBinsPerLevel = qsizetype(1) << 18;
+
+    static double binMeters(int level);
+    static quint64 binKey(int x, int y);
+    static int binX(quint64 key);
+    static int binY(quint64 key);
+
+    void clear();
+    // Levels already past a lower limit are dropped by the next add().
+    void setMaxBinsPerLevel(qsizetype bins);
+    qsizetype maxBinsPerLevel() const;
+    void add(double eastMeters, double northMeters);
+    void remove(double eastMeters, double northMeters);
+
+    qint64 sampleCount() const;
+    // False for a level that was dropped, or out of range.
+    bool hasLevel(int level) const;
+    // Bin indices seen at the level since clear(); removals do not shrink
+    // it. Empty while the level has no bins.
+    QRect bounds(int level) const;
+    // Sample count per occupied bin, keyed by binKey().
+    const QHash<quint64, quint32> &bins(int level) const;
+    // Bumped by every change.
+    quint64 revision() const;
+    // Estimated heap held by the bins.
+    qint64 memoryBytes() const;
+
+private:
+    struct Level {
+        QHash<quint64, quint32> bins;
+        QRect bounds;
+        bool dropped = false;
+    };
+
+    std::array<Level, kLevels> m_levels;
+    qsizetype m_maxBinsPerLevel = kDefaultMaxBinsPerLevel;
+    qint64 m_sampleCount = 0;
+    quint64 m_revision = 0;
+};
+
+}  // namespace hdgnss
@@ -2,28 +2,33 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace hdgnss {
 
 namespace {
 
-constexpr double kEarthRadiusMeters = 6378137.0;
-constexpr double kPi = 3.14159265358979323846;
+// Rough heap cost of one occupied density bin, per level.
+constexpr qint64 kBytesPerBin = 32;
+constexpr int kMinWindowSize = 1024;
+constexpr qint64 kMinBinsPerLevel = 4096;
+constexpr qint64 kDefaultMemoryBudget = qint64(64) * 1024 * 1024;
 
-QVariantMap emptyAxisStats() {
+QVariantMap axisStats(const DeviationSummary &summary) {
     return {
-        {QStringLiteral("min"), 0.0},
-        {QStringLiteral("max"), 0.0},
-        {QStringLiteral("avg"), 0.0},
-        {QStringLiteral("stdDev"), 0.0}
+        {QStringLiteral("min"), summary.min},
+        {QStringLiteral("max"), summary.max},
+        {QStringLiteral("avg"), summary.avg},
+        {QStringLiteral("stdDev"), summary.stdDev}
     };
 }
 
-QVariantMap emptyDistanceStats() {
-    QVariantMap stats = emptyAxisStats();
-    stats.insert(QStringLiteral("cep50"), 0.0);
-    stats.insert(QStringLiteral("cep68"), 0.0);
-    stats.insert(QStringLiteral("cep95"), 0.0);
+QVariantMap distanceStats(const DeviationDistanceSummary &summary) {
+    QVariantMap stats = axisStats(summary);
+    stats.insert(QStringLiteral("cep50"), summary.cep50);
+    stats.insert(QStringLiteral("cep68"), summary.cep68);
+    stats.insert(QStringLiteral("cep95"), summary.cep95);
+    stats.insert(QStringLiteral("resolution"), summary.resolution);
     return stats;
 }
 
@@ -31,33 +36,24 @@ QVariantMap emptyDistanceStats() {
 
 DeviationMapModel::DeviationMapModel(QObject *parent)
     : QAbstractListModel(parent) {
-    m_stats = {
-        {QStringLiteral("points"), 0},
-        {QStringLiteral("centerMode"), QStringLiteral("Average")},
-        {QStringLiteral("centerLatitude"), 0.0},
-        {QStringLiteral("centerLongitude"), 0.0},
-        {QStringLiteral("maxDistance"), 1.0},
-        {QStringLiteral("horizontal"), emptyDistanceStats()},
-        {QStringLiteral("latitude"), emptyAxisStats()},
-        {QStringLiteral("longitude"), emptyAxisStats()}
-    };
+    setMemoryBudget(kDefaultMemoryBudget);
+    m_stats = buildStats();
 }
 
 int DeviationMapModel::rowCount(const QModelIndex &parent) const {
-    return parent.isValid() ? 0 : m_samples.size();
+    return parent.isValid() ? 0 : static_cast<int>(m_statistics.size());
 }
 
 QVariant DeviationMapModel::data(const QModelIndex &index, int role) const {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_samples.size()) {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_statistics.size()) {
         return {};
     }
-    const DeviationSample &sample = m_samples.at(index.row());
+    const DeviationPoint sample = m_statistics.localPoint(index.row());
     switch (role) {
     case EastMetersRole: return sample.eastMeters;
     case NorthMetersRole: return sample.northMeters;
-    case DistanceMetersRole: return sample.distanceMeters;
-    case SequenceRole: return index.row() + 1;
-    case LatestRole: return index.row() == (m_samples.size() - 1);
+    case SequenceRole: return m_statistics.evictedCount() + index.row() + 1;
+    case LatestRole: return index.row() == (m_statistics.size() - 1);
     default: return {};
     }
 }
@@ -66,53 +62,80 @@ QHash<int, QByteArray> DeviationMapModel::roleNames() const {
     return {
         {EastMetersRole, "eastMeters"},
         {NorthMetersRole, "northMeters"},
-        {DistanceMetersRole, "distanceMeters"},
         {SequenceRole, "sequence"},
         {LatestRole, "latest"}
     };
 }
 
 QVariantMap DeviationMapModel::get(int row) const {
-    if (row < 0 || row >= m_samples.size()) {
+    if (row < 0 || row >= m_statistics.size()) {
         return {};
     }
-    const DeviationSample &sample = m_samples.at(row);
+    const DeviationPoint sample = m_statistics.localPoint(row);
     return {
         {QStringLiteral("eastMeters"), sample.eastMeters},
         {QStringLiteral("northMeters"), sample.northMeters},
-        {QStringLiteral("distanceMeters"), sample.distanceMeters},
-        {QStringLiteral("sequence"), row + 1},
-        {QStringLiteral("latest"), row == (m_samples.size() - 1)}
+        {QStringLiteral("sequence"), m_statistics.evictedCount() + row + 1},
+        {QStringLiteral("latest"), row == (m_statistics.size() - 1)}
     };
 }
 
 void DeviationMapModel::clear() {
-    if (m_rawSamples.isEmpty() && m_samples.isEmpty()) {
+    if (m_statistics.size() == 0) {
         return;
     }
     beginResetModel();
-    m_rawSamples.clear();
-    m_samples.clear();
+    m_statistics.clear();
     endResetModel();
-    recalculate();
+    publish();
+    emit countChanged();
+}
+
+QVariantList DeviationMapModel::intervals() const {
+    QVariantList intervals;
+    intervals.reserve(m_statistics.intervals().size());
+    for (const DeviationInterval &interval : m_statistics.intervals()) {
+        intervals.append(QVariantMap{
+            {QStringLiteral("firstSequence"), interval.firstSequence + 1},
+            {QStringLiteral("count"), interval.count},
+            {QStringLiteral("eastMean"), interval.eastMean},
+            {QStringLiteral("northMean"), interval.northMean},
+            {QStringLiteral("eastStdDev"), std::sqrt(interval.eastVariance())},
+            {QStringLiteral("northStdDev"), std::sqrt(interval.northVariance())},
+            {QStringLiteral("covariance"), interval.covariance()},
+            {QStringLiteral("maxRadius"), interval.maxRadius}
+        });
+    }
+    return intervals;
 }
 
 void DeviationMapModel::addSample(double latitude, double longitude) {
     if (!std::isfinite(latitude) || !std::isfinite(longitude)) {
         return;
     }
-    m_rawSamples.append({latitude, longitude});
-    recalculate();
+    const int row = static_cast<int>(m_statistics.size());
+    beginInsertRows(QModelIndex(), row, row);
+    m_statistics.append(latitude, longitude);
+    endInsertRows();
+    // Notify after the insert so LatestRole of the previous last row reads false.
+    if (row > 0) {
+        emit dataChanged(index(row - 1), index(row - 1), {LatestRole});
+    }
+    enforceRetention();
+    emit countChanged();
+    publish();
 }
 
 bool DeviationMapModel::updateLastSample(double latitude, double longitude) {
-    if (!std::isfinite(latitude) || !std::isfinite(longitude) || m_rawSamples.isEmpty()) {
+    if (!std::isfinite(latitude) || !std::isfinite(longitude)) {
+        return false;
+    }
+    const int row = static_cast<int>(m_statistics.size()) - 1;
+    if (!m_statistics.replaceLast(latitude, longitude)) {
         return false;
     }
-    RawSample &lastSample = m_rawSamples.last();
-    lastSample.latitude = latitude;
-    lastSample.longitude = longitude;
-    recalculate();
+    emit dataChanged(index(row), index(row), {EastMetersRole, NorthMetersRole});
+    publish();
     return true;
 }
 
@@ -121,7 +144,8 @@ void DeviationMapModel::setFixedCenterEnabled(bool enabled) {
         return;
     }
     m_fixedCenterEnabled = enabled;
-    recalculate();
+    m_statistics.setFixedCenter(m_fixedCenterEnabled, m_fixedLatitude, m_fixedLongitude);
+    publish();
 }
 
 void DeviationMapModel::setFixedCenter(double latitude, double longitude) {
@@ -131,7 +155,34 @@ void DeviationMapModel::setFixedCenter(double latitude, double longitude) {
     }
     m_fixedLatitude = latitude;
     m_fixedLongitude = longitude;
-    recalculate();
+    m_statistics.setFixedCenter(m_fixedCenterEnabled, m_fixedLatitude, m_fixedLongitude);
+    publish();
+}
+
+void DeviationMapModel::setMemoryBudget(qint64 bytes) {
+    // A quarter for the density grid, whose levels each get an equal share,
+    // the most the intervals can take, and the rest for rows, less one
+    // eviction batch of headroom.
+    m_memoryBudget = bytes;
+    const qint64 gridBytes = bytes / 4;
+    m_statistics.setDensityBinsPerLevel(
+        std::max(kMinBinsPerLevel, gridBytes / (DeviationDensityGrid::kLevels * kBytesPerBin)));
+    const qint64 rowBytes = bytes - gridBytes - DeviationStatistics::maxIntervalBytes();
+    const qint64 rows = std::max<qint64>(kMinWindowSize, rowBytes / DeviationStatistics::retainedSampleBytes());
+    m_evictionBatch = static_cast<int>(std::min<qint64>(rows / 32, std::numeric_limits<int>::max() / 2));
+    m_windowSize = static_cast<int>(std::min<qint64>(rows - m_evictionBatch, std::numeric_limits<int>::max() / 2));
+}
+
+qint64 DeviationMapModel::memoryBudget() const {
+    return m_memoryBudget;
+}
+
+qint64 DeviationMapModel::memoryBytes() const {
+    return m_statistics.memoryBytes();
+}
+
+int DeviationMapModel::windowSize() const {
+    return m_windowSize;
 }
 
 int DeviationMapModel::revision() const {
@@ -142,185 +193,82 @@ QVariantMap DeviationMapModel::stats() const {
     return m_stats;
 }
 
+QPointF DeviationMapModel::centerOffset() const {
+    return m_centerOffset;
+}
+
+QPointF DeviationMapModel::localPoint(int row) const {
+    const DeviationPoint point = m_statistics.localPoint(row);
+    return {point.eastMeters, point.northMeters};
+}
+
+const DeviationDensityGrid &DeviationMapModel::densityGrid() const {
+    return m_statistics.densityGrid();
+}
+
 #ifdef HDGNSS_REGRESSION_TESTS
 int DeviationMapModel::regressionRawSampleCount() const {
-    return m_rawSamples.size();
+    return static_cast<int>(m_statistics.size());
 }
 
 QVariantMap DeviationMapModel::regressionRawSample(int index) const {
-    if (index < 0 || index >= m_rawSamples.size()) {
+    if (index < 0 || index >= m_statistics.size()) {
         return {};
     }
 
-    const RawSample &sample = m_rawSamples.at(index);
     return {
-        {QStringLiteral("latitude"), sample.latitude},
-        {QStringLiteral("longitude"), sample.longitude}
+        {QStringLiteral("latitude"), m_statistics.sampleLatitude(index)},
+        {QStringLiteral("longitude"), m_statistics.sampleLongitude(index)}
     };
 }
 #endif
 
-void DeviationMapModel::recalculate() {
-    const int oldCount = m_samples.size();
-
-    // Compute center
-    double centerLatitude = 0.0;
-    double centerLongitude = 0.0;
-    if (!m_rawSamples.isEmpty()) {
-        if (m_fixedCenterEnabled) {
-            centerLatitude = m_fixedLatitude;
-            centerLongitude = m_fixedLongitude;
-        } else {
-            for (const RawSample &sample : std::as_const(m_rawSamples)) {
-                centerLatitude += sample.latitude;
-                centerLongitude += sample.longitude;
-            }
-            centerLatitude /= m_rawSamples.size();
-            centerLongitude /= m_rawSamples.size();
-        }
-    }
-
-    // Project all raw samples into metric deviations
-    QList<DeviationSample> newSamples;
-    QList<double> eastValues;
-    QList<double> northValues;
-    QList<double> distances;
-    newSamples.reserve(m_rawSamples.size());
-    eastValues.reserve(m_rawSamples.size());
-    northValues.reserve(m_rawSamples.size());
-    distances.reserve(m_rawSamples.size());
-
-    const double centerLatRad = centerLatitude * kPi / 180.0;
-    for (const RawSample &sample : std::as_const(m_rawSamples)) {
-        const double northMeters = (sample.latitude - centerLatitude) * kPi / 180.0 * kEarthRadiusMeters;
-        const double eastMeters = (sample.longitude - centerLongitude) * kPi / 180.0 * kEarthRadiusMeters * std::cos(centerLatRad);
-        const double distanceMeters = std::hypot(eastMeters, northMeters);
-        newSamples.append({eastMeters, northMeters, distanceMeters});
-        eastValues.append(eastMeters);
-        northValues.append(northMeters);
-        distances.append(distanceMeters);
-    }
-
-    const int newCount = newSamples.size();
-
-    // Apply model changes with the narrowest possible notification scope
-    if (newCount == oldCount + 1) {
-        // One sample appended: update existing row data in-place, then insert the new row.
-        // The in-place update is needed because adding a point shifts the average center.
-        for (int i = 0; i < oldCount; ++i) {
-            m_samples[i] = newSamples[i];
-        }
-        beginInsertRows(QModelIndex(), oldCount, oldCount);
-        m_samples.append(newSamples.last());
-        endInsertRows();
-        // Notify after insert so LatestRole for old last row evaluates correctly (false).
-        if (oldCount > 0) {
-            emit dataChanged(index(0), index(oldCount - 1),
-                {EastMetersRole, NorthMetersRole, DistanceMetersRole, LatestRole});
-        }
-    } else if (newCount == oldCount && newCount > 0) {
-        // Same count but values changed (center move or updateLastSample).
-        m_samples = std::move(newSamples);
-        emit dataChanged(index(0), index(newCount - 1),
-            {EastMetersRole, NorthMetersRole, DistanceMetersRole, LatestRole});
-    } else if (newCount == 0 && oldCount == 0) {
-        // Nothing to do — called after clear() which already reset the model.
-    } else {
-        // Fallback for any unexpected size transition.
-        beginResetModel();
-        m_samples = std::move(newSamples);
-        endResetModel();
+void DeviationMapModel::enforceRetention() {
+    // Evicting a batch at a time keeps row removal, and the views' rebuild
+    // that follows it, rare.
+    const int rows = static_cast<int>(m_statistics.size());
+    if (rows <= m_windowSize + m_evictionBatch) {
+        return;
     }
+    const int count = rows - m_windowSize;
+    beginRemoveRows(QModelIndex(), 0, count - 1);
+    m_statistics.evictOldest(count);
+    endRemoveRows();
+}
 
-    // Update aggregate statistics
-    m_stats = {
-        {QStringLiteral("points"), m_samples.size()},
-        {QStringLiteral("centerMode"), m_fixedCenterEnabled ? QStringLiteral("Fixed") : QStringLiteral("Average")},
-        {QStringLiteral("centerLatitude"), centerLatitude},
-        {QStringLiteral("centerLongitude"), centerLongitude},
-        {QStringLiteral("maxDistance"), 1.0},
-        {QStringLiteral("horizontal"), buildDistanceStats(distances)},
-        {QStringLiteral("latitude"), buildAxisStats(northValues)},
-        {QStringLiteral("longitude"), buildAxisStats(eastValues)}
-    };
-
-    if (distances.isEmpty()) {
-        m_stats.insert(QStringLiteral("maxDistance"), 1.0);
-        m_stats.insert(QStringLiteral("horizontal"), emptyDistanceStats());
-        m_stats.insert(QStringLiteral("latitude"), emptyAxisStats());
-        m_stats.insert(QStringLiteral("longitude"), emptyAxisStats());
-    } else {
-        const auto maxIt = std::max_element(distances.cbegin(), distances.cend());
-        m_stats.insert(QStringLiteral("maxDistance"), qMax(1.0, std::ceil(*maxIt)));
+void DeviationMapModel::publish() {
+    const DeviationPoint center = m_statistics.centerOffset();
+    const QPointF offset(center.eastMeters, center.northMeters);
+    if (offset != m_centerOffset) {
+        m_centerOffset = offset;
+        emit centerOffsetChanged();
     }
+    rebuildStats();
+}
 
+void DeviationMapModel::rebuildStats() {
+    m_stats = buildStats();
     ++m_revision;
-    emit countChanged();
     emit revisionChanged();
     emit statsChanged();
 }
 
-QVariantMap DeviationMapModel::buildAxisStats(const QList<double> &values) {
-    if (values.isEmpty()) {
-        return emptyAxisStats();
-    }
-
-    double minValue = values.first();
-    double maxValue = values.first();
-    double sum = 0.0;
-    for (double value : values) {
-        minValue = std::min(minValue, value);
-        maxValue = std::max(maxValue, value);
-        sum += value;
-    }
-    const double average = sum / values.size();
-
-    double variance = 0.0;
-    for (double value : values) {
-        const double delta = value - average;
-        variance += delta * delta;
-    }
-    variance /= values.size();
-
+QVariantMap DeviationMapModel::buildStats() const {
+    // Every summary is zero while there are no samples.
+    const DeviationDistanceSummary horizontal = m_statistics.horizontal();
+    const bool empty = m_statistics.size() == 0;
     return {
-        {QStringLiteral("min"), minValue},
-        {QStringLiteral("max"), maxValue},
-        {QStringLiteral("avg"), average},
-        {QStringLiteral("stdDev"), std::sqrt(variance)}
+        {QStringLiteral("points"), m_statistics.totalCount()},
+        {QStringLiteral("retainedPoints"), static_cast<int>(m_statistics.size())},
+        {QStringLiteral("centerMode"), m_fixedCenterEnabled ? QStringLiteral("Fixed") : QStringLiteral("Average")},
+        {QStringLiteral("centerLatitude"), empty ? 0.0 : m_statistics.centerLatitude()},
+        {QStringLiteral("centerLongitude"), empty ? 0.0 : m_statistics.centerLongitude()},
+        {QStringLiteral("maxDistance"), qMax(1.0, std::ceil(horizontal.max))},
+        {QStringLiteral("horizontal"), distanceStats(horizontal)},
+        {QStringLiteral("retainedHorizontal"), distanceStats(m_statistics.retainedHorizontal())},
+        {QStringLiteral("latitude"), axisStats(m_statistics.north())},
+        {QStringLiteral("longitude"), axisStats(m_statistics.east())}
     };
 }
 
-QVariantMap DeviationMapModel::buildDistanceStats(const QList<double> &values) {
-    if (values.isEmpty()) {
-        return emptyDistanceStats();
-    }
-
-    QVariantMap stats = buildAxisStats(values);
-    QList<double> sorted = values;
-    std::sort(sorted.begin(), sorted.end());
-    stats.insert(QStringLiteral("cep50"), percentile(sorted, 0.50));
-    stats.insert(QStringLiteral("cep68"), percentile(sorted, 0.68));
-    stats.insert(QStringLiteral("cep95"), percentile(sorted, 0.95));
-    return stats;
-}
-
-double DeviationMapModel::percentile(const QList<double> &sortedValues, double ratio) {
-    if (sortedValues.isEmpty()) {
-        return 0.0;
-    }
-    if (sortedValues.size() == 1) {
-        return sortedValues.first();
-    }
-
-    const double clampedRatio = std::clamp(ratio, 0.0, 1.0);
-    const double position = clampedRatio * static_cast<double>(sortedValues.size() - 1);
-    const int lowerIndex = static_cast<int>(std::floor(position));
-    const int upperIndex = static_cast<int>(std::ceil(position));
-    if (lowerIndex == upperIndex) {
-        return sortedValues.at(lowerIndex);
-    }
-    const double weight = position - lowerIndex;
-    return sortedValues.at(lowerIndex) * (1.0 - weight) + sortedValues.at(upperIndex) * weight;
-}
-
 }  // namespace hdgnss
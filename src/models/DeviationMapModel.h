@@ -1,21 +1,36 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QPointF>
 #include <QVariantMap>
 
+#include "src/models/DeviationStatistics.h"
+
 namespace hdgnss {
 
+// Rows are the samples in the fixed local frame of DeviationStatistics, east
+// and north of the first sample, and stats() its summaries. A row keeps its
+// position once inserted; the moving center is published on its own as
+// centerOffset, so views subtract it instead of re-reading every row. The
+// rows are also binned into densityGrid() for views that draw too many
+// samples to show one by one.
+//
+// setMemoryBudget() bounds the rows: once they outgrow the window the budget
+// allows, the oldest are removed in batches and live on only as the interval
+// aggregates and density grid of DeviationStatistics. stats() keeps
+// describing the whole run, with "retainedPoints" and "retainedHorizontal"
+// for the rows still held.
 class DeviationMapModel : public QAbstractListModel {
     Q_OBJECT
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(int revision READ revision NOTIFY revisionChanged)
     Q_PROPERTY(QVariantMap stats READ stats NOTIFY statsChanged)
+    Q_PROPERTY(QPointF centerOffset READ centerOffset NOTIFY centerOffsetChanged)
 
 public:
     enum Roles {
         EastMetersRole = Qt::UserRole + 1,
         NorthMetersRole,
-        DistanceMetersRole,
         SequenceRole,
         LatestRole
     };
@@ -28,13 +43,29 @@ public:
 
     Q_INVOKABLE QVariantMap get(int row) const;
     Q_INVOKABLE void clear();
+    // Evicted samples folded into {firstSequence, count, eastMean, northMean,
+    // eastStdDev, northStdDev, covariance, maxRadius} maps.
+    Q_INVOKABLE QVariantList intervals() const;
 
     void addSample(double latitude, double longitude);
     bool updateLastSample(double latitude, double longitude);
     void setFixedCenterEnabled(bool enabled);
     void setFixedCenter(double latitude, double longitude);
+    // Split between retained rows, the interval aggregates and the density
+    // grid; shrinking it evicts on the next sample. It covers the model's own
+    // heap down to a floor of about 3 MiB; the point cloud's vertices
+    // are bounded by the view's level of detail instead.
+    void setMemoryBudget(qint64 bytes);
+    qint64 memoryBudget() const;
+    // Estimated heap held by the samples and their aggregates.
+    qint64 memoryBytes() const;
+    int windowSize() const;
     int revision() const;
     QVariantMap stats() const;
+    // East (x) and north (y) of the center in the row frame, in meters.
+    QPointF centerOffset() const;
+    QPointF localPoint(int row) const;
+    const DeviationDensityGrid &densityGrid() const;
 
 #ifdef HDGNSS_REGRESSION_TESTS
     int regressionRawSampleCount() const;
@@ -45,30 +76,23 @@ signals:
     void countChanged();
     void revisionChanged();
     void statsChanged();
+    void centerOffsetChanged();
 
 private:
-    struct RawSample {
-        double latitude = 0.0;
-        double longitude = 0.0;
-    };
-
-    struct DeviationSample {
-        double eastMeters = 0.0;
-        double northMeters = 0.0;
-        double distanceMeters = 0.0;
-    };
-
-    void recalculate();
-    static QVariantMap buildAxisStats(const QList<double> &values);
-    static QVariantMap buildDistanceStats(const QList<double> &values);
-    static double percentile(const QList<double> &sortedValues, double ratio);
+    void enforceRetention();
+    void publish();
+    void rebuildStats();
+    QVariantMap buildStats() const;
 
-    QList<RawSample> m_rawSamples;
-    QList<DeviationSample> m_samples;
+    DeviationStatistics m_statistics;
     QVariantMap m_stats;
+    QPointF m_centerOffset;
     bool m_fixedCenterEnabled = false;
     double m_fixedLatitude = 0.0;
     double m_fixedLongitude = 0.0;
+    qint64 m_memoryBudget = 0;
+    int m_windowSize = 0;
+    int m_evictionBatch = 0;
     int m_revision = 0;
 };
 
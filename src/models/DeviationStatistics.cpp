@@ -0,0 +1,560 @@
+#include "DeviationStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+namespace hdgnss {
+
+namespace {
+
+constexpr double kEarthRadiusMeters = 6378137.0;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMetersPerDegree = kPi / 180.0 * kEarthRadiusMeters;
+
+double eastScale(double latitude) {
+    return kMetersPerDegree * std::cos(latitude * kPi / 180.0);
+}
+
+// A std::set node on a 64-bit build: color and three links (32 bytes), the
+// 16 byte key and the allocator's header, in a 64 byte chunk.
+constexpr qint64 kDistanceNodeBytes = 64;
+// Evicting from the front leaves the sample list up to four times as large
+// as its peak size: doubling while it first fills, and once more when the
+// space freed at the front is too small to slide into.
+constexpr qint64 kSampleSlotsPerSample = 4;
+
+// Position of a ratio between ranks 0 and count - 1, as the full sort used to
+// interpolate it.
+double rankPosition(double ratio, qsizetype count) {
+    return std::clamp(ratio, 0.0, 1.0) * static_cast<double>(count - 1);
+}
+
+}  // namespace
+
+void DeviationInterval::add(double eastMeters, double northMeters) {
+    ++count;
+    if (count == 1) {
+        eastMean = eastMeters;
+        northMean = northMeters;
+        return;
+    }
+    const double eastDelta = eastMeters - eastMean;
+    const double northDelta = northMeters - northMean;
+    eastMean += eastDelta / count;
+    northMean += northDelta / count;
+    eastM2 += eastDelta * (eastMeters - eastMean);
+    northM2 += northDelta * (northMeters - northMean);
+    crossM2 += eastDelta * (northMeters - northMean);
+    // The means moved towards the new sample, possibly away from the furthest one.
+    maxRadius = std::max(maxRadius + std::hypot(eastDelta, northDelta) / count,
+                         std::hypot(eastMeters - eastMean, northMeters - northMean));
+}
+
+void DeviationInterval::merge(const DeviationInterval &next) {
+    if (next.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = next;
+        return;
+    }
+    const double total = static_cast<double>(count + next.count);
+    const double eastDelta = next.eastMean - eastMean;
+    const double northDelta = next.northMean - northMean;
+    const double weight = static_cast<double>(count) * static_cast<double>(next.count) / total;
+    const double mergedEast = eastMean + eastDelta * next.count / total;
+    const double mergedNorth = northMean + northDelta * next.count / total;
+    eastM2 += next.eastM2 + eastDelta * eastDelta * weight;
+    northM2 += next.northM2 + northDelta * northDelta * weight;
+    crossM2 += next.crossM2 + eastDelta * northDelta * weight;
+    maxRadius = std::max(maxRadius + std::hypot(mergedEast - eastMean, mergedNorth - northMean),
+                         next.maxRadius + std::hypot(mergedEast - next.eastMean, mergedNorth - next.northMean));
+    eastMean = mergedEast;
+    northMean = mergedNorth;
+    count += next.count;
+}
+
+double DeviationInterval::eastVariance() const {
+    return count > 0 ? eastM2 / count : 0.0;
+}
+
+double DeviationInterval::northVariance() const {
+    return count > 0 ? northM2 / count : 0.0;
+}
+
+double DeviationInterval::covariance() const {
+    return count > 0 ? crossM2 / count : 0.0;
+}
+
+void DeviationStatistics::Moments::add(double value) {
+    ++count;
+    const double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+void DeviationStatistics::Moments::remove(double value) {
+    if (count <= 1) {
+        *this = Moments{};
+        return;
+    }
+    const double previousMean = (mean * count - value) / (count - 1);
+    m2 = std::max(0.0, m2 - (value - previousMean) * (value - mean));
+    mean = previousMean;
+    --count;
+}
+
+double DeviationStatistics::Moments::variance() const {
+    return count > 0 ? m2 / count : 0.0;
+}
+
+void DeviationStatistics::Range::add(double value) {
+    min = empty ? value : std::min(min, value);
+    max = empty ? value : std::max(max, value);
+    empty = false;
+}
+
+void DeviationStatistics::clear() {
+    m_samples.clear();
+    m_evicted = 0;
+    m_committedLatitude = {};
+    m_committedLongitude = {};
+    m_latitude = {};
+    m_longitude = {};
+    m_distanceMoments = {};
+    m_distances.clear();
+    for (Quantile &quantile : m_quantiles) {
+        quantile.index = -1;
+    }
+    m_intervals.clear();
+    m_intervalSamples = kInitialIntervalSamples;
+    m_densityGrid.clear();
+    m_estimateTotal = -1;
+}
+
+void DeviationStatistics::append(double latitude, double longitude) {
+    if (m_samples.isEmpty()) {
+        m_referenceLatitude = latitude;
+        m_referenceLongitude = longitude;
+        m_referenceEastScale = eastScale(latitude);
+    } else {
+        m_committedLatitude.add(m_samples.last().latitude);
+        m_committedLongitude.add(m_samples.last().longitude);
+    }
+    m_samples.append({latitude, longitude});
+    m_latitude.add(latitude);
+    m_longitude.add(longitude);
+    const DeviationPoint added = local(latitude, longitude);
+    m_densityGrid.add(added.eastMeters, added.northMeters);
+    settleNewestSample();
+}
+
+bool DeviationStatistics::replaceLast(double latitude, double longitude) {
+    if (m_samples.isEmpty()) {
+        return false;
+    }
+    RawSample &last = m_samples.last();
+    eraseDistance(distanceKey(m_samples.size() - 1));
+    const DeviationPoint replaced = local(last.latitude, last.longitude);
+    m_densityGrid.remove(replaced.eastMeters, replaced.northMeters);
+    m_latitude.remove(last.latitude);
+    m_longitude.remove(last.longitude);
+    last = {latitude, longitude};
+    m_latitude.add(latitude);
+    m_longitude.add(longitude);
+    const DeviationPoint added = local(latitude, longitude);
+    m_densityGrid.add(added.eastMeters, added.northMeters);
+    settleNewestSample();
+    return true;
+}
+
+void DeviationStatistics::evictOldest(qsizetype count) {
+    count = std::min(count, m_samples.size() - 1);
+    if (count <= 0) {
+        return;
+    }
+    for (qsizetype index = 0; index < count; ++index) {
+        eraseDistance(distanceKey(index));
+        foldIntoIntervals(m_evicted + index, localPoint(index));
+    }
+    m_samples.remove(0, count);
+    m_evicted += count;
+    m_estimateTotal = -1;
+}
+
+void DeviationStatistics::setFixedCenter(bool enabled, double latitude, double longitude) {
+    m_fixedCenter = enabled;
+    m_fixedLatitude = latitude;
+    m_fixedLongitude = longitude;
+    m_estimateTotal = -1;
+    reproject();
+}
+
+bool DeviationStatistics::fixedCenter() const {
+    return m_fixedCenter;
+}
+
+void DeviationStatistics::setDensityBinsPerLevel(qsizetype bins) {
+    m_densityGrid.setMaxBinsPerLevel(bins);
+}
+
+qsizetype DeviationStatistics::size() const {
+    return m_samples.size();
+}
+
+qint64 DeviationStatistics::totalCount() const {
+    return m_evicted + m_samples.size();
+}
+
+qint64 DeviationStatistics::evictedCount() const {
+    return m_evicted;
+}
+
+double DeviationStatistics::sampleLatitude(qsizetype index) const {
+    return index >= 0 && index < m_samples.size() ? m_samples.at(index).latitude : 0.0;
+}
+
+double DeviationStatistics::sampleLongitude(qsizetype index) const {
+    return index >= 0 && index < m_samples.size() ? m_samples.at(index).longitude : 0.0;
+}
+
+DeviationPoint DeviationStatistics::point(qsizetype index) const {
+    return index >= 0 && index < m_samples.size() ? project(m_samples.at(index)) : DeviationPoint{};
+}
+
+DeviationPoint DeviationStatistics::localPoint(qsizetype index) const {
+    if (index < 0 || index >= m_samples.size()) {
+        return {};
+    }
+    const RawSample &sample = m_samples.at(index);
+    return local(sample.latitude, sample.longitude);
+}
+
+DeviationPoint DeviationStatistics::centerOffset() const {
+    return m_samples.isEmpty() ? DeviationPoint{} : local(centerLatitude(), centerLongitude());
+}
+
+double DeviationStatistics::centerLatitude() const {
+    if (m_fixedCenter) {
+        return m_fixedLatitude;
+    }
+    return m_latitude.count > 0 ? m_latitude.mean : 0.0;
+}
+
+double DeviationStatistics::centerLongitude() const {
+    if (m_fixedCenter) {
+        return m_fixedLongitude;
+    }
+    return m_longitude.count > 0 ? m_longitude.mean : 0.0;
+}
+
+DeviationSummary DeviationStatistics::north() const {
+    if (m_samples.isEmpty()) {
+        return {};
+    }
+    return axisSummary(m_latitude, m_committedLatitude, m_samples.last().latitude, centerLatitude(),
+                       kMetersPerDegree);
+}
+
+DeviationSummary DeviationStatistics::east() const {
+    if (m_samples.isEmpty()) {
+        return {};
+    }
+    return axisSummary(m_longitude, m_committedLongitude, m_samples.last().longitude, centerLongitude(),
+                       eastScale(centerLatitude()));
+}
+
+DeviationDistanceSummary DeviationStatistics::horizontal() const {
+    if (m_evicted == 0) {
+        return retainedHorizontal();
+    }
+    const DeviationPoint center = centerOffset();
+    if (m_estimateTotal < 0 || totalCount() - m_estimateTotal >= kEstimateRefreshSamples
+        || std::hypot(center.eastMeters - m_estimateCenter.eastMeters,
+                      center.northMeters - m_estimateCenter.northMeters) > driftToleranceMeters()) {
+        m_estimate = estimateFromGrid();
+        m_estimateTotal = totalCount();
+        m_estimateCenter = center;
+    }
+    return m_estimate;
+}
+
+DeviationDistanceSummary DeviationStatistics::retainedHorizontal() const {
+    DeviationDistanceSummary summary;
+    if (m_distances.empty()) {
+        return summary;
+    }
+    summary.min = m_distances.begin()->first;
+    summary.max = m_distances.rbegin()->first;
+    summary.avg = m_distanceMoments.mean;
+    summary.stdDev = std::sqrt(m_distanceMoments.variance());
+    summary.cep50 = quantileValue(m_quantiles[0]);
+    summary.cep68 = quantileValue(m_quantiles[1]);
+    summary.cep95 = quantileValue(m_quantiles[2]);
+    return summary;
+}
+
+const QList<DeviationInterval> &DeviationStatistics::intervals() const {
+    return m_intervals;
+}
+
+const DeviationDensityGrid &DeviationStatistics::densityGrid() const {
+    return m_densityGrid;
+}
+
+qint64 DeviationStatistics::retainedSampleBytes() {
+    return kSampleSlotsPerSample * qint64(sizeof(RawSample)) + kDistanceNodeBytes;
+}
+
+qint64 DeviationStatistics::maxIntervalBytes() {
+    // Up to kMaxIntervals + 1 before a merge, in a list grown by doubling.
+    return 2 * (kMaxIntervals + 1) * qint64(sizeof(DeviationInterval));
+}
+
+qint64 DeviationStatistics::memoryBytes() const {
+    return m_samples.capacity() * qint64(sizeof(RawSample))
+        + qint64(m_distances.size()) * kDistanceNodeBytes
+        + m_intervals.capacity() * qint64(sizeof(DeviationInterval))
+        + m_densityGrid.memoryBytes();
+}
+
+DeviationPoint DeviationStatistics::project(const RawSample &sample) const {
+    DeviationPoint point;
+    point.northMeters = (sample.latitude - m_projectionLatitude) * kMetersPerDegree;
+    point.eastMeters = (sample.longitude - m_projectionLongitude) * m_projectionEastScale;
+    point.distanceMeters = std::hypot(point.eastMeters, point.northMeters);
+    return point;
+}
+
+DeviationPoint DeviationStatistics::local(double latitude, double longitude) const {
+    DeviationPoint point;
+    point.northMeters = (latitude - m_referenceLatitude) * kMetersPerDegree;
+    point.eastMeters = (longitude - m_referenceLongitude) * m_referenceEastScale;
+    point.distanceMeters = std::hypot(point.eastMeters, point.northMeters);
+    return point;
+}
+
+DeviationStatistics::DistanceKey DeviationStatistics::distanceKey(qsizetype index) const {
+    return {project(m_samples.at(index)).distanceMeters, m_evicted + index};
+}
+
+void DeviationStatistics::insertDistance(const DistanceKey &key) {
+    const DistanceSet::const_iterator inserted = m_distances.insert(key).first;
+    m_distanceMoments.add(key.first);
+    for (Quantile &quantile : m_quantiles) {
+        if (quantile.index < 0) {
+            quantile.at = inserted;
+            quantile.index = 0;
+        } else if (key < *quantile.at) {
+            ++quantile.index;
+        }
+        moveToRank(quantile);
+    }
+}
+
+void DeviationStatistics::eraseDistance(const DistanceKey &key) {
+    const DistanceSet::const_iterator erased = m_distances.find(key);
+    if (erased == m_distances.cend()) {
+        return;
+    }
+    m_distanceMoments.remove(key.first);
+    for (Quantile &quantile : m_quantiles) {
+        if (key < *quantile.at) {
+            --quantile.index;
+        } else if (quantile.at == erased) {
+            // The next distance takes over this rank; without one, step back.
+            if (std::next(quantile.at) != m_distances.cend()) {
+                ++quantile.at;
+            } else if (quantile.at != m_distances.cbegin()) {
+                --quantile.at;
+                --quantile.index;
+            } else {
+                quantile.index = -1;
+            }
+        }
+    }
+    m_distances.erase(erased);
+    for (Quantile &quantile : m_quantiles) {
+        moveToRank(quantile);
+    }
+}
+
+void DeviationStatistics::moveToRank(Quantile &quantile) const {
+    if (quantile.index < 0) {
+        return;
+    }
+    const qsizetype rank = static_cast<qsizetype>(
+        std::floor(rankPosition(quantile.ratio, static_cast<qsizetype>(m_distances.size()))));
+    while (quantile.index < rank) {
+        ++quantile.at;
+        ++quantile.index;
+    }
+    while (quantile.index > rank) {
+        --quantile.at;
+        --quantile.index;
+    }
+}
+
+double DeviationStatistics::quantileValue(const Quantile &quantile) const {
+    const double lower = quantile.at->first;
+    const double weight = rankPosition(quantile.ratio, static_cast<qsizetype>(m_distances.size()))
+        - static_cast<double>(quantile.index);
+    if (weight <= 0.0) {
+        return lower;
+    }
+    return lower * (1.0 - weight) + std::next(quantile.at)->first * weight;
+}
+
+double DeviationStatistics::centerDriftMeters() const {
+    return std::hypot((centerLatitude() - m_projectionLatitude) * kMetersPerDegree,
+                      (centerLongitude() - m_projectionLongitude) * m_projectionEastScale);
+}
+
+double DeviationStatistics::driftToleranceMeters() const {
+    const double drms = std::sqrt(m_latitude.variance() * kMetersPerDegree * kMetersPerDegree
+                                  + m_longitude.variance() * m_projectionEastScale * m_projectionEastScale);
+    return std::max(kMinCenterDriftMeters, kCenterDriftRatio * drms);
+}
+
+void DeviationStatistics::settleNewestSample() {
+    if (!m_fixedCenter && (totalCount() == 1 || centerDriftMeters() > driftToleranceMeters())) {
+        reproject();
+        return;
+    }
+    insertDistance(distanceKey(m_samples.size() - 1));
+}
+
+void DeviationStatistics::reproject() {
+    m_projectionLatitude = centerLatitude();
+    m_projectionLongitude = centerLongitude();
+    m_projectionEastScale = eastScale(m_projectionLatitude);
+
+    std::vector<DistanceKey> keys;
+    keys.reserve(m_samples.size());
+    m_distanceMoments = {};
+    for (qsizetype index = 0; index < m_samples.size(); ++index) {
+        keys.push_back(distanceKey(index));
+        m_distanceMoments.add(keys.back().first);
+    }
+    std::sort(keys.begin(), keys.end());
+    m_distances.clear();
+    for (const DistanceKey &key : keys) {
+        m_distances.insert(m_distances.cend(), key);
+    }
+    for (Quantile &quantile : m_quantiles) {
+        if (m_distances.empty()) {
+            quantile.index = -1;
+            continue;
+        }
+        quantile.at = m_distances.cbegin();
+        quantile.index = 0;
+        moveToRank(quantile);
+    }
+}
+
+void DeviationStatistics::foldIntoIntervals(qint64 sequence, const DeviationPoint &point) {
+    if (m_intervals.isEmpty() || m_intervals.last().count >= m_intervalSamples) {
+        DeviationInterval interval;
+        interval.firstSequence = sequence;
+        m_intervals.append(interval);
+    }
+    m_intervals.last().add(point.eastMeters, point.northMeters);
+    if (m_intervals.size() <= kMaxIntervals) {
+        return;
+    }
+    // Halve the resolution of the whole history; an odd last interval is
+    // still filling and stays as it is.
+    QList<DeviationInterval> merged;
+    merged.reserve(m_intervals.size() / 2 + 1);
+    for (qsizetype index = 0; index < m_intervals.size(); index += 2) {
+        DeviationInterval interval = m_intervals.at(index);
+        if (index + 1 < m_intervals.size()) {
+            interval.merge(m_intervals.at(index + 1));
+        }
+        merged.append(interval);
+    }
+    m_intervals = std::move(merged);
+    m_intervalSamples *= 2;
+}
+
+DeviationDistanceSummary DeviationStatistics::estimateFromGrid() const {
+    DeviationDistanceSummary summary;
+    const qint64 total = m_densityGrid.sampleCount();
+    if (total <= 0) {
+        return summary;
+    }
+    int level = DeviationDensityGrid::kLevels - 1;
+    for (int candidate = 0; candidate < DeviationDensityGrid::kLevels; ++candidate) {
+        if (m_densityGrid.hasLevel(candidate) && m_densityGrid.bins(candidate).size() <= kEstimatorBins) {
+            level = candidate;
+            break;
+        }
+    }
+
+    // Every sample is taken to sit at its bin's center.
+    const double binMeters = DeviationDensityGrid::binMeters(level);
+    const DeviationPoint center = centerOffset();
+    const QHash<quint64, quint32> &bins = m_densityGrid.bins(level);
+    std::vector<std::pair<double, quint32>> distances;
+    distances.reserve(static_cast<size_t>(bins.size()));
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (auto it = bins.cbegin(); it != bins.cend(); ++it) {
+        const double distance = std::hypot((DeviationDensityGrid::binX(it.key()) + 0.5) * binMeters - center.eastMeters,
+                                           (DeviationDensityGrid::binY(it.key()) + 0.5) * binMeters - center.northMeters);
+        distances.emplace_back(distance, it.value());
+        sum += distance * it.value();
+        sumSquares += distance * distance * it.value();
+    }
+    if (distances.empty()) {
+        return summary;
+    }
+    std::sort(distances.begin(), distances.end());
+    std::vector<qint64> cumulative;
+    cumulative.reserve(distances.size());
+    qint64 running = 0;
+    for (const auto &[distance, count] : distances) {
+        running += count;
+        cumulative.push_back(running);
+    }
+    const auto distanceAtRank = [&](qint64 rank) {
+        const auto bin = std::upper_bound(cumulative.cbegin(), cumulative.cend(), rank);
+        return distances.at(static_cast<size_t>(std::min<std::ptrdiff_t>(bin - cumulative.cbegin(),
+                                                                         std::ptrdiff_t(distances.size()) - 1)))
+            .first;
+    };
+    const auto quantile = [&](double ratio) {
+        const double position = rankPosition(ratio, static_cast<qsizetype>(running));
+        const qint64 lower = static_cast<qint64>(std::floor(position));
+        const double weight = position - static_cast<double>(lower);
+        const double value = distanceAtRank(lower);
+        return weight > 0.0 ? value * (1.0 - weight) + distanceAtRank(lower + 1) * weight : value;
+    };
+
+    summary.min = distances.front().first;
+    summary.max = distances.back().first;
+    summary.avg = sum / running;
+    summary.stdDev = std::sqrt(std::max(0.0, sumSquares / running - summary.avg * summary.avg));
+    summary.cep50 = quantile(m_quantiles[0].ratio);
+    summary.cep68 = quantile(m_quantiles[1].ratio);
+    summary.cep95 = quantile(m_quantiles[2].ratio);
+    // Half a bin diagonal.
+    summary.resolution = binMeters * std::sqrt(0.5);
+    return summary;
+}
+
+DeviationSummary DeviationStatistics::axisSummary(const Moments &moments, const Range &committed, double last,
+                                                  double center, double metersPerDegree) const {
+    Range range = committed;
+    range.add(last);
+    DeviationSummary summary;
+    summary.min = (range.min - center) * metersPerDegree;
+    summary.max = (range.max - center) * metersPerDegree;
+    summary.avg = (moments.mean - center) * metersPerDegree;
+    summary.stdDev = std::sqrt(moments.variance()) * metersPerDegree;
+    return summary;
+}
+
+}  // namespace hdgnss
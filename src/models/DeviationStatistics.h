@@ -0,0 +1,218 @@
+#pragma once
+
+#include <QList>
+
+#include <array>
+#include <set>
+#include <utility>
+
+#include "src/models/DeviationDensityGrid.h"
+
+namespace hdgnss {
+
+struct DeviationPoint {
+    double eastMeters = 0.0;
+    double northMeters = 0.0;
+    double distanceMeters = 0.0;
+};
+
+struct DeviationSummary {
+    double min = 0.0;
+    double max = 0.0;
+    double avg = 0.0;
+    double stdDev = 0.0;
+};
+
+struct DeviationDistanceSummary : DeviationSummary {
+    double cep50 = 0.0;
+    double cep68 = 0.0;
+    double cep95 = 0.0;
+    // 0 when the figures come from the distances themselves; otherwise they
+    // are estimates within this many meters.
+    double resolution = 0.0;
+};
+
+// Evicted samples summarized in the local frame of DeviationStatistics.
+struct DeviationInterval {
+    // Position of the interval's first sample in the run, from 0.
+    qint64 firstSequence = 0;
+    qint64 count = 0;
+    double eastMean = 0.0;
+    double northMean = 0.0;
+    // Sums of squared and crossed deviations from the means.
+    double eastM2 = 0.0;
+    double northM2 = 0.0;
+    double crossM2 = 0.0;
+    // No sample lies further than this from the means.
+    double maxRadius = 0.0;
+
+    void add(double eastMeters, double northMeters);
+    // Folds in the interval that follows this one.
+    void merge(const DeviationInterval &next);
+    double eastVariance() const;
+    double northVariance() const;
+    double covariance() const;
+};
+
+// Position samples and their deviation statistics, kept current one sample at
+// a time. Latitude and longitude run through Welford accumulators and running
+// extremes, so the per-axis figures are exact for whichever center is in use.
+// Horizontal distances sit in an ordered set with an iterator parked on each
+// CEP rank, so appending or replacing a sample costs O(log n) and CEPs stay
+// exact order statistics.
+//
+// Distances and points are measured from the projection center. With a fixed
+// center that is the center itself. With the average center it is the average
+// as of the last re-projection, which happens only when the running average
+// has drifted further than max(kMinCenterDriftMeters, kCenterDriftRatio *
+// DRMS) from it, so horizontal figures are within that distance of the exact
+// ones while re-projection stays rare once the average settles.
+//
+// For drawing, localPoint() places every sample in a fixed east/north frame
+// around the first sample, so a sample's local point never changes once it
+// is in and centerOffset() alone follows the moving center.
+//
+// evictOldest() bounds the memory of long runs. Evicted samples leave the
+// ordered set and survive as intervals() of mean, covariance and extent,
+// whose length doubles as needed to stay within kMaxIntervals, and in
+// densityGrid(). The axis figures still cover the whole run exactly; the
+// lifetime horizontal figures are then estimated from the density grid.
+class DeviationStatistics {
+public:
+    static constexpr double kMinCenterDriftMeters = 0.001;
+    static constexpr double kCenterDriftRatio = 0.005;
+    static constexpr qint64 kInitialIntervalSamples = 64;
+    static constexpr qsizetype kMaxIntervals = 4096;
+    // Lifetime estimates use the finest grid level with at most this many
+    // bins, and are refreshed after kEstimateRefreshSamples samples or once
+    // the center drifts as far as a re-projection would need.
+    static constexpr qsizetype kEstimatorBins = 16384;
+    static constexpr qint64 kEstimateRefreshSamples = 256;
+
+    // Heap cost of one retained sample, for sizing the window: its slot in
+    // the sample list and its node in the distance set.
+    static qint64 retainedSampleBytes();
+    // Most heap intervals() can hold, which kMaxIntervals bounds.
+    static qint64 maxIntervalBytes();
+
+    void clear();
+    void append(double latitude, double longitude);
+    // False when there is no sample to replace.
+    bool replaceLast(double latitude, double longitude);
+    // Evicts up to count of the oldest samples, always keeping the newest,
+    // which replaceLast() may still change.
+    void evictOldest(qsizetype count);
+    void setFixedCenter(bool enabled, double latitude, double longitude);
+    bool fixedCenter() const;
+    void setDensityBinsPerLevel(qsizetype bins);
+
+    // Retained samples, indexed from the oldest.
+    qsizetype size() const;
+    // Every sample since clear(), evicted or not.
+    qint64 totalCount() const;
+    qint64 evictedCount() const;
+    double sampleLatitude(qsizetype index) const;
+    double sampleLongitude(qsizetype index) const;
+    DeviationPoint point(qsizetype index) const;
+    // Relative to the first sample since clear(), which is the frame origin.
+    DeviationPoint localPoint(qsizetype index) const;
+    // centerLatitude() and centerLongitude() in the localPoint() frame.
+    DeviationPoint centerOffset() const;
+    // The fixed center, or the exact average of all samples.
+    double centerLatitude() const;
+    double centerLongitude() const;
+    // Exact, relative to centerLatitude() and centerLongitude().
+    DeviationSummary north() const;
+    DeviationSummary east() const;
+    // Every sample, relative to the projection center while none was
+    // evicted and to the exact center after.
+    DeviationDistanceSummary horizontal() const;
+    // Retained samples, relative to the projection center.
+    DeviationDistanceSummary retainedHorizontal() const;
+    const QList<DeviationInterval> &intervals() const;
+    const DeviationDensityGrid &densityGrid() const;
+    // Estimated heap held now by samples, distances, intervals and the grid.
+    qint64 memoryBytes() const;
+
+private:
+    struct RawSample {
+        double latitude = 0.0;
+        double longitude = 0.0;
+    };
+
+    struct Moments {
+        qsizetype count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double value);
+        void remove(double value);
+        double variance() const;
+    };
+
+    struct Range {
+        double min = 0.0;
+        double max = 0.0;
+        bool empty = true;
+
+        void add(double value);
+    };
+
+    // Distance and sample sequence, so equal distances still order strictly.
+    using DistanceKey = std::pair<double, qint64>;
+    using DistanceSet = std::set<DistanceKey>;
+
+    struct Quantile {
+        double ratio = 0.0;
+        DistanceSet::const_iterator at;
+        // Rank of `at`, or -1 while the set is empty.
+        qsizetype index = -1;
+    };
+
+    DeviationPoint project(const RawSample &sample) const;
+    DeviationPoint local(double latitude, double longitude) const;
+    DistanceKey distanceKey(qsizetype index) const;
+    void insertDistance(const DistanceKey &key);
+    void eraseDistance(const DistanceKey &key);
+    void moveToRank(Quantile &quantile) const;
+    double quantileValue(const Quantile &quantile) const;
+    double centerDriftMeters() const;
+    double driftToleranceMeters() const;
+    // Re-projects if the center moved too far, otherwise files the newest
+    // sample's distance.
+    void settleNewestSample();
+    void reproject();
+    void foldIntoIntervals(qint64 sequence, const DeviationPoint &point);
+    DeviationDistanceSummary estimateFromGrid() const;
+    DeviationSummary axisSummary(const Moments &moments, const Range &committed, double last,
+                                 double center, double metersPerDegree) const;
+
+    QList<RawSample> m_samples;
+    qint64 m_evicted = 0;
+    // Extremes of every sample but the newest, which replaceLast() may change.
+    Range m_committedLatitude;
+    Range m_committedLongitude;
+    Moments m_latitude;
+    Moments m_longitude;
+    Moments m_distanceMoments;
+    DistanceSet m_distances;
+    std::array<Quantile, 3> m_quantiles{{{0.50}, {0.68}, {0.95}}};
+    QList<DeviationInterval> m_intervals;
+    qint64 m_intervalSamples = kInitialIntervalSamples;
+    DeviationDensityGrid m_densityGrid;
+    mutable DeviationDistanceSummary m_estimate;
+    // totalCount() when m_estimate was made, or -1 when it is out of date.
+    mutable qint64 m_estimateTotal = -1;
+    mutable DeviationPoint m_estimateCenter;
+    bool m_fixedCenter = false;
+    double m_fixedLatitude = 0.0;
+    double m_fixedLongitude = 0.0;
+    double m_projectionLatitude = 0.0;
+    double m_projectionLongitude = 0.0;
+    double m_projectionEastScale = 0.0;
+    double m_referenceLatitude = 0.0;
+    double m_referenceLongitude = 0.0;
+    double m_referenceEastScale = 0.0;
+};
+
+}  // namespace hdgnss
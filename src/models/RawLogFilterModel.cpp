@@ -0,0 +1,648 @@
+#include "RawLogFilterModel.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QCoreApplication>
+#include <QString>
+#include <QThread>
+
+#include "src/utils/ByteUtils.h"
+
+namespace hdgnss {
+
+namespace {
+
+constexpr int kDimensionRoles[RawLogFilterModel::DimensionCount] = {
+    RawLogModel::DirectionRole,
+    RawLogModel::KindRole,
+    RawLogModel::TransportRole,
+    RawLogModel::MessageRole,
+};
+
+QStringList sortedValues(const QHash<QString, QList<qint64>> &postings) {
+    QStringList values = postings.keys();
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// First id of one posting list from firstRowId on; older ones were evicted.
+QList<qint64>::const_iterator liveBegin(const QList<qint64> &ids, qint64 firstRowId) {
+    return std::lower_bound(ids.cbegin(), ids.cend(), firstRowId);
+}
+
+// First id in [first, last) not below id, found in steps that double from
+// first, so probing rising ids costs the log of each skip, not of the list.
+const qint64 *gallop(const qint64 *first, const qint64 *last, qint64 id) {
+    qsizetype step = 1;
+    while (step < last - first && first[step] < id) {
+        first += step;
+        step *= 2;
+    }
+    return std::lower_bound(first, first + std::min(step, last - first), id);
+}
+
+}  // namespace
+
+RawLogFilterModel::RawLogFilterModel(RawLogModel *source, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_source(source) {
+    connect(m_source, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex &, int first, int last) {
+        onSourceRowsInserted(first, last);
+    });
+    connect(m_source, &QAbstractItemModel::rowsAboutToBeRemoved, this, [this](const QModelIndex &, int first, int last) {
+        onSourceRowsAboutToBeRemoved(first, last);
+    });
+    connect(m_source, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex &, int first, int last) {
+        onSourceRowsRemoved(first, last);
+    });
+    connect(m_source, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+        // The workers may be reading archive files the reset deletes.
+        stopSearch();
+        stopIndexing();
+        beginResetModel();
+    });
+    connect(m_source, &QAbstractItemModel::modelReset, this, [this]() {
+        rebuild();
+        endResetModel();
+        emit countChanged();
+    });
+    rebuild();
+}
+
+RawLogFilterModel::~RawLogFilterModel() {
+    stopSearch();
+    stopIndexing();
+}
+
+int RawLogFilterModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return isActive() ? static_cast<int>(m_rows.size()) : m_passThroughRows;
+}
+
+QVariant RawLogFilterModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid()) {
+        return {};
+    }
+    const int row = sourceRow(index.row());
+    return row < 0 ? QVariant() : m_source->data(m_source->index(row), role);
+}
+
+QHash<int, QByteArray> RawLogFilterModel::roleNames() const {
+    return m_source->roleNames();
+}
+
+QVariantMap RawLogFilterModel::get(int row) const {
+    const int source = sourceRow(row);
+    return source < 0 ? QVariantMap() : m_source->get(source);
+}
+
+int RawLogFilterModel::sourceRow(int row) const {
+    if (row < 0 || row >= rowCount()) {
+        return -1;
+    }
+    return isActive() ? static_cast<int>(m_rows.at(row) - m_firstRowId) : row;
+}
+
+void RawLogFilterModel::setDirectionFilter(const QStringList &directions) {
+    setFilter(DirectionDimension, directions);
+}
+
+void RawLogFilterModel::setKindFilter(const QStringList &kinds) {
+    setFilter(KindDimension, kinds);
+}
+
+void RawLogFilterModel::setTransportFilter(const QStringList &transports) {
+    setFilter(TransportDimension, transports);
+}
+
+void RawLogFilterModel::setMessageFilter(const QStringList &messages) {
+    setFilter(MessageDimension, messages);
+}
+
+void RawLogFilterModel::setFilter(Dimension dimension, const QStringList &values) {
+    QSet<QString> selected(values.cbegin(), values.cend());
+    selected.remove(QString());
+    if (selected == m_selected[dimension]) {
+        return;
+    }
+    m_selected[dimension] = selected;
+    refilter();
+}
+
+QStringList RawLogFilterModel::filter(Dimension dimension) const {
+    QStringList values(m_selected[dimension].cbegin(), m_selected[dimension].cend());
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+void RawLogFilterModel::setSearch(const QString &text, bool hex) {
+    if (text == m_searchText && hex == m_searchHex) {
+        return;
+    }
+    m_searchText = text;
+    m_searchHex = hex;
+    // Text that is not valid hex searches for nothing rather than everything.
+    m_searchPattern = hex ? ByteUtils::fromHexString(text) : text.toLatin1();
+    refilter();
+}
+
+void RawLogFilterModel::cancelSearch() {
+    stopSearch();
+}
+
+void RawLogFilterModel::clearFilters() {
+    if (!isActive()) {
+        return;
+    }
+    for (QSet<QString> &selected : m_selected) {
+        selected.clear();
+    }
+    m_searchText.clear();
+    m_searchPattern.clear();
+    refilter();
+}
+
+bool RawLogFilterModel::isActive() const {
+    return facetsActive() || searchActive();
+}
+
+QStringList RawLogFilterModel::kinds() const {
+    return sortedValues(m_postings[KindDimension]);
+}
+
+QStringList RawLogFilterModel::transports() const {
+    return sortedValues(m_postings[TransportDimension]);
+}
+
+QStringList RawLogFilterModel::messages() const {
+    return sortedValues(m_postings[MessageDimension]);
+}
+
+bool RawLogFilterModel::searching() const {
+    return m_searching;
+}
+
+double RawLogFilterModel::searchProgress() const {
+    return m_searchProgress;
+}
+
+void RawLogFilterModel::waitForSearch() {
+    if (!m_searchThread) {
+        return;
+    }
+    m_searchThread->wait();
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+}
+
+bool RawLogFilterModel::indexing() const {
+    return m_indexThread != nullptr;
+}
+
+void RawLogFilterModel::waitForIndexing() {
+    if (!m_indexThread) {
+        return;
+    }
+    m_indexThread->wait();
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+}
+
+bool RawLogFilterModel::previewMatches(const QByteArray &preview, const QByteArray &pattern, bool hex) {
+    if (hex) {
+        return !pattern.isEmpty() && preview.contains(pattern);
+    }
+    return QLatin1StringView(preview).contains(QLatin1StringView(pattern), Qt::CaseInsensitive);
+}
+
+bool RawLogFilterModel::facetsActive() const {
+    return std::any_of(m_selected.cbegin(), m_selected.cend(), [](const QSet<QString> &selected) {
+        return !selected.isEmpty();
+    });
+}
+
+bool RawLogFilterModel::searchActive() const {
+    return !m_searchText.isEmpty();
+}
+
+bool RawLogFilterModel::facetMatches(const std::array<QString, DimensionCount> &values) const {
+    for (int dimension = 0; dimension < DimensionCount; ++dimension) {
+        const QSet<QString> &selected = m_selected[dimension];
+        if (!selected.isEmpty() && !selected.contains(values[dimension])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QList<qint64> RawLogFilterModel::facetRows() const {
+    // Walk the ids of the smallest selection and probe the other dimensions
+    // for each, so the cost is bounded by the rarest selection. Every list
+    // is read in place, and the probes only ever move forward.
+    std::array<QList<PostingRange>, DimensionCount> selected;
+    std::array<qsizetype, DimensionCount> sizes{};
+    int smallest = -1;
+    for (int dimension = 0; dimension < DimensionCount; ++dimension) {
+        if (m_selected[dimension].isEmpty()) {
+            continue;
+        }
+        selected[dimension] = selectedPostings(static_cast<Dimension>(dimension));
+        for (const PostingRange &range : std::as_const(selected[dimension])) {
+            sizes[dimension] += range.end - range.begin;
+        }
+        if (smallest < 0 || sizes[dimension] < sizes[smallest]) {
+            smallest = dimension;
+        }
+    }
+    if (smallest < 0 || sizes[smallest] == 0) {
+        return {};
+    }
+
+    QList<qint64> rows;
+    rows.reserve(sizes[smallest]);
+    QList<PostingRange> &walk = selected[smallest];
+    for (;;) {
+        // A row has one value per dimension, so the lists are disjoint and
+        // the next id of their union is the lowest head.
+        PostingRange *head = nullptr;
+        for (PostingRange &range : walk) {
+            if (range.begin != range.end && (!head || *range.begin < *head->begin)) {
+                head = &range;
+            }
+        }
+        if (!head) {
+            break;
+        }
+        const qint64 id = *head->begin++;
+        bool matches = true;
+        for (int dimension = 0; dimension < DimensionCount && matches; ++dimension) {
+            if (dimension == smallest || m_selected[dimension].isEmpty()) {
+                continue;
+            }
+            matches = false;
+            for (PostingRange &range : selected[dimension]) {
+                range.begin = gallop(range.begin, range.end, id);
+                if (range.begin != range.end && *range.begin == id) {
+                    matches = true;
+                    break;
+                }
+            }
+        }
+        if (matches) {
+            rows.append(id);
+        }
+    }
+    return rows;
+}
+
+QList<RawLogFilterModel::PostingRange> RawLogFilterModel::selectedPostings(Dimension dimension) const {
+    QList<PostingRange> ranges;
+    for (const QString &value : m_selected[dimension]) {
+        const auto it = m_postings[dimension].constFind(value);
+        if (it == m_postings[dimension].cend()) {
+            continue;
+        }
+        const Postings &ids = it.value();
+        const auto begin = liveBegin(ids, m_firstRowId);
+        if (begin != ids.cend()) {
+            ranges.append(PostingRange{&*begin, ids.constData() + ids.size()});
+        }
+    }
+    return ranges;
+}
+
+void RawLogFilterModel::rebuild() {
+    stopIndexing();
+    // Selected values stay listed for the pickers even with no rows left.
+    for (int dimension = 0; dimension < DimensionCount; ++dimension) {
+        m_postings[dimension].clear();
+        for (const QString &value : std::as_const(m_selected[dimension])) {
+            m_postings[dimension].insert(value, {});
+        }
+    }
+    m_firstRowId = m_source->rowId(0);
+    m_passThroughRows = m_source->rowCount();
+    // Archived rows would be paged in from disk one by one on this thread,
+    // so only the in-memory rows are indexed here.
+    const int archived = m_source->archivedRows();
+    bool newValues = false;
+    for (int row = archived; row < m_passThroughRows; ++row) {
+        indexSourceRow(row, &newValues);
+    }
+    m_rows.clear();
+    if (facetsActive() && !searchActive()) {
+        m_rows = facetRows();
+    }
+    // A search is not rerun over rebuilt rows; later rows are matched as
+    // they arrive.
+    m_searchEndId = m_firstRowId + m_passThroughRows;
+    if (archived > 0) {
+        startIndexing();
+    }
+    emit valuesChanged();
+}
+
+void RawLogFilterModel::refilter() {
+    stopSearch();
+    beginResetModel();
+    m_rows.clear();
+    if (facetsActive() && !searchActive()) {
+        m_rows = facetRows();
+    }
+    m_passThroughRows = m_source->rowCount();
+    endResetModel();
+    if (searchActive()) {
+        startSearch();
+    }
+    emit countChanged();
+    emit filterChanged();
+}
+
+void RawLogFilterModel::startSearch() {
+    RawLogModel::PreviewSnapshot snapshot = m_source->previewSnapshot();
+    m_searchEndId = snapshot.firstRowId() + snapshot.rowCount();
+    m_searchReadsArchive = snapshot.archivedRows() > 0;
+    const bool allRows = !facetsActive();
+    QList<qint64> candidates = allRows ? QList<qint64>() : facetRows();
+
+    m_cancelSearch = false;
+    const quint64 generation = ++m_searchGeneration;
+    m_searchThread.reset(QThread::create([this, snapshot = std::move(snapshot), candidates = std::move(candidates),
+                                          allRows, pattern = m_searchPattern, hex = m_searchHex, generation]() {
+        runSearch(snapshot, candidates, allRows, pattern, hex, generation);
+    }));
+    m_searchThread->setObjectName(QStringLiteral("RawLogSearch"));
+    m_searchThread->start(QThread::LowPriority);
+
+    m_searching = true;
+    m_searchProgress = 0.0;
+    emit searchingChanged();
+    emit searchProgressChanged();
+}
+
+void RawLogFilterModel::stopSearch() {
+    if (!m_searchThread) {
+        return;
+    }
+    m_cancelSearch = true;
+    m_searchThread->wait();
+    m_searchThread.reset();
+    // Batches still queued from the stopped worker are ignored.
+    ++m_searchGeneration;
+    if (m_searching) {
+        m_searching = false;
+        emit searchingChanged();
+    }
+}
+
+void RawLogFilterModel::runSearch(const RawLogModel::PreviewSnapshot &snapshot,
+                                  const QList<qint64> &candidates,
+                                  bool allRows,
+                                  const QByteArray &pattern,
+                                  bool hex,
+                                  quint64 generation) {
+    const qint64 total = allRows ? snapshot.rowCount() : candidates.size();
+    const auto post = [this, generation](const QList<qint64> &matches, double progress, bool finished) {
+        QMetaObject::invokeMethod(this, [this, generation, matches, progress, finished]() {
+            applySearchBatch(generation, matches, progress, finished);
+        }, Qt::QueuedConnection);
+    };
+
+    QList<qint64> matches;
+    for (qint64 index = 0; index < total; ++index) {
+        if (m_cancelSearch.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const qint64 id = allRows ? snapshot.firstRowId() + index : candidates.at(index);
+        if (previewMatches(snapshot.preview(id), pattern, hex)) {
+            matches.append(id);
+        }
+        if ((index + 1) % kSearchBatchRows == 0) {
+            post(matches, static_cast<double>(index + 1) / total, false);
+            matches.clear();
+        }
+    }
+    post(matches, 1.0, true);
+}
+
+void RawLogFilterModel::applySearchBatch(quint64 generation,
+                                         const QList<qint64> &matches,
+                                         double progress,
+                                         bool finished) {
+    if (generation != m_searchGeneration) {
+        return;
+    }
+    // Matches evicted while the worker ran are dropped. Every batch is newer
+    // than the previous ones and older than the rows matched on arrival, so
+    // it lands as one contiguous range.
+    const auto begin = std::lower_bound(matches.cbegin(), matches.cend(), m_firstRowId);
+    const int count = static_cast<int>(matches.cend() - begin);
+    if (count > 0) {
+        const auto position = std::lower_bound(m_rows.cbegin(), m_rows.cend(), *begin) - m_rows.cbegin();
+        beginInsertRows({}, static_cast<int>(position), static_cast<int>(position) + count - 1);
+        m_rows.insert(position, count, 0);
+        std::copy(begin, matches.cend(), m_rows.begin() + position);
+        endInsertRows();
+        emit countChanged();
+    }
+    m_searchProgress = progress;
+    emit searchProgressChanged();
+    if (finished) {
+        m_searching = false;
+        emit searchingChanged();
+    }
+}
+
+void RawLogFilterModel::startIndexing() {
+    RawLogModel::PreviewSnapshot snapshot = m_source->previewSnapshot();
+    m_cancelIndex = false;
+    const quint64 generation = ++m_indexGeneration;
+    m_indexThread.reset(QThread::create([this, snapshot = std::move(snapshot), generation]() {
+        runIndexing(snapshot, generation);
+    }));
+    m_indexThread->setObjectName(QStringLiteral("RawLogIndex"));
+    m_indexThread->start(QThread::LowPriority);
+}
+
+void RawLogFilterModel::stopIndexing() {
+    if (!m_indexThread) {
+        return;
+    }
+    m_cancelIndex = true;
+    m_indexThread->wait();
+    m_indexThread.reset();
+    // A merge still queued from the stopped worker is ignored.
+    ++m_indexGeneration;
+}
+
+void RawLogFilterModel::runIndexing(const RawLogModel::PreviewSnapshot &snapshot, quint64 generation) {
+    std::array<QHash<QString, Postings>, DimensionCount> postings;
+    std::array<QString, DimensionCount> values;
+    for (qint64 row = 0; row < snapshot.archivedRows(); ++row) {
+        if (m_cancelIndex.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const qint64 id = snapshot.firstRowId() + row;
+        if (!snapshot.archivedLabels(id, &values[DirectionDimension], &values[TransportDimension],
+                                     &values[KindDimension], &values[MessageDimension])) {
+            continue;
+        }
+        for (int dimension = 0; dimension < DimensionCount; ++dimension) {
+            if (!values[dimension].isEmpty()) {
+                postings[dimension][values[dimension]].append(id);
+            }
+        }
+    }
+    QMetaObject::invokeMethod(this, [this, generation, postings = std::move(postings)]() {
+        mergeArchivedPostings(generation, postings);
+    }, Qt::QueuedConnection);
+}
+
+void RawLogFilterModel::mergeArchivedPostings(quint64 generation,
+                                              const std::array<QHash<QString, Postings>, DimensionCount> &archived) {
+    if (generation != m_indexGeneration) {
+        return;
+    }
+    m_indexThread->wait();
+    m_indexThread.reset();
+
+    // Archived ids are older than every row indexed on arrival, so each list
+    // goes in front of the one already held for its value.
+    bool newValues = false;
+    for (int dimension = 0; dimension < DimensionCount; ++dimension) {
+        for (auto it = archived[dimension].cbegin(); it != archived[dimension].cend(); ++it) {
+            const Postings &ids = it.value();
+            const auto begin = liveBegin(ids, m_firstRowId);
+            auto target = m_postings[dimension].find(it.key());
+            if (target == m_postings[dimension].end()) {
+                target = m_postings[dimension].insert(it.key(), {});
+                newValues = true;
+            }
+            if (begin != ids.cend()) {
+                Postings merged(begin, ids.cend());
+                merged.append(*target);
+                target->swap(merged);
+            }
+        }
+    }
+    if (newValues) {
+        emit valuesChanged();
+    }
+    if (facetsActive()) {
+        refilter();
+    }
+}
+
+void RawLogFilterModel::onSourceRowsInserted(int first, int last) {
+    // RawLogModel only appends, so new ids are larger than every indexed one.
+    bool newValues = false;
+    QList<qint64> matched;
+    for (int row = first; row <= last; ++row) {
+        const std::array<QString, DimensionCount> values = indexSourceRow(row, &newValues);
+        if (!isActive() || !facetMatches(values)) {
+            continue;
+        }
+        const qint64 id = m_source->rowId(row);
+        if (searchActive()
+            && (id < m_searchEndId || !previewMatches(m_source->preview(row), m_searchPattern, m_searchHex))) {
+            continue;
+        }
+        matched.append(id);
+    }
+
+    if (!isActive()) {
+        const int count = last - first + 1;
+        beginInsertRows({}, m_passThroughRows, m_passThroughRows + count - 1);
+        m_passThroughRows += count;
+        endInsertRows();
+        emit countChanged();
+    } else if (!matched.isEmpty()) {
+        const int position = static_cast<int>(m_rows.size());
+        beginInsertRows({}, position, position + static_cast<int>(matched.size()) - 1);
+        m_rows.append(matched);
+        endInsertRows();
+        emit countChanged();
+    }
+    if (newValues) {
+        emit valuesChanged();
+    }
+}
+
+void RawLogFilterModel::onSourceRowsAboutToBeRemoved(int first, int last) {
+    // Rows only leave RawLogModel from the front: evicted, or dropped from
+    // the archive when scrollback is turned off.
+    if (m_searchReadsArchive) {
+        stopSearch();
+    }
+    stopIndexing();
+    if (!isActive()) {
+        m_removingFirst = first;
+        m_removingLast = last;
+    } else {
+        const qint64 firstId = m_source->rowId(first);
+        const qint64 lastId = m_source->rowId(last);
+        m_removingFirst = static_cast<int>(std::lower_bound(m_rows.cbegin(), m_rows.cend(), firstId) - m_rows.cbegin());
+        m_removingLast = static_cast<int>(std::upper_bound(m_rows.cbegin(), m_rows.cend(), lastId) - m_rows.cbegin()) - 1;
+    }
+    if (m_removingLast < m_removingFirst) {
+        m_removingFirst = -1;
+        m_removingLast = -1;
+        return;
+    }
+    beginRemoveRows({}, m_removingFirst, m_removingLast);
+}
+
+void RawLogFilterModel::onSourceRowsRemoved(int first, int last) {
+    Q_UNUSED(first);
+    Q_UNUSED(last);
+    m_firstRowId = m_source->rowId(0);
+    if (m_removingFirst >= 0) {
+        const int count = m_removingLast - m_removingFirst + 1;
+        if (isActive()) {
+            m_rows.remove(m_removingFirst, count);
+        } else {
+            m_passThroughRows -= count;
+        }
+        m_removingFirst = -1;
+        m_removingLast = -1;
+        endRemoveRows();
+        emit countChanged();
+    }
+    trimPostings();
+}
+
+std::array<QString, RawLogFilterModel::DimensionCount> RawLogFilterModel::indexSourceRow(int row, bool *newValues) {
+    std::array<QString, DimensionCount> values;
+    const QModelIndex index = m_source->index(row);
+    const qint64 id = m_source->rowId(row);
+    for (int dimension = 0; dimension < DimensionCount; ++dimension) {
+        values[dimension] = m_source->data(index, kDimensionRoles[dimension]).toString();
+        // Rows without a value, such as chunks without a message name, only
+        // match while the dimension is unfiltered.
+        if (values[dimension].isEmpty()) {
+            continue;
+        }
+        auto it = m_postings[dimension].find(values[dimension]);
+        if (it == m_postings[dimension].end()) {
+            it = m_postings[dimension].insert(values[dimension], {});
+            *newValues = true;
+        }
+        it->append(id);
+    }
+    return values;
+}
+
+void RawLogFilterModel::trimPostings() {
+    // Values whose rows were all evicted stay listed, so a selection in the
+    // pickers never disappears under the user.
+    for (QHash<QString, Postings> &postings : m_postings) {
+        for (Postings &ids : postings) {
+            const auto live = std::lower_bound(ids.cbegin(), ids.cend(), m_firstRowId) - ids.cbegin();
+            // Removing from the front of a QList only moves its begin.
+            ids.remove(0, live);
+        }
+    }
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QStringList>
+
+#include "src/models/RawLogModel.h"
+
+class QThread;
+
+namespace hdgnss {
+
+// Filtered view of a RawLogModel for the RawData panel. Every source row is
+// added, by id, to one posting list per direction, kind, transport and message
+// name as it is inserted, and evicted rows are trimmed off the front, so
+// changing a filter only walks the posting lists of the selected values:
+// the cost follows the matching rows, not the log size. Values selected in one
+// dimension are OR-ed and dimensions are AND-ed; an empty selection matches
+// everything. With nothing selected and no search the model passes rows
+// through unchanged.
+// When the source is reset or the filter is created over a log that already
+// has scrollback on disk, only the in-memory rows are indexed on the spot;
+// the archived rows are indexed on a worker thread and their postings merged
+// in front when it finishes.
+// A substring or hex-pattern search over the payload previews runs on a
+// worker thread against a RawLogModel::PreviewSnapshot and narrows the view
+// as batches of matches arrive; rows published after the search started are
+// matched on arrival.
+class RawLogFilterModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(bool active READ isActive NOTIFY filterChanged)
+    Q_PROPERTY(QStringList kinds READ kinds NOTIFY valuesChanged)
+    Q_PROPERTY(QStringList transports READ transports NOTIFY valuesChanged)
+    Q_PROPERTY(QStringList messages READ messages NOTIFY valuesChanged)
+    Q_PROPERTY(bool searching READ searching NOTIFY searchingChanged)
+    Q_PROPERTY(double searchProgress READ searchProgress NOTIFY searchProgressChanged)
+
+public:
+    enum Dimension {
+        DirectionDimension,
+        KindDimension,
+        TransportDimension,
+        MessageDimension,
+        DimensionCount
+    };
+
+    // The worker hands over matches and progress every this many rows.
+    static constexpr int kSearchBatchRows = 4096;
+
+    explicit RawLogFilterModel(RawLogModel *source, QObject *parent = nullptr);
+    ~RawLogFilterModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE int sourceRow(int row) const;
+
+    // An empty list clears the dimension's filter.
+    Q_INVOKABLE void setDirectionFilter(const QStringList &directions);
+    Q_INVOKABLE void setKindFilter(const QStringList &kinds);
+    Q_INVOKABLE void setTransportFilter(const QStringList &transports);
+    Q_INVOKABLE void setMessageFilter(const QStringList &messages);
+    void setFilter(Dimension dimension, const QStringList &values);
+    QStringList filter(Dimension dimension) const;
+    // Empty text ends the search. In hex mode the text is parsed as bytes,
+    // otherwise it is matched case-insensitively against the Latin-1 preview.
+    Q_INVOKABLE void setSearch(const QString &text, bool hex);
+    // Stops the worker; matches found so far stay in the view.
+    Q_INVOKABLE void cancelSearch();
+    Q_INVOKABLE void clearFilters();
+
+    bool isActive() const;
+    // Values seen since the log was last cleared, sorted, for the pickers.
+    QStringList kinds() const;
+    QStringList transports() const;
+    QStringList messages() const;
+    bool searching() const;
+    double searchProgress() const;
+    // Blocks until the running search has delivered its last batch.
+    void waitForSearch();
+    // True while archived rows are still being indexed.
+    bool indexing() const;
+    // Blocks until the archived rows are indexed and merged.
+    void waitForIndexing();
+
+    static bool previewMatches(const QByteArray &preview, const QByteArray &pattern, bool hex);
+
+signals:
+    void countChanged();
+    void filterChanged();
+    void valuesChanged();
+    void searchingChanged();
+    void searchProgressChanged();
+
+private:
+    // Row ids in ascending order; ids below m_firstRowId are stale.
+    using Postings = QList<qint64>;
+    // The live ids of one posting list, read in place and consumed from the
+    // front as a walk in rising id order passes them.
+    struct PostingRange {
+        const qint64 *begin = nullptr;
+        const qint64 *end = nullptr;
+    };
+
+    bool facetsActive() const;
+    bool searchActive() const;
+    bool facetMatches(const std::array<QString, DimensionCount> &values) const;
+    QList<qint64> facetRows() const;
+    QList<PostingRange> selectedPostings(Dimension dimension) const;
+    void rebuild();
+    void refilter();
+    void startSearch();
+    void stopSearch();
+    // Runs on the worker thread; candidates are ignored when allRows is set.
+    void runSearch(const RawLogModel::PreviewSnapshot &snapshot,
+                   const QList<qint64> &candidates,
+                   bool allRows,
+                   const QByteArray &pattern,
+                   bool hex,
+                   quint64 generation);
+    void applySearchBatch(quint64 generation, const QList<qint64> &matches, double progress, bool finished);
+    void startIndexing();
+    void stopIndexing();
+    // Runs on the worker thread.
+    void runIndexing(const RawLogModel::PreviewSnapshot &snapshot, quint64 generation);
+    void mergeArchivedPostings(quint64 generation,
+                               const std::array<QHash<QString, Postings>, DimensionCount> &archived);
+    void onSourceRowsInserted(int first, int last);
+    void onSourceRowsAboutToBeRemoved(int first, int last);
+    void onSourceRowsRemoved(int first, int last);
+    std::array<QString, DimensionCount> indexSourceRow(int row, bool *newValues);
+    void trimPostings();
+
+    RawLogModel *m_source = nullptr;
+    std::array<QHash<QString, Postings>, DimensionCount> m_postings;
+    std::array<QSet<QString>, DimensionCount> m_selected;
+    // Matching row ids while filtering; unused in pass-through.
+    QList<qint64> m_rows;
+    int m_passThroughRows = 0;
+    qint64 m_firstRowId = 0;
+    // Our rows announced in rowsAboutToBeRemoved, -1 if none.
+    int m_removingFirst = -1;
+    int m_removingLast = -1;
+
+    QString m_searchText;
+    QByteArray m_searchPattern;
+    bool m_searchHex = false;
+    // Rows with ids from here on were not in the worker's snapshot.
+    qint64 m_searchEndId = 0;
+    bool m_searchReadsArchive = false;
+    std::unique_ptr<QThread> m_searchThread;
+    std::atomic<bool> m_cancelSearch{false};
+    quint64 m_searchGeneration = 0;
+    bool m_searching = false;
+    double m_searchProgress = 0.0;
+
+    std::unique_ptr<QThread> m_indexThread;
+    std::atomic<bool> m_cancelIndex{false};
+    quint64 m_indexGeneration = 0;
+};
+
+}  // namespace hdgnss
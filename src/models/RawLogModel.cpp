@@ -1,6 +1,11 @@
 #include "RawLogModel.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 #include <QDebug>
+#include <QTimeZone>
 
 #include "src/utils/ByteUtils.h"
 
@@ -10,6 +15,9 @@ namespace {
 
 constexpr int kPreviewBytes = 256;
 constexpr int kMaxHexDisplayChars = 86;
+// Allocation header Qt puts in front of each QByteArray/QString payload.
+constexpr qint64 kArrayHeaderBytes = 24;
+constexpr qint64 kMinPreviewArenaBytes = 4096;
 
 bool rawDataScrollDebugEnabled() {
   static const bool enabled =
@@ -34,52 +42,113 @@ QString displayTextForEntry(const QString &kind,
     return text.trimmed() + previewSuffix(payloadSize, payloadPreview.size());
   }
 
-  const QString hexText = ByteUtils::toHex(payloadPreview);
-  if (hexText.size() <= kMaxHexDisplayChars) {
-    return hexText + previewSuffix(payloadSize, payloadPreview.size());
+  // Only the bytes that fit the column are formatted.
+  constexpr int kMaxHexDisplayBytes = (kMaxHexDisplayChars + 1) / 3;
+  if (payloadPreview.size() <= kMaxHexDisplayBytes) {
+    return ByteUtils::toHex(payloadPreview) +
+           previewSuffix(payloadSize, payloadPreview.size());
   }
-
-  return hexText.left(kMaxHexDisplayChars).trimmed() +
+  return ByteUtils::toHex(payloadPreview.constData(), kMaxHexDisplayBytes) +
          QStringLiteral(" (%1 B)").arg(payloadSize);
 }
 
+QString directionText(quint8 direction) {
+  return static_cast<DataDirection>(direction) == DataDirection::Rx
+             ? QStringLiteral("RX")
+             : QStringLiteral("TX");
+}
+
+template <typename T> void resizeColumn(QList<T> &column, int head, int slots) {
+  if (head > 0) {
+    std::rotate(column.begin(), column.begin() + head, column.end());
+  }
+  if (slots > column.capacity()) {
+    column.reserve(slots);
+  }
+  column.resize(slots);
+  if (column.capacity() > slots) {
+    column.squeeze();
+  }
+}
+
 } // namespace
 
+RawLogModel::StringTable::StringTable() : m_strings{QString()} {}
+
+quint16 RawLogModel::StringTable::intern(const QString &text) {
+  if (text.isEmpty()) {
+    return 0;
+  }
+  const auto it = m_ids.constFind(text);
+  if (it != m_ids.cend()) {
+    return it.value();
+  }
+  if (m_strings.size() > std::numeric_limits<quint16>::max()) {
+    return 0;
+  }
+  const auto id = static_cast<quint16>(m_strings.size());
+  m_strings.append(text);
+  m_ids.insert(text, id);
+  return id;
+}
+
+const QString &RawLogModel::StringTable::at(quint16 id) const {
+  return m_strings.at(id < m_strings.size() ? id : 0);
+}
+
+const QList<QString> &RawLogModel::StringTable::strings() const {
+  return m_strings;
+}
+
+qint64 RawLogModel::StringTable::heapBytes() const {
+  qint64 bytes = 0;
+  for (const QString &text : m_strings) {
+    if (!text.isEmpty()) {
+      // Once in the list and once as the hash key, sharing one payload.
+      bytes += kArrayHeaderBytes + text.size() * qint64(sizeof(QChar)) +
+               2 * qint64(sizeof(QString)) + qint64(sizeof(quint16));
+    }
+  }
+  return bytes;
+}
+
+void RawLogModel::StringTable::clear() {
+  m_strings = {QString()};
+  m_ids.clear();
+}
+
 RawLogModel::RawLogModel(QObject *parent) : QAbstractListModel(parent) {}
 
 int RawLogModel::rowCount(const QModelIndex &parent) const {
-  return parent.isValid() ? 0 : m_entries.size();
+  return parent.isValid() ? 0 : archivedRows() + m_count;
 }
 
 QVariant RawLogModel::data(const QModelIndex &index, int role) const {
-  if (!index.isValid() || index.row() < 0 || index.row() >= m_entries.size()) {
+  if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) {
     return {};
   }
+  if (role == DisplayRole || role == HexRole || role == AsciiRole) {
+    return renderText(index.row(), role);
+  }
 
-  const DisplayEntry &entry = m_entries.at(index.row());
+  RawLogArchiveRow row;
+  if (!readRow(index.row(), &row)) {
+    return {};
+  }
   switch (role) {
   case TimestampRole:
-    return entry.timestampUtc.toString(QStringLiteral("HH:mm:ss.zzz"));
+    return QDateTime::fromMSecsSinceEpoch(row.timestampMs, QTimeZone::UTC)
+        .toString(QStringLiteral("HH:mm:ss.zzz"));
   case DirectionRole:
-    return entry.direction == DataDirection::Rx ? QStringLiteral("RX")
-                                                : QStringLiteral("TX");
+    return directionText(row.direction);
   case TransportRole:
-    return entry.transportName;
+    return m_transports.at(row.transportId);
   case KindRole:
-    return entry.kind;
+    return m_kinds.at(row.kindId);
   case MessageRole:
-    return entry.messageName;
+    return m_messages.at(row.messageId);
   case SizeRole:
-    return entry.payloadSize;
-  case DisplayRole:
-    return displayTextForEntry(entry.kind, entry.payloadPreview,
-                               entry.payloadSize);
-  case HexRole:
-    return displayTextForEntry(QStringLiteral("BIN"), entry.payloadPreview,
-                               entry.payloadSize);
-  case AsciiRole:
-    return ByteUtils::toAscii(entry.payloadPreview) +
-           previewSuffix(entry.payloadSize, entry.payloadPreview.size());
+    return row.payloadSize;
   default:
     return {};
   }
@@ -94,92 +163,518 @@ QHash<int, QByteArray> RawLogModel::roleNames() const {
 }
 
 QVariantMap RawLogModel::get(int row) const {
-  if (row < 0 || row >= m_entries.size()) {
+  RawLogArchiveRow stored;
+  if (row < 0 || row >= rowCount() || !readRow(row, &stored)) {
     return {};
   }
-  const DisplayEntry &entry = m_entries.at(row);
   return {{QStringLiteral("timestamp"),
-           entry.timestampUtc.toString(Qt::ISODateWithMs)},
-          {QStringLiteral("direction"), entry.direction == DataDirection::Rx
-                                            ? QStringLiteral("RX")
-                                            : QStringLiteral("TX")},
-          {QStringLiteral("transport"), entry.transportName},
-          {QStringLiteral("kind"), entry.kind},
-          {QStringLiteral("message"), entry.messageName},
-          {QStringLiteral("display"),
-           displayTextForEntry(entry.kind, entry.payloadPreview,
-                               entry.payloadSize)},
-          {QStringLiteral("hex"),
-           displayTextForEntry(QStringLiteral("BIN"), entry.payloadPreview,
-                               entry.payloadSize)},
-          {QStringLiteral("ascii"),
-           ByteUtils::toAscii(entry.payloadPreview) +
-               previewSuffix(entry.payloadSize, entry.payloadPreview.size())},
-          {QStringLiteral("size"), entry.payloadSize}};
+           QDateTime::fromMSecsSinceEpoch(stored.timestampMs, QTimeZone::UTC)
+               .toString(Qt::ISODateWithMs)},
+          {QStringLiteral("direction"), directionText(stored.direction)},
+          {QStringLiteral("transport"), m_transports.at(stored.transportId)},
+          {QStringLiteral("kind"), m_kinds.at(stored.kindId)},
+          {QStringLiteral("message"), m_messages.at(stored.messageId)},
+          {QStringLiteral("display"), renderText(row, DisplayRole)},
+          {QStringLiteral("hex"), renderText(row, HexRole)},
+          {QStringLiteral("ascii"), renderText(row, AsciiRole)},
+          {QStringLiteral("size"), stored.payloadSize}};
 }
 
 void RawLogModel::clear() {
-  if (m_entries.isEmpty() && m_pendingBuffers.isEmpty()) {
+  const int archived = archivedRows();
+  if (m_count == 0 && archived == 0 && m_pending.isEmpty()) {
     return;
   }
   if (rawDataScrollDebugEnabled()) {
-    qInfo().noquote() << "[RawDataModel] clear entries=" << m_entries.size()
-                      << "pendingStreams=" << m_pendingBuffers.size();
+    qInfo().noquote() << "[RawDataModel] clear entries=" << m_count
+                      << "archived=" << archived
+                      << "pending=" << m_pending.size();
   }
   beginResetModel();
-  m_entries.clear();
-  m_pendingBuffers.clear();
+  if (m_scrollbackEnabled && !m_archive.open()) {
+    qWarning().noquote() << "RawData scrollback unavailable:"
+                         << m_archive.errorString();
+    m_scrollbackEnabled = false;
+  }
+  m_timestampsMs = {};
+  m_directions = {};
+  m_transportIds = {};
+  m_kindIds = {};
+  m_messageIds = {};
+  m_previewOffsets = {};
+  m_payloadSizes = {};
+  m_previewArena = {};
+  m_transports.clear();
+  m_kinds.clear();
+  m_messages.clear();
+  m_renderCache.clear();
+  m_firstRowId += archived + m_count;
+  m_slots = 0;
+  m_head = 0;
+  m_count = 0;
+  m_pending.clear();
   endResetModel();
   emit countChanged();
 }
 
-void RawLogModel::appendEntry(const RawLogEntry &entry) {
-  const QString streamKey =
-      QStringLiteral("%1:%2")
-          .arg(entry.transportName)
-          .arg(entry.direction == DataDirection::Rx ? QStringLiteral("RX")
-                                                    : QStringLiteral("TX"));
+qint64 RawLogModel::rowId(int row) const { return m_firstRowId + row; }
 
-  StreamChunker &buffer = m_pendingBuffers[streamKey];
-  buffer.append(entry.payload);
-  const QList<StreamChunk> chunks = buffer.takeAvailableChunks();
+QByteArray RawLogModel::preview(int row) const {
+  RawLogArchiveRow stored;
+  if (row < 0 || row >= rowCount() || !readRow(row, &stored)) {
+    return {};
+  }
+  return QByteArray(stored.preview.constData(), stored.preview.size());
+}
 
-  for (const StreamChunk &chunk : chunks) {
-    appendDisplayEntry(DisplayEntry{
-        entry.timestampUtc, entry.direction, entry.transportName,
-        chunk.kindName(), QString{}, chunk.payload.left(kPreviewBytes),
-        static_cast<int>(chunk.payload.size())});
+RawLogModel::PreviewSnapshot RawLogModel::previewSnapshot() const {
+  PreviewSnapshot snapshot;
+  snapshot.m_firstRowId = m_firstRowId;
+  snapshot.m_archivedRows = archivedRows();
+  if (snapshot.m_archivedRows > 0 && m_archive.flush()) {
+    auto reader = std::make_shared<RawLogArchive>();
+    if (reader->openForReading(m_archive.recordPath(), m_archive.previewPath(),
+                               snapshot.m_archivedRows)) {
+      snapshot.m_archive = std::move(reader);
+      snapshot.m_transports = m_transports.strings();
+      snapshot.m_kinds = m_kinds.strings();
+      snapshot.m_messages = m_messages.strings();
+    }
+  }
+  // The live previews are already contiguous, so one copy takes them all.
+  const qint64 live = livePreviewBytes();
+  const quint32 base = m_count > 0 ? m_previewOffsets.at(m_head) : 0;
+  snapshot.m_previews = QByteArray(m_previewArena.constData() + base, live);
+  snapshot.m_offsets.reserve(m_count);
+  for (int row = 0; row < m_count; ++row) {
+    snapshot.m_offsets.append(m_previewOffsets.at(slotOf(row)) - base);
+  }
+  return snapshot;
+}
+
+qint64 RawLogModel::PreviewSnapshot::firstRowId() const {
+  return m_firstRowId;
+}
+
+qint64 RawLogModel::PreviewSnapshot::rowCount() const {
+  return m_archivedRows + m_offsets.size();
+}
+
+qint64 RawLogModel::PreviewSnapshot::archivedRows() const {
+  return m_archivedRows;
+}
+
+QByteArray RawLogModel::PreviewSnapshot::preview(qint64 rowId) const {
+  const qint64 row = rowId - m_firstRowId;
+  if (row < 0 || row >= rowCount()) {
+    return {};
+  }
+  if (row < m_archivedRows) {
+    RawLogArchiveRow stored;
+    return m_archive && m_archive->readRow(row, &stored) ? stored.preview
+                                                         : QByteArray();
+  }
+  const qsizetype memoryRow = row - m_archivedRows;
+  const quint32 begin = m_offsets.at(memoryRow);
+  const quint32 end = memoryRow + 1 < m_offsets.size()
+                          ? m_offsets.at(memoryRow + 1)
+                          : static_cast<quint32>(m_previews.size());
+  return QByteArray::fromRawData(m_previews.constData() + begin, end - begin);
+}
+
+bool RawLogModel::PreviewSnapshot::archivedLabels(qint64 rowId,
+                                                 QString *direction,
+                                                 QString *transport,
+                                                 QString *kind,
+                                                 QString *message) const {
+  const qint64 row = rowId - m_firstRowId;
+  RawLogArchiveRow stored;
+  if (row < 0 || row >= m_archivedRows || !m_archive ||
+      !m_archive->readRow(row, &stored)) {
+    return false;
+  }
+  *direction = directionText(stored.direction);
+  *transport = m_transports.value(stored.transportId);
+  *kind = m_kinds.value(stored.kindId);
+  *message = m_messages.value(stored.messageId);
+  return true;
+}
+
+void RawLogModel::setRetention(int maxRows, qint64 memoryBudgetBytes) {
+  m_maxRows = std::max(1, maxRows);
+  m_memoryBudgetBytes = std::max<qint64>(0, memoryBudgetBytes);
+
+  const int evict = rowsToEvict(0, 0);
+  if (evict > 0) {
+    evictFront(evict);
+  }
+  if (m_slots > m_maxRows) {
+    resizeRing(m_count);
+  }
+  if (m_previewArena.capacity() > previewCapacityFor(m_slots)) {
+    compactPreviews();
+    m_previewArena.squeeze();
+  }
+  if (evict > 0) {
+    emit countChanged();
+  }
+}
+
+void RawLogModel::setScrollbackEnabled(bool enabled) {
+  if (enabled == m_scrollbackEnabled) {
+    return;
+  }
+  if (enabled) {
+    if (!m_archive.open()) {
+      qWarning().noquote() << "RawData scrollback unavailable:"
+                           << m_archive.errorString();
+      return;
+    }
+    m_scrollbackEnabled = true;
+    emit countChanged();
+    return;
+  }
+
+  // Rows already on disk leave the view; the in-memory ones stay.
+  const int archived = archivedRows();
+  if (archived > 0) {
+    beginRemoveRows({}, 0, archived - 1);
+  }
+  m_scrollbackEnabled = false;
+  m_archive.close();
+  m_firstRowId += archived;
+  if (archived > 0) {
+    endRemoveRows();
   }
   emit countChanged();
 }
 
+bool RawLogModel::scrollbackEnabled() const { return m_scrollbackEnabled; }
+
+int RawLogModel::maxRows() const { return m_maxRows; }
+
+qint64 RawLogModel::memoryBudgetBytes() const { return m_memoryBudgetBytes; }
+
+qint64 RawLogModel::memoryBytes() const {
+  return static_cast<qint64>(m_slots) * kRowFixedBytes + previewBytes() +
+         m_transports.heapBytes() + m_kinds.heapBytes() +
+         m_messages.heapBytes() + m_archive.memoryBytes();
+}
+
+qint64 RawLogModel::diskBytes() const {
+  return m_scrollbackEnabled ? m_archive.diskBytes() : 0;
+}
+
+qint64 RawLogModel::previewBytes() const { return m_previewArena.capacity(); }
+
 void RawLogModel::appendChunk(const QDateTime &timestampUtc,
                               DataDirection direction,
-                              const QString &transportName, const QString &kind,
-                              const QByteArray &payload) {
-  appendDisplayEntry(DisplayEntry{timestampUtc, direction, transportName, kind,
-                                  QString{}, payload.left(kPreviewBytes),
-                                  static_cast<int>(payload.size())});
-  emit countChanged();
+                              const QString &transportName,
+                              const StreamChunk &chunk,
+                              const QList<ProtocolMessage> &messages) {
+  const QString kind = chunk.kindName();
+  if (messages.isEmpty()) {
+    stageRow(timestampUtc, direction, transportName, kind, QString{},
+             chunk.payload);
+    return;
+  }
+  for (const ProtocolMessage &message : messages) {
+    stageRow(timestampUtc, direction, transportName, kind, message.messageName,
+             message.rawFrame);
+  }
 }
 
-void RawLogModel::appendProtocolMessage(const QDateTime &timestampUtc,
-                                        DataDirection direction,
-                                        const QString &transportName,
-                                        const QString &kind,
-                                        const ProtocolMessage &message) {
-  appendDisplayEntry(DisplayEntry{timestampUtc, direction, transportName, kind,
-                                  message.messageName,
-                                  message.rawFrame.left(kPreviewBytes),
-                                  static_cast<int>(message.rawFrame.size())});
-  emit countChanged();
+int RawLogModel::slotOf(int row) const { return (m_head + row) % m_slots; }
+
+int RawLogModel::ringSlotsFor(int rows) const {
+  if (rows <= m_slots) {
+    return m_slots;
+  }
+  // Only reached while the ring is still growing towards m_maxRows.
+  return std::min(m_maxRows, std::max({64, rows, m_slots * 2}));
+}
+
+qint64 RawLogModel::previewCapacityFor(int slots) const {
+  if (m_memoryBudgetBytes <= 0) {
+    return std::numeric_limits<qint64>::max();
+  }
+  return std::max<qint64>(
+      0, m_memoryBudgetBytes - static_cast<qint64>(slots) * kRowFixedBytes);
 }
 
-void RawLogModel::appendDisplayEntry(const DisplayEntry &entry) {
-  const int row = m_entries.size();
-  beginInsertRows({}, row, row);
-  m_entries.append(entry);
+int RawLogModel::previewSize(int row) const {
+  const quint32 end = row + 1 < m_count
+                          ? m_previewOffsets.at(slotOf(row + 1))
+                          : static_cast<quint32>(m_previewArena.size());
+  return static_cast<int>(end - m_previewOffsets.at(slotOf(row)));
+}
+
+QByteArray RawLogModel::previewAt(int row) const {
+  return QByteArray::fromRawData(m_previewArena.constData() +
+                                     m_previewOffsets.at(slotOf(row)),
+                                 previewSize(row));
+}
+
+qint64 RawLogModel::livePreviewBytes() const {
+  return m_count > 0 ? m_previewArena.size() - m_previewOffsets.at(m_head) : 0;
+}
+
+int RawLogModel::archivedRows() const {
+  return m_scrollbackEnabled ? static_cast<int>(m_archive.rowCount()) : 0;
+}
+
+bool RawLogModel::readRow(int row, RawLogArchiveRow *out) const {
+  const int archived = archivedRows();
+  if (row < archived) {
+    return m_archive.readRow(row, out);
+  }
+  readMemoryRow(row - archived, out);
+  return true;
+}
+
+void RawLogModel::readMemoryRow(int memoryRow, RawLogArchiveRow *out) const {
+  const int slot = slotOf(memoryRow);
+  out->timestampMs = m_timestampsMs.at(slot);
+  out->direction = m_directions.at(slot);
+  out->transportId = m_transportIds.at(slot);
+  out->kindId = m_kindIds.at(slot);
+  out->messageId = m_messageIds.at(slot);
+  out->payloadSize = m_payloadSizes.at(slot);
+  out->preview = previewAt(memoryRow);
+}
+
+QString RawLogModel::renderText(int row, int role) const {
+  const qint64 id = m_firstRowId + row;
+  const quint8 bit = quint8(1) << (role - DisplayRole);
+  RenderedRow *rendered = m_renderCache.object(id);
+  if (rendered == nullptr) {
+    rendered = new RenderedRow;
+    m_renderCache.insert(id, rendered);
+  }
+  QString &text = role == DisplayRole ? rendered->display
+                  : role == HexRole   ? rendered->hex
+                                      : rendered->ascii;
+  if ((rendered->renderedRoles & bit) == 0) {
+    RawLogArchiveRow stored;
+    if (!readRow(row, &stored)) {
+      return {};
+    }
+    text = formatText(stored, role);
+    rendered->renderedRoles |= bit;
+  }
+  return text;
+}
+
+QString RawLogModel::formatText(const RawLogArchiveRow &row, int role) const {
+  switch (role) {
+  case DisplayRole:
+    return displayTextForEntry(m_kinds.at(row.kindId), row.preview,
+                               row.payloadSize);
+  case HexRole:
+    return displayTextForEntry(QStringLiteral("BIN"), row.preview,
+                               row.payloadSize);
+  default:
+    return ByteUtils::toAscii(row.preview) +
+           previewSuffix(row.payloadSize, row.preview.size());
+  }
+}
+
+void RawLogModel::stageRow(const QDateTime &timestampUtc,
+                           DataDirection direction,
+                           const QString &transportName, const QString &kind,
+                           const QString &messageName,
+                           const QByteArray &payload) {
+  m_pending.append(PendingRow{
+      timestampUtc.toMSecsSinceEpoch(), direction,
+      m_transports.intern(transportName), m_kinds.intern(kind),
+      m_messages.intern(messageName), payload.left(kPreviewBytes),
+      static_cast<int>(payload.size())});
+  // Rows beyond the limit would be evicted on publish anyway; trimming at
+  // twice the limit keeps a stalled UI from buffering without bound. With
+  // scrollback nothing may be dropped, so they are published early instead.
+  if (m_pending.size() >= 2 * qsizetype(m_maxRows)) {
+    if (m_scrollbackEnabled) {
+      publishPending();
+    } else {
+      m_pending.remove(0, m_pending.size() - m_maxRows);
+    }
+  }
+}
+
+int RawLogModel::pendingCount() const { return m_pending.size(); }
+
+void RawLogModel::publishPending() {
+  if (m_pending.isEmpty()) {
+    return;
+  }
+  QList<PendingRow> staged;
+  staged.swap(m_pending);
+
+  // Staged rows that would be evicted in the same tick never enter the ring;
+  // without scrollback they are not inserted at all.
+  qsizetype first = std::max<qsizetype>(0, staged.size() - m_maxRows);
+  qint64 incomingBytes = 0;
+  for (qsizetype i = first; i < staged.size(); ++i) {
+    incomingBytes += staged.at(i).preview.size();
+  }
+  if (m_memoryBudgetBytes > 0) {
+    while (staged.size() - first > 1 &&
+           incomingBytes + (staged.size() - first) * kRowFixedBytes >
+               m_memoryBudgetBytes) {
+      incomingBytes -= staged.at(first).preview.size();
+      ++first;
+    }
+  }
+  const int incoming = static_cast<int>(staged.size() - first);
+
+  if (m_scrollbackEnabled) {
+    // Every staged row becomes a model row; the ones that do not fit in
+    // memory go straight to the archive after the rows already there.
+    const int total = rowCount();
+    beginInsertRows({}, total, total + static_cast<int>(staged.size()) - 1);
+    if (first > 0) {
+      evictFront(m_count);
+      for (qsizetype i = 0; i < first; ++i) {
+        const PendingRow &row = staged.at(i);
+        m_archive.append(RawLogArchiveRow{
+            row.timestampMs, static_cast<quint8>(row.direction),
+            row.transportId, row.kindId, row.messageId, row.payloadSize,
+            row.preview});
+      }
+    }
+    evictFront(rowsToEvict(incoming, incomingBytes));
+    storeStaged(staged, first, incomingBytes);
+    endInsertRows();
+    emit countChanged();
+    return;
+  }
+
+  evictFront(rowsToEvict(incoming, incomingBytes));
+  beginInsertRows({}, m_count, m_count + incoming - 1);
+  storeStaged(staged, first, incomingBytes);
   endInsertRows();
+  emit countChanged();
+}
+
+void RawLogModel::storeStaged(const QList<PendingRow> &staged, qsizetype first,
+                              qint64 stagedPreviewBytes) {
+  const int slots =
+      ringSlotsFor(m_count + static_cast<int>(staged.size() - first));
+  if (slots > m_slots) {
+    resizeRing(slots);
+  }
+  reservePreviewBytes(stagedPreviewBytes);
+  for (qsizetype i = first; i < staged.size(); ++i) {
+    const PendingRow &row = staged.at(i);
+    const int slot = slotOf(m_count);
+    m_timestampsMs[slot] = row.timestampMs;
+    m_directions[slot] = static_cast<quint8>(row.direction);
+    m_transportIds[slot] = row.transportId;
+    m_kindIds[slot] = row.kindId;
+    m_messageIds[slot] = row.messageId;
+    m_previewOffsets[slot] = static_cast<quint32>(m_previewArena.size());
+    m_payloadSizes[slot] = row.payloadSize;
+    m_previewArena.append(row.preview);
+    ++m_count;
+  }
+}
+
+int RawLogModel::rowsToEvict(int incomingRows,
+                             qint64 incomingPreviewBytes) const {
+  int evict = std::max(0, m_count + incomingRows - m_maxRows);
+  if (m_memoryBudgetBytes <= 0) {
+    return evict;
+  }
+  // The ring's slots are paid for whether or not they hold a row, so the
+  // budget left for previews is what the arena may grow to. Sizing the ring
+  // for every incoming row errs on the small side when some are evicted.
+  const qint64 capacity = previewCapacityFor(ringSlotsFor(m_count + incomingRows));
+  qint64 used = livePreviewBytes() + incomingPreviewBytes;
+  for (int row = 0; row < evict; ++row) {
+    used -= previewSize(row);
+  }
+  if (used <= capacity) {
+    return evict;
+  }
+  // Free a quarter of the arena beyond what is needed, so the compaction
+  // this leads to moves the live previews once per quarter arena appended.
+  const qint64 target = capacity - capacity / 4;
+  while (evict < m_count && used > target) {
+    used -= previewSize(evict);
+    ++evict;
+  }
+  return evict;
+}
+
+void RawLogModel::evictFront(int rows) {
+  rows = std::min(rows, m_count);
+  if (rows <= 0) {
+    return;
+  }
+  // Evicted previews stay in the arena until the next compaction. With
+  // scrollback the rows move to the archive and keep their model rows.
+  if (m_scrollbackEnabled) {
+    RawLogArchiveRow row;
+    for (int memoryRow = 0; memoryRow < rows; ++memoryRow) {
+      readMemoryRow(memoryRow, &row);
+      m_archive.append(row);
+    }
+  } else {
+    beginRemoveRows({}, 0, rows - 1);
+    m_firstRowId += rows;
+  }
+  m_count -= rows;
+  m_head = m_count == 0 ? 0 : (m_head + rows) % m_slots;
+  if (!m_scrollbackEnabled) {
+    endRemoveRows();
+  }
+}
+
+void RawLogModel::resizeRing(int slots) {
+  resizeColumn(m_timestampsMs, m_head, slots);
+  resizeColumn(m_directions, m_head, slots);
+  resizeColumn(m_transportIds, m_head, slots);
+  resizeColumn(m_kindIds, m_head, slots);
+  resizeColumn(m_messageIds, m_head, slots);
+  resizeColumn(m_previewOffsets, m_head, slots);
+  resizeColumn(m_payloadSizes, m_head, slots);
+  m_slots = slots;
+  m_head = 0;
+}
+
+void RawLogModel::compactPreviews() {
+  const qint64 dead = m_previewArena.size() - livePreviewBytes();
+  if (dead <= 0) {
+    return;
+  }
+  char *data = m_previewArena.data();
+  std::memmove(data, data + dead, m_previewArena.size() - dead);
+  m_previewArena.resize(m_previewArena.size() - dead);
+  for (int row = 0; row < m_count; ++row) {
+    m_previewOffsets[slotOf(row)] -= static_cast<quint32>(dead);
+  }
+}
+
+void RawLogModel::reservePreviewBytes(qint64 bytes) {
+  const qint64 budget = previewCapacityFor(m_slots);
+  if (m_previewArena.size() + bytes <= m_previewArena.capacity() &&
+      m_previewArena.capacity() <= budget) {
+    return;
+  }
+  // Compacting only when the arena is full keeps the cost at one move of
+  // the live previews per arena's worth of appended bytes. The arena grows
+  // by doubling up to what the budget leaves beside the ring, and shrinks
+  // back to it when the ring has grown into that share.
+  compactPreviews();
+  const qint64 needed = m_previewArena.size() + bytes;
+  const qint64 wanted =
+      std::max(needed, std::min(std::max(needed * 2, kMinPreviewArenaBytes), budget));
+  if (m_previewArena.capacity() > budget) {
+    m_previewArena.squeeze();
+  }
+  if (wanted > m_previewArena.capacity()) {
+    m_previewArena.reserve(wanted);
+  }
 }
 
 } // namespace hdgnss
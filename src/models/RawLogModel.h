@@ -1,16 +1,41 @@
 #pragma once
 
+#include <memory>
+
 #include <QAbstractListModel>
+#include <QCache>
 #include <QHash>
+#include <QList>
 
 #include "src/core/StreamChunker.h"
 #include "src/protocols/GnssTypes.h"
+#include "src/storage/RawLogArchive.h"
 
 namespace hdgnss {
 
+// Rows are stored column by column: a millisecond timestamp, direction,
+// interned transport, kind and message ids, and an offset into one shared
+// arena of payload previews. Strings are only formatted in data() and get(),
+// and the rendered display, hex and ASCII text of recently viewed rows is
+// kept in a small LRU cache so delegates recreated while scrolling reuse it.
+// Rows live in a ring of at most maxRows() entries. The oldest rows are
+// evicted, with beginRemoveRows(), when either the row limit or the memory
+// budget would be exceeded, so a long session runs at constant memory. The
+// budget covers the ring slots and the preview arena's capacity, as
+// memoryBytes() reports them; the interned strings come on top. When the
+// budget forces eviction, a quarter of the arena is freed at once, so the
+// arena is compacted once per quarter of its size rather than every tick.
+// Appends are staged and become visible on publishPending(), which inserts
+// them as one contiguous range so a busy stream costs the view one relayout
+// per UI tick rather than one per chunk.
+// With scrollback enabled, rows leaving the ring are not removed but moved to
+// a RawLogArchive on disk and paged back in on demand, so the view can scroll
+// through the whole session while memory stays bounded by the same limits.
 class RawLogModel : public QAbstractListModel {
     Q_OBJECT
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(qint64 memoryBytes READ memoryBytes NOTIFY countChanged)
+    Q_PROPERTY(qint64 diskBytes READ diskBytes NOTIFY countChanged)
 
 public:
     enum Roles {
@@ -25,6 +50,43 @@ public:
         AsciiRole
     };
 
+    static constexpr int kDefaultMaxRows = 200000;
+    static constexpr qint64 kDefaultMemoryBudgetBytes = 256LL * 1024 * 1024;
+    // A few viewport heights of the RawData list.
+    static constexpr int kRenderCacheRows = 512;
+
+    // Previews of the published rows at one point in time, readable from a
+    // worker thread while the model keeps changing. In-memory previews are
+    // copied; archived ones are read through a private reader of the archive
+    // files, so the archive must outlive the snapshot's use.
+    class PreviewSnapshot {
+    public:
+        qint64 firstRowId() const;
+        qint64 rowCount() const;
+        qint64 archivedRows() const;
+        // Empty if the row is outside the snapshot or cannot be read.
+        QByteArray preview(qint64 rowId) const;
+        // Text of the direction, transport, kind and message roles of an
+        // archived row. False for rows held in memory, which data() reads
+        // without touching the disk, and for rows that cannot be read.
+        bool archivedLabels(qint64 rowId, QString *direction, QString *transport, QString *kind,
+                            QString *message) const;
+
+    private:
+        friend class RawLogModel;
+
+        qint64 m_firstRowId = 0;
+        qint64 m_archivedRows = 0;
+        QByteArray m_previews;
+        // Start of each in-memory row's preview in m_previews.
+        QList<quint32> m_offsets;
+        std::shared_ptr<RawLogArchive> m_archive;
+        // Interned names the archived rows' ids refer to.
+        QList<QString> m_transports;
+        QList<QString> m_kinds;
+        QList<QString> m_messages;
+    };
+
     explicit RawLogModel(QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -33,36 +95,137 @@ public:
 
     Q_INVOKABLE QVariantMap get(int row) const;
     Q_INVOKABLE void clear();
-    void appendEntry(const RawLogEntry &entry);
+    // Stable identity of a row: ids grow by one per row and are never reused,
+    // so a row keeps its id while older rows are evicted.
+    qint64 rowId(int row) const;
+    QByteArray preview(int row) const;
+    PreviewSnapshot previewSnapshot() const;
+    // Evicts and inserts everything appended since the last call.
+    void publishPending();
+    int pendingCount() const;
+    // A budget of 0 limits by row count only. Shrinking evicts immediately.
+    void setRetention(int maxRows, qint64 memoryBudgetBytes);
+    int maxRows() const;
+    qint64 memoryBudgetBytes() const;
+    // Estimated heap held by the stored rows, ring slots included. Stays
+    // within memoryBudgetBytes() plus the interned strings and the archive
+    // index, unless a single row is larger than the budget.
+    qint64 memoryBytes() const;
+    // The part of memoryBytes() taken by the shared preview arena.
+    qint64 previewBytes() const;
+    // Size of the scrollback archive, 0 while scrollback is off.
+    qint64 diskBytes() const;
+    // Rows at the front of the model that live in the scrollback archive.
+    int archivedRows() const;
+    // Turning scrollback off removes the archived rows from the view.
+    void setScrollbackEnabled(bool enabled);
+    bool scrollbackEnabled() const;
+    // Rows come from chunks the shared StreamChunker already produced, with
+    // the messages decoded from each: one row per message showing its raw
+    // frame, or the chunk itself when nothing decoded. The model never
+    // chunks bytes on its own.
     void appendChunk(const QDateTime &timestampUtc,
                      DataDirection direction,
                      const QString &transportName,
-                     const QString &kind,
-                     const QByteArray &payload);
-    void appendProtocolMessage(const QDateTime &timestampUtc,
-                               DataDirection direction,
-                               const QString &transportName,
-                               const QString &kind,
-                               const ProtocolMessage &message);
+                     const StreamChunk &chunk,
+                     const QList<ProtocolMessage> &messages = {});
 
 signals:
     void countChanged();
 
 private:
-    struct DisplayEntry {
-        QDateTime timestampUtc;
+    // Names repeated on every row are stored once; rows keep 16-bit ids and
+    // id 0 is the empty string.
+    class StringTable {
+    public:
+        StringTable();
+        // Returns 0 once the table is full.
+        quint16 intern(const QString &text);
+        const QString &at(quint16 id) const;
+        const QList<QString> &strings() const;
+        qint64 heapBytes() const;
+        void clear();
+
+    private:
+        QList<QString> m_strings;
+        QHash<QString, quint16> m_ids;
+    };
+
+    struct PendingRow {
+        qint64 timestampMs = 0;
         DataDirection direction = DataDirection::Rx;
-        QString transportName;
-        QString kind;
-        QString messageName;
-        QByteArray payloadPreview;
+        quint16 transportId = 0;
+        quint16 kindId = 0;
+        quint16 messageId = 0;
+        QByteArray preview;
         int payloadSize = 0;
     };
 
-    void appendDisplayEntry(const DisplayEntry &entry);
+    struct RenderedRow {
+        QString display;
+        QString hex;
+        QString ascii;
+        // Bit per role already rendered, indexed from DisplayRole.
+        quint8 renderedRoles = 0;
+    };
+
+    // Bytes of column storage per ring slot; previews live in the arena.
+    static constexpr qint64 kRowFixedBytes = sizeof(qint64) + sizeof(quint8) + 3 * sizeof(quint16)
+        + sizeof(quint32) + sizeof(qint32);
+
+    int slotOf(int row) const;
+    // Ring size once rows rows are stored; the ring only grows.
+    int ringSlotsFor(int rows) const;
+    // Arena capacity the budget leaves beside a ring of slots slots.
+    qint64 previewCapacityFor(int slots) const;
+    int previewSize(int row) const;
+    QByteArray previewAt(int row) const;
+    qint64 livePreviewBytes() const;
+    bool readRow(int row, RawLogArchiveRow *out) const;
+    void readMemoryRow(int memoryRow, RawLogArchiveRow *out) const;
+    QString renderText(int row, int role) const;
+    QString formatText(const RawLogArchiveRow &row, int role) const;
+    void stageRow(const QDateTime &timestampUtc,
+                  DataDirection direction,
+                  const QString &transportName,
+                  const QString &kind,
+                  const QString &messageName,
+                  const QByteArray &payload);
+    int rowsToEvict(int incomingRows, qint64 incomingPreviewBytes) const;
+    void storeStaged(const QList<PendingRow> &staged, qsizetype first, qint64 stagedPreviewBytes);
+    void evictFront(int rows);
+    void resizeRing(int slots);
+    void compactPreviews();
+    void reservePreviewBytes(qint64 bytes);
 
-    QList<DisplayEntry> m_entries;
-    QHash<QString, StreamChunker> m_pendingBuffers;
+    // Memory row r, model row archivedRows() + r, lives in slot
+    // (m_head + r) % m_slots of every column.
+    QList<qint64> m_timestampsMs;
+    QList<quint8> m_directions;
+    QList<quint16> m_transportIds;
+    QList<quint16> m_kindIds;
+    QList<quint16> m_messageIds;
+    QList<quint32> m_previewOffsets;
+    QList<qint32> m_payloadSizes;
+    // Previews of the live rows back to back in row order, starting at row
+    // 0's offset. Bytes of evicted rows stay in front until the next
+    // compaction.
+    QByteArray m_previewArena;
+    StringTable m_transports;
+    StringTable m_kinds;
+    StringTable m_messages;
+    // Keyed by row id, which stays fixed for a row while older rows are
+    // evicted in front of it.
+    mutable QCache<qint64, RenderedRow> m_renderCache{kRenderCacheRows};
+    qint64 m_firstRowId = 0;
+    mutable RawLogArchive m_archive;
+    bool m_scrollbackEnabled = false;
+    int m_slots = 0;
+    int m_head = 0;
+    int m_count = 0;
+    int m_maxRows = kDefaultMaxRows;
+    qint64 m_memoryBudgetBytes = kDefaultMemoryBudgetBytes;
+    QList<PendingRow> m_pending;
 };
 
 }  // namespace hdgnss
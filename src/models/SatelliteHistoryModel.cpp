@@ -0,0 +1,175 @@
+#include "SatelliteHistoryModel.h"
+
+#include <algorithm>
+
+namespace hdgnss {
+
+namespace {
+
+constexpr int kMinWindowSeconds = 10;
+constexpr int kMaxWindowSeconds = 24 * 60 * 60;
+constexpr int kMinPoints = 8;
+constexpr int kMaxPoints = 2000;
+
+}  // namespace
+
+SatelliteHistoryModel::SatelliteHistoryModel(QObject *parent)
+    : QAbstractListModel(parent) {}
+
+int SatelliteHistoryModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_keys.size());
+}
+
+QVariant SatelliteHistoryModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_keys.size()) {
+        return {};
+    }
+    const QString &key = m_keys.at(index.row());
+    if (role == KeyRole) {
+        return key;
+    }
+    if (role == SeriesRole) {
+        return series(key);
+    }
+    const SatelliteHistoryStats window =
+        m_history.windowStats(key, windowStartMs(), m_history.latestTimestampMs());
+    switch (role) {
+    case SamplesRole: return window.samples;
+    case MinCn0Role: return window.minCn0;
+    case MeanCn0Role: return window.meanCn0;
+    case MaxCn0Role: return window.maxCn0;
+    case MinElevationRole: return window.minElevation;
+    case MeanElevationRole: return window.meanElevation;
+    case MaxElevationRole: return window.maxElevation;
+    case UsedRatioRole: return window.samples > 0 ? double(window.usedSamples) / window.samples : 0.0;
+    default: return {};
+    }
+}
+
+QHash<int, QByteArray> SatelliteHistoryModel::roleNames() const {
+    return {
+        {KeyRole, "key"},
+        {SamplesRole, "samples"},
+        {MinCn0Role, "minCn0"},
+        {MeanCn0Role, "meanCn0"},
+        {MaxCn0Role, "maxCn0"},
+        {MinElevationRole, "minElevation"},
+        {MeanElevationRole, "meanElevation"},
+        {MaxElevationRole, "maxElevation"},
+        {UsedRatioRole, "usedRatio"},
+        {SeriesRole, "series"}
+    };
+}
+
+const SatelliteHistory &SatelliteHistoryModel::history() const {
+    return m_history;
+}
+
+void SatelliteHistoryModel::setMemoryBudget(qint64 bytes) {
+    m_history.setMemoryBudget(bytes);
+    m_pending = true;
+}
+
+void SatelliteHistoryModel::appendEpoch(qint64 timestampMs, const QHash<QString, SatelliteInfo> &satellites) {
+    m_history.appendEpoch(timestampMs, satellites);
+    m_pending = true;
+}
+
+void SatelliteHistoryModel::clear() {
+    m_history.clear();
+    m_pending = true;
+}
+
+void SatelliteHistoryModel::publish() {
+    if (!m_pending) {
+        return;
+    }
+    m_pending = false;
+    announceRows();
+}
+
+int SatelliteHistoryModel::revision() const {
+    return m_revision;
+}
+
+int SatelliteHistoryModel::windowSeconds() const {
+    return m_windowSeconds;
+}
+
+void SatelliteHistoryModel::setWindowSeconds(int seconds) {
+    const int clamped = std::clamp(seconds, kMinWindowSeconds, kMaxWindowSeconds);
+    if (clamped == m_windowSeconds) {
+        return;
+    }
+    m_windowSeconds = clamped;
+    emit windowChanged();
+    announceRows();
+}
+
+int SatelliteHistoryModel::points() const {
+    return m_points;
+}
+
+void SatelliteHistoryModel::setPoints(int points) {
+    const int clamped = std::clamp(points, kMinPoints, kMaxPoints);
+    if (clamped == m_points) {
+        return;
+    }
+    m_points = clamped;
+    emit windowChanged();
+    announceRows();
+}
+
+QVariantList SatelliteHistoryModel::series(const QString &key) const {
+    const qint64 fromMs = windowStartMs();
+    const qint64 toMs = m_history.latestTimestampMs();
+    const double spanMs = std::max<qint64>(1, toMs - fromMs);
+    // Each bucket contributes its low and its high point.
+    const QList<QPointF> decimated = m_history.decimatedCn0(key, fromMs, toMs, std::max(1, m_points / 2));
+    QVariantList points;
+    points.reserve(decimated.size());
+    for (const QPointF &point : decimated) {
+        points.append(QPointF((point.x() - fromMs) / spanMs, point.y()));
+    }
+    return points;
+}
+
+QVariantMap SatelliteHistoryModel::stats(const QString &key) const {
+    const SatelliteHistoryStats window =
+        m_history.windowStats(key, windowStartMs(), m_history.latestTimestampMs());
+    return {
+        {QStringLiteral("samples"), window.samples},
+        {QStringLiteral("minCn0"), window.minCn0},
+        {QStringLiteral("meanCn0"), window.meanCn0},
+        {QStringLiteral("maxCn0"), window.maxCn0},
+        {QStringLiteral("minElevation"), window.minElevation},
+        {QStringLiteral("meanElevation"), window.meanElevation},
+        {QStringLiteral("maxElevation"), window.maxElevation},
+        {QStringLiteral("usedRatio"), window.samples > 0 ? double(window.usedSamples) / window.samples : 0.0}
+    };
+}
+
+qint64 SatelliteHistoryModel::windowStartMs() const {
+    return m_history.latestTimestampMs() - static_cast<qint64>(m_windowSeconds) * 1000;
+}
+
+void SatelliteHistoryModel::announceRows() {
+    const qsizetype countBefore = m_keys.size();
+    if (m_history.layoutRevision() != m_publishedLayout) {
+        beginResetModel();
+        m_keys = m_history.keys();
+        m_publishedLayout = m_history.layoutRevision();
+        endResetModel();
+    } else if (!m_keys.isEmpty()) {
+        emit dataChanged(index(0), index(static_cast<int>(m_keys.size()) - 1),
+                         {SamplesRole, MinCn0Role, MeanCn0Role, MaxCn0Role, MinElevationRole, MeanElevationRole,
+                          MaxElevationRole, UsedRatioRole, SeriesRole});
+    }
+    ++m_revision;
+    if (m_keys.size() != countBefore) {
+        emit countChanged();
+    }
+    emit revisionChanged();
+}
+
+}  // namespace hdgnss
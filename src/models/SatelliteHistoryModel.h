@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include "src/storage/SatelliteHistory.h"
+
+namespace hdgnss {
+
+// One row per signal kept in a SatelliteHistory, with its C/N0 and elevation
+// aggregates over the last windowSeconds and the C/N0 series for a sparkline,
+// already decimated to at most `points` points. The window ends at the newest
+// sample rather than the wall clock, so a replayed capture reads like a live
+// one. Appends are announced in one batch per publish().
+class SatelliteHistoryModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(int revision READ revision NOTIFY revisionChanged)
+    Q_PROPERTY(int windowSeconds READ windowSeconds WRITE setWindowSeconds NOTIFY windowChanged)
+    Q_PROPERTY(int points READ points WRITE setPoints NOTIFY windowChanged)
+
+public:
+    enum Roles {
+        KeyRole = Qt::UserRole + 1,
+        SamplesRole,
+        MinCn0Role,
+        MeanCn0Role,
+        MaxCn0Role,
+        MinElevationRole,
+        MeanElevationRole,
+        MaxElevationRole,
+        UsedRatioRole,
+        SeriesRole
+    };
+
+    explicit SatelliteHistoryModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    const SatelliteHistory &history() const;
+    void setMemoryBudget(qint64 bytes);
+    void appendEpoch(qint64 timestampMs, const QHash<QString, SatelliteInfo> &satellites);
+    void clear();
+    // Resets the rows if signals came or went, otherwise refreshes every
+    // row's aggregates and series; does nothing if nothing was appended.
+    void publish();
+    int revision() const;
+
+    int windowSeconds() const;
+    void setWindowSeconds(int seconds);
+    int points() const;
+    void setPoints(int points);
+
+    // Points have x from 0 (window start) to 1 (newest sample) and y in dB-Hz.
+    Q_INVOKABLE QVariantList series(const QString &key) const;
+    Q_INVOKABLE QVariantMap stats(const QString &key) const;
+
+signals:
+    void countChanged();
+    void revisionChanged();
+    void windowChanged();
+
+private:
+    qint64 windowStartMs() const;
+    void announceRows();
+
+    SatelliteHistory m_history;
+    QStringList m_keys;
+    quint64 m_publishedLayout = 0;
+    bool m_pending = false;
+    int m_revision = 0;
+    int m_windowSeconds = 300;
+    int m_points = 120;
+};
+
+}  // namespace hdgnss
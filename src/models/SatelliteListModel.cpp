@@ -0,0 +1,155 @@
+#include "SatelliteListModel.h"
+
+#include <utility>
+
+namespace hdgnss {
+
+namespace {
+
+bool sameSatellite(const SatelliteInfo &a, const SatelliteInfo &b) {
+    return a.key == b.key
+        && a.constellation == b.constellation
+        && a.band == b.band
+        && a.signalId == b.signalId
+        && a.svid == b.svid
+        && a.azimuth == b.azimuth
+        && a.elevation == b.elevation
+        && a.cn0 == b.cn0
+        && a.usedInFix == b.usedInFix
+        && a.stale == b.stale;
+}
+
+}  // namespace
+
+SatelliteListModel::SatelliteListModel(QObject *parent)
+    : QAbstractListModel(parent) {}
+
+int SatelliteListModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_satellites.size();
+}
+
+void SatelliteListModel::setSatellites(const QList<SatelliteInfo> &satellites) {
+    QList<const SatelliteInfo *> visible;
+    visible.reserve(satellites.size());
+    for (const SatelliteInfo &sat : satellites) {
+        if (satelliteHasVisibleSignal(sat)) {
+            visible.append(&sat);
+        }
+    }
+    applySatellites(visible);
+}
+
+void SatelliteListModel::setSatellites(const QHash<QString, SatelliteInfo> &satellites) {
+    QList<const SatelliteInfo *> visible;
+    visible.reserve(satellites.size());
+    for (const SatelliteInfo &sat : satellites) {
+        if (satelliteHasVisibleSignal(sat)) {
+            visible.append(&sat);
+        }
+    }
+    applySatellites(visible);
+}
+
+int SatelliteListModel::revision() const {
+    return m_revision;
+}
+
+const SatelliteInfo &SatelliteListModel::satellite(int row) const {
+    return m_satellites.at(row);
+}
+
+void SatelliteListModel::storeRowsRemoved(int first, int last) {
+    Q_UNUSED(first);
+    Q_UNUSED(last);
+}
+
+void SatelliteListModel::storeRowsInserted(int first, int last) {
+    Q_UNUSED(first);
+    Q_UNUSED(last);
+}
+
+void SatelliteListModel::storeRowChanging(int row, const SatelliteInfo &before, const SatelliteInfo &after) {
+    Q_UNUSED(row);
+    Q_UNUSED(before);
+    Q_UNUSED(after);
+}
+
+void SatelliteListModel::applySatellites(const QList<const SatelliteInfo *> &visible) {
+    // A key listed twice keeps its last state.
+    QHash<QString, const SatelliteInfo *> incoming;
+    incoming.reserve(visible.size());
+    for (const SatelliteInfo *sat : visible) {
+        incoming.insert(sat->key, sat);
+    }
+    const qsizetype countBefore = m_satellites.size();
+    bool changed = false;
+
+    // Vanished keys leave in contiguous runs, walking back so the rows not
+    // yet visited keep their numbers.
+    for (int last = static_cast<int>(m_satellites.size()) - 1; last >= 0;) {
+        if (incoming.contains(m_satellites.at(last).key)) {
+            --last;
+            continue;
+        }
+        int first = last;
+        while (first > 0 && !incoming.contains(m_satellites.at(first - 1).key)) {
+            --first;
+        }
+        beginRemoveRows({}, first, last);
+        m_satellites.remove(first, last - first + 1);
+        storeRowsRemoved(first, last);
+        endRemoveRows();
+        changed = true;
+        last = first - 1;
+    }
+
+    for (int row = 0; row < m_satellites.size(); ++row) {
+        SatelliteInfo &current = m_satellites[row];
+        const SatelliteInfo *incomingSat = incoming.take(current.key);
+        if (sameSatellite(current, *incomingSat)) {
+            continue;
+        }
+        SatelliteInfo next = *incomingSat;
+        if (next.signalGroup == SignalGroup::Unresolved) {
+            resolveSignalGroup(next);
+        }
+        const QList<int> roles = changedRoles(current, next);
+        storeRowChanging(row, current, next);
+        current = std::move(next);
+        changed = true;
+        if (!roles.isEmpty()) {
+            emit dataChanged(index(row), index(row), roles);
+        }
+    }
+
+    // What is left in incoming is new; it is appended in the caller's order.
+    QList<SatelliteInfo> added;
+    for (const SatelliteInfo *sat : visible) {
+        const auto it = incoming.constFind(sat->key);
+        if (it != incoming.cend() && it.value() == sat) {
+            added.append(*sat);
+            if (added.last().signalGroup == SignalGroup::Unresolved) {
+                resolveSignalGroup(added.last());
+            }
+        }
+    }
+    if (!added.isEmpty()) {
+        const int first = static_cast<int>(m_satellites.size());
+        beginInsertRows({}, first, first + static_cast<int>(added.size()) - 1);
+        m_satellites.append(added);
+        storeRowsInserted(first, static_cast<int>(m_satellites.size()) - 1);
+        endInsertRows();
+        changed = true;
+    }
+
+    if (!changed) {
+        return;
+    }
+    ++m_revision;
+    if (m_satellites.size() != countBefore) {
+        emit countChanged();
+    }
+    emit revisionChanged();
+}
+
+}  // namespace hdgnss
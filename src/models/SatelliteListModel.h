@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// Shared row store of SatelliteModel and SignalModel. Each update is applied
+// as a keyed diff against the rows already shown: a satellite keeps its row
+// for as long as it stays visible, vanished keys are removed, new keys are
+// appended, and changed rows report only the roles that changed, so the
+// delegates of a sky plot or signal chart survive across UI ticks. An update
+// that changes nothing emits nothing. Stored rows always carry a resolved
+// SignalGroup, so data() never classifies bands.
+class SatelliteListModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(int revision READ revision NOTIFY revisionChanged)
+
+public:
+    explicit SatelliteListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    // Satellites without a visible signal are left out.
+    void setSatellites(const QList<SatelliteInfo> &satellites);
+    void setSatellites(const QHash<QString, SatelliteInfo> &satellites);
+    // Bumped once per update that changed any row.
+    int revision() const;
+    // The row's stored state, with its SignalGroup resolved.
+    const SatelliteInfo &satellite(int row) const;
+
+signals:
+    void countChanged();
+    void revisionChanged();
+
+protected:
+    // Roles whose value differs between two states of the same satellite.
+    virtual QList<int> changedRoles(const SatelliteInfo &before, const SatelliteInfo &after) const = 0;
+    // Called as the keyed diff edits m_satellites, before the matching
+    // endRemoveRows(), endInsertRows() or dataChanged(), so an index kept
+    // by a derived model is current when views react to the change.
+    virtual void storeRowsRemoved(int first, int last);
+    virtual void storeRowsInserted(int first, int last);
+    // Called while the row still holds before.
+    virtual void storeRowChanging(int row, const SatelliteInfo &before, const SatelliteInfo &after);
+
+    QList<SatelliteInfo> m_satellites;
+
+private:
+    void applySatellites(const QList<const SatelliteInfo *> &visible);
+
+    int m_revision = 0;
+};
+
+}  // namespace hdgnss
@@ -3,11 +3,7 @@
 namespace hdgnss {
 
 SatelliteModel::SatelliteModel(QObject *parent)
-    : QAbstractListModel(parent) {}
-
-int SatelliteModel::rowCount(const QModelIndex &parent) const {
-    return parent.isValid() ? 0 : m_satellites.size();
-}
+    : SatelliteListModel(parent) {}
 
 QVariant SatelliteModel::data(const QModelIndex &index, int role) const {
     if (!index.isValid() || index.row() < 0 || index.row() >= m_satellites.size()) {
@@ -24,7 +20,8 @@ QVariant SatelliteModel::data(const QModelIndex &index, int role) const {
     case Cn0Role: return sat.cn0;
     case UsedRole: return sat.usedInFix;
     case UsedAliasRole: return sat.usedInFix;
-    case BandGroupRole: return satelliteSignalGroup(sat);
+    case BandGroupRole: return signalGroupName(sat.signalGroup);
+    case StaleRole: return sat.stale;
     default: return {};
     }
 }
@@ -40,7 +37,8 @@ QHash<int, QByteArray> SatelliteModel::roleNames() const {
         {Cn0Role, "cn0"},
         {UsedRole, "usedInFix"},
         {UsedAliasRole, "used"},
-        {BandGroupRole, "bandGroup"}
+        {BandGroupRole, "bandGroup"},
+        {StaleRole, "stale"}
     };
 }
 
@@ -59,27 +57,41 @@ QVariantMap SatelliteModel::get(int row) const {
         {QStringLiteral("elevation"), sat.elevation},
         {QStringLiteral("cn0"), sat.cn0},
         {QStringLiteral("usedInFix"), sat.usedInFix},
-        {QStringLiteral("bandGroup"), satelliteSignalGroup(sat)}
+        {QStringLiteral("bandGroup"), signalGroupName(sat.signalGroup)},
+        {QStringLiteral("stale"), sat.stale}
     };
 }
 
-void SatelliteModel::setSatellites(const QList<SatelliteInfo> &satellites) {
-    beginResetModel();
-    m_satellites.clear();
-    m_satellites.reserve(satellites.size());
-    for (const SatelliteInfo &sat : satellites) {
-        if (satelliteHasVisibleSignal(sat)) {
-            m_satellites.append(sat);
-        }
+QList<int> SatelliteModel::changedRoles(const SatelliteInfo &before, const SatelliteInfo &after) const {
+    QList<int> roles;
+    if (before.constellation != after.constellation) {
+        roles << ConstellationRole;
     }
-    endResetModel();
-    ++m_revision;
-    emit countChanged();
-    emit revisionChanged();
-}
-
-int SatelliteModel::revision() const {
-    return m_revision;
+    if (before.band != after.band) {
+        roles << BandRole;
+    }
+    if (before.signalGroup != after.signalGroup) {
+        roles << BandGroupRole;
+    }
+    if (before.svid != after.svid) {
+        roles << SvidRole;
+    }
+    if (before.azimuth != after.azimuth) {
+        roles << AzimuthRole;
+    }
+    if (before.elevation != after.elevation) {
+        roles << ElevationRole;
+    }
+    if (before.cn0 != after.cn0) {
+        roles << Cn0Role;
+    }
+    if (before.usedInFix != after.usedInFix) {
+        roles << UsedRole << UsedAliasRole;
+    }
+    if (before.stale != after.stale) {
+        roles << StaleRole;
+    }
+    return roles;
 }
 
 }  // namespace hdgnss
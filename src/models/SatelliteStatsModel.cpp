@@ -0,0 +1,195 @@
+#include "SatelliteStatsModel.h"
+
+#include <utility>
+
+namespace hdgnss {
+
+namespace {
+
+const QString kAllRow = QStringLiteral("ALL");
+const QString kOtherRow = QStringLiteral("OTHER");
+
+bool isNamedConstellation(const QString &constellation) {
+    return constellation == QStringLiteral("GPS")
+        || constellation == QStringLiteral("GLONASS")
+        || constellation == QStringLiteral("BEIDOU")
+        || constellation == QStringLiteral("GALILEO");
+}
+
+}  // namespace
+
+SatelliteStatsModel::SatelliteStatsModel(QObject *parent)
+    : QAbstractListModel(parent) {
+    resetRows();
+}
+
+int SatelliteStatsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant SatelliteStatsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size()) {
+        return {};
+    }
+    const Row &row = m_rows.at(index.row());
+    switch (role) {
+    case NameRole: return row.name;
+    case KindRole: return row.kind;
+    case VisibleSignalsRole: return row.counts.visibleSignals;
+    case UsedSignalsRole: return row.counts.usedSignals;
+    case VisibleSatellitesRole: return row.counts.visibleSatellites;
+    case UsedSatellitesRole: return row.counts.usedSatellites;
+    default: return {};
+    }
+}
+
+QHash<int, QByteArray> SatelliteStatsModel::roleNames() const {
+    return {
+        {NameRole, "name"},
+        {KindRole, "kind"},
+        {VisibleSignalsRole, "visibleSignals"},
+        {UsedSignalsRole, "usedSignals"},
+        {VisibleSatellitesRole, "visibleSatellites"},
+        {UsedSatellitesRole, "usedSatellites"}
+    };
+}
+
+void SatelliteStatsModel::addSatellite(const SatelliteInfo &sat) {
+    applySatellite(sat, 1);
+}
+
+void SatelliteStatsModel::removeSatellite(const SatelliteInfo &sat) {
+    applySatellite(sat, -1);
+}
+
+void SatelliteStatsModel::clear() {
+    beginResetModel();
+    resetRows();
+    endResetModel();
+    m_clearedSincePublish = true;
+    ++m_revision;
+    emit revisionChanged();
+}
+
+bool SatelliteStatsModel::publish() {
+    bool changed = std::exchange(m_clearedSincePublish, false);
+    for (int index = 0; index < m_rows.size(); ++index) {
+        Row &row = m_rows[index];
+        if (row.counts == row.published) {
+            continue;
+        }
+        row.published = row.counts;
+        changed = true;
+        emit dataChanged(this->index(index), this->index(index),
+                         {VisibleSignalsRole, UsedSignalsRole, VisibleSatellitesRole, UsedSatellitesRole});
+    }
+    if (changed) {
+        ++m_revision;
+        emit revisionChanged();
+    }
+    return changed;
+}
+
+int SatelliteStatsModel::revision() const {
+    return m_revision;
+}
+
+int SatelliteStatsModel::visibleSignals(const QString &name) const {
+    const Row *found = row(name);
+    return found ? found->counts.visibleSignals : 0;
+}
+
+int SatelliteStatsModel::usedSignals(const QString &name) const {
+    const Row *found = row(name);
+    return found ? found->counts.usedSignals : 0;
+}
+
+int SatelliteStatsModel::visibleSatellites(const QString &name) const {
+    const Row *found = row(name);
+    return found ? found->counts.visibleSatellites : 0;
+}
+
+int SatelliteStatsModel::usedSatellites(const QString &name) const {
+    const Row *found = row(name);
+    return found ? found->counts.usedSatellites : 0;
+}
+
+QString SatelliteStatsModel::usageText(const QString &name) const {
+    const Row *found = row(name);
+    return QStringLiteral("%1 / %2")
+        .arg(found ? found->counts.usedSatellites : 0)
+        .arg(found ? found->counts.visibleSatellites : 0);
+}
+
+void SatelliteStatsModel::resetRows() {
+    m_rows.clear();
+    m_rowByName.clear();
+    appendRow(kAllRow, QStringLiteral("total"));
+    appendRow(kOtherRow, QStringLiteral("total"));
+    m_firstGroupRow = static_cast<int>(m_rows.size());
+    for (int group = static_cast<int>(SignalGroup::Unknown); group < static_cast<int>(SignalGroup::Count); ++group) {
+        appendRow(signalGroupName(static_cast<SignalGroup>(group)), QStringLiteral("band"));
+    }
+}
+
+void SatelliteStatsModel::appendRow(const QString &name, const QString &kind, bool countsAsOther) {
+    Row row;
+    row.name = name;
+    row.kind = kind;
+    row.countsAsOther = countsAsOther;
+    m_rowByName.insert(name, static_cast<int>(m_rows.size()));
+    m_rows.append(row);
+}
+
+int SatelliteStatsModel::constellationRow(const QString &constellation) {
+    const auto it = m_rowByName.constFind(constellation);
+    if (it != m_rowByName.cend()) {
+        return it.value();
+    }
+    const int index = static_cast<int>(m_rows.size());
+    beginInsertRows({}, index, index);
+    appendRow(constellation, QStringLiteral("constellation"), !isNamedConstellation(constellation));
+    endInsertRows();
+    return index;
+}
+
+void SatelliteStatsModel::applySatellite(const SatelliteInfo &sat, int delta) {
+    if (!satelliteHasLiveSignal(sat)) {
+        return;
+    }
+    const int constellation = constellationRow(sat.constellation);
+    const quint64 satelliteId = (static_cast<quint64>(constellation) << 32) | static_cast<quint32>(sat.svid);
+    const int group = m_firstGroupRow + static_cast<int>(resolvedSignalGroup(sat))
+        - static_cast<int>(SignalGroup::Unknown);
+
+    adjust(m_rows[0], satelliteId, sat.usedInFix, delta);
+    adjust(m_rows[constellation], satelliteId, sat.usedInFix, delta);
+    if (m_rows.at(constellation).countsAsOther) {
+        adjust(m_rows[1], satelliteId, sat.usedInFix, delta);
+    }
+    adjust(m_rows[group], satelliteId, sat.usedInFix, delta);
+}
+
+void SatelliteStatsModel::adjust(Row &row, quint64 satelliteId, bool used, int delta) {
+    SignalCounts &counts = row.satellites[satelliteId];
+    const bool wasVisible = counts.visible > 0;
+    const bool wasUsed = counts.used > 0;
+    counts.visible += delta;
+    row.counts.visibleSignals += delta;
+    if (used) {
+        counts.used += delta;
+        row.counts.usedSignals += delta;
+    }
+    row.counts.visibleSatellites += int(counts.visible > 0) - int(wasVisible);
+    row.counts.usedSatellites += int(counts.used > 0) - int(wasUsed);
+    if (counts.visible <= 0) {
+        row.satellites.remove(satelliteId);
+    }
+}
+
+const SatelliteStatsModel::Row *SatelliteStatsModel::row(const QString &name) const {
+    const auto it = m_rowByName.constFind(name);
+    return it != m_rowByName.cend() ? &m_rows.at(it.value()) : nullptr;
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// Used and visible counts per constellation and signal group, kept current
+// one signal at a time as satellites are ingested instead of being recounted
+// on every read. Rows are ALL, OTHER (anything but GPS, GLONASS, BEIDOU and
+// GALILEO), one per signal group and one per constellation seen since the
+// last clear. Only live signals (a visible C/N0 and not stale) count;
+// satellite counts are distinct constellation/SVID pairs. Counters change
+// immediately; publish() announces the rows whose counts differ, once per UI
+// refresh.
+class SatelliteStatsModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int revision READ revision NOTIFY revisionChanged)
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        KindRole,
+        VisibleSignalsRole,
+        UsedSignalsRole,
+        VisibleSatellitesRole,
+        UsedSatellitesRole
+    };
+
+    explicit SatelliteStatsModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // A satellite must be removed with the exact state it was added with.
+    void addSatellite(const SatelliteInfo &sat);
+    void removeSatellite(const SatelliteInfo &sat);
+    void clear();
+    // Emits dataChanged for rows whose counts differ from the last call.
+    // Returns whether any did or the model was cleared in between.
+    bool publish();
+    int revision() const;
+
+    // Unknown names count as zero.
+    Q_INVOKABLE int visibleSignals(const QString &name) const;
+    Q_INVOKABLE int usedSignals(const QString &name) const;
+    Q_INVOKABLE int visibleSatellites(const QString &name) const;
+    Q_INVOKABLE int usedSatellites(const QString &name) const;
+    // "used / visible" satellites.
+    QString usageText(const QString &name) const;
+
+signals:
+    void revisionChanged();
+
+private:
+    struct SignalCounts {
+        int visible = 0;
+        int used = 0;
+    };
+
+    struct Counts {
+        int visibleSignals = 0;
+        int usedSignals = 0;
+        int visibleSatellites = 0;
+        int usedSatellites = 0;
+
+        bool operator==(const Counts &) const = default;
+    };
+
+    struct Row {
+        QString name;
+        QString kind;
+        Counts counts;
+        // As of the last publish(), so re-ingesting an unchanged satellite
+        // is not announced.
+        Counts published;
+        // Signals per satellite, so distinct counts move only on the first
+        // and last signal of a satellite.
+        QHash<quint64, SignalCounts> satellites;
+        // Set on constellation rows that also count towards OTHER.
+        bool countsAsOther = false;
+    };
+
+    void resetRows();
+    void appendRow(const QString &name, const QString &kind, bool countsAsOther = false);
+    int constellationRow(const QString &constellation);
+    void applySatellite(const SatelliteInfo &sat, int delta);
+    static void adjust(Row &row, quint64 satelliteId, bool used, int delta);
+    const Row *row(const QString &name) const;
+
+    QList<Row> m_rows;
+    QHash<QString, int> m_rowByName;
+    int m_firstGroupRow = 0;
+    bool m_clearedSincePublish = false;
+    int m_revision = 0;
+};
+
+}  // namespace hdgnss
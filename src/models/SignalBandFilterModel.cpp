@@ -0,0 +1,118 @@
+#include "SignalBandFilterModel.h"
+
+namespace hdgnss {
+
+SignalBandFilterModel::SignalBandFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent) {
+    // Only a dataChanged naming the label can reorder rows; C/N0, used and
+    // stale updates leave every row where it is.
+    setSortRole(SignalModel::LabelRole);
+    connect(this, &QAbstractItemModel::rowsInserted, this, &SignalBandFilterModel::updateSummary);
+    connect(this, &QAbstractItemModel::rowsRemoved, this, &SignalBandFilterModel::updateSummary);
+    connect(this, &QAbstractItemModel::modelReset, this, &SignalBandFilterModel::updateSummary);
+    connect(this, &QAbstractItemModel::layoutChanged, this, &SignalBandFilterModel::updateSummary);
+    connect(this, &QAbstractItemModel::dataChanged, this, &SignalBandFilterModel::updateSummary);
+}
+
+void SignalBandFilterModel::setSourceModel(QAbstractItemModel *model) {
+    QSortFilterProxyModel::setSourceModel(qobject_cast<SignalModel *>(model));
+    sort(0);
+}
+
+QString SignalBandFilterModel::band() const {
+    return m_band;
+}
+
+void SignalBandFilterModel::setBand(const QString &band) {
+    if (m_band == band) {
+        return;
+    }
+    m_band = band;
+    m_groups = signalTabGroups(band);
+    invalidateFilter();
+    emit bandChanged();
+}
+
+int SignalBandFilterModel::count() const {
+    return m_count;
+}
+
+int SignalBandFilterModel::usedCount() const {
+    return m_usedCount;
+}
+
+int SignalBandFilterModel::peakStrength() const {
+    return m_peakStrength;
+}
+
+QString SignalBandFilterModel::peakLabel() const {
+    return m_peakLabel;
+}
+
+int SignalBandFilterModel::constellationOrder(const QString &constellation) {
+    if (constellation == QStringLiteral("GPS")) return 0;
+    if (constellation == QStringLiteral("GLONASS")) return 1;
+    if (constellation == QStringLiteral("GALILEO")) return 2;
+    if (constellation == QStringLiteral("BEIDOU")) return 3;
+    if (constellation == QStringLiteral("QZSS")) return 4;
+    if (constellation == QStringLiteral("SBAS")) return 5;
+    if (constellation == QStringLiteral("NAVIC") || constellation == QStringLiteral("IRNSS")) return 6;
+    return 9;
+}
+
+bool SignalBandFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+    const SignalModel *source = signalSource();
+    if (sourceParent.isValid() || !source) {
+        return false;
+    }
+    return (m_groups & signalGroupBit(source->satellite(sourceRow).signalGroup)) != 0;
+}
+
+bool SignalBandFilterModel::lessThan(const QModelIndex &left, const QModelIndex &right) const {
+    const SatelliteInfo &a = signalSource()->satellite(left.row());
+    const SatelliteInfo &b = signalSource()->satellite(right.row());
+    const int orderDiff = constellationOrder(a.constellation) - constellationOrder(b.constellation);
+    if (orderDiff != 0) {
+        return orderDiff < 0;
+    }
+    const int labelDiff = QString::compare(left.data(SignalModel::LabelRole).toString(),
+                                           right.data(SignalModel::LabelRole).toString());
+    if (labelDiff != 0) {
+        return labelDiff < 0;
+    }
+    // Signals of one satellite share a label; keep them in a fixed order.
+    return a.key < b.key;
+}
+
+const SignalModel *SignalBandFilterModel::signalSource() const {
+    return static_cast<const SignalModel *>(sourceModel());
+}
+
+void SignalBandFilterModel::updateSummary() {
+    int used = 0;
+    int peak = 0;
+    QString peakLabel = QStringLiteral("--");
+    const int rows = rowCount();
+    for (int row = 0; row < rows; ++row) {
+        const SatelliteInfo &sat = signalSource()->satellite(mapToSource(index(row, 0)).row());
+        used += sat.usedInFix ? 1 : 0;
+        if (row == 0 || sat.cn0 > peak) {
+            peak = sat.cn0;
+            peakLabel = index(row, 0).data(SignalModel::LabelRole).toString();
+        }
+    }
+    const bool countDiffers = rows != m_count;
+    const bool summaryDiffers = used != m_usedCount || peak != m_peakStrength || peakLabel != m_peakLabel;
+    m_count = rows;
+    m_usedCount = used;
+    m_peakStrength = peak;
+    m_peakLabel = peakLabel;
+    if (countDiffers) {
+        emit countChanged();
+    }
+    if (summaryDiffers) {
+        emit summaryChanged();
+    }
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QSortFilterProxyModel>
+#include <QString>
+
+#include "src/models/SignalModel.h"
+
+namespace hdgnss {
+
+// The rows of a SignalModel (the sourceModel) shown on one signal tab, ordered
+// by constellation and label, for the signal bar chart. Rows are matched on
+// their stored SignalGroup, and the source's inserts, removes and dataChanged
+// pass through as the same operations on the matching rows: a C/N0 update
+// reaches a bar delegate as a dataChanged and never recreates it. The tab's
+// channel count, used count and strongest signal are kept here so the chart
+// does not walk the rows in JavaScript.
+class SignalBandFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+    // A signal tab name as accepted by signalTabGroups().
+    Q_PROPERTY(QString band READ band WRITE setBand NOTIFY bandChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int usedCount READ usedCount NOTIFY summaryChanged)
+    Q_PROPERTY(int peakStrength READ peakStrength NOTIFY summaryChanged)
+    Q_PROPERTY(QString peakLabel READ peakLabel NOTIFY summaryChanged)
+
+public:
+    explicit SignalBandFilterModel(QObject *parent = nullptr);
+
+    // Anything but a SignalModel leaves the view empty.
+    void setSourceModel(QAbstractItemModel *model) override;
+    QString band() const;
+    void setBand(const QString &band);
+
+    int count() const;
+    int usedCount() const;
+    // Highest C/N0 on the tab, 0 when it is empty.
+    int peakStrength() const;
+    // Label of the first row with peakStrength(), "--" when the tab is empty.
+    QString peakLabel() const;
+
+    // Rank of a constellation in the chart, GPS first.
+    static int constellationOrder(const QString &constellation);
+
+signals:
+    void bandChanged();
+    void countChanged();
+    void summaryChanged();
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    const SignalModel *signalSource() const;
+    void updateSummary();
+
+    QString m_band;
+    quint32 m_groups = 0;
+    int m_count = 0;
+    int m_usedCount = 0;
+    int m_peakStrength = 0;
+    QString m_peakLabel = QStringLiteral("--");
+};
+
+}  // namespace hdgnss
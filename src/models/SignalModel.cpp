@@ -1,5 +1,7 @@
 #include "SignalModel.h"
 
+#include <algorithm>
+
 namespace hdgnss {
 
 namespace {
@@ -24,11 +26,7 @@ QString satelliteLabel(const SatelliteInfo &sat) {
 }  // namespace
 
 SignalModel::SignalModel(QObject *parent)
-    : QAbstractListModel(parent) {}
-
-int SignalModel::rowCount(const QModelIndex &parent) const {
-    return parent.isValid() ? 0 : m_satellites.size();
-}
+    : SatelliteListModel(parent) {}
 
 QVariant SignalModel::data(const QModelIndex &index, int role) const {
     if (!index.isValid() || index.row() < 0 || index.row() >= m_satellites.size()) {
@@ -44,7 +42,9 @@ QVariant SignalModel::data(const QModelIndex &index, int role) const {
     case Cn0Role: return sat.cn0;
     case StrengthRole: return sat.cn0;
     case UsedRole: return sat.usedInFix;
-    case BandGroupRole: return satelliteSignalGroup(sat);
+    case BandGroupRole: return signalGroupName(sat.signalGroup);
+    case StaleRole: return sat.stale;
+    case KeyRole: return sat.key;
     default: return {};
     }
 }
@@ -59,47 +59,123 @@ QHash<int, QByteArray> SignalModel::roleNames() const {
         {Cn0Role, "cn0"},
         {StrengthRole, "strength"},
         {UsedRole, "usedInFix"},
-        {BandGroupRole, "bandGroup"}
+        {BandGroupRole, "bandGroup"},
+        {StaleRole, "stale"},
+        {KeyRole, "key"}
     };
 }
 
 QVariantList SignalModel::itemsForBand(const QString &band) const {
+    const quint32 groups = signalTabGroups(band);
+    qsizetype total = 0;
+    for (int group = 0; group < static_cast<int>(m_groupRows.size()); ++group) {
+        if (groups & signalGroupBit(static_cast<SignalGroup>(group))) {
+            total += m_groupRows[group].size();
+        }
+    }
+
     QVariantList items;
-    for (const SatelliteInfo &sat : m_satellites) {
-        if (!satelliteHasVisibleSignal(sat) || !satelliteMatchesSignalTab(sat, band)) {
-            continue;
+    items.reserve(total);
+    // Tabs spanning several groups still list their rows in model order:
+    // the groups' ascending lists are merged by taking the lowest head.
+    std::array<qsizetype, static_cast<int>(SignalGroup::Count)> next{};
+    for (;;) {
+        int lowest = -1;
+        for (int group = 0; group < static_cast<int>(m_groupRows.size()); ++group) {
+            if (!(groups & signalGroupBit(static_cast<SignalGroup>(group)))
+                || next[group] == m_groupRows[group].size()) {
+                continue;
+            }
+            if (lowest < 0 || m_groupRows[group].at(next[group]) < m_groupRows[lowest].at(next[lowest])) {
+                lowest = group;
+            }
         }
+        if (lowest < 0) {
+            break;
+        }
+        const SatelliteInfo &sat = m_satellites.at(m_groupRows[lowest].at(next[lowest]++));
         items.append(QVariantMap{
+            {QStringLiteral("key"), sat.key},
             {QStringLiteral("label"), satelliteLabel(sat)},
             {QStringLiteral("constellation"), sat.constellation},
             {QStringLiteral("band"), sat.band},
-            {QStringLiteral("bandGroup"), satelliteSignalGroup(sat)},
+            {QStringLiteral("bandGroup"), signalGroupName(sat.signalGroup)},
             {QStringLiteral("signalId"), sat.signalId},
             {QStringLiteral("svid"), sat.svid},
             {QStringLiteral("strength"), sat.cn0},
-            {QStringLiteral("usedInFix"), sat.usedInFix}
+            {QStringLiteral("usedInFix"), sat.usedInFix},
+            {QStringLiteral("stale"), sat.stale}
         });
     }
     return items;
 }
 
-void SignalModel::setSatellites(const QList<SatelliteInfo> &satellites) {
-    beginResetModel();
-    m_satellites.clear();
-    m_satellites.reserve(satellites.size());
-    for (const SatelliteInfo &sat : satellites) {
-        if (satelliteHasVisibleSignal(sat)) {
-            m_satellites.append(sat);
+QList<int> SignalModel::changedRoles(const SatelliteInfo &before, const SatelliteInfo &after) const {
+    QList<int> roles;
+    if (before.constellation != after.constellation || before.svid != after.svid) {
+        roles << LabelRole;
+    }
+    if (before.band != after.band) {
+        roles << BandRole;
+    }
+    if (before.constellation != after.constellation) {
+        roles << ConstellationRole;
+    }
+    if (before.signalGroup != after.signalGroup) {
+        roles << BandGroupRole;
+    }
+    if (before.signalId != after.signalId) {
+        roles << SignalIdRole;
+    }
+    if (before.svid != after.svid) {
+        roles << SvidRole;
+    }
+    if (before.cn0 != after.cn0) {
+        roles << Cn0Role << StrengthRole;
+    }
+    if (before.usedInFix != after.usedInFix) {
+        roles << UsedRole;
+    }
+    if (before.stale != after.stale) {
+        roles << StaleRole;
+    }
+    return roles;
+}
+
+void SignalModel::storeRowsRemoved(int first, int last) {
+    const int count = last - first + 1;
+    for (QList<int> &rows : m_groupRows) {
+        const auto begin = std::lower_bound(rows.begin(), rows.end(), first);
+        const auto end = std::lower_bound(begin, rows.end(), last + 1);
+        for (auto it = end; it != rows.end(); ++it) {
+            *it -= count;
         }
+        rows.erase(begin, end);
     }
-    endResetModel();
-    ++m_revision;
-    emit countChanged();
-    emit revisionChanged();
 }
 
-int SignalModel::revision() const {
-    return m_revision;
+void SignalModel::storeRowsInserted(int first, int last) {
+    const int count = last - first + 1;
+    for (QList<int> &rows : m_groupRows) {
+        for (auto it = std::lower_bound(rows.begin(), rows.end(), first); it != rows.end(); ++it) {
+            *it += count;
+        }
+    }
+    // Inserted rows are appended by the keyed diff, so this is a push_back.
+    for (int row = first; row <= last; ++row) {
+        QList<int> &rows = m_groupRows[static_cast<int>(m_satellites.at(row).signalGroup)];
+        rows.insert(std::lower_bound(rows.begin(), rows.end(), row), row);
+    }
+}
+
+void SignalModel::storeRowChanging(int row, const SatelliteInfo &before, const SatelliteInfo &after) {
+    if (before.signalGroup == after.signalGroup) {
+        return;
+    }
+    QList<int> &from = m_groupRows[static_cast<int>(before.signalGroup)];
+    from.erase(std::lower_bound(from.begin(), from.end(), row));
+    QList<int> &to = m_groupRows[static_cast<int>(after.signalGroup)];
+    to.insert(std::lower_bound(to.begin(), to.end(), row), row);
 }
 
 }  // namespace hdgnss
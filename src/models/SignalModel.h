@@ -1,15 +1,13 @@
 #pragma once
 
-#include <QAbstractListModel>
+#include <array>
 
-#include "src/protocols/GnssTypes.h"
+#include "src/models/SatelliteListModel.h"
 
 namespace hdgnss {
 
-class SignalModel : public QAbstractListModel {
+class SignalModel : public SatelliteListModel {
     Q_OBJECT
-    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
-    Q_PROPERTY(int revision READ revision NOTIFY revisionChanged)
 
 public:
     enum Roles {
@@ -21,26 +19,28 @@ public:
         Cn0Role,
         StrengthRole,
         UsedRole,
-        BandGroupRole
+        BandGroupRole,
+        StaleRole,
+        KeyRole
     };
 
     explicit SignalModel(QObject *parent = nullptr);
 
-    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    // Walks only the rows of the tab's signal groups.
     Q_INVOKABLE QVariantList itemsForBand(const QString &band) const;
-    void setSatellites(const QList<SatelliteInfo> &satellites);
-    int revision() const;
 
-signals:
-    void countChanged();
-    void revisionChanged();
+protected:
+    QList<int> changedRoles(const SatelliteInfo &before, const SatelliteInfo &after) const override;
+    void storeRowsRemoved(int first, int last) override;
+    void storeRowsInserted(int first, int last) override;
+    void storeRowChanging(int row, const SatelliteInfo &before, const SatelliteInfo &after) override;
 
 private:
-    QList<SatelliteInfo> m_satellites;
-    int m_revision = 0;
+    // Ascending rows per SignalGroup, kept in step with every row edit.
+    std::array<QList<int>, static_cast<int>(SignalGroup::Count)> m_groupRows;
 };
 
 }  // namespace hdgnss
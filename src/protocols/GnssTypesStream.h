@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QDataStream>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// QDataStream forms of the shared GNSS types, used by receiver keyframes.
+// Field order is part of the keyframe format; append new fields at the end
+// and bump the keyframe version.
+
+inline QDataStream &operator<<(QDataStream &stream, const SatelliteInfo &sat) {
+    return stream << sat.key << sat.constellation << sat.band << qint32(sat.signalId) << qint32(sat.svid)
+                  << qint32(sat.azimuth) << qint32(sat.elevation) << qint32(sat.cn0) << sat.usedInFix;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, SatelliteInfo &sat) {
+    qint32 signalId = 0;
+    qint32 svid = 0;
+    qint32 azimuth = 0;
+    qint32 elevation = 0;
+    qint32 cn0 = 0;
+    stream >> sat.key >> sat.constellation >> sat.band >> signalId >> svid >> azimuth >> elevation >> cn0
+        >> sat.usedInFix;
+    sat.signalId = signalId;
+    sat.svid = svid;
+    sat.azimuth = azimuth;
+    sat.elevation = elevation;
+    sat.cn0 = cn0;
+    resolveSignalGroup(sat);
+    return stream;
+}
+
+inline QDataStream &operator<<(QDataStream &stream, const GnssLocation &location) {
+    stream << location.validFix << location.utcTime;
+    for (const double value : {location.latitude, location.longitude, location.altitudeMeters,
+                               location.undulationMeters, location.speedMps, location.courseDegrees,
+                               location.magneticVariationDegrees, location.differentialAgeSeconds,
+                               location.hdop, location.vdop, location.pdop, location.gstRms,
+                               location.latitudeSigma, location.longitudeSigma, location.altitudeSigma}) {
+        stream << value;
+    }
+    return stream << location.fixType << location.mode << location.status << qint32(location.quality)
+                  << qint32(location.satellitesUsed) << qint32(location.satellitesInView);
+}
+
+inline QDataStream &operator>>(QDataStream &stream, GnssLocation &location) {
+    stream >> location.validFix >> location.utcTime;
+    for (double *value : {&location.latitude, &location.longitude, &location.altitudeMeters,
+                          &location.undulationMeters, &location.speedMps, &location.courseDegrees,
+                          &location.magneticVariationDegrees, &location.differentialAgeSeconds,
+                          &location.hdop, &location.vdop, &location.pdop, &location.gstRms,
+                          &location.latitudeSigma, &location.longitudeSigma, &location.altitudeSigma}) {
+        stream >> *value;
+    }
+    qint32 quality = 0;
+    qint32 satellitesUsed = 0;
+    qint32 satellitesInView = 0;
+    stream >> location.fixType >> location.mode >> location.status >> quality >> satellitesUsed >> satellitesInView;
+    location.quality = quality;
+    location.satellitesUsed = satellitesUsed;
+    location.satellitesInView = satellitesInView;
+    return stream;
+}
+
+}  // namespace hdgnss
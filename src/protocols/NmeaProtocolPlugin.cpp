@@ -2,10 +2,13 @@
 
 #include <cmath>
 #include <limits>
+#include <QDataStream>
 #include <QDate>
 #include <QRegularExpression>
 #include <QTimeZone>
 
+#include "src/protocols/GnssTypesStream.h"
+
 namespace hdgnss {
 
 namespace {
@@ -298,6 +301,28 @@ void NmeaProtocolPlugin::resetState() {
     m_updatedGsaSignalsByConstellation.clear();
 }
 
+QByteArray NmeaProtocolPlugin::saveState() const {
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << m_buffer << m_satellites << m_usedSatelliteIdsByConstellation << m_seenGsvSignalsByConstellation
+           << m_updatedGsaSignalsByConstellation;
+    return state;
+}
+
+bool NmeaProtocolPlugin::restoreState(const QByteArray &state) {
+    resetState();
+    QDataStream stream(state);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream >> m_buffer >> m_satellites >> m_usedSatelliteIdsByConstellation >> m_seenGsvSignalsByConstellation
+        >> m_updatedGsaSignalsByConstellation;
+    if (stream.status() != QDataStream::Ok) {
+        resetState();
+        return false;
+    }
+    return true;
+}
+
 quint8 NmeaProtocolPlugin::checksumForBody(const QByteArray &body) {
     quint8 checksum = 0;
     for (const char ch : body) {
@@ -19,6 +19,9 @@ public:
     QList<CommandTemplate> commandTemplates() const override;
     bool supportsFullDecode() const override;
     void resetState();
+    // Partial sentence and GSV/GSA bookkeeping, for receiver keyframes.
+    QByteArray saveState() const;
+    bool restoreState(const QByteArray &state);
 
     static bool validateChecksum(const QByteArray &sentence);
     static quint8 checksumForBody(const QByteArray &body);
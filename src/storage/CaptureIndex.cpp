@@ -0,0 +1,67 @@
+#include "CaptureIndex.h"
+
+#include <algorithm>
+
+#include <QtEndian>
+
+namespace hdgnss {
+
+namespace {
+
+constexpr quint32 kFlagTx = 0x1;
+
+}  // namespace
+
+QString CaptureIndex::indexPathForCapture(const QString &capturePath) {
+    static const QString kBinarySuffix = QStringLiteral(".raw.bin");
+    if (capturePath.endsWith(kBinarySuffix, Qt::CaseInsensitive)) {
+        return capturePath.left(capturePath.size() - kBinarySuffix.size()) + QStringLiteral(".raw.idx");
+    }
+    return capturePath + QStringLiteral(".idx");
+}
+
+void CaptureIndex::appendRecord(QByteArray &out, const CaptureIndexRecord &record) {
+    uchar encoded[kRecordSize];
+    qToLittleEndian<qint64>(record.offset, encoded);
+    qToLittleEndian<qint64>(record.timestampMs, encoded + 8);
+    qToLittleEndian<quint32>(record.length, encoded + 16);
+    qToLittleEndian<quint32>(record.direction == DataDirection::Tx ? kFlagTx : 0u, encoded + 20);
+    out.append(reinterpret_cast<const char *>(encoded), kRecordSize);
+}
+
+QList<CaptureIndexRecord> CaptureIndex::parse(const uchar *data, qint64 size) {
+    QList<CaptureIndexRecord> records;
+    if (!data || size < kRecordSize) {
+        return records;
+    }
+    const qint64 count = size / kRecordSize;
+    records.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        const uchar *encoded = data + i * kRecordSize;
+        CaptureIndexRecord record;
+        record.offset = qFromLittleEndian<qint64>(encoded);
+        record.timestampMs = qFromLittleEndian<qint64>(encoded + 8);
+        record.length = qFromLittleEndian<quint32>(encoded + 16);
+        record.direction = (qFromLittleEndian<quint32>(encoded + 20) & kFlagTx) ? DataDirection::Tx : DataDirection::Rx;
+        records.append(record);
+    }
+    return records;
+}
+
+qsizetype CaptureIndex::recordAtOffset(const QList<CaptureIndexRecord> &records, qint64 byteOffset) {
+    const auto it = std::upper_bound(records.cbegin(), records.cend(), byteOffset,
+                                     [](qint64 offset, const CaptureIndexRecord &record) {
+                                         return offset < record.offset;
+                                     });
+    return static_cast<qsizetype>(it - records.cbegin()) - 1;
+}
+
+qsizetype CaptureIndex::recordAtTime(const QList<CaptureIndexRecord> &records, qint64 timestampMs) {
+    const auto it = std::lower_bound(records.cbegin(), records.cend(), timestampMs,
+                                     [](const CaptureIndexRecord &record, qint64 value) {
+                                         return record.timestampMs < value;
+                                     });
+    return static_cast<qsizetype>(it - records.cbegin());
+}
+
+}  // namespace hdgnss
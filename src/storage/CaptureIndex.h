@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+struct CaptureIndexRecord {
+    qint64 offset = 0;
+    qint64 timestampMs = 0;
+    quint32 length = 0;
+    DataDirection direction = DataDirection::Rx;
+};
+
+// "<stem>.raw.bin" carries bytes only. RawRecorder writes one fixed-size
+// little-endian record per write into "<stem>.raw.idx" so replay can restore
+// the original timing and seek by time without scanning the capture.
+class CaptureIndex {
+public:
+    static constexpr qsizetype kRecordSize = 24;
+
+    static QString indexPathForCapture(const QString &capturePath);
+    static void appendRecord(QByteArray &out, const CaptureIndexRecord &record);
+    // Trailing partial records (recorder killed mid-write) are ignored.
+    static QList<CaptureIndexRecord> parse(const uchar *data, qint64 size);
+    // Index of the last record whose offset is <= byteOffset, or -1.
+    static qsizetype recordAtOffset(const QList<CaptureIndexRecord> &records, qint64 byteOffset);
+    // Index of the first record whose timestamp is >= timestampMs, or size().
+    static qsizetype recordAtTime(const QList<CaptureIndexRecord> &records, qint64 timestampMs);
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,57 @@
+#include "CaptureKeyframes.h"
+
+#include <algorithm>
+
+#include <QtEndian>
+
+namespace hdgnss {
+
+QString CaptureKeyframes::keyframePathForCapture(const QString &capturePath) {
+    static const QString kBinarySuffix = QStringLiteral(".raw.bin");
+    if (capturePath.endsWith(kBinarySuffix, Qt::CaseInsensitive)) {
+        return capturePath.left(capturePath.size() - kBinarySuffix.size()) + QStringLiteral(".raw.kf");
+    }
+    return capturePath + QStringLiteral(".kf");
+}
+
+void CaptureKeyframes::appendRecord(QByteArray &out, const CaptureKeyframe &keyframe) {
+    uchar header[kHeaderSize];
+    qToLittleEndian<quint32>(static_cast<quint32>(keyframe.state.size()), header);
+    qToLittleEndian<qint64>(keyframe.offset, header + 4);
+    qToLittleEndian<qint64>(keyframe.timestampMs, header + 12);
+    out.append(reinterpret_cast<const char *>(header), kHeaderSize);
+    out.append(keyframe.state);
+}
+
+QList<CaptureKeyframe> CaptureKeyframes::parse(const QByteArray &bytes) {
+    QList<CaptureKeyframe> keyframes;
+    const auto *data = reinterpret_cast<const uchar *>(bytes.constData());
+    qint64 position = 0;
+    while (bytes.size() - position >= kHeaderSize) {
+        const quint32 length = qFromLittleEndian<quint32>(data + position);
+        if (bytes.size() - position - kHeaderSize < static_cast<qint64>(length)) {
+            break;
+        }
+        CaptureKeyframe keyframe;
+        keyframe.offset = qFromLittleEndian<qint64>(data + position + 4);
+        keyframe.timestampMs = qFromLittleEndian<qint64>(data + position + 12);
+        keyframe.state = bytes.mid(position + kHeaderSize, length);
+        position += kHeaderSize + length;
+        // Offsets only grow within a session; anything else is not ours.
+        if (!keyframes.isEmpty() && keyframe.offset < keyframes.constLast().offset) {
+            break;
+        }
+        keyframes.append(std::move(keyframe));
+    }
+    return keyframes;
+}
+
+qsizetype CaptureKeyframes::keyframeAtOffset(const QList<CaptureKeyframe> &keyframes, qint64 byteOffset) {
+    const auto it = std::upper_bound(keyframes.cbegin(), keyframes.cend(), byteOffset,
+                                     [](qint64 offset, const CaptureKeyframe &keyframe) {
+                                         return offset < keyframe.offset;
+                                     });
+    return static_cast<qsizetype>(it - keyframes.cbegin()) - 1;
+}
+
+}  // namespace hdgnss
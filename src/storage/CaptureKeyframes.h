@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+namespace hdgnss {
+
+struct CaptureKeyframe {
+    // Capture offset of the first RX byte not yet reflected in `state`.
+    qint64 offset = 0;
+    qint64 timestampMs = 0;
+    QByteArray state;
+};
+
+// RawRecorder appends a receiver-state keyframe to "<stem>.raw.kf" every
+// kIntervalMs of recording. Each record is a little-endian header (payload
+// length, offset, timestamp) followed by the opaque state AppController
+// produced, so replay can seek to the keyframe before a target and decode only
+// the bytes in between.
+class CaptureKeyframes {
+public:
+    static constexpr qint64 kIntervalMs = 30 * 1000;
+    static constexpr qsizetype kHeaderSize = 20;
+
+    static QString keyframePathForCapture(const QString &capturePath);
+    static void appendRecord(QByteArray &out, const CaptureKeyframe &keyframe);
+    // Stops at the first truncated record (recorder killed mid-write).
+    static QList<CaptureKeyframe> parse(const QByteArray &bytes);
+    // Index of the last keyframe whose offset is <= byteOffset, or -1.
+    static qsizetype keyframeAtOffset(const QList<CaptureKeyframe> &keyframes, qint64 byteOffset);
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,255 @@
+#include "DecodeJsonlExporter.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimeZone>
+
+#include "src/storage/JsonStreamWriter.h"
+
+namespace hdgnss {
+
+namespace {
+
+constexpr qsizetype kWriteChunkBytes = 1024 * 1024;
+
+// Formatting a QDateTime per record dominates small messages, so the
+// "yyyy-MM-ddTHH:mm:ss" prefix is reused for every record in the same second.
+QLatin1StringView formatTimestamp(qint64 timestampMs, char (&out)[32]) {
+    thread_local qint64 cachedSecond = std::numeric_limits<qint64>::min();
+    thread_local QByteArray cachedPrefix;
+
+    qint64 second = timestampMs / 1000;
+    int millis = static_cast<int>(timestampMs % 1000);
+    if (millis < 0) {
+        millis += 1000;
+        --second;
+    }
+    if (second != cachedSecond) {
+        cachedSecond = second;
+        cachedPrefix = QDateTime::fromSecsSinceEpoch(second, QTimeZone::UTC)
+                           .toString(QStringLiteral("yyyy-MM-ddTHH:mm:ss"))
+                           .toLatin1()
+                           .left(sizeof(out) - 5);
+    }
+    const qsizetype prefixSize = cachedPrefix.size();
+    std::memcpy(out, cachedPrefix.constData(), static_cast<size_t>(prefixSize));
+    out[prefixSize] = '.';
+    out[prefixSize + 1] = static_cast<char>('0' + millis / 100);
+    out[prefixSize + 2] = static_cast<char>('0' + (millis / 10) % 10);
+    out[prefixSize + 3] = static_cast<char>('0' + millis % 10);
+    out[prefixSize + 4] = 'Z';
+    return QLatin1StringView(out, prefixSize + 5);
+}
+
+}  // namespace
+
+DecodeJsonlExporter::DecodeJsonlExporter() = default;
+
+DecodeJsonlExporter::~DecodeJsonlExporter() {
+    close();
+}
+
+bool DecodeJsonlExporter::open(const QString &filePath) {
+    close();
+
+    auto file = std::make_shared<QFile>(filePath);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_filePath = filePath;
+        m_enqueued = 0;
+        m_written = 0;
+        m_dropped = 0;
+        m_stopping = false;
+    }
+    m_thread.reset(QThread::create([this, file]() {
+        run(file.get());
+        file->close();
+    }));
+    m_thread->setObjectName(QStringLiteral("DecodeJsonlExporter"));
+    m_thread->start(QThread::LowPriority);
+    return true;
+}
+
+void DecodeJsonlExporter::close() {
+    if (!m_thread) {
+        return;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_workAvailable.wakeAll();
+    }
+    m_thread->wait();
+    m_thread.reset();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_dropped > 0) {
+        qWarning().noquote() << "Decode JSONL export dropped" << m_dropped << "messages from" << m_filePath;
+    }
+    m_queue.clear();
+    m_filePath.clear();
+    m_stopping = false;
+    m_paused = false;
+}
+
+bool DecodeJsonlExporter::isOpen() const {
+    return m_thread != nullptr;
+}
+
+QString DecodeJsonlExporter::filePath() const {
+    QMutexLocker locker(&m_mutex);
+    return m_filePath;
+}
+
+void DecodeJsonlExporter::enqueue(qint64 timestampMs,
+                                  DataDirection direction,
+                                  const QString &transportName,
+                                  const ProtocolMessage &message) {
+    if (!m_thread) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    const bool wasEmpty = m_queue.isEmpty();
+    if (m_queue.size() >= m_maxQueued) {
+        m_queue.removeFirst();
+        ++m_dropped;
+    }
+    m_queue.append(Record{timestampMs, direction, transportName, message});
+    ++m_enqueued;
+    if (wasEmpty) {
+        m_workAvailable.wakeOne();
+    }
+}
+
+void DecodeJsonlExporter::flush() {
+    if (!m_thread) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    while (m_written + m_dropped < m_enqueued) {
+        m_drained.wait(&m_mutex);
+    }
+}
+
+qint64 DecodeJsonlExporter::messagesWritten() const {
+    QMutexLocker locker(&m_mutex);
+    return m_written;
+}
+
+qint64 DecodeJsonlExporter::messagesDropped() const {
+    QMutexLocker locker(&m_mutex);
+    return m_dropped;
+}
+
+void DecodeJsonlExporter::setMaxQueuedMessages(qsizetype maxMessages) {
+    QMutexLocker locker(&m_mutex);
+    m_maxQueued = qMax<qsizetype>(1, maxMessages);
+    if (m_queue.size() <= m_maxQueued) {
+        return;
+    }
+    while (m_queue.size() > m_maxQueued) {
+        m_queue.removeFirst();
+        ++m_dropped;
+    }
+    m_drained.wakeAll();
+}
+
+qsizetype DecodeJsonlExporter::maxQueuedMessages() const {
+    QMutexLocker locker(&m_mutex);
+    return m_maxQueued;
+}
+
+#ifdef HDGNSS_REGRESSION_TESTS
+void DecodeJsonlExporter::regressionPauseWriter(bool paused) {
+    QMutexLocker locker(&m_mutex);
+    m_paused = paused;
+    if (!paused) {
+        m_workAvailable.wakeAll();
+    }
+}
+#endif
+
+void DecodeJsonlExporter::appendRecord(QByteArray &out,
+                                       qint64 timestampMs,
+                                       DataDirection direction,
+                                       const QString &transportName,
+                                       const ProtocolMessage &message) {
+    JsonStreamWriter writer(&out);
+    writer.beginObject();
+    char timestamp[32];
+    writer.writeKey(QLatin1StringView("timestamp"));
+    writer.writeString(formatTimestamp(timestampMs, timestamp));
+    writer.writeKey(QLatin1StringView("direction"));
+    writer.writeString(direction == DataDirection::Rx ? QLatin1StringView("RX") : QLatin1StringView("TX"));
+    writer.writeKey(QLatin1StringView("transport"));
+    writer.writeString(transportName);
+    writer.writeKey(QLatin1StringView("protocol"));
+    writer.writeString(message.protocol);
+    writer.writeKey(QLatin1StringView("message"));
+    writer.writeString(message.messageName);
+    writer.writeKey(QLatin1StringView("fields"));
+    writer.beginObject();
+    for (auto it = message.fields.cbegin(); it != message.fields.cend(); ++it) {
+        writer.writeKey(it.key());
+        writer.writeVariant(it.value());
+    }
+    writer.endObject();
+    writer.endObject();
+    out.append('\n');
+}
+
+void DecodeJsonlExporter::run(QFile *file) {
+    QList<Record> batch;
+    QByteArray buffer;
+    buffer.reserve(kWriteChunkBytes + 64 * 1024);
+
+    forever {
+        {
+            QMutexLocker locker(&m_mutex);
+            while ((m_queue.isEmpty() || m_paused) && !m_stopping) {
+                m_workAvailable.wait(&m_mutex);
+            }
+            if (m_queue.isEmpty()) {
+                break;
+            }
+            batch.swap(m_queue);
+        }
+
+        for (const Record &record : std::as_const(batch)) {
+            appendRecord(buffer, record.timestampMs, record.direction, record.transportName, record.message);
+            if (buffer.size() >= kWriteChunkBytes) {
+                file->write(buffer);
+                buffer.clear();
+            }
+        }
+        if (!buffer.isEmpty()) {
+            file->write(buffer);
+            buffer.clear();
+        }
+        file->flush();
+
+        const qsizetype batchSize = batch.size();
+        batch.clear();
+        QMutexLocker locker(&m_mutex);
+        m_written += batchSize;
+        if (m_written + m_dropped >= m_enqueued) {
+            m_drained.wakeAll();
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_drained.wakeAll();
+}
+
+}  // namespace hdgnss
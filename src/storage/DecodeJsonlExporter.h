@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+
+#include <memory>
+
+#include "src/protocols/GnssTypes.h"
+
+class QFile;
+class QThread;
+
+namespace hdgnss {
+
+// Writes one JSON object per decoded ProtocolMessage to a .jsonl file.
+// Callers only enqueue; serialization and file I/O run on a private thread.
+// The queue is bounded: when the writer falls behind, the oldest queued
+// messages are dropped and counted rather than letting memory grow.
+class DecodeJsonlExporter {
+public:
+    static constexpr qsizetype kDefaultMaxQueuedMessages = 65536;
+
+    DecodeJsonlExporter();
+    ~DecodeJsonlExporter();
+
+    DecodeJsonlExporter(const DecodeJsonlExporter &) = delete;
+    DecodeJsonlExporter &operator=(const DecodeJsonlExporter &) = delete;
+
+    bool open(const QString &filePath);
+    void close();
+    bool isOpen() const;
+    QString filePath() const;
+
+    void enqueue(qint64 timestampMs,
+                 DataDirection direction,
+                 const QString &transportName,
+                 const ProtocolMessage &message);
+    // Blocks until every message enqueued so far has reached the file or
+    // been dropped.
+    void flush();
+    qint64 messagesWritten() const;
+    qint64 messagesDropped() const;
+    void setMaxQueuedMessages(qsizetype maxMessages);
+    qsizetype maxQueuedMessages() const;
+
+#ifdef HDGNSS_REGRESSION_TESTS
+    // Holds the writer thread so a test can fill the queue past its cap.
+    void regressionPauseWriter(bool paused);
+#endif
+
+    static void appendRecord(QByteArray &out,
+                             qint64 timestampMs,
+                             DataDirection direction,
+                             const QString &transportName,
+                             const ProtocolMessage &message);
+
+private:
+    struct Record {
+        qint64 timestampMs = 0;
+        DataDirection direction = DataDirection::Rx;
+        QString transportName;
+        ProtocolMessage message;
+    };
+
+    void run(QFile *file);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_workAvailable;
+    QWaitCondition m_drained;
+    QList<Record> m_queue;
+    std::unique_ptr<QThread> m_thread;
+    QString m_filePath;
+    qint64 m_enqueued = 0;
+    qint64 m_written = 0;
+    qint64 m_dropped = 0;
+    qsizetype m_maxQueued = kDefaultMaxQueuedMessages;
+    bool m_stopping = false;
+    bool m_paused = false;
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,242 @@
+#include "JsonStreamWriter.h"
+
+#include <cmath>
+
+#include <QDateTime>
+#include <QLocale>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+namespace hdgnss {
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+}  // namespace
+
+JsonStreamWriter::JsonStreamWriter(QByteArray *out)
+    : m_out(out) {}
+
+void JsonStreamWriter::beforeValue() {
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (m_firstInScope.isEmpty()) {
+        return;
+    }
+    if (m_firstInScope.last()) {
+        m_firstInScope.last() = false;
+    } else {
+        m_out->append(',');
+    }
+}
+
+void JsonStreamWriter::beginObject() {
+    beforeValue();
+    m_out->append('{');
+    m_firstInScope.append(true);
+}
+
+void JsonStreamWriter::endObject() {
+    m_out->append('}');
+    m_firstInScope.removeLast();
+}
+
+void JsonStreamWriter::beginArray() {
+    beforeValue();
+    m_out->append('[');
+    m_firstInScope.append(true);
+}
+
+void JsonStreamWriter::endArray() {
+    m_out->append(']');
+    m_firstInScope.removeLast();
+}
+
+void JsonStreamWriter::writeKey(QLatin1StringView key) {
+    beforeValue();
+    m_out->append('"');
+    appendEscaped(*m_out, QByteArray::fromRawData(key.data(), key.size()));
+    m_out->append("\":", 2);
+    m_afterKey = true;
+}
+
+void JsonStreamWriter::writeKey(const QString &key) {
+    beforeValue();
+    m_out->append('"');
+    appendEscaped(*m_out, key.toUtf8());
+    m_out->append("\":", 2);
+    m_afterKey = true;
+}
+
+void JsonStreamWriter::writeString(const QString &value) {
+    beforeValue();
+    m_out->append('"');
+    appendEscaped(*m_out, value.toUtf8());
+    m_out->append('"');
+}
+
+void JsonStreamWriter::writeString(QLatin1StringView value) {
+    beforeValue();
+    m_out->append('"');
+    appendEscaped(*m_out, QByteArray::fromRawData(value.data(), value.size()));
+    m_out->append('"');
+}
+
+void JsonStreamWriter::writeInteger(qint64 value) {
+    beforeValue();
+    m_out->append(QByteArray::number(value));
+}
+
+void JsonStreamWriter::writeUnsigned(quint64 value) {
+    beforeValue();
+    m_out->append(QByteArray::number(value));
+}
+
+void JsonStreamWriter::writeDouble(double value) {
+    beforeValue();
+    // JSON has no NaN/Inf; receivers report missing values as NaN.
+    if (!std::isfinite(value)) {
+        m_out->append("null", 4);
+        return;
+    }
+    m_out->append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+}
+
+void JsonStreamWriter::writeBool(bool value) {
+    beforeValue();
+    if (value) {
+        m_out->append("true", 4);
+    } else {
+        m_out->append("false", 5);
+    }
+}
+
+void JsonStreamWriter::writeNull() {
+    beforeValue();
+    m_out->append("null", 4);
+}
+
+void JsonStreamWriter::writeVariant(const QVariant &value) {
+    if (!value.isValid() || value.isNull()) {
+        writeNull();
+        return;
+    }
+
+    switch (value.typeId()) {
+    case QMetaType::Bool:
+        writeBool(value.toBool());
+        return;
+    case QMetaType::Int:
+    case QMetaType::Short:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::SChar:
+        writeInteger(value.toLongLong());
+        return;
+    case QMetaType::UInt:
+    case QMetaType::UShort:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UChar:
+        writeUnsigned(value.toULongLong());
+        return;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        writeDouble(value.toDouble());
+        return;
+    case QMetaType::QString:
+        writeString(value.toString());
+        return;
+    case QMetaType::QByteArray:
+        writeString(QLatin1StringView(value.toByteArray().toHex()));
+        return;
+    case QMetaType::QDateTime:
+        writeString(value.toDateTime().toString(Qt::ISODateWithMs));
+        return;
+    case QMetaType::QDate:
+        writeString(value.toDate().toString(Qt::ISODate));
+        return;
+    case QMetaType::QTime:
+        writeString(value.toTime().toString(Qt::ISODateWithMs));
+        return;
+    case QMetaType::QStringList: {
+        beginArray();
+        const QStringList values = value.toStringList();
+        for (const QString &item : values) {
+            writeString(item);
+        }
+        endArray();
+        return;
+    }
+    case QMetaType::QVariantList: {
+        beginArray();
+        const QVariantList values = value.toList();
+        for (const QVariant &item : values) {
+            writeVariant(item);
+        }
+        endArray();
+        return;
+    }
+    case QMetaType::QVariantMap: {
+        beginObject();
+        const QVariantMap values = value.toMap();
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            writeKey(it.key());
+            writeVariant(it.value());
+        }
+        endObject();
+        return;
+    }
+    case QMetaType::QVariantHash: {
+        beginObject();
+        const QVariantHash values = value.toHash();
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            writeKey(it.key());
+            writeVariant(it.value());
+        }
+        endObject();
+        return;
+    }
+    default:
+        break;
+    }
+
+    if (value.canConvert<QString>()) {
+        writeString(value.toString());
+        return;
+    }
+    writeNull();
+}
+
+void JsonStreamWriter::appendEscaped(QByteArray &out, const QByteArray &utf8) {
+    const char *data = utf8.constData();
+    const qsizetype size = utf8.size();
+    qsizetype runStart = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        const unsigned char ch = static_cast<unsigned char>(data[i]);
+        if (ch >= 0x20 && ch != '"' && ch != '\\') {
+            continue;
+        }
+        out.append(data + runStart, i - runStart);
+        runStart = i + 1;
+        switch (ch) {
+        case '"': out.append("\\\"", 2); break;
+        case '\\': out.append("\\\\", 2); break;
+        case '\n': out.append("\\n", 2); break;
+        case '\r': out.append("\\r", 2); break;
+        case '\t': out.append("\\t", 2); break;
+        default: {
+            const char escaped[] = {'\\', 'u', '0', '0', kHexDigits[ch >> 4], kHexDigits[ch & 0x0F]};
+            out.append(escaped, sizeof(escaped));
+            break;
+        }
+        }
+    }
+    out.append(data + runStart, size - runStart);
+}
+
+}  // namespace hdgnss
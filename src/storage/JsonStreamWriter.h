@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <QVarLengthArray>
+
+namespace hdgnss {
+
+// Minimal append-only JSON writer. It serializes directly into a caller-owned
+// byte buffer so a JSON Lines record costs no intermediate QJsonDocument.
+class JsonStreamWriter {
+public:
+    explicit JsonStreamWriter(QByteArray *out);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void writeKey(QLatin1StringView key);
+    void writeKey(const QString &key);
+    void writeString(const QString &value);
+    void writeString(QLatin1StringView value);
+    void writeInteger(qint64 value);
+    void writeUnsigned(quint64 value);
+    void writeDouble(double value);
+    void writeBool(bool value);
+    void writeNull();
+    void writeVariant(const QVariant &value);
+
+    static void appendEscaped(QByteArray &out, const QByteArray &utf8);
+
+private:
+    void beforeValue();
+
+    QByteArray *m_out = nullptr;
+    // One entry per open container: true until its first element is written.
+    QVarLengthArray<bool, 8> m_firstInScope;
+    bool m_afterKey = false;
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,226 @@
+#include "RawLogArchive.h"
+
+#include <algorithm>
+
+#include <QDebug>
+#include <QDir>
+#include <QtEndian>
+
+namespace hdgnss {
+
+namespace {
+
+constexpr qsizetype kFlushBytes = 256 * 1024;
+
+QString archiveTemplate(const QString &name) {
+    return QDir(QDir::tempPath()).filePath(QStringLiteral("gnssview-rawlog-XXXXXX.") + name);
+}
+
+}  // namespace
+
+RawLogArchive::RawLogArchive() = default;
+
+RawLogArchive::~RawLogArchive() = default;
+
+bool RawLogArchive::open() {
+    close();
+    auto recordFile = std::make_unique<QTemporaryFile>(archiveTemplate(QStringLiteral("rows")));
+    auto previewFile = std::make_unique<QTemporaryFile>(archiveTemplate(QStringLiteral("previews")));
+    for (QTemporaryFile *file : {recordFile.get(), previewFile.get()}) {
+        if (!file->open()) {
+            m_error = file->errorString();
+            return false;
+        }
+    }
+    m_recordFile = std::move(recordFile);
+    m_previewFile = std::move(previewFile);
+    return true;
+}
+
+bool RawLogArchive::openForReading(const QString &recordPath, const QString &previewPath, qint64 rows) {
+    close();
+    auto recordFile = std::make_unique<QFile>(recordPath);
+    auto previewFile = std::make_unique<QFile>(previewPath);
+    for (QFile *file : {recordFile.get(), previewFile.get()}) {
+        if (!file->open(QIODevice::ReadOnly)) {
+            m_error = file->errorString();
+            return false;
+        }
+    }
+    m_recordFile = std::move(recordFile);
+    m_previewFile = std::move(previewFile);
+    m_rowCount = rows;
+    m_flushedRows = rows;
+    m_readOnly = true;
+    return true;
+}
+
+void RawLogArchive::close() {
+    m_recordFile.reset();
+    m_previewFile.reset();
+    m_recordBuffer = {};
+    m_previewBuffer = {};
+    m_pages.clear();
+    m_error.clear();
+    m_rowCount = 0;
+    m_flushedRows = 0;
+    m_previewBytes = 0;
+    m_failed = false;
+    m_readOnly = false;
+}
+
+bool RawLogArchive::isOpen() const {
+    return m_recordFile != nullptr;
+}
+
+QString RawLogArchive::errorString() const {
+    return m_error;
+}
+
+QString RawLogArchive::recordPath() const {
+    return m_recordFile ? m_recordFile->fileName() : QString();
+}
+
+QString RawLogArchive::previewPath() const {
+    return m_previewFile ? m_previewFile->fileName() : QString();
+}
+
+qint64 RawLogArchive::rowCount() const {
+    return m_rowCount;
+}
+
+qint64 RawLogArchive::diskBytes() const {
+    return m_rowCount * kRecordSize + m_previewBytes;
+}
+
+qint64 RawLogArchive::memoryBytes() const {
+    return m_recordBuffer.capacity() + m_previewBuffer.capacity() + m_pages.totalCost();
+}
+
+void RawLogArchive::append(const RawLogArchiveRow &row) {
+    if (m_readOnly) {
+        return;
+    }
+    // The last page may be cached with fewer rows than it now has.
+    m_pages.remove(m_rowCount / kPageRows);
+    ++m_rowCount;
+    if (m_failed || !isOpen()) {
+        return;
+    }
+
+    const auto previewLength = static_cast<quint16>(std::min<qsizetype>(row.preview.size(), 0xFFFF));
+    uchar encoded[kRecordSize] = {};
+    qToLittleEndian<qint64>(row.timestampMs, encoded);
+    qToLittleEndian<qint64>(m_previewBytes, encoded + 8);
+    qToLittleEndian<qint32>(row.payloadSize, encoded + 16);
+    qToLittleEndian<quint16>(previewLength, encoded + 20);
+    qToLittleEndian<quint16>(row.transportId, encoded + 22);
+    qToLittleEndian<quint16>(row.kindId, encoded + 24);
+    qToLittleEndian<quint16>(row.messageId, encoded + 26);
+    encoded[28] = row.direction;
+    m_recordBuffer.append(reinterpret_cast<const char *>(encoded), kRecordSize);
+    m_previewBuffer.append(row.preview.constData(), previewLength);
+    m_previewBytes += previewLength;
+
+    if (m_recordBuffer.size() + m_previewBuffer.size() >= kFlushBytes) {
+        flush();
+    }
+}
+
+bool RawLogArchive::readRow(qint64 index, RawLogArchiveRow *row) {
+    if (!row || index < 0 || index >= m_rowCount || m_failed || !isOpen()) {
+        return false;
+    }
+    if (index >= m_flushedRows && !flush()) {
+        return false;
+    }
+    const Page *cached = page(index / kPageRows);
+    const qsizetype recordOffset = (index % kPageRows) * kRecordSize;
+    if (!cached || recordOffset + kRecordSize > cached->records.size()) {
+        return false;
+    }
+
+    const auto *encoded = reinterpret_cast<const uchar *>(cached->records.constData() + recordOffset);
+    const qint64 previewOffset = qFromLittleEndian<qint64>(encoded + 8) - cached->previewBase;
+    const quint16 previewLength = qFromLittleEndian<quint16>(encoded + 20);
+    row->timestampMs = qFromLittleEndian<qint64>(encoded);
+    row->payloadSize = qFromLittleEndian<qint32>(encoded + 16);
+    row->transportId = qFromLittleEndian<quint16>(encoded + 22);
+    row->kindId = qFromLittleEndian<quint16>(encoded + 24);
+    row->messageId = qFromLittleEndian<quint16>(encoded + 26);
+    row->direction = encoded[28];
+    row->preview = cached->previews.mid(previewOffset, previewLength);
+    return true;
+}
+
+bool RawLogArchive::flush() {
+    if (m_failed || !isOpen()) {
+        return false;
+    }
+    if (m_recordBuffer.isEmpty()) {
+        return true;
+    }
+    if (!m_recordFile->seek(m_flushedRows * kRecordSize)
+        || m_recordFile->write(m_recordBuffer) != m_recordBuffer.size()) {
+        fail(m_recordFile->errorString());
+        return false;
+    }
+    if (!m_previewFile->seek(m_previewBytes - m_previewBuffer.size())
+        || m_previewFile->write(m_previewBuffer) != m_previewBuffer.size()) {
+        fail(m_previewFile->errorString());
+        return false;
+    }
+    m_flushedRows = m_rowCount;
+    m_recordBuffer.resize(0);
+    m_previewBuffer.resize(0);
+    return true;
+}
+
+const RawLogArchive::Page *RawLogArchive::page(qint64 pageIndex) {
+    if (const Page *cached = m_pages.object(pageIndex)) {
+        return cached;
+    }
+
+    const qint64 firstRow = pageIndex * kPageRows;
+    const qint64 rows = std::min<qint64>(kPageRows, m_flushedRows - firstRow);
+    if (rows <= 0) {
+        return nullptr;
+    }
+    auto loaded = std::make_unique<Page>();
+    if (!m_recordFile->seek(firstRow * kRecordSize)) {
+        fail(m_recordFile->errorString());
+        return nullptr;
+    }
+    loaded->records = m_recordFile->read(rows * kRecordSize);
+    if (loaded->records.size() != rows * kRecordSize) {
+        fail(m_recordFile->errorString());
+        return nullptr;
+    }
+
+    // Previews of consecutive rows are contiguous, so the page needs one read.
+    const auto *first = reinterpret_cast<const uchar *>(loaded->records.constData());
+    const auto *last = first + (rows - 1) * kRecordSize;
+    loaded->previewBase = qFromLittleEndian<qint64>(first + 8);
+    const qint64 previewEnd = qFromLittleEndian<qint64>(last + 8) + qFromLittleEndian<quint16>(last + 20);
+    if (!m_previewFile->seek(loaded->previewBase)) {
+        fail(m_previewFile->errorString());
+        return nullptr;
+    }
+    loaded->previews = m_previewFile->read(previewEnd - loaded->previewBase);
+    if (loaded->previews.size() != previewEnd - loaded->previewBase) {
+        fail(m_previewFile->errorString());
+        return nullptr;
+    }
+
+    const qint64 cost = loaded->records.size() + loaded->previews.size();
+    return m_pages.insert(pageIndex, loaded.release(), cost) ? m_pages.object(pageIndex) : nullptr;
+}
+
+void RawLogArchive::fail(const QString &error) {
+    m_failed = true;
+    m_error = error;
+    m_pages.clear();
+    qWarning().noquote() << "RawData scrollback disabled:" << error;
+}
+
+}  // namespace hdgnss
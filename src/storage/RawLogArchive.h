@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+
+#include <QByteArray>
+#include <QCache>
+#include <QString>
+#include <QTemporaryFile>
+
+namespace hdgnss {
+
+// One RawData row as it is spilled to disk. Names are ids into the intern
+// tables of the RawLogModel that owns the archive.
+struct RawLogArchiveRow {
+    qint64 timestampMs = 0;
+    quint8 direction = 0;
+    quint16 transportId = 0;
+    quint16 kindId = 0;
+    quint16 messageId = 0;
+    qint32 payloadSize = 0;
+    QByteArray preview;
+};
+
+// Append-only scrollback for rows RawLogModel no longer keeps in memory. Rows
+// are fixed-size little-endian records in one temporary file, so row n sits at
+// n * kRecordSize without an in-memory index; each record points into a second
+// file holding the previews back to back. Reads go through an LRU cache of
+// kPageRows-row pages, each filled with one read per file.
+class RawLogArchive {
+public:
+    static constexpr qsizetype kRecordSize = 32;
+    static constexpr int kPageRows = 4096;
+    static constexpr qint64 kPageCacheBytes = 8LL * 1024 * 1024;
+
+    RawLogArchive();
+    ~RawLogArchive();
+
+    // Starts an empty archive; an open one is discarded first.
+    bool open();
+    // Read-only view of the first `rows` rows of another archive's files, for
+    // a worker thread that must not share the writer's caches.
+    bool openForReading(const QString &recordPath, const QString &previewPath, qint64 rows);
+    void close();
+    bool isOpen() const;
+    QString errorString() const;
+    QString recordPath() const;
+    QString previewPath() const;
+
+    qint64 rowCount() const;
+    // Bytes written or still buffered for both files.
+    qint64 diskBytes() const;
+    // Write buffers plus cached pages.
+    qint64 memoryBytes() const;
+
+    // Rows are counted even if writing fails, so indexes stay aligned with
+    // the model; readRow() fails for them instead.
+    void append(const RawLogArchiveRow &row);
+    bool readRow(qint64 index, RawLogArchiveRow *row);
+    // Writes buffered rows so other readers of the files see them.
+    bool flush();
+
+private:
+    struct Page {
+        QByteArray records;
+        QByteArray previews;
+        qint64 previewBase = 0;
+    };
+
+    const Page *page(qint64 pageIndex);
+    void fail(const QString &error);
+
+    std::unique_ptr<QFile> m_recordFile;
+    std::unique_ptr<QFile> m_previewFile;
+    QByteArray m_recordBuffer;
+    QByteArray m_previewBuffer;
+    QCache<qint64, Page> m_pages{kPageCacheBytes};
+    QString m_error;
+    qint64 m_rowCount = 0;
+    qint64 m_flushedRows = 0;
+    qint64 m_previewBytes = 0;
+    bool m_failed = false;
+    bool m_readOnly = false;
+};
+
+}  // namespace hdgnss
@@ -3,12 +3,19 @@
 #include <QDir>
 #include <QFileInfo>
 
+#include "src/storage/CaptureIndex.h"
+#include "src/storage/CaptureKeyframes.h"
 #include "src/utils/ByteUtils.h"
 
 namespace hdgnss {
 
 namespace {
 
+// Index records go to the sidecar every 64 writes or every second of
+// capture time, whichever comes first.
+constexpr qsizetype kIndexFlushBytes = 64 * CaptureIndex::kRecordSize;
+constexpr qint64 kIndexFlushIntervalMs = 1000;
+
 QString directionName(DataDirection direction) {
     return direction == DataDirection::Rx ? QStringLiteral("RX") : QStringLiteral("TX");
 }
@@ -48,7 +55,7 @@ QString RawRecorder::logFilePath() const {
 }
 
 QString RawRecorder::jsonlFilePath() const {
-    return logFilePath();
+    return m_jsonlExporter.filePath();
 }
 
 qint64 RawRecorder::bytesRecorded() const {
@@ -81,6 +88,10 @@ void RawRecorder::setRecordDecodeEnabled(bool enabled) {
     m_recordDecodeEnabled = enabled;
 }
 
+void RawRecorder::setRecordJsonlEnabled(bool enabled) {
+    m_recordJsonlEnabled = enabled;
+}
+
 QString RawRecorder::sanitizeFilePart(const QString &value) const {
     QString out = value.trimmed();
     if (out.isEmpty()) {
@@ -95,18 +106,28 @@ QString RawRecorder::sanitizeFilePart(const QString &value) const {
 }
 
 void RawRecorder::closeFiles() {
+    flushIndex();
     if (m_binaryFile.isOpen()) {
         m_binaryFile.close();
     }
+    if (m_indexFile.isOpen()) {
+        m_indexFile.close();
+    }
+    if (m_keyframeFile.isOpen()) {
+        m_keyframeFile.close();
+    }
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
+    m_jsonlExporter.close();
 }
 
 void RawRecorder::startSession(const QString &baseName, const QDateTime &openedAt, const QString &qualifier) {
     closeFiles();
     m_bytesRecorded = 0;
     m_entriesRecorded = 0;
+    m_lastKeyframeMs = openedAt.toMSecsSinceEpoch();
+    m_lastIndexFlushMs = m_lastKeyframeMs;
     m_sessionDirectory.clear();
     m_fileStem.clear();
 
@@ -133,6 +154,9 @@ void RawRecorder::startSession(const QString &baseName, const QDateTime &openedA
         : QStringLiteral("%1_%2_%3").arg(cleanBase, cleanQualifier, timeSuffix);
 
     ensureOpen();
+    if (m_recordJsonlEnabled) {
+        m_jsonlExporter.open(QDir(m_sessionDirectory).filePath(QStringLiteral("%1.jsonl").arg(m_fileStem)));
+    }
 }
 
 void RawRecorder::ensureOpen() {
@@ -142,6 +166,11 @@ void RawRecorder::ensureOpen() {
     if (!m_binaryFile.isOpen()) {
         m_binaryFile.setFileName(QDir(m_sessionDirectory).filePath(QStringLiteral("%1.raw.bin").arg(m_fileStem)));
         m_binaryFile.open(QIODevice::WriteOnly | QIODevice::Append);
+        m_binaryOffset = m_binaryFile.isOpen() ? m_binaryFile.size() : 0;
+    }
+    if (!m_indexFile.isOpen()) {
+        m_indexFile.setFileName(CaptureIndex::indexPathForCapture(m_binaryFile.fileName()));
+        m_indexFile.open(QIODevice::WriteOnly | QIODevice::Append);
     }
     if (!m_logFile.isOpen()) {
         m_logFile.setFileName(QDir(m_sessionDirectory).filePath(QStringLiteral("%1.log").arg(m_fileStem)));
@@ -171,13 +200,68 @@ void RawRecorder::recordRaw(const RawLogEntry &entry) {
         return;
     }
 
+    const qint64 offset = m_binaryOffset;
     const qint64 written = m_binaryFile.write(entry.payload);
     if (written > 0) {
+        m_binaryOffset += written;
         m_bytesRecorded += written;
+        if (m_indexFile.isOpen()) {
+            const qint64 timestampMs = entry.timestampUtc.toMSecsSinceEpoch();
+            CaptureIndex::appendRecord(m_pendingIndex, {offset,
+                                                        timestampMs,
+                                                        static_cast<quint32>(written),
+                                                        entry.direction});
+            if (m_pendingIndex.size() >= kIndexFlushBytes
+                || timestampMs - m_lastIndexFlushMs >= kIndexFlushIntervalMs) {
+                m_lastIndexFlushMs = timestampMs;
+                flushIndex();
+            }
+        }
     }
     m_binaryFile.flush();
 }
 
+// Index records are written in batches. If the recorder dies before a
+// batch lands, replay streams the unindexed tail at the end of the capture.
+void RawRecorder::flushIndex() {
+    if (m_pendingIndex.isEmpty()) {
+        return;
+    }
+    if (m_indexFile.isOpen()) {
+        m_indexFile.write(m_pendingIndex);
+        m_indexFile.flush();
+    }
+    m_pendingIndex.clear();
+}
+
+bool RawRecorder::keyframeDue(const QDateTime &timestampUtc) const {
+    return m_recordRawEnabled
+        && m_binaryFile.isOpen()
+        && m_binaryOffset > 0
+        && timestampUtc.toMSecsSinceEpoch() - m_lastKeyframeMs >= CaptureKeyframes::kIntervalMs;
+}
+
+void RawRecorder::recordKeyframe(const QDateTime &timestampUtc, const QByteArray &state) {
+    if (!m_recordRawEnabled || !m_binaryFile.isOpen()) {
+        return;
+    }
+    m_lastKeyframeMs = timestampUtc.toMSecsSinceEpoch();
+    // Opened on first use so short sessions do not leave empty sidecars.
+    if (!m_keyframeFile.isOpen()) {
+        m_keyframeFile.setFileName(CaptureKeyframes::keyframePathForCapture(m_binaryFile.fileName()));
+        if (!m_keyframeFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            return;
+        }
+    }
+    // Keyframe offsets are only trusted alongside the index, so the index
+    // must cover everything before the keyframe.
+    flushIndex();
+    QByteArray record;
+    CaptureKeyframes::appendRecord(record, {m_binaryOffset, m_lastKeyframeMs, state});
+    m_keyframeFile.write(record);
+    m_keyframeFile.flush();
+}
+
 void RawRecorder::recordChunk(const QDateTime &timestampUtc,
                               DataDirection direction,
                               const StreamChunk &chunk,
@@ -212,4 +296,14 @@ void RawRecorder::recordChunk(const QDateTime &timestampUtc,
     m_logFile.flush();
 }
 
+void RawRecorder::recordMessage(const QDateTime &timestampUtc,
+                                DataDirection direction,
+                                const QString &transportName,
+                                const ProtocolMessage &message) {
+    if (!m_jsonlExporter.isOpen()) {
+        return;
+    }
+    m_jsonlExporter.enqueue(timestampUtc.toMSecsSinceEpoch(), direction, transportName, message);
+}
+
 }  // namespace hdgnss
@@ -6,6 +6,7 @@
 
 #include "src/core/StreamChunker.h"
 #include "src/protocols/GnssTypes.h"
+#include "src/storage/DecodeJsonlExporter.h"
 
 namespace hdgnss {
 
@@ -26,17 +27,30 @@ public:
     void setLogRootDirectory(const QString &directory);
     void setRecordRawEnabled(bool enabled);
     void setRecordDecodeEnabled(bool enabled);
+    // Takes effect when the next session starts.
+    void setRecordJsonlEnabled(bool enabled);
     void recordRaw(const RawLogEntry &entry);
+    // True once CaptureKeyframes::kIntervalMs has passed since the session
+    // started or the last keyframe, while raw recording is on.
+    bool keyframeDue(const QDateTime &timestampUtc) const;
+    // Stores receiver state valid at the current end of the raw capture, so
+    // call it before recordRaw() of the bytes that follow.
+    void recordKeyframe(const QDateTime &timestampUtc, const QByteArray &state);
     void recordChunk(const QDateTime &timestampUtc,
                      DataDirection direction,
                      const StreamChunk &chunk,
                      const QStringList &decodedLines = {});
+    void recordMessage(const QDateTime &timestampUtc,
+                       DataDirection direction,
+                       const QString &transportName,
+                       const ProtocolMessage &message);
     void startSession(const QString &baseName, const QDateTime &openedAt, const QString &qualifier = QString());
 
 private:
     QString sanitizeFilePart(const QString &value) const;
     void closeFiles();
     void ensureOpen();
+    void flushIndex();
     void writeLogEntry(const QDateTime &timestampUtc,
                        DataDirection direction,
                        const QString &format,
@@ -46,11 +60,21 @@ private:
     QString m_sessionDirectory;
     QString m_fileStem;
     QFile m_binaryFile;
+    QFile m_indexFile;
+    QFile m_keyframeFile;
     QFile m_logFile;
+    DecodeJsonlExporter m_jsonlExporter;
     bool m_recordRawEnabled = false;
     bool m_recordDecodeEnabled = false;
+    bool m_recordJsonlEnabled = false;
     qint64 m_bytesRecorded = 0;
     qint64 m_entriesRecorded = 0;
+    qint64 m_lastKeyframeMs = 0;
+    // End of the capture file, tracked here so writes skip a size() call.
+    qint64 m_binaryOffset = 0;
+    // Index records not yet written to the sidecar; see flushIndex().
+    QByteArray m_pendingIndex;
+    qint64 m_lastIndexFlushMs = 0;
 };
 
 }  // namespace hdgnss
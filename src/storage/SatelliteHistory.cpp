@@ -0,0 +1,316 @@
+#include "SatelliteHistory.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace hdgnss {
+
+SatelliteHistory::SatelliteHistory() {
+    setMemoryBudget(kDefaultMemoryBudget);
+}
+
+void SatelliteHistory::setMemoryBudget(qint64 bytes) {
+    m_memoryBudget = std::max<qint64>(bytes, kMinTrackSamples * kSampleBytes);
+    const int capacity = static_cast<int>(std::clamp<qint64>(m_memoryBudget / (kSampleBytes * kPlannedTracks),
+                                                             kMinTrackSamples,
+                                                             std::numeric_limits<int>::max()));
+    m_maxTracks = static_cast<int>(std::max<qint64>(1, m_memoryBudget / (capacity * kSampleBytes)));
+    if (capacity != m_trackCapacity) {
+        m_trackCapacity = capacity;
+        for (Track &track : m_tracks) {
+            resizeTrack(track, capacity);
+        }
+    }
+    while (m_tracks.size() > m_maxTracks) {
+        evictStalestTrack();
+    }
+}
+
+qint64 SatelliteHistory::memoryBudget() const {
+    return m_memoryBudget;
+}
+
+int SatelliteHistory::trackCapacity() const {
+    return m_trackCapacity;
+}
+
+int SatelliteHistory::maxTracks() const {
+    return m_maxTracks;
+}
+
+qint64 SatelliteHistory::memoryBytes() const {
+    qint64 bytes = 0;
+    for (const Track &track : m_tracks) {
+        bytes += track.timestampsMs.capacity() * qint64(sizeof(qint64))
+            + track.cn0.capacity()
+            + track.elevation.capacity()
+            + track.azimuth.capacity() * qint64(sizeof(quint16))
+            + track.used.capacity();
+    }
+    return bytes;
+}
+
+void SatelliteHistory::appendEpoch(qint64 timestampMs, const QHash<QString, SatelliteInfo> &satellites) {
+    for (const SatelliteInfo &sat : satellites) {
+        if (satelliteHasLiveSignal(sat)) {
+            append(timestampMs, sat);
+        }
+    }
+}
+
+void SatelliteHistory::append(qint64 timestampMs, const SatelliteInfo &sat) {
+    // The clock went back for every signal, as after a replay seek or when a
+    // capture replays after wall-clock epochs. Keeping the old newest time
+    // would anchor the window there and leave every later sample outside it.
+    if (timestampMs < m_latestTimestampMs) {
+        clear();
+    }
+    Track &track = trackFor(sat.key);
+    const qsizetype size = track.timestampsMs.size();
+    if (size > 0 && timestampMs == timestampAt(track, size - 1)) {
+        setSample(track, slot(track, size - 1), timestampMs, sat);
+        return;
+    }
+
+    if (size < m_trackCapacity) {
+        if (size == 0) {
+            track.timestampsMs.reserve(m_trackCapacity);
+            track.cn0.reserve(m_trackCapacity);
+            track.elevation.reserve(m_trackCapacity);
+            track.azimuth.reserve(m_trackCapacity);
+            track.used.reserve(m_trackCapacity);
+        }
+        track.timestampsMs.append(0);
+        track.cn0.append(0);
+        track.elevation.append(0);
+        track.azimuth.append(0);
+        track.used.append(0);
+        setSample(track, size, timestampMs, sat);
+    } else {
+        setSample(track, track.head, timestampMs, sat);
+        track.head = (track.head + 1) % size;
+    }
+    m_latestTimestampMs = std::max(m_latestTimestampMs, timestampMs);
+}
+
+void SatelliteHistory::clear() {
+    m_tracks.clear();
+    m_trackByKey.clear();
+    m_latestTimestampMs = 0;
+    ++m_layoutRevision;
+}
+
+int SatelliteHistory::trackCount() const {
+    return static_cast<int>(m_tracks.size());
+}
+
+QStringList SatelliteHistory::keys() const {
+    QStringList keys;
+    keys.reserve(m_tracks.size());
+    for (const Track &track : m_tracks) {
+        keys.append(track.key);
+    }
+    return keys;
+}
+
+int SatelliteHistory::sampleCount(const QString &key) const {
+    const Track *found = track(key);
+    return found ? static_cast<int>(found->timestampsMs.size()) : 0;
+}
+
+qint64 SatelliteHistory::latestTimestampMs() const {
+    return m_latestTimestampMs;
+}
+
+quint64 SatelliteHistory::layoutRevision() const {
+    return m_layoutRevision;
+}
+
+SatelliteHistoryStats SatelliteHistory::windowStats(const QString &key, qint64 fromMs, qint64 toMs) const {
+    SatelliteHistoryStats stats;
+    const Track *found = track(key);
+    if (!found || fromMs > toMs) {
+        return stats;
+    }
+    const qsizetype size = found->timestampsMs.size();
+    const qsizetype first = lowerBound(*found, fromMs);
+    qsizetype end = lowerBound(*found, toMs);
+    if (end < size && timestampAt(*found, end) == toMs) {
+        ++end;
+    }
+    if (first >= end) {
+        return stats;
+    }
+
+    qint64 cn0Sum = 0;
+    qint64 elevationSum = 0;
+    stats.minCn0 = std::numeric_limits<int>::max();
+    stats.maxCn0 = std::numeric_limits<int>::min();
+    stats.minElevation = std::numeric_limits<int>::max();
+    stats.maxElevation = std::numeric_limits<int>::min();
+    for (qsizetype sample = first; sample < end; ++sample) {
+        const qsizetype at = slot(*found, sample);
+        const int cn0 = found->cn0.at(at);
+        const int elevation = found->elevation.at(at);
+        cn0Sum += cn0;
+        elevationSum += elevation;
+        stats.minCn0 = std::min(stats.minCn0, cn0);
+        stats.maxCn0 = std::max(stats.maxCn0, cn0);
+        stats.minElevation = std::min(stats.minElevation, elevation);
+        stats.maxElevation = std::max(stats.maxElevation, elevation);
+        stats.usedSamples += found->used.at(at);
+    }
+    stats.samples = static_cast<int>(end - first);
+    stats.meanCn0 = double(cn0Sum) / stats.samples;
+    stats.meanElevation = double(elevationSum) / stats.samples;
+    return stats;
+}
+
+QList<QPointF> SatelliteHistory::decimatedCn0(const QString &key, qint64 fromMs, qint64 toMs, int buckets) const {
+    QList<QPointF> points;
+    const Track *found = track(key);
+    if (!found || fromMs > toMs || buckets <= 0) {
+        return points;
+    }
+    const qsizetype size = found->timestampsMs.size();
+    const qint64 spanMs = toMs - fromMs + 1;
+    points.reserve(2 * buckets);
+
+    qint64 bucket = -1;
+    qsizetype lowest = -1;
+    qsizetype highest = -1;
+    const auto flush = [&]() {
+        if (lowest < 0) {
+            return;
+        }
+        const qsizetype firstSlot = slot(*found, std::min(lowest, highest));
+        const qsizetype lastSlot = slot(*found, std::max(lowest, highest));
+        points.append(QPointF(found->timestampsMs.at(firstSlot), found->cn0.at(firstSlot)));
+        if (lowest != highest) {
+            points.append(QPointF(found->timestampsMs.at(lastSlot), found->cn0.at(lastSlot)));
+        }
+    };
+    for (qsizetype sample = lowerBound(*found, fromMs); sample < size; ++sample) {
+        const qsizetype at = slot(*found, sample);
+        const qint64 timestampMs = found->timestampsMs.at(at);
+        if (timestampMs > toMs) {
+            break;
+        }
+        const qint64 sampleBucket = (timestampMs - fromMs) * buckets / spanMs;
+        if (sampleBucket != bucket) {
+            flush();
+            bucket = sampleBucket;
+            lowest = sample;
+            highest = sample;
+            continue;
+        }
+        if (found->cn0.at(at) < found->cn0.at(slot(*found, lowest))) {
+            lowest = sample;
+        }
+        if (found->cn0.at(at) > found->cn0.at(slot(*found, highest))) {
+            highest = sample;
+        }
+    }
+    flush();
+    return points;
+}
+
+qsizetype SatelliteHistory::slot(const Track &track, qsizetype sample) const {
+    return (track.head + sample) % track.timestampsMs.size();
+}
+
+qint64 SatelliteHistory::timestampAt(const Track &track, qsizetype sample) const {
+    return track.timestampsMs.at(slot(track, sample));
+}
+
+qsizetype SatelliteHistory::lowerBound(const Track &track, qint64 timestampMs) const {
+    qsizetype low = 0;
+    qsizetype high = track.timestampsMs.size();
+    while (low < high) {
+        const qsizetype middle = low + (high - low) / 2;
+        if (timestampAt(track, middle) < timestampMs) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void SatelliteHistory::setSample(Track &track, qsizetype slot, qint64 timestampMs, const SatelliteInfo &sat) {
+    track.timestampsMs[slot] = timestampMs;
+    track.cn0[slot] = static_cast<quint8>(std::clamp(sat.cn0, 0, 255));
+    track.elevation[slot] = static_cast<qint8>(std::clamp(sat.elevation, -90, 90));
+    track.azimuth[slot] = static_cast<quint16>(std::clamp(sat.azimuth, 0, 359));
+    track.used[slot] = sat.usedInFix ? 1 : 0;
+}
+
+SatelliteHistory::Track &SatelliteHistory::trackFor(const QString &key) {
+    const auto it = m_trackByKey.constFind(key);
+    if (it != m_trackByKey.cend()) {
+        return m_tracks[it.value()];
+    }
+    while (m_tracks.size() >= m_maxTracks) {
+        evictStalestTrack();
+    }
+    m_trackByKey.insert(key, m_tracks.size());
+    m_tracks.append(Track{});
+    m_tracks.last().key = key;
+    ++m_layoutRevision;
+    return m_tracks.last();
+}
+
+void SatelliteHistory::evictStalestTrack() {
+    if (m_tracks.isEmpty()) {
+        return;
+    }
+    qsizetype stalest = 0;
+    qint64 stalestMs = std::numeric_limits<qint64>::max();
+    for (qsizetype index = 0; index < m_tracks.size(); ++index) {
+        const Track &track = m_tracks.at(index);
+        const qint64 newestMs = track.timestampsMs.isEmpty()
+            ? std::numeric_limits<qint64>::min()
+            : timestampAt(track, track.timestampsMs.size() - 1);
+        if (newestMs < stalestMs) {
+            stalest = index;
+            stalestMs = newestMs;
+        }
+    }
+    m_trackByKey.remove(m_tracks.at(stalest).key);
+    if (stalest != m_tracks.size() - 1) {
+        m_tracks[stalest] = std::move(m_tracks.last());
+        m_trackByKey.insert(m_tracks.at(stalest).key, stalest);
+    }
+    m_tracks.removeLast();
+    ++m_layoutRevision;
+}
+
+void SatelliteHistory::resizeTrack(Track &track, int capacity) {
+    const qsizetype size = track.timestampsMs.size();
+    const qsizetype kept = std::min<qsizetype>(size, capacity);
+    Track resized;
+    resized.key = track.key;
+    if (kept > 0) {
+        resized.timestampsMs.reserve(capacity);
+        resized.cn0.reserve(capacity);
+        resized.elevation.reserve(capacity);
+        resized.azimuth.reserve(capacity);
+        resized.used.reserve(capacity);
+    }
+    for (qsizetype sample = size - kept; sample < size; ++sample) {
+        const qsizetype at = slot(track, sample);
+        resized.timestampsMs.append(track.timestampsMs.at(at));
+        resized.cn0.append(track.cn0.at(at));
+        resized.elevation.append(track.elevation.at(at));
+        resized.azimuth.append(track.azimuth.at(at));
+        resized.used.append(track.used.at(at));
+    }
+    track = std::move(resized);
+}
+
+const SatelliteHistory::Track *SatelliteHistory::track(const QString &key) const {
+    const auto it = m_trackByKey.constFind(key);
+    return it != m_trackByKey.cend() ? &m_tracks.at(it.value()) : nullptr;
+}
+
+}  // namespace hdgnss
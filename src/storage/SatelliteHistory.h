@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QPointF>
+#include <QString>
+#include <QStringList>
+
+#include "src/protocols/GnssTypes.h"
+
+namespace hdgnss {
+
+// Aggregates of one signal's samples inside a time window.
+struct SatelliteHistoryStats {
+    int samples = 0;
+    int usedSamples = 0;
+    int minCn0 = 0;
+    double meanCn0 = 0.0;
+    int maxCn0 = 0;
+    int minElevation = 0;
+    double meanElevation = 0.0;
+    int maxElevation = 0;
+};
+
+// Per-signal time series of C/N0, elevation, azimuth and fix use. Each signal
+// key owns a ring of trackCapacity() samples stored as one array per field,
+// so appending an epoch is a hash lookup plus five stores and a window scan
+// touches only the fields it aggregates. The memory budget sets the ring size
+// for kPlannedTracks concurrent signals; when more signals than that appear,
+// the one that has gone longest without a sample is dropped.
+class SatelliteHistory {
+public:
+    // Timestamp, C/N0, elevation, azimuth and used flag.
+    static constexpr qsizetype kSampleBytes = 8 + 1 + 1 + 2 + 1;
+    static constexpr int kPlannedTracks = 192;
+    static constexpr int kMinTrackSamples = 64;
+    static constexpr qint64 kDefaultMemoryBudget = 32LL * 1024 * 1024;
+
+    SatelliteHistory();
+
+    // Rings are resized in place, keeping each signal's newest samples.
+    void setMemoryBudget(qint64 bytes);
+    qint64 memoryBudget() const;
+    int trackCapacity() const;
+    int maxTracks() const;
+    // Bytes currently allocated for samples.
+    qint64 memoryBytes() const;
+
+    // Adds one sample per satellite with a visible signal that is not stale.
+    void appendEpoch(qint64 timestampMs, const QHash<QString, SatelliteInfo> &satellites);
+    // A sample at the signal's newest timestamp replaces it. One older than
+    // latestTimestampMs() restarts the whole history, as after a replay seek.
+    void append(qint64 timestampMs, const SatelliteInfo &sat);
+    void clear();
+
+    int trackCount() const;
+    QStringList keys() const;
+    int sampleCount(const QString &key) const;
+    // Newest timestamp appended to any signal since the history last
+    // restarted, 0 when empty.
+    qint64 latestTimestampMs() const;
+    // Bumped whenever a signal is added or dropped.
+    quint64 layoutRevision() const;
+
+    // Samples with fromMs <= timestamp <= toMs.
+    SatelliteHistoryStats windowStats(const QString &key, qint64 fromMs, qint64 toMs) const;
+    // The window split into `buckets` equal slices, each reduced to its
+    // lowest and highest C/N0 sample as (timestamp, C/N0) points in time
+    // order, so a sparkline keeps every dip and peak. Empty slices are
+    // skipped.
+    QList<QPointF> decimatedCn0(const QString &key, qint64 fromMs, qint64 toMs, int buckets) const;
+
+private:
+    struct Track {
+        QString key;
+        QList<qint64> timestampsMs;
+        QList<quint8> cn0;
+        QList<qint8> elevation;
+        QList<quint16> azimuth;
+        QList<quint8> used;
+        // Slot of the oldest sample, and of the next write, once full.
+        qsizetype head = 0;
+    };
+
+    // Sample i of a track, counted from its oldest.
+    qsizetype slot(const Track &track, qsizetype sample) const;
+    qint64 timestampAt(const Track &track, qsizetype sample) const;
+    // First sample at or after timestampMs.
+    qsizetype lowerBound(const Track &track, qint64 timestampMs) const;
+    void setSample(Track &track, qsizetype slot, qint64 timestampMs, const SatelliteInfo &sat);
+    Track &trackFor(const QString &key);
+    void evictStalestTrack();
+    void resizeTrack(Track &track, int capacity);
+    const Track *track(const QString &key) const;
+
+    QList<Track> m_tracks;
+    QHash<QString, qsizetype> m_trackByKey;
+    qint64 m_memoryBudget = kDefaultMemoryBudget;
+    int m_trackCapacity = kMinTrackSamples;
+    int m_maxTracks = kPlannedTracks;
+    qint64 m_latestTimestampMs = 0;
+    quint64 m_layoutRevision = 0;
+};
+
+}  // namespace hdgnss
@@ -1,15 +1,13 @@
 #include "TecMapOverlayModel.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <QCoreApplication>
-#include <QDir>
-#include <QFile>
 #include <QMetaObject>
 #include <QMetaType>
-#include <QPainterPath>
+#include <QMutexLocker>
 #include <QPointF>
-#include <QStandardPaths>
 #include <limits>
 
 #include "hdgnss/IConfigurablePlugin.h"
@@ -22,15 +20,17 @@ namespace hdgnss {
 
 namespace {
 
-QString overlayDirectoryPath() {
-    const QString root = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-    return QDir(root).filePath(QStringLiteral("hdgnss/tec"));
-}
-
 constexpr double kWorldMinY = -91.296;
 constexpr double kWorldHeight = 182.592;
 constexpr double kDefaultLonStepDegrees = 5.0;
 constexpr double kDefaultLatStepDegrees = 2.5;
+// Off-cell points still pick a sample whose center is this close.
+constexpr double kNearestSamplePixels = 24.0;
+// Datasets whose lattice would need more cells are not indexed.
+constexpr qint64 kMaxGridIndexCells = qint64(1) << 22;
+// The renderer splits each image across threads itself; two renders at once
+// keep a slow source from holding up another.
+constexpr int kRenderWorkers = 2;
 
 constexpr double kRobinsonX[] = {
     1.0, 0.9986, 0.9954, 0.99, 0.9822, 0.973, 0.96, 0.9427, 0.9216,
@@ -79,42 +79,36 @@ QPointF projectedCanvasPoint(double width, double height, double lonDeg, double
     };
 }
 
-QPainterPath cellPath(double width,
-                      double height,
-                      double lonMin,
-                      double lonMax,
-                      double latMin,
-                      double latMax) {
-    const double stepDegrees = std::max(0.5, (lonMax - lonMin) / 4.0);
-    QPainterPath path;
-    bool firstPoint = true;
-
-    auto addPoint = [&](double lon, double lat) {
-        const QPointF point = projectedCanvasPoint(width, height, lon, lat);
-        if (!std::isfinite(point.x()) || !std::isfinite(point.y())) {
-            return;
-        }
-        if (firstPoint) {
-            path.moveTo(point);
-            firstPoint = false;
-        } else {
-            path.lineTo(point);
+// Inverse of robinsonProject() on the canvas: the band comes from a search of
+// kRobinsonY, and within a band both factors are linear in latitude. Points
+// off the map are clamped to its edge when clampToMap is set, and are NaN
+// otherwise.
+QPointF robinsonUnprojectCanvas(double width, double height, double x, double y, bool clampToMap) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double projectedX = x / width * 360.0 - 180.0;
+    const double projectedY = y / height * kWorldHeight + kWorldMinY;
+    double yFactor = std::abs(projectedY) / (90.0 * 1.0144);
+    if (yFactor > 1.0) {
+        if (!clampToMap) {
+            return {nan, nan};
         }
-    };
-
-    for (double lon = lonMin; lon <= lonMax + 0.001; lon += stepDegrees) {
-        addPoint(std::min(lon, lonMax), latMin);
+        yFactor = 1.0;
     }
-    addPoint(lonMax, latMin);
-    for (double lon = lonMax; lon >= lonMin - 0.001; lon -= stepDegrees) {
-        addPoint(std::max(lon, lonMin), latMax);
-    }
-    addPoint(lonMin, latMax);
 
-    if (!firstPoint) {
-        path.closeSubpath();
+    const auto upper = std::upper_bound(std::cbegin(kRobinsonY), std::cend(kRobinsonY), yFactor);
+    const int bandIndex = std::clamp<int>(static_cast<int>(upper - std::cbegin(kRobinsonY)) - 1, 0,
+                                          static_cast<int>(std::size(kRobinsonY)) - 2);
+    const double ratio = (yFactor - kRobinsonY[bandIndex]) / (kRobinsonY[bandIndex + 1] - kRobinsonY[bandIndex]);
+    const double absLat = (bandIndex + ratio) * 5.0;
+    const double xFactor = lerp(kRobinsonX[bandIndex], kRobinsonX[bandIndex + 1], ratio);
+    double lonDeg = projectedX / xFactor;
+    if (std::abs(lonDeg) > 180.0) {
+        if (!clampToMap) {
+            return {nan, nan};
+        }
+        lonDeg = clamp(lonDeg, -180.0, 180.0);
     }
-    return path;
+    return {lonDeg, projectedY <= 0.0 ? absLat : -absLat};
 }
 
 QVariantMap tecPluginDescriptor(QObject *pluginObject, AppSettings *settings) {
@@ -162,6 +156,7 @@ TecMapOverlayModel::TecMapOverlayModel(AppSettings *settings, QObject *parent)
     qRegisterMetaType<hdgnss::TecGridData>("hdgnss::TecGridData");
     m_requestDebounceTimer.setSingleShot(true);
     m_requestDebounceTimer.setInterval(250);
+    m_renderPool.setMaxThreadCount(kRenderWorkers);
     connect(&m_requestDebounceTimer, &QTimer::timeout, this, &TecMapOverlayModel::requestRefreshForEnabledSources);
 
     if (m_settings) {
@@ -179,6 +174,9 @@ TecMapOverlayModel::TecMapOverlayModel(AppSettings *settings, QObject *parent)
 }
 
 TecMapOverlayModel::~TecMapOverlayModel() {
+    // Workers post their results back to this object; none may be left.
+    m_renderPool.clear();
+    m_renderPool.waitForDone();
     disconnectPluginSignals();
     for (int index = 0; index < m_sources.size(); ++index) {
         clearOverlay(index);
@@ -189,6 +187,42 @@ QUrl TecMapOverlayModel::overlaySource() const {
     return m_overlaySource;
 }
 
+qint64 TecMapOverlayModel::overlayLatencyMs() const {
+    return m_overlayLatencyMs.load();
+}
+
+QVariantMap TecMapOverlayModel::renderStats() const {
+    return {
+        {QStringLiteral("lastRenderMs"), m_lastRenderMs},
+        {QStringLiteral("lastQueueMs"), m_lastQueueMs},
+        {QStringLiteral("completedRenders"), m_completedRenders},
+        {QStringLiteral("droppedRenders"), m_droppedRenders},
+        {QStringLiteral("pendingRenders"), m_pendingRenders}
+    };
+}
+
+QImage TecMapOverlayModel::serveOverlayImage(const QString &pluginId) {
+    QImage image;
+    bool firstServe = false;
+    {
+        QMutexLocker locker(&m_overlayMutex);
+        const auto it = m_overlayImages.find(pluginId);
+        if (it == m_overlayImages.end()) {
+            return {};
+        }
+        image = it->image;
+        if (!it->served) {
+            it->served = true;
+            firstServe = true;
+            m_overlayLatencyMs.store(it->sinceDataReady.elapsed());
+        }
+    }
+    if (firstServe) {
+        emit overlayLatencyChanged();
+    }
+    return image;
+}
+
 bool TecMapOverlayModel::ready() const {
     return m_overlaySource.isValid() && !m_overlaySource.isEmpty();
 }
@@ -246,40 +280,56 @@ QVariantMap TecMapOverlayModel::sampleAtCanvasPoint(qreal x,
     }
 
     const TecGridData &dataset = m_sources.at(m_activeSourceIndex).dataset;
-    const QPointF clickPoint(x, y);
-    const double lonHalfStep = (dataset.longitudeStepDegrees > 0.0 ? dataset.longitudeStepDegrees : kDefaultLonStepDegrees) * 0.5;
-    const double latHalfStep = (dataset.latitudeStepDegrees > 0.0 ? dataset.latitudeStepDegrees : kDefaultLatStepDegrees) * 0.5;
+    const GridIndex &grid = m_sources.at(m_activeSourceIndex).gridIndex;
+    if (grid.cells.isEmpty()) {
+        return result;
+    }
+    const auto columnOf = [&grid](double lonDeg) {
+        return static_cast<int>(std::floor((lonDeg - grid.westLongitude) / grid.longitudeStep + 0.5));
+    };
+    const auto rowOf = [&grid](double latDeg) {
+        return static_cast<int>(std::floor((latDeg - grid.southLatitude) / grid.latitudeStep + 0.5));
+    };
 
     int bestIndex = -1;
-    double bestDistanceSquared = std::numeric_limits<double>::max();
-
-    for (int i = 0; i < dataset.samples.size(); ++i) {
-        const TecSample &sample = dataset.samples.at(i);
-        const double lonMin = clamp(sample.longitude - lonHalfStep, -180.0, 180.0);
-        const double lonMax = clamp(sample.longitude + lonHalfStep, -180.0, 180.0);
-        const double latMin = clamp(sample.latitude - latHalfStep, -90.0, 90.0);
-        const double latMax = clamp(sample.latitude + latHalfStep, -90.0, 90.0);
-        if (lonMax <= lonMin || latMax <= latMin) {
-            continue;
-        }
-
-        const QPainterPath path = cellPath(width, height, lonMin, lonMax, latMin, latMax);
-        if (!path.isEmpty() && path.contains(clickPoint)) {
-            bestIndex = i;
-            break;
-        }
+    const QPointF geo = robinsonUnprojectCanvas(width, height, x, y, false);
+    if (std::isfinite(geo.x()) && std::isfinite(geo.y())) {
+        bestIndex = grid.sampleAt(columnOf(geo.x()), rowOf(geo.y()));
+    }
 
-        const QPointF samplePoint = projectedCanvasPoint(width, height, sample.longitude, sample.latitude);
-        if (!std::isfinite(samplePoint.x()) || !std::isfinite(samplePoint.y())) {
-            continue;
+    if (bestIndex < 0) {
+        // Search the cells around the nearest map point for the closest
+        // projected center. Degrees per pixel peak at the poles, where both
+        // Robinson factors change slowest; the reach is doubled because the
+        // nearest map point can itself be up to kNearestSamplePixels away.
+        double minYSlope = std::numeric_limits<double>::max();
+        for (size_t band = 0; band + 1 < std::size(kRobinsonY); ++band) {
+            minYSlope = std::min(minYSlope, (kRobinsonY[band + 1] - kRobinsonY[band]) / 5.0);
         }
-
-        const double dx = samplePoint.x() - clickPoint.x();
-        const double dy = samplePoint.y() - clickPoint.y();
-        const double distanceSquared = dx * dx + dy * dy;
-        if (distanceSquared < bestDistanceSquared) {
-            bestDistanceSquared = distanceSquared;
-            bestIndex = i;
+        const double reachPixels = 2.0 * kNearestSamplePixels;
+        const double lonReach = reachPixels / width * 360.0 / kRobinsonX[std::size(kRobinsonX) - 1];
+        const double latReach = reachPixels / height * kWorldHeight / (90.0 * 1.0144 * minYSlope);
+        const QPointF anchor = robinsonUnprojectCanvas(width, height, x, y, true);
+        const int firstColumn = std::max(0, columnOf(anchor.x() - lonReach));
+        const int lastColumn = std::min(grid.columns - 1, columnOf(anchor.x() + lonReach));
+        const int firstRow = std::max(0, rowOf(anchor.y() - latReach));
+        const int lastRow = std::min(grid.rows - 1, rowOf(anchor.y() + latReach));
+        double bestDistanceSquared = kNearestSamplePixels * kNearestSamplePixels;
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                const int index = grid.sampleAt(column, row);
+                if (index < 0) {
+                    continue;
+                }
+                const TecSample &sample = dataset.samples.at(index);
+                const QPointF samplePoint = projectedCanvasPoint(width, height, sample.longitude, sample.latitude);
+                const double dx = samplePoint.x() - x;
+                const double dy = samplePoint.y() - y;
+                if (dx * dx + dy * dy <= bestDistanceSquared) {
+                    bestDistanceSquared = dx * dx + dy * dy;
+                    bestIndex = index;
+                }
+            }
         }
     }
 
@@ -287,18 +337,6 @@ QVariantMap TecMapOverlayModel::sampleAtCanvasPoint(qreal x,
         return result;
     }
 
-    const QPointF matchedPoint = projectedCanvasPoint(width, height,
-                                                      dataset.samples.at(bestIndex).longitude,
-                                                      dataset.samples.at(bestIndex).latitude);
-    const double dx = matchedPoint.x() - clickPoint.x();
-    const double dy = matchedPoint.y() - clickPoint.y();
-    if (bestDistanceSquared != std::numeric_limits<double>::max() && bestDistanceSquared > 24.0 * 24.0) {
-        return result;
-    }
-    if (std::isfinite(dx) && std::isfinite(dy) && bestDistanceSquared == std::numeric_limits<double>::max()) {
-        bestDistanceSquared = dx * dx + dy * dy;
-    }
-
     const TecSample &sample = dataset.samples.at(bestIndex);
     result.insert(QStringLiteral("valid"), true);
     result.insert(QStringLiteral("longitude"), sample.longitude);
@@ -351,14 +389,23 @@ void TecMapOverlayModel::setTestDataset(const hdgnss::TecGridData &dataset, cons
         sourceIndex = m_sources.size() - 1;
     }
 
-    m_sources[sourceIndex].dataset = dataset;
-    m_sources[sourceIndex].datasetTimestampUtc = dataset.timestampUtc.toUTC();
-    m_sources[sourceIndex].statusText = QStringLiteral("TEC ready");
-    updateDatasetLabel(sourceIndex);
     m_activeSourceIndex = sourceIndex;
-    applyActiveSourceState();
-    rebuildDescriptors();
+    QElapsedTimer sinceDataReady;
+    sinceDataReady.start();
+    const qint64 generation = beginRender(sourceIndex);
+    finishRender(resolvedPluginId, generation, dataset, renderOverlay(dataset), sinceDataReady);
+}
+
+#ifdef HDGNSS_REGRESSION_TESTS
+void TecMapOverlayModel::regressionQueueDataset(const hdgnss::TecGridData &dataset, const QString &pluginId) {
+    for (int index = 0; index < m_sources.size(); ++index) {
+        if (m_sources.at(index).pluginId == pluginId) {
+            renderDataset(index, dataset);
+            return;
+        }
+    }
 }
+#endif
 
 bool TecMapOverlayModel::shouldRequestRefresh(const QDateTime &lastRequestObservationTimeUtc,
                                               const QDateTime &observationTimeUtc,
@@ -402,6 +449,7 @@ void TecMapOverlayModel::setObservationTime(const QDateTime &observationTimeUtc)
             m_sources[index].lastRequestObservationTimeUtc = {};
             m_sources[index].datasetTimestampUtc = {};
             m_sources[index].dataset = {};
+            m_sources[index].gridIndex = {};
             m_sources[index].loading = false;
             updateDatasetLabel(index);
             setSourceStatusText(index, QStringLiteral("TEC waiting for GNSS UTC time"));
@@ -737,52 +785,156 @@ void TecMapOverlayModel::updateDatasetLabel(int index) {
     m_sources[index].datasetLabel = nextLabel;
 }
 
+int TecMapOverlayModel::GridIndex::sampleAt(int column, int row) const {
+    if (column < 0 || row < 0 || column >= columns || row >= rows) {
+        return -1;
+    }
+    return cells.at(row * columns + column);
+}
+
+TecMapOverlayModel::GridIndex TecMapOverlayModel::buildGridIndex(const TecGridData &dataset) {
+    GridIndex grid;
+    grid.longitudeStep = dataset.longitudeStepDegrees > 0.0 ? dataset.longitudeStepDegrees : kDefaultLonStepDegrees;
+    grid.latitudeStep = dataset.latitudeStepDegrees > 0.0 ? dataset.latitudeStepDegrees : kDefaultLatStepDegrees;
+
+    double west = std::numeric_limits<double>::max();
+    double east = std::numeric_limits<double>::lowest();
+    double south = std::numeric_limits<double>::max();
+    double north = std::numeric_limits<double>::lowest();
+    for (const TecSample &sample : dataset.samples) {
+        if (!std::isfinite(sample.longitude) || !std::isfinite(sample.latitude)) {
+            continue;
+        }
+        west = std::min(west, sample.longitude);
+        east = std::max(east, sample.longitude);
+        south = std::min(south, sample.latitude);
+        north = std::max(north, sample.latitude);
+    }
+    if (west > east) {
+        return grid;
+    }
+
+    const qint64 columns = std::llround((east - west) / grid.longitudeStep) + 1;
+    const qint64 rows = std::llround((north - south) / grid.latitudeStep) + 1;
+    if (columns * rows > kMaxGridIndexCells) {
+        return grid;
+    }
+    grid.westLongitude = west;
+    grid.southLatitude = south;
+    grid.columns = static_cast<int>(columns);
+    grid.rows = static_cast<int>(rows);
+    grid.cells = QList<int>(grid.columns * grid.rows, -1);
+    // Samples off the lattice go to the nearest cell; the first sample of a
+    // cell keeps it, as the first matching cell used to win.
+    for (int index = 0; index < dataset.samples.size(); ++index) {
+        const TecSample &sample = dataset.samples.at(index);
+        if (!std::isfinite(sample.longitude) || !std::isfinite(sample.latitude)) {
+            continue;
+        }
+        const int column = static_cast<int>(std::llround((sample.longitude - west) / grid.longitudeStep));
+        const int row = static_cast<int>(std::llround((sample.latitude - south) / grid.latitudeStep));
+        int &cell = grid.cells[row * grid.columns + column];
+        if (cell < 0) {
+            cell = index;
+        }
+    }
+    return grid;
+}
+
 void TecMapOverlayModel::clearOverlay(int index) {
     if (index < 0 || index >= m_sources.size()) {
         return;
     }
-    if (!m_sources[index].overlayPath.isEmpty()) {
-        QFile::remove(m_sources[index].overlayPath);
-        m_sources[index].overlayPath.clear();
+    // Renders still in flight would bring the overlay back.
+    m_sources.at(index).renderGeneration->store(++m_renderGeneration);
+    {
+        QMutexLocker locker(&m_overlayMutex);
+        m_overlayImages.remove(m_sources.at(index).pluginId);
     }
     m_sources[index].overlaySource = QUrl();
 }
 
+TecMapOverlayModel::RenderResult TecMapOverlayModel::renderOverlay(const TecGridData &dataset) {
+    QElapsedTimer timer;
+    timer.start();
+    RenderResult result;
+    result.image = TecMapRenderer::render(dataset);
+    result.gridIndex = buildGridIndex(dataset);
+    result.renderMs = timer.elapsed();
+    return result;
+}
+
+qint64 TecMapOverlayModel::beginRender(int index) {
+    const qint64 generation = ++m_renderGeneration;
+    m_sources.at(index).renderGeneration->store(generation);
+    ++m_pendingRenders;
+    emit renderStatsChanged();
+    return generation;
+}
+
 void TecMapOverlayModel::renderDataset(int index, const TecGridData &dataset) {
     if (index < 0 || index >= m_sources.size()) {
         return;
     }
 
-    const QString directoryPath = overlayDirectoryPath();
-    QDir directory;
-    if (!directory.mkpath(directoryPath)) {
-        setSourceStatusText(index, QStringLiteral("TEC overlay cache directory could not be created"));
-        applyActiveSourceState();
-        rebuildDescriptors();
-        return;
+    QElapsedTimer sinceDataReady;
+    sinceDataReady.start();
+    const qint64 generation = beginRender(index);
+    const QString pluginId = m_sources.at(index).pluginId;
+    const std::shared_ptr<std::atomic<qint64>> latestGeneration = m_sources.at(index).renderGeneration;
+    m_renderPool.start([this, pluginId, generation, latestGeneration, dataset, sinceDataReady]() {
+        RenderResult result;
+        result.queueMs = sinceDataReady.elapsed();
+        if (latestGeneration->load() == generation) {
+            const qint64 queueMs = result.queueMs;
+            result = renderOverlay(dataset);
+            result.queueMs = queueMs;
+        } else {
+            result.skipped = true;
+        }
+        QMetaObject::invokeMethod(this, [this, pluginId, generation, dataset, result, sinceDataReady]() {
+            finishRender(pluginId, generation, dataset, result, sinceDataReady);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void TecMapOverlayModel::finishRender(const QString &pluginId,
+                                      qint64 generation,
+                                      const TecGridData &dataset,
+                                      const RenderResult &result,
+                                      const QElapsedTimer &sinceDataReady) {
+    --m_pendingRenders;
+    int index = -1;
+    for (int candidate = 0; candidate < m_sources.size(); ++candidate) {
+        if (m_sources.at(candidate).pluginId == pluginId) {
+            index = candidate;
+            break;
+        }
     }
-
-    const QImage image = TecMapRenderer::render(dataset);
-    const QString filePath = QDir(directoryPath).filePath(
-        QStringLiteral("tec-%1-%2-%3.png")
-            .arg(dataset.sourceId.isEmpty() ? QStringLiteral("overlay") : dataset.sourceId)
-            .arg(dataset.timestampUtc.toUTC().toString(QStringLiteral("yyyyMMddTHHmmss")))
-            .arg(++m_revision));
-    if (!image.save(filePath)) {
-        setSourceStatusText(index, QStringLiteral("TEC overlay image could not be written"));
-        applyActiveSourceState();
-        rebuildDescriptors();
+    if (result.skipped || index < 0 || m_sources.at(index).renderGeneration->load() != generation) {
+        ++m_droppedRenders;
+        emit renderStatsChanged();
         return;
     }
+    ++m_completedRenders;
+    m_lastRenderMs = result.renderMs;
+    m_lastQueueMs = result.queueMs;
+    emit renderStatsChanged();
 
-    if (!m_sources[index].overlayPath.isEmpty() && m_sources[index].overlayPath != filePath) {
-        QFile::remove(m_sources[index].overlayPath);
+    OverlayImage overlay;
+    overlay.image = result.image;
+    overlay.sinceDataReady = sinceDataReady;
+    {
+        QMutexLocker locker(&m_overlayMutex);
+        m_overlayImages.insert(pluginId, overlay);
     }
 
-    m_sources[index].overlayPath = filePath;
-    m_sources[index].overlaySource = QUrl::fromLocalFile(filePath);
+    m_sources[index].overlaySource = QUrl(QStringLiteral("image://%1/%2/%3")
+                                              .arg(QLatin1String(kOverlayImageProviderId), pluginId)
+                                              .arg(++m_revision));
     m_sources[index].datasetTimestampUtc = dataset.timestampUtc.toUTC();
     m_sources[index].dataset = dataset;
+    m_sources[index].gridIndex = result.gridIndex;
     updateDatasetLabel(index);
 
     if (dataset.fromCache) {
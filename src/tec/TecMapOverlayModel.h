@@ -1,9 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
 #include <QList>
+#include <QMutex>
 #include <QObject>
+#include <QThreadPool>
 #include <QVariantMap>
 #include <QTimer>
 #include <QUrl>
@@ -16,9 +22,24 @@ namespace hdgnss {
 class AppSettings;
 class TecPluginLoader;
 
+// Rendered overlays stay in memory and reach QML through an image provider
+// registered as kOverlayImageProviderId: overlaySource is
+// image://<provider>/<plugin id>/<revision>, and the revision changes with
+// every render so QML never reuses a stale image.
+//
+// Datasets render on a worker pool. Each render takes a new generation for
+// its source; a render that is no longer its source's latest is skipped if
+// it has not started and discarded when it finishes, so the overlay, and the
+// dataset used for lookups, only ever swap to the newest completed render.
 class TecMapOverlayModel : public QObject {
     Q_OBJECT
     Q_PROPERTY(QUrl overlaySource READ overlaySource NOTIFY overlayChanged)
+    // From dataReady to the overlay image being handed to QML, for the last
+    // overlay served; -1 until one has been.
+    Q_PROPERTY(qint64 overlayLatencyMs READ overlayLatencyMs NOTIFY overlayLatencyChanged)
+    // lastRenderMs, lastQueueMs, completedRenders, droppedRenders and
+    // pendingRenders.
+    Q_PROPERTY(QVariantMap renderStats READ renderStats NOTIFY renderStatsChanged)
     Q_PROPERTY(bool ready READ ready NOTIFY overlayChanged)
     Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
     Q_PROPERTY(QString statusText READ statusText NOTIFY statusChanged)
@@ -31,10 +52,18 @@ class TecMapOverlayModel : public QObject {
     Q_PROPERTY(QString activeSourceId READ activeSourceId NOTIFY activeSourceChanged)
 
 public:
+    static constexpr const char *kOverlayImageProviderId = "tecoverlay";
+
     explicit TecMapOverlayModel(AppSettings *settings, QObject *parent = nullptr);
     ~TecMapOverlayModel() override;
 
     [[nodiscard]] QUrl overlaySource() const;
+    [[nodiscard]] qint64 overlayLatencyMs() const;
+    [[nodiscard]] QVariantMap renderStats() const;
+    // The latest overlay of a source, or a null image; the first call for an
+    // overlay sets overlayLatencyMs. Safe to call from the image provider's
+    // thread.
+    QImage serveOverlayImage(const QString &pluginId);
     [[nodiscard]] bool ready() const;
     [[nodiscard]] bool loading() const;
     [[nodiscard]] QString statusText() const;
@@ -50,7 +79,12 @@ public:
                                                 qreal width,
                                                 qreal height) const;
     Q_INVOKABLE void setActiveSourceIndex(int index);
+    // Renders on the calling thread, so the overlay is ready on return.
     void setTestDataset(const hdgnss::TecGridData &dataset, const QString &pluginId = QString());
+#ifdef HDGNSS_REGRESSION_TESTS
+    // Renders on the worker pool, as a plugin's dataReady does.
+    void regressionQueueDataset(const hdgnss::TecGridData &dataset, const QString &pluginId);
+#endif
 
     void setObservationTime(const QDateTime &observationTimeUtc);
     static bool shouldRequestRefresh(const QDateTime &lastRequestObservationTimeUtc,
@@ -62,6 +96,8 @@ public:
 
 signals:
     void overlayChanged();
+    void overlayLatencyChanged();
+    void renderStatsChanged();
     void loadingChanged();
     void statusChanged();
     void availableTecPluginsChanged();
@@ -75,6 +111,22 @@ private slots:
     void handlePluginErrorOccurred(const QString &message);
 
 private:
+    // The dataset's samples on a regular lattice of cells, so a point finds
+    // its cell by index arithmetic.
+    struct GridIndex {
+        double westLongitude = 0.0;
+        double southLatitude = 0.0;
+        double longitudeStep = 0.0;
+        double latitudeStep = 0.0;
+        int columns = 0;
+        int rows = 0;
+        // Sample index per cell, row-major from the south-west, or -1.
+        QList<int> cells;
+
+        // -1 when the cell is outside the lattice or empty.
+        int sampleAt(int column, int row) const;
+    };
+
     struct SourceState {
         QString pluginId;
         QString displayName;
@@ -83,13 +135,28 @@ private:
         QDateTime lastRequestObservationTimeUtc;
         QDateTime datasetTimestampUtc;
         TecGridData dataset;
+        GridIndex gridIndex;
+        // Generation of the newest render requested; shared with the workers,
+        // which skip renders that are no longer the newest.
+        std::shared_ptr<std::atomic<qint64>> renderGeneration = std::make_shared<std::atomic<qint64>>(0);
         QUrl overlaySource;
-        QString overlayPath;
         QString statusText = QStringLiteral("TEC waiting for GNSS UTC time");
         QString datasetLabel = QStringLiteral("TEC unavailable");
         bool loading = false;
     };
 
+    struct RenderResult {
+        QImage image;
+        GridIndex gridIndex;
+        qint64 queueMs = 0;
+        qint64 renderMs = 0;
+        bool skipped = false;
+    };
+
+    static GridIndex buildGridIndex(const TecGridData &dataset);
+    // Safe on any thread.
+    static RenderResult renderOverlay(const TecGridData &dataset);
+
     void reloadPlugin();
     void connectPluginSignals(QObject *pluginObject);
     void disconnectPluginSignals();
@@ -102,7 +169,21 @@ private:
     void setSourceStatusText(int index, const QString &text);
     void updateDatasetLabel(int index);
     void clearOverlay(int index);
+    // Returns the new generation, which supersedes any render in flight.
+    qint64 beginRender(int index);
     void renderDataset(int index, const TecGridData &dataset);
+    void finishRender(const QString &pluginId,
+                      qint64 generation,
+                      const TecGridData &dataset,
+                      const RenderResult &result,
+                      const QElapsedTimer &sinceDataReady);
+
+    struct OverlayImage {
+        QImage image;
+        // Running since the dataset arrived, until the image is first served.
+        QElapsedTimer sinceDataReady;
+        bool served = false;
+    };
 
     AppSettings *m_settings = nullptr;
     std::unique_ptr<TecPluginLoader> m_pluginLoader;
@@ -119,6 +200,17 @@ private:
     int m_activeSourceIndex = -1;
     QString m_activeSourceId;
     qint64 m_revision = 0;
+    // Keyed by plugin id; read by the image provider off the GUI thread.
+    QMutex m_overlayMutex;
+    QHash<QString, OverlayImage> m_overlayImages;
+    std::atomic<qint64> m_overlayLatencyMs{-1};
+    qint64 m_renderGeneration = 0;
+    qint64 m_lastRenderMs = -1;
+    qint64 m_lastQueueMs = -1;
+    int m_completedRenders = 0;
+    int m_droppedRenders = 0;
+    int m_pendingRenders = 0;
+    QThreadPool m_renderPool;
     bool m_loading = false;
     bool m_pluginsEnabled = true;
 };
@@ -1,14 +1,18 @@
 #include "TecMapRenderer.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <memory>
 
-#include <QBrush>
 #include <QColor>
-#include <QPainter>
-#include <QPainterPath>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPointF>
-#include <QVector>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 
 namespace hdgnss {
 
@@ -19,6 +23,10 @@ constexpr double kWorldHeight = 182.592;
 constexpr double kPi = 3.14159265358979323846;
 constexpr double kDefaultLonStepDegrees = 5.0;
 constexpr double kDefaultLatStepDegrees = 2.5;
+constexpr int kColorLevels = 256;
+constexpr double kEdgeTolerance = 1e-9;
+// Fewer rows than this per worker are not worth a thread.
+constexpr int kMinRowsPerWorker = 64;
 
 constexpr double kRobinsonX[] = {
     1.0, 0.9986, 0.9954, 0.99, 0.9822, 0.973, 0.96, 0.9427, 0.9216,
@@ -99,8 +107,10 @@ QColor interpolateColor(const QColor &from, const QColor &to, double t) {
         lerp(from.alphaF(), to.alphaF(), t));
 }
 
-QColor tecColor(double value, double minTec, double maxTec) {
-    static const QVector<TecColorStop> kStops = {
+// kColorLevels premultiplied colors spread evenly from the lowest to the
+// highest TEC.
+std::array<QRgb, kColorLevels> buildColorTable() {
+    const std::array<TecColorStop, 7> stops = {{
         {0.00, QColor(33, 60, 125, 192)},
         {0.18, QColor(43, 110, 204, 192)},
         {0.36, QColor(63, 198, 255, 192)},
@@ -108,60 +118,140 @@ QColor tecColor(double value, double minTec, double maxTec) {
         {0.72, QColor(255, 214, 102, 192)},
         {0.86, QColor(255, 140, 66, 192)},
         {1.00, QColor(213, 38, 61, 192)}
-    };
-
-    if (maxTec - minTec < 1e-6) {
-        return kStops.last().color;
+    }};
+
+    std::array<QRgb, kColorLevels> table{};
+    for (int level = 0; level < kColorLevels; ++level) {
+        const double normalized = static_cast<double>(level) / (kColorLevels - 1);
+        QColor color = stops.back().color;
+        for (size_t i = 1; i < stops.size(); ++i) {
+            if (normalized <= stops[i].position) {
+                const TecColorStop &left = stops[i - 1];
+                const TecColorStop &right = stops[i];
+                color = interpolateColor(left.color, right.color,
+                                         (normalized - left.position) / (right.position - left.position));
+                break;
+            }
+        }
+        table[static_cast<size_t>(level)] = qPremultiply(color.rgba());
     }
+    return table;
+}
 
-    const double normalized = clamp((value - minTec) / (maxTec - minTec), 0.0, 1.0);
-    for (int i = 1; i < kStops.size(); ++i) {
-        if (normalized <= kStops.at(i).position) {
-            const TecColorStop &left = kStops.at(i - 1);
-            const TecColorStop &right = kStops.at(i);
-            const double section = (normalized - left.position) / (right.position - left.position);
-            return interpolateColor(left.color, right.color, section);
+const std::array<QRgb, kColorLevels> &colorTable() {
+    static const std::array<QRgb, kColorLevels> table = buildColorTable();
+    return table;
+}
+
+// Sorted cell edges with values closer than kEdgeTolerance merged, so
+// neighbouring cells share their edge vertices exactly.
+QList<double> uniqueEdges(QList<double> edges) {
+    std::sort(edges.begin(), edges.end());
+    QList<double> unique;
+    unique.reserve(edges.size());
+    for (const double edge : std::as_const(edges)) {
+        if (unique.isEmpty() || edge - unique.last() > kEdgeTolerance) {
+            unique.append(edge);
         }
     }
-    return kStops.last().color;
+    return unique;
 }
 
-QPainterPath cellPath(int width,
-                      int height,
-                      double lonMin,
-                      double lonMax,
-                      double latMin,
-                      double latMax) {
-    const double stepDegrees = std::max(0.5, (lonMax - lonMin) / 4.0);
-    QPainterPath path;
-    bool firstPoint = true;
-
-    auto addPoint = [&](double lon, double lat) {
-        const QPointF point = projectedCanvasPoint(width, height, lon, lat);
-        if (!std::isfinite(point.x()) || !std::isfinite(point.y())) {
-            return;
-        }
-        if (firstPoint) {
-            path.moveTo(point);
-            firstPoint = false;
-        } else {
-            path.lineTo(point);
-        }
-    };
+int edgeIndex(const QList<double> &edges, double value) {
+    const auto it = std::lower_bound(edges.cbegin(), edges.cend(), value - kEdgeTolerance);
+    return static_cast<int>(std::min<qsizetype>(it - edges.cbegin(), edges.size() - 1));
+}
 
-    for (double lon = lonMin; lon <= lonMax + 0.001; lon += stepDegrees) {
-        addPoint(std::min(lon, lonMax), latMin);
+// Canvas position of every crossing of a longitude and a latitude edge, for
+// one output size.
+struct ProjectedMesh {
+    QSize size;
+    QList<double> longitudes;
+    QList<double> latitudes;
+    // Latitude-major.
+    QList<QPointF> vertices;
+
+    const QPointF &vertex(int longitudeIndex, int latitudeIndex) const {
+        return vertices.at(latitudeIndex * longitudes.size() + longitudeIndex);
     }
-    addPoint(lonMax, latMin);
-    for (double lon = lonMax; lon >= lonMin - 0.001; lon -= stepDegrees) {
-        addPoint(std::max(lon, lonMin), latMax);
+};
+
+// The last mesh is kept, so re-rendering the same grid at the same size
+// projects nothing.
+std::shared_ptr<const ProjectedMesh> projectedMesh(const QSize &size,
+                                                   const QList<double> &longitudes,
+                                                   const QList<double> &latitudes) {
+    static QMutex mutex;
+    static std::shared_ptr<const ProjectedMesh> cached;
+
+    QMutexLocker locker(&mutex);
+    if (cached && cached->size == size && cached->longitudes == longitudes && cached->latitudes == latitudes) {
+        return cached;
     }
-    addPoint(lonMin, latMax);
 
-    if (!firstPoint) {
-        path.closeSubpath();
+    auto mesh = std::make_shared<ProjectedMesh>();
+    mesh->size = size;
+    mesh->longitudes = longitudes;
+    mesh->latitudes = latitudes;
+    mesh->vertices.reserve(longitudes.size() * latitudes.size());
+    for (const double latitude : latitudes) {
+        for (const double longitude : longitudes) {
+            mesh->vertices.append(projectedCanvasPoint(size.width(), size.height(), longitude, latitude));
+        }
+    }
+    cached = mesh;
+    return cached;
+}
+
+struct RasterCell {
+    int west = 0;
+    int east = 0;
+    int south = 0;
+    int north = 0;
+    QRgb color = 0;
+};
+
+// Shared by every render, so renders running side by side, such as the
+// overlay model's workers, split one set of idealThreadCount() threads.
+QThreadPool &rasterPool() {
+    static QThreadPool pool;
+    return pool;
+}
+
+// Fills the cells' pixels in rows [firstRow, endRow) of an image of `width`
+// pixels at `bits`. A pixel belongs to a cell when its center lies inside the
+// cell's projected quad, left and top edges inclusive, so cells sharing an
+// edge neither overlap nor leave a gap.
+void rasterizeRows(uchar *bits,
+                   qsizetype bytesPerLine,
+                   int width,
+                   const ProjectedMesh &mesh,
+                   const QList<RasterCell> &cells,
+                   int firstRow,
+                   int endRow) {
+    for (const RasterCell &cell : cells) {
+        const QPointF &northWest = mesh.vertex(cell.west, cell.north);
+        const QPointF &northEast = mesh.vertex(cell.east, cell.north);
+        const QPointF &southWest = mesh.vertex(cell.west, cell.south);
+        const QPointF &southEast = mesh.vertex(cell.east, cell.south);
+        // Latitude alone fixes y, so the north and south edges are level.
+        const double top = northWest.y();
+        const double bottom = southWest.y();
+        const int rowBegin = std::max(firstRow, static_cast<int>(std::ceil(top - 0.5)));
+        const int rowEnd = std::min(endRow, static_cast<int>(std::ceil(bottom - 0.5)));
+        for (int row = rowBegin; row < rowEnd; ++row) {
+            const double t = (row + 0.5 - top) / (bottom - top);
+            const double left = lerp(northWest.x(), southWest.x(), t);
+            const double right = lerp(northEast.x(), southEast.x(), t);
+            const int columnBegin = std::max(0, static_cast<int>(std::ceil(left - 0.5)));
+            const int columnEnd = std::min(width, static_cast<int>(std::ceil(right - 0.5)));
+            if (columnBegin >= columnEnd) {
+                continue;
+            }
+            QRgb *const line = reinterpret_cast<QRgb *>(bits + row * bytesPerLine);
+            std::fill(line + columnBegin, line + columnEnd, cell.color);
+        }
     }
-    return path;
 }
 
 }  // namespace
@@ -196,12 +286,23 @@ QImage TecMapRenderer::render(const TecGridData &dataset, const QSize &size) {
     const double lonHalfStep = (dataset.longitudeStepDegrees > 0.0 ? dataset.longitudeStepDegrees : kDefaultLonStepDegrees) * 0.5;
     const double latHalfStep = (dataset.latitudeStepDegrees > 0.0 ? dataset.latitudeStepDegrees : kDefaultLatStepDegrees) * 0.5;
 
-    QPainter painter(&image);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
-    painter.setPen(Qt::NoPen);
-
+    struct CellBounds {
+        double lonMin;
+        double lonMax;
+        double latMin;
+        double latMax;
+        double tec;
+    };
+    QList<CellBounds> bounds;
+    bounds.reserve(dataset.samples.size());
+    QList<double> longitudes;
+    QList<double> latitudes;
+    longitudes.reserve(dataset.samples.size() * 2);
+    latitudes.reserve(dataset.samples.size() * 2);
     for (const TecSample &sample : dataset.samples) {
+        if (!std::isfinite(sample.longitude) || !std::isfinite(sample.latitude)) {
+            continue;
+        }
         const double lonMin = clamp(sample.longitude - lonHalfStep, -180.0, 180.0);
         const double lonMax = clamp(sample.longitude + lonHalfStep, -180.0, 180.0);
         const double latMin = clamp(sample.latitude - latHalfStep, -90.0, 90.0);
@@ -209,12 +310,57 @@ QImage TecMapRenderer::render(const TecGridData &dataset, const QSize &size) {
         if (lonMax <= lonMin || latMax <= latMin) {
             continue;
         }
+        bounds.append({lonMin, lonMax, latMin, latMax, sample.tec});
+        longitudes.append(lonMin);
+        longitudes.append(lonMax);
+        latitudes.append(latMin);
+        latitudes.append(latMax);
+    }
+    if (bounds.isEmpty()) {
+        return image;
+    }
 
-        const QColor color = tecColor(sample.tec, minTec, maxTec);
-        painter.setBrush(QBrush(color));
-        painter.drawPath(cellPath(image.width(), image.height(), lonMin, lonMax, latMin, latMax));
+    const std::shared_ptr<const ProjectedMesh> mesh =
+        projectedMesh(size, uniqueEdges(std::move(longitudes)), uniqueEdges(std::move(latitudes)));
+    const std::array<QRgb, kColorLevels> &colors = colorTable();
+    QList<RasterCell> cells;
+    cells.reserve(bounds.size());
+    for (const CellBounds &cell : std::as_const(bounds)) {
+        const double normalized = clamp((cell.tec - minTec) / (maxTec - minTec), 0.0, 1.0);
+        cells.append({edgeIndex(mesh->longitudes, cell.lonMin),
+                      edgeIndex(mesh->longitudes, cell.lonMax),
+                      edgeIndex(mesh->latitudes, cell.latMin),
+                      edgeIndex(mesh->latitudes, cell.latMax),
+                      colors[static_cast<size_t>(std::lround(normalized * (kColorLevels - 1)))]});
     }
 
+    // Workers take disjoint bands of rows, so they never write the same
+    // pixel. The pointer is taken here, so the image is detached once and
+    // no worker touches the QImage itself.
+    uchar *const bits = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+    const int height = image.height();
+    const int workers = std::clamp(height / kMinRowsPerWorker, 1, QThread::idealThreadCount());
+    const int rowsPerWorker = (height + workers - 1) / workers;
+    // The first band is always ours; a band no pool thread is free for is
+    // ours too, so a busy pool never queues work behind another render.
+    QSemaphore finished;
+    int started = 0;
+    for (int firstRow = rowsPerWorker; firstRow < height; firstRow += rowsPerWorker) {
+        const int endRow = std::min(height, firstRow + rowsPerWorker);
+        const bool handedOff = rasterPool().tryStart([&, firstRow, endRow]() {
+            rasterizeRows(bits, bytesPerLine, width, *mesh, cells, firstRow, endRow);
+            finished.release();
+        });
+        if (handedOff) {
+            ++started;
+        } else {
+            rasterizeRows(bits, bytesPerLine, width, *mesh, cells, firstRow, endRow);
+        }
+    }
+    rasterizeRows(bits, bytesPerLine, width, *mesh, cells, 0, std::min(height, rowsPerWorker));
+    finished.acquire(started);
     return image;
 }
 
@@ -7,6 +7,12 @@
 
 namespace hdgnss {
 
+// Rasterizes a TEC grid onto the Robinson world canvas. Cell corners are
+// projected once per grid and output size into a cached mesh; each cell is
+// then filled scanline by scanline straight into the image, from a 256-level
+// premultiplied color table, with bands of rows spread over a thread pool
+// shared by all renders; the calling thread takes the bands the pool has no
+// free thread for.
 class TecMapRenderer {
 public:
     static QSize defaultOverlaySize();
@@ -0,0 +1,472 @@
+#include "ReplayTransport.h"
+
+#include <limits>
+
+#include <QFileInfo>
+#include <QLocale>
+#include <QUrl>
+
+namespace hdgnss {
+
+namespace {
+
+// Keeps each emission well inside StreamChunker's 256 KiB buffer.
+constexpr qint64 kChunkBytes = 64 * 1024;
+// Longest a single pump may hold the event loop before yielding.
+constexpr qint64 kSliceNs = 20 * 1000 * 1000;
+constexpr int kUntimedTickMs = 20;
+constexpr int kMaxTimedWaitMs = 250;
+constexpr qint64 kPositionNotifyMs = 100;
+
+}  // namespace
+
+ReplayTransport::ReplayTransport(QObject *parent)
+    : ITransport(QStringLiteral("Replay"), parent) {
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &ReplayTransport::pump);
+}
+
+bool ReplayTransport::openWithSettings(const QVariantMap &settings) {
+    close();
+
+    auto fail = [this](const QString &message) {
+        if (m_file.isOpen()) {
+            m_file.close();
+        }
+        setStatus(message);
+        emit errorOccurred(message);
+        emitOpenChanged();
+        return false;
+    };
+
+    QString path = settings.value(QStringLiteral("path")).toString().trimmed();
+    if (path.startsWith(QStringLiteral("file:"))) {
+        path = QUrl(path).toLocalFile();
+    }
+    if (path.isEmpty()) {
+        return fail(QStringLiteral("Replay: no capture file selected"));
+    }
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(QStringLiteral("Replay open failed: %1").arg(m_file.errorString()));
+    }
+    const qint64 fileSize = m_file.size();
+    if (fileSize <= 0) {
+        return fail(QStringLiteral("Replay: %1 is empty").arg(QFileInfo(path).fileName()));
+    }
+    m_data = m_file.map(0, fileSize);
+    if (!m_data) {
+        return fail(QStringLiteral("Replay map failed: %1").arg(m_file.errorString()));
+    }
+    m_size = fileSize;
+
+    QFile indexFile(CaptureIndex::indexPathForCapture(path));
+    if (indexFile.open(QIODevice::ReadOnly)) {
+        const qint64 indexSize = indexFile.size();
+        if (uchar *indexData = indexSize > 0 ? indexFile.map(0, indexSize) : nullptr) {
+            m_records = CaptureIndex::parse(indexData, indexSize);
+            indexFile.unmap(indexData);
+        }
+    }
+    // An index from another session would misplace every byte; fall back to
+    // the nominal rate rather than replaying garbage timing.
+    if (!m_records.isEmpty()
+        && m_records.constLast().offset + m_records.constLast().length > m_size) {
+        m_records.clear();
+    }
+    m_firstTimestampMs = m_records.isEmpty() ? 0 : m_records.constFirst().timestampMs;
+
+    // Keyframe offsets are write boundaries from the index, so they are only
+    // trusted alongside it.
+    QFile keyframeFile(CaptureKeyframes::keyframePathForCapture(path));
+    if (!m_records.isEmpty() && keyframeFile.open(QIODevice::ReadOnly)) {
+        m_keyframes = CaptureKeyframes::parse(keyframeFile.readAll());
+        while (!m_keyframes.isEmpty() && m_keyframes.constLast().offset > m_size) {
+            m_keyframes.removeLast();
+        }
+    }
+
+    m_speed = qMax(0.0, settings.value(QStringLiteral("speed"), 1.0).toDouble());
+    m_bytesPerSecond = qMax<qint64>(1, settings.value(QStringLiteral("bytesPerSecond"), 11520).toLongLong());
+    m_includeTx = settings.value(QStringLiteral("includeTx"), false).toBool();
+    m_paused = settings.value(QStringLiteral("paused"), false).toBool();
+    m_position = 0;
+    m_nextRecord = 0;
+    m_catchUpUntil = 0;
+    m_finished = false;
+    restartClock(0);
+
+    emit replayChanged();
+    notifyPosition(true);
+    emitOpenChanged();
+    schedule(0);
+    return true;
+}
+
+void ReplayTransport::close() {
+    m_timer.stop();
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_records.clear();
+    m_keyframes.clear();
+    m_catchUpUntil = 0;
+    m_size = 0;
+    m_position = 0;
+    m_nextRecord = 0;
+    m_firstTimestampMs = 0;
+    m_paused = false;
+    m_finished = false;
+    setStatus(QStringLiteral("Replay stopped"));
+    emit replayChanged();
+    emit positionChanged();
+    emitOpenChanged();
+}
+
+bool ReplayTransport::isOpen() const {
+    return m_data != nullptr;
+}
+
+bool ReplayTransport::sendData(const QByteArray &payload) {
+    Q_UNUSED(payload);
+    return false;
+}
+
+QStringList ReplayTransport::capabilities() const {
+    return {
+        QStringLiteral("rx"),
+        QStringLiteral("replay")
+    };
+}
+
+QString ReplayTransport::sessionQualifier() const {
+    if (!m_data) {
+        return {};
+    }
+    return QFileInfo(m_file.fileName()).completeBaseName();
+}
+
+QString ReplayTransport::filePath() const {
+    return m_data ? m_file.fileName() : QString();
+}
+
+qint64 ReplayTransport::size() const {
+    return m_size;
+}
+
+qint64 ReplayTransport::position() const {
+    return m_position;
+}
+
+qint64 ReplayTransport::durationMs() const {
+    if (!m_records.isEmpty()) {
+        return m_records.constLast().timestampMs - m_firstTimestampMs;
+    }
+    return captureMsAtOffset(m_size);
+}
+
+qint64 ReplayTransport::positionMs() const {
+    return captureMsAtOffset(m_position);
+}
+
+double ReplayTransport::speed() const {
+    return m_speed;
+}
+
+bool ReplayTransport::isPaused() const {
+    return m_paused;
+}
+
+bool ReplayTransport::isTimed() const {
+    return !m_records.isEmpty();
+}
+
+bool ReplayTransport::isFinished() const {
+    return m_finished;
+}
+
+void ReplayTransport::setSpeed(double speed) {
+    const double clamped = qMax(0.0, speed);
+    if (qFuzzyCompare(m_speed + 1.0, clamped + 1.0)) {
+        return;
+    }
+    const qint64 anchorMs = m_speed > 0.0 ? targetCaptureMs() : positionMs();
+    m_speed = clamped;
+    restartClock(anchorMs);
+    updateStatus();
+    emit replayChanged();
+    schedule(0);
+}
+
+void ReplayTransport::setPaused(bool paused) {
+    if (m_paused == paused) {
+        return;
+    }
+    if (paused) {
+        m_clockAnchorMs = m_speed > 0.0 ? targetCaptureMs() : positionMs();
+        m_paused = true;
+        m_timer.stop();
+    } else {
+        m_paused = false;
+        restartClock(m_clockAnchorMs);
+    }
+    updateStatus();
+    emit replayChanged();
+    schedule(0);
+}
+
+void ReplayTransport::pause() {
+    setPaused(true);
+}
+
+void ReplayTransport::resume() {
+    setPaused(false);
+}
+
+void ReplayTransport::seek(qint64 byteOffset) {
+    if (!m_data) {
+        return;
+    }
+    const qint64 target = qBound<qint64>(0, byteOffset, m_size);
+    m_position = target;
+    m_catchUpUntil = 0;
+    QByteArray keyframeState;
+    const qsizetype keyframe = CaptureKeyframes::keyframeAtOffset(m_keyframes, target);
+    if (keyframe >= 0) {
+        m_position = m_keyframes.at(keyframe).offset;
+        m_catchUpUntil = target;
+        keyframeState = m_keyframes.at(keyframe).state;
+    }
+    qint64 anchorMs = captureMsAtOffset(target);
+    if (!m_records.isEmpty()) {
+        m_nextRecord = qMax<qsizetype>(0, CaptureIndex::recordAtOffset(m_records, m_position));
+        anchorMs = m_records.at(qMax<qsizetype>(0, CaptureIndex::recordAtOffset(m_records, target))).timestampMs
+            - m_firstTimestampMs;
+    }
+    m_finished = false;
+    restartClock(anchorMs);
+    emit seeked(keyframeState);
+    notifyPosition(true);
+    schedule(0);
+}
+
+void ReplayTransport::seekToTime(qint64 positionMs) {
+    if (!m_data) {
+        return;
+    }
+    const qint64 clampedMs = qBound<qint64>(0, positionMs, durationMs());
+    if (m_records.isEmpty()) {
+        seek(clampedMs * m_bytesPerSecond / 1000);
+        return;
+    }
+    const qsizetype index = CaptureIndex::recordAtTime(m_records, m_firstTimestampMs + clampedMs);
+    seek(index < m_records.size() ? m_records.at(index).offset : m_size);
+}
+
+void ReplayTransport::pump() {
+    if (!m_data || m_finished || (m_paused && !catchingUp())) {
+        return;
+    }
+    QElapsedTimer slice;
+    slice.start();
+    int delayMs = 0;
+    if (catchingUp()) {
+        // Everything between the keyframe and the seek target is due at once,
+        // even while paused, so the receiver state matches the new position.
+        delayMs = pumpTimed(std::numeric_limits<qint64>::max(), m_catchUpUntil, slice);
+        if (delayMs >= 0) {
+            if (!catchingUp()) {
+                m_catchUpUntil = 0;
+                restartClock(m_clockAnchorMs);
+            }
+            delayMs = 0;
+        }
+    } else {
+        const qint64 targetMs = targetCaptureMs();
+        delayMs = m_records.isEmpty() ? pumpUntimed(targetMs, slice) : pumpTimed(targetMs, m_size, slice);
+    }
+    if (!m_data) {
+        // A receiver closed the replay from inside dataReceived().
+        return;
+    }
+    if (delayMs < 0) {
+        finish();
+        return;
+    }
+    notifyPosition(false);
+    schedule(delayMs);
+}
+
+int ReplayTransport::pumpTimed(qint64 targetMs, qint64 offsetLimit, const QElapsedTimer &slice) {
+    // Consecutive due RX writes are coalesced so small UART reads do not cost
+    // one signal each when replaying faster than real time.
+    qint64 pendingBegin = -1;
+    qint64 pendingEnd = -1;
+    auto flushPending = [&]() {
+        if (pendingBegin < 0) {
+            return true;
+        }
+        const qint64 begin = pendingBegin;
+        pendingBegin = -1;
+        return emitRange(begin, pendingEnd);
+    };
+
+    while (m_nextRecord < m_records.size() && slice.nsecsElapsed() < kSliceNs) {
+        const CaptureIndexRecord &record = m_records.at(m_nextRecord);
+        if (record.timestampMs - m_firstTimestampMs > targetMs || record.offset >= offsetLimit) {
+            break;
+        }
+        ++m_nextRecord;
+        const qint64 begin = qMax(record.offset, m_position);
+        const qint64 end = qMin(record.offset + record.length, m_size);
+        if (begin >= end) {
+            continue;
+        }
+        m_position = end;
+        if (record.direction == DataDirection::Tx && !m_includeTx) {
+            if (!flushPending()) {
+                return -1;
+            }
+            continue;
+        }
+        if (pendingBegin >= 0 && pendingEnd == begin && end - pendingBegin <= kChunkBytes) {
+            pendingEnd = end;
+            continue;
+        }
+        if (!flushPending()) {
+            return -1;
+        }
+        pendingBegin = begin;
+        pendingEnd = end;
+    }
+    if (!flushPending()) {
+        return -1;
+    }
+
+    if (m_nextRecord >= m_records.size()) {
+        // Bytes written after the last index record (recorder stopped
+        // mid-write) have no record, so their direction is unknown; they are
+        // replayed as received data whether or not TX is included, a chunk
+        // at a time within the slice like an untimed replay.
+        const qint64 tailEnd = qMin(m_size, offsetLimit);
+        while (m_position < tailEnd && slice.nsecsElapsed() < kSliceNs) {
+            const qint64 begin = m_position;
+            m_position = qMin(tailEnd, begin + kChunkBytes);
+            if (!emitRange(begin, m_position)) {
+                return -1;
+            }
+        }
+        return m_position < m_size ? 0 : -1;
+    }
+    if (m_speed <= 0.0) {
+        return 0;
+    }
+    const qint64 aheadMs = m_records.at(m_nextRecord).timestampMs - m_firstTimestampMs - targetCaptureMs();
+    return static_cast<int>(qBound<qint64>(0, static_cast<qint64>(aheadMs / m_speed), kMaxTimedWaitMs));
+}
+
+int ReplayTransport::pumpUntimed(qint64 targetMs, const QElapsedTimer &slice) {
+    const qint64 targetOffset = m_speed > 0.0
+        ? qMin(m_size, targetMs * m_bytesPerSecond / 1000)
+        : m_size;
+    while (m_position < targetOffset && slice.nsecsElapsed() < kSliceNs) {
+        const qint64 begin = m_position;
+        const qint64 end = qMin(targetOffset, begin + kChunkBytes);
+        m_position = end;
+        if (!emitRange(begin, end)) {
+            return -1;
+        }
+    }
+    if (m_position >= m_size) {
+        return -1;
+    }
+    return m_speed > 0.0 ? kUntimedTickMs : 0;
+}
+
+bool ReplayTransport::emitRange(qint64 begin, qint64 end) {
+    // Receivers may keep the payload beyond close(), so each emission owns a
+    // copy instead of aliasing the mapping with QByteArray::fromRawData().
+    for (qint64 offset = begin; offset < end && m_data; offset += kChunkBytes) {
+        const qint64 length = qMin(kChunkBytes, end - offset);
+        emit dataReceived(QByteArray(reinterpret_cast<const char *>(m_data + offset), length));
+    }
+    return m_data != nullptr;
+}
+
+void ReplayTransport::restartClock(qint64 anchorMs) {
+    m_clockAnchorMs = anchorMs;
+    m_clock.start();
+}
+
+void ReplayTransport::schedule(int delayMs) {
+    if (!m_data || m_finished || (m_paused && !catchingUp())) {
+        return;
+    }
+    m_timer.start(delayMs);
+}
+
+void ReplayTransport::finish() {
+    m_finished = true;
+    m_timer.stop();
+    notifyPosition(true);
+    emit finished();
+}
+
+void ReplayTransport::notifyPosition(bool force) {
+    if (!force && m_positionNotify.isValid() && m_positionNotify.elapsed() < kPositionNotifyMs) {
+        return;
+    }
+    m_positionNotify.start();
+    updateStatus();
+    emit positionChanged();
+}
+
+void ReplayTransport::updateStatus() {
+    if (!m_data) {
+        setStatus(QStringLiteral("Replay stopped"));
+        return;
+    }
+    const QLocale locale;
+    const QString fileName = QFileInfo(m_file.fileName()).fileName();
+    const QString progress = QStringLiteral("%1 / %2")
+                                 .arg(locale.formattedDataSize(m_position), locale.formattedDataSize(m_size));
+    if (m_finished) {
+        setStatus(QStringLiteral("Replay finished %1 (%2)").arg(fileName, progress));
+    } else if (m_paused) {
+        setStatus(QStringLiteral("Replay paused %1 (%2)").arg(fileName, progress));
+    } else {
+        const QString speedText = m_speed > 0.0
+            ? QStringLiteral("%1x").arg(m_speed, 0, 'g', 3)
+            : QStringLiteral("max speed");
+        setStatus(QStringLiteral("Replaying %1 at %2 (%3)").arg(fileName, speedText, progress));
+    }
+}
+
+qint64 ReplayTransport::targetCaptureMs() const {
+    if (m_speed <= 0.0) {
+        return std::numeric_limits<qint64>::max();
+    }
+    if (m_paused) {
+        return m_clockAnchorMs;
+    }
+    return m_clockAnchorMs + static_cast<qint64>(static_cast<double>(m_clock.elapsed()) * m_speed);
+}
+
+qint64 ReplayTransport::captureMsAtOffset(qint64 byteOffset) const {
+    if (m_records.isEmpty()) {
+        return byteOffset * 1000 / m_bytesPerSecond;
+    }
+    const qsizetype index = CaptureIndex::recordAtOffset(m_records, byteOffset);
+    return index < 0 ? 0 : m_records.at(index).timestampMs - m_firstTimestampMs;
+}
+
+bool ReplayTransport::catchingUp() const {
+    return m_position < m_catchUpUntil;
+}
+
+}  // namespace hdgnss
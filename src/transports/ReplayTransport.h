@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QTimer>
+
+#include "ITransport.h"
+#include "src/storage/CaptureIndex.h"
+#include "src/storage/CaptureKeyframes.h"
+
+namespace hdgnss {
+
+// Virtual transport that memory-maps a recorded "<stem>.raw.bin" capture and
+// emits it through dataReceived() as if it arrived from a device. Timing comes
+// from the "<stem>.raw.idx" sidecar when present, otherwise from a nominal
+// byte rate. A speed of 0 replays as fast as the pipeline consumes it.
+// Seeking in a capture with a "<stem>.raw.kf" sidecar resumes from the nearest
+// earlier keyframe and replays the bytes up to the target unpaced, so receiver
+// state is current without decoding the capture from the start.
+class ReplayTransport : public ITransport {
+    Q_OBJECT
+    Q_PROPERTY(QString filePath READ filePath NOTIFY replayChanged)
+    Q_PROPERTY(qint64 size READ size NOTIFY replayChanged)
+    Q_PROPERTY(qint64 position READ position NOTIFY positionChanged)
+    Q_PROPERTY(qint64 durationMs READ durationMs NOTIFY replayChanged)
+    Q_PROPERTY(qint64 positionMs READ positionMs NOTIFY positionChanged)
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY replayChanged)
+    Q_PROPERTY(bool paused READ isPaused WRITE setPaused NOTIFY replayChanged)
+    Q_PROPERTY(bool timed READ isTimed NOTIFY replayChanged)
+    Q_PROPERTY(bool finished READ isFinished NOTIFY positionChanged)
+
+public:
+    explicit ReplayTransport(QObject *parent = nullptr);
+
+    // Settings: "path", "speed" (default 1.0, 0 = as fast as possible),
+    // "paused", "includeTx" and "bytesPerSecond" for captures without an index.
+    bool openWithSettings(const QVariantMap &settings) override;
+    void close() override;
+    bool isOpen() const override;
+    bool sendData(const QByteArray &payload) override;
+    QStringList capabilities() const override;
+    QString sessionQualifier() const override;
+
+    QString filePath() const;
+    qint64 size() const;
+    qint64 position() const;
+    qint64 durationMs() const;
+    qint64 positionMs() const;
+    double speed() const;
+    bool isPaused() const;
+    bool isTimed() const;
+    bool isFinished() const;
+
+public slots:
+    void setSpeed(double speed);
+    void setPaused(bool paused);
+    void pause();
+    void resume();
+    void seek(qint64 byteOffset);
+    void seekToTime(qint64 positionMs);
+
+signals:
+    void replayChanged();
+    void positionChanged();
+    // Bytes before the new position no longer precede the next emission, so
+    // any partially assembled frames for this stream must be dropped. A
+    // non-empty keyframeState is the receiver state valid at the new position.
+    void seeked(const QByteArray &keyframeState);
+    void finished();
+
+private:
+    void pump();
+    // Both return the delay until the next pump in ms, or -1 at the end.
+    int pumpTimed(qint64 targetMs, qint64 offsetLimit, const QElapsedTimer &slice);
+    int pumpUntimed(qint64 targetMs, const QElapsedTimer &slice);
+    bool emitRange(qint64 begin, qint64 end);
+    void restartClock(qint64 anchorMs);
+    void schedule(int delayMs);
+    void finish();
+    void notifyPosition(bool force);
+    void updateStatus();
+    qint64 targetCaptureMs() const;
+    qint64 captureMsAtOffset(qint64 byteOffset) const;
+    bool catchingUp() const;
+
+    QFile m_file;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_position = 0;
+    QList<CaptureIndexRecord> m_records;
+    qsizetype m_nextRecord = 0;
+    qint64 m_firstTimestampMs = 0;
+    QList<CaptureKeyframe> m_keyframes;
+    // Seek target still being reached from a keyframe.
+    qint64 m_catchUpUntil = 0;
+    double m_speed = 1.0;
+    qint64 m_bytesPerSecond = 11520;
+    bool m_includeTx = false;
+    bool m_paused = false;
+    bool m_finished = false;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_clockAnchorMs = 0;
+    QElapsedTimer m_positionNotify;
+};
+
+}  // namespace hdgnss
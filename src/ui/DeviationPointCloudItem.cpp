@@ -0,0 +1,396 @@
+#include "DeviationPointCloudItem.h"
+
+#include <QMatrix4x4>
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGSimpleTextureNode>
+#include <QSGTransformNode>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace hdgnss {
+
+namespace {
+
+QSGGeometryNode *createSquaresNode(const QColor &color) {
+    auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    auto *material = new QSGFlatColorMaterial;
+    material->setColor(color);
+    auto *node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(material);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+void setNodeColor(QSGGeometryNode *node, const QColor &color) {
+    static_cast<QSGFlatColorMaterial *>(node->material())->setColor(color);
+    node->markDirty(QSGNode::DirtyMaterial);
+}
+
+}  // namespace
+
+DeviationPointCloudItem::DeviationPointCloudItem(QQuickItem *parent)
+    : QQuickItem(parent) {
+    setFlag(ItemHasContents, true);
+    m_densityRefreshTimer.setSingleShot(true);
+    connect(&m_densityRefreshTimer, &QTimer::timeout, this, &QQuickItem::update);
+}
+
+DeviationMapModel *DeviationPointCloudItem::model() const {
+    return m_model;
+}
+
+void DeviationPointCloudItem::setModel(DeviationMapModel *model) {
+    if (m_model == model) {
+        return;
+    }
+    if (m_model) {
+        disconnect(m_model, nullptr, this, nullptr);
+    }
+    m_model = model;
+    if (m_model) {
+        connect(m_model, &QAbstractItemModel::rowsInserted, this,
+                [this](const QModelIndex &, int first, int) { markDirtyFrom(first); });
+        connect(m_model, &QAbstractItemModel::rowsRemoved, this,
+                [this](const QModelIndex &, int first, int) { markDirtyFrom(first); });
+        connect(m_model, &QAbstractItemModel::dataChanged, this,
+                [this](const QModelIndex &topLeft, const QModelIndex &, const QList<int> &roles) {
+                    // LatestRole changes are covered by the latest node, which is redrawn every update.
+                    if (roles.isEmpty() || roles.contains(DeviationMapModel::EastMetersRole)
+                        || roles.contains(DeviationMapModel::NorthMetersRole)) {
+                        markDirtyFrom(topLeft.row());
+                    }
+                });
+        connect(m_model, &QAbstractItemModel::modelReset, this, &DeviationPointCloudItem::markAllDirty);
+        connect(m_model, &DeviationMapModel::centerOffsetChanged, this, &QQuickItem::update);
+    }
+    m_densityDirty = true;
+    markAllDirty();
+    emit modelChanged();
+}
+
+QPointF DeviationPointCloudItem::origin() const {
+    return m_origin;
+}
+
+void DeviationPointCloudItem::setOrigin(const QPointF &origin) {
+    if (m_origin == origin) {
+        return;
+    }
+    m_origin = origin;
+    update();
+    emit originChanged();
+}
+
+qreal DeviationPointCloudItem::pixelsPerMeter() const {
+    return m_pixelsPerMeter;
+}
+
+void DeviationPointCloudItem::setPixelsPerMeter(qreal pixelsPerMeter) {
+    if (!(pixelsPerMeter > 0.0) || qFuzzyCompare(m_pixelsPerMeter, pixelsPerMeter)) {
+        return;
+    }
+    m_pixelsPerMeter = pixelsPerMeter;
+    // Point squares are sized in meters, so a new scale resizes all of them.
+    markAllDirty();
+    emit pixelsPerMeterChanged();
+}
+
+qreal DeviationPointCloudItem::pointSize() const {
+    return m_pointSize;
+}
+
+void DeviationPointCloudItem::setPointSize(qreal size) {
+    if (qFuzzyCompare(m_pointSize, size)) {
+        return;
+    }
+    m_pointSize = size;
+    markAllDirty();
+    emit pointSizeChanged();
+}
+
+qreal DeviationPointCloudItem::latestPointSize() const {
+    return m_latestPointSize;
+}
+
+void DeviationPointCloudItem::setLatestPointSize(qreal size) {
+    if (qFuzzyCompare(m_latestPointSize, size)) {
+        return;
+    }
+    m_latestPointSize = size;
+    update();
+    emit latestPointSizeChanged();
+}
+
+QColor DeviationPointCloudItem::color() const {
+    return m_color;
+}
+
+void DeviationPointCloudItem::setColor(const QColor &color) {
+    if (m_color == color) {
+        return;
+    }
+    m_color = color;
+    m_colorsDirty = true;
+    update();
+    emit colorChanged();
+}
+
+QColor DeviationPointCloudItem::latestColor() const {
+    return m_latestColor;
+}
+
+void DeviationPointCloudItem::setLatestColor(const QColor &color) {
+    if (m_latestColor == color) {
+        return;
+    }
+    m_latestColor = color;
+    m_colorsDirty = true;
+    update();
+    emit latestColorChanged();
+}
+
+int DeviationPointCloudItem::densityThreshold() const {
+    return m_densityThreshold;
+}
+
+void DeviationPointCloudItem::setDensityThreshold(int points) {
+    if (m_densityThreshold == points) {
+        return;
+    }
+    m_densityThreshold = points;
+    update();
+    emit densityThresholdChanged();
+}
+
+int DeviationPointCloudItem::recentPoints() const {
+    return m_recentPoints;
+}
+
+void DeviationPointCloudItem::setRecentPoints(int points) {
+    points = std::max(0, points);
+    if (m_recentPoints == points) {
+        return;
+    }
+    m_recentPoints = points;
+    update();
+    emit recentPointsChanged();
+}
+
+QColor DeviationPointCloudItem::densityColor() const {
+    return m_densityColor;
+}
+
+void DeviationPointCloudItem::setDensityColor(const QColor &color) {
+    if (m_densityColor == color) {
+        return;
+    }
+    m_densityColor = color;
+    m_densityDirty = true;
+    update();
+    emit densityColorChanged();
+}
+
+QSGNode *DeviationPointCloudItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
+    auto *root = static_cast<QSGTransformNode *>(oldNode);
+    if (!root) {
+        // A new scene graph, or the first frame: nothing of ours survives.
+        root = new QSGTransformNode;
+        m_pointNodes.clear();
+        m_firstPointNode = 0;
+        m_densityNode = nullptr;
+        m_latestNode = createSquaresNode(m_latestColor);
+        root->appendChildNode(m_latestNode);
+        m_dirtyFromRow = 0;
+        m_colorsDirty = false;
+        m_densityDirty = true;
+    }
+
+    const int count = m_model ? m_model->rowCount() : 0;
+    if (m_colorsDirty) {
+        for (QSGGeometryNode *node : std::as_const(m_pointNodes)) {
+            setNodeColor(node, m_color);
+        }
+        setNodeColor(m_latestNode, m_latestColor);
+        m_colorsDirty = false;
+    }
+    // Evicted samples are only in the density grid, so it decides.
+    const qint64 total = m_model ? m_model->densityGrid().sampleCount() : 0;
+    const bool dense = total > m_densityThreshold && densityLevel() >= 0;
+    updateDensityNode(root, dense);
+    updatePointNodes(root, count, dense ? std::max(0, count - m_recentPoints) / kPointsPerNode : 0);
+    fillSquares(m_latestNode, count - 1, count - 1, m_latestPointSize);
+
+    const QPointF center = m_model ? m_model->centerOffset() : QPointF();
+    QMatrix4x4 matrix;
+    matrix.translate(static_cast<float>(m_origin.x()), static_cast<float>(m_origin.y()));
+    matrix.scale(static_cast<float>(m_pixelsPerMeter), static_cast<float>(-m_pixelsPerMeter));
+    matrix.translate(static_cast<float>(-center.x()), static_cast<float>(-center.y()));
+    root->setMatrix(matrix);
+    return root;
+}
+
+void DeviationPointCloudItem::updatePointNodes(QSGTransformNode *root, int count, int firstNode) {
+    const int nodeCount = (count + kPointsPerNode - 1) / kPointsPerNode;
+    if (firstNode < m_firstPointNode) {
+        // Back from the density texture: the older nodes are gone.
+        qDeleteAll(m_pointNodes);
+        m_pointNodes.clear();
+    }
+    while (m_firstPointNode < firstNode && !m_pointNodes.isEmpty()) {
+        delete m_pointNodes.takeFirst();
+        ++m_firstPointNode;
+    }
+    m_firstPointNode = firstNode;
+    const qsizetype wanted = std::max(0, nodeCount - firstNode);
+    while (m_pointNodes.size() > wanted) {
+        delete m_pointNodes.takeLast();
+    }
+    while (m_pointNodes.size() < wanted) {
+        const int nodeIndex = m_firstPointNode + static_cast<int>(m_pointNodes.size());
+        m_dirtyFromRow = std::min(m_dirtyFromRow, nodeIndex * kPointsPerNode);
+        QSGGeometryNode *node = createSquaresNode(m_color);
+        // Keep the latest point drawn on top of the cloud.
+        root->insertChildNodeBefore(node, m_latestNode);
+        m_pointNodes.append(node);
+    }
+
+    for (int nodeIndex = std::max(firstNode, m_dirtyFromRow / kPointsPerNode); nodeIndex < nodeCount; ++nodeIndex) {
+        const int first = nodeIndex * kPointsPerNode;
+        fillSquares(m_pointNodes.at(nodeIndex - firstNode), first, std::min(count, first + kPointsPerNode) - 1,
+                    m_pointSize);
+    }
+    m_dirtyFromRow = count;
+}
+
+int DeviationPointCloudItem::densityLevel() const {
+    if (!m_model) {
+        return -1;
+    }
+    const DeviationDensityGrid &grid = m_model->densityGrid();
+    for (int level = 0; level < DeviationDensityGrid::kLevels; ++level) {
+        if (DeviationDensityGrid::binMeters(level) * m_pixelsPerMeter < 1.0 || !grid.hasLevel(level)) {
+            continue;
+        }
+        const QRect bounds = grid.bounds(level);
+        if (bounds.isEmpty()) {
+            return -1;
+        }
+        if (bounds.width() <= kMaxDensityTextureSide && bounds.height() <= kMaxDensityTextureSide) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+QImage DeviationPointCloudItem::densityImage(int level) const {
+    const DeviationDensityGrid &grid = m_model->densityGrid();
+    const QRect bounds = grid.bounds(level);
+    const QHash<quint64, quint32> &bins = grid.bins(level);
+    QImage image(bounds.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    quint32 densest = 1;
+    for (const quint32 count : bins) {
+        densest = std::max(densest, count);
+    }
+    // Log scale, with a floor so that single samples stay visible.
+    const double scale = 1.0 / std::log1p(static_cast<double>(densest));
+    const QRgb rgb = m_densityColor.rgb();
+    for (auto it = bins.cbegin(); it != bins.cend(); ++it) {
+        const double weight = std::log1p(static_cast<double>(it.value())) * scale;
+        const int alpha = qRound(m_densityColor.alphaF() * (0.25 + 0.75 * weight) * 255.0);
+        // Row 0 is the southernmost bin; the transform flips it to the bottom.
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(DeviationDensityGrid::binY(it.key()) - bounds.top()));
+        line[DeviationDensityGrid::binX(it.key()) - bounds.left()] =
+            qPremultiply(qRgba(qRed(rgb), qGreen(rgb), qBlue(rgb), alpha));
+    }
+    return image;
+}
+
+void DeviationPointCloudItem::updateDensityNode(QSGTransformNode *root, bool shown) {
+    if (!shown) {
+        delete m_densityNode;
+        m_densityNode = nullptr;
+        m_densityLevel = -1;
+        return;
+    }
+    const DeviationDensityGrid &grid = m_model->densityGrid();
+    const int level = densityLevel();
+    const QRect bounds = grid.bounds(level);
+    if (m_densityNode && !m_densityDirty && level == m_densityLevel && bounds == m_densityBounds) {
+        if (grid.revision() == m_densityRevision) {
+            return;
+        }
+        // Samples landed in bins the texture already covers; uploading up
+        // to kMaxDensityTextureSide squared texels per sample would cost
+        // more than the points it replaces, so batch them.
+        const qint64 waitMs = kDensityRefreshMs - m_densityAge.elapsed();
+        if (waitMs > 0) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, waitMs] {
+                    if (!m_densityRefreshTimer.isActive()) {
+                        m_densityRefreshTimer.start(static_cast<int>(waitMs));
+                    }
+                },
+                Qt::QueuedConnection);
+            return;
+        }
+    }
+    if (!m_densityNode) {
+        m_densityNode = new QSGSimpleTextureNode;
+        m_densityNode->setOwnsTexture(true);
+        m_densityNode->setFiltering(QSGTexture::Linear);
+        // Under the points.
+        root->prependChildNode(m_densityNode);
+    }
+    m_densityNode->setTexture(window()->createTextureFromImage(densityImage(level)));
+    const double binMeters = DeviationDensityGrid::binMeters(level);
+    m_densityNode->setRect(QRectF(bounds.left() * binMeters, bounds.top() * binMeters,
+                                  bounds.width() * binMeters, bounds.height() * binMeters));
+    m_densityLevel = level;
+    m_densityBounds = bounds;
+    m_densityRevision = grid.revision();
+    m_densityAge.start();
+    m_densityDirty = false;
+}
+
+void DeviationPointCloudItem::markDirtyFrom(int row) {
+    m_dirtyFromRow = std::min(m_dirtyFromRow, std::max(0, row));
+    update();
+}
+
+void DeviationPointCloudItem::markAllDirty() {
+    markDirtyFrom(0);
+}
+
+void DeviationPointCloudItem::fillSquares(QSGGeometryNode *node, int first, int last, qreal size) const {
+    QSGGeometry *geometry = node->geometry();
+    const int points = m_model && first >= 0 ? last - first + 1 : 0;
+    geometry->allocate(points * 6);
+    QSGGeometry::Point2D *vertex = geometry->vertexDataAsPoint2D();
+    const qreal half = size * 0.5 / m_pixelsPerMeter;
+    for (int row = first; row < first + points; ++row) {
+        const QPointF point = m_model->localPoint(row);
+        const float left = static_cast<float>(point.x() - half);
+        const float right = static_cast<float>(point.x() + half);
+        const float bottom = static_cast<float>(point.y() - half);
+        const float top = static_cast<float>(point.y() + half);
+        vertex[0].set(left, bottom);
+        vertex[1].set(right, bottom);
+        vertex[2].set(left, top);
+        vertex[3].set(left, top);
+        vertex[4].set(right, bottom);
+        vertex[5].set(right, top);
+        vertex += 6;
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QList>
+#include <QPointF>
+#include <QPointer>
+#include <QQuickItem>
+#include <QRect>
+#include <QTimer>
+
+#include "src/models/DeviationMapModel.h"
+
+class QSGGeometryNode;
+class QSGSimpleTextureNode;
+class QSGTransformNode;
+
+namespace hdgnss {
+
+// Draws the rows of a DeviationMapModel as a point cloud in the scene graph.
+// Vertices stay in the model's local east/north frame and the item maps them
+// to pixels with a single transform node, so a moving center only changes a
+// matrix. Points are grouped in nodes of kPointsPerNode; only the nodes from
+// the first changed row onwards are rebuilt, which for a new sample is the
+// last one.
+//
+// Past densityThreshold points the item switches to level of detail: the
+// model's density grid is drawn as one texture, at the finest level whose
+// bins are at least a pixel, and only the latest recentPoints samples (rounded
+// down to a whole node) are drawn as points. The texture has at most one
+// texel per pixel of the view, so the draw cost no longer grows with the
+// number of samples. It is rebuilt at once when the level or the grid bounds
+// change; new samples inside the bounds refresh it at most every
+// kDensityRefreshMs.
+class DeviationPointCloudItem : public QQuickItem {
+    Q_OBJECT
+    Q_PROPERTY(hdgnss::DeviationMapModel *model READ model WRITE setModel NOTIFY modelChanged)
+    // Where the center is drawn, in item coordinates.
+    Q_PROPERTY(QPointF origin READ origin WRITE setOrigin NOTIFY originChanged)
+    Q_PROPERTY(qreal pixelsPerMeter READ pixelsPerMeter WRITE setPixelsPerMeter NOTIFY pixelsPerMeterChanged)
+    Q_PROPERTY(qreal pointSize READ pointSize WRITE setPointSize NOTIFY pointSizeChanged)
+    Q_PROPERTY(qreal latestPointSize READ latestPointSize WRITE setLatestPointSize NOTIFY latestPointSizeChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor latestColor READ latestColor WRITE setLatestColor NOTIFY latestColorChanged)
+    Q_PROPERTY(int densityThreshold READ densityThreshold WRITE setDensityThreshold NOTIFY densityThresholdChanged)
+    Q_PROPERTY(int recentPoints READ recentPoints WRITE setRecentPoints NOTIFY recentPointsChanged)
+    // Color of the densest bin; sparser bins fade out on a log scale.
+    Q_PROPERTY(QColor densityColor READ densityColor WRITE setDensityColor NOTIFY densityColorChanged)
+
+public:
+    static constexpr int kPointsPerNode = 4096;
+    static constexpr int kDefaultDensityThreshold = 20000;
+    static constexpr int kDefaultRecentPoints = 2000;
+    // Coarser levels are used while the texture would be wider than this.
+    static constexpr int kMaxDensityTextureSide = 2048;
+    static constexpr int kDensityRefreshMs = 250;
+
+    explicit DeviationPointCloudItem(QQuickItem *parent = nullptr);
+
+    DeviationMapModel *model() const;
+    void setModel(DeviationMapModel *model);
+    QPointF origin() const;
+    void setOrigin(const QPointF &origin);
+    qreal pixelsPerMeter() const;
+    void setPixelsPerMeter(qreal pixelsPerMeter);
+    qreal pointSize() const;
+    void setPointSize(qreal size);
+    qreal latestPointSize() const;
+    void setLatestPointSize(qreal size);
+    QColor color() const;
+    void setColor(const QColor &color);
+    QColor latestColor() const;
+    void setLatestColor(const QColor &color);
+    int densityThreshold() const;
+    void setDensityThreshold(int points);
+    int recentPoints() const;
+    void setRecentPoints(int points);
+    QColor densityColor() const;
+    void setDensityColor(const QColor &color);
+
+signals:
+    void modelChanged();
+    void originChanged();
+    void pixelsPerMeterChanged();
+    void pointSizeChanged();
+    void latestPointSizeChanged();
+    void colorChanged();
+    void latestColorChanged();
+    void densityThresholdChanged();
+    void recentPointsChanged();
+    void densityColorChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    // Rows from `row` onwards need new vertices.
+    void markDirtyFrom(int row);
+    void markAllDirty();
+    // Squares of `size` pixels around each row in [first, last], in meters.
+    void fillSquares(QSGGeometryNode *node, int first, int last, qreal size) const;
+    // Nodes before firstNode are left to the density texture.
+    void updatePointNodes(QSGTransformNode *root, int count, int firstNode);
+    // The finest usable grid level at the current scale, or -1.
+    int densityLevel() const;
+    QImage densityImage(int level) const;
+    void updateDensityNode(QSGTransformNode *root, bool shown);
+
+    QPointer<DeviationMapModel> m_model;
+    QPointF m_origin;
+    qreal m_pixelsPerMeter = 1.0;
+    qreal m_pointSize = 5.0;
+    qreal m_latestPointSize = 8.0;
+    QColor m_color = QColor(255, 255, 255, 143);
+    QColor m_latestColor = Qt::white;
+    QColor m_densityColor = Qt::white;
+    int m_densityThreshold = kDefaultDensityThreshold;
+    int m_recentPoints = kDefaultRecentPoints;
+    int m_dirtyFromRow = 0;
+    bool m_colorsDirty = true;
+    bool m_densityDirty = true;
+    // Only touched from updatePaintNode(), while the GUI thread is blocked.
+    // m_pointNodes holds the nodes from m_firstPointNode onwards.
+    QList<QSGGeometryNode *> m_pointNodes;
+    int m_firstPointNode = 0;
+    QSGGeometryNode *m_latestNode = nullptr;
+    QSGSimpleTextureNode *m_densityNode = nullptr;
+    int m_densityLevel = -1;
+    QRect m_densityBounds;
+    quint64 m_densityRevision = 0;
+    QElapsedTimer m_densityAge;
+    // Lives on the GUI thread; asks for the frame that picks up samples
+    // held back by kDensityRefreshMs.
+    QTimer m_densityRefreshTimer;
+};
+
+}  // namespace hdgnss
@@ -0,0 +1,22 @@
+#include "TecOverlayImageProvider.h"
+
+namespace hdgnss {
+
+TecOverlayImageProvider::TecOverlayImageProvider(TecMapOverlayModel *model)
+    : QQuickImageProvider(QQuickImageProvider::Image)
+    , m_model(model) {
+}
+
+QImage TecOverlayImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize) {
+    const qsizetype separator = id.lastIndexOf(QLatin1Char('/'));
+    QImage image = m_model ? m_model->serveOverlayImage(separator < 0 ? id : id.left(separator)) : QImage();
+    if (size) {
+        *size = image.size();
+    }
+    if (!image.isNull() && requestedSize.width() > 0 && requestedSize.height() > 0 && requestedSize != image.size()) {
+        image = image.scaled(requestedSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+}  // namespace hdgnss
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QQuickImageProvider>
+
+#include "src/tec/TecMapOverlayModel.h"
+
+namespace hdgnss {
+
+// Serves TecMapOverlayModel overlays to QML from memory. Ids are
+// <plugin id>/<revision>; the revision only keeps QML from reusing an older
+// image, the latest overlay of the source is always returned.
+class TecOverlayImageProvider : public QQuickImageProvider {
+public:
+    // The model must outlive the QML engine the provider is added to.
+    explicit TecOverlayImageProvider(TecMapOverlayModel *model);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+private:
+    TecMapOverlayModel *m_model = nullptr;
+};
+
+}  // namespace hdgnss
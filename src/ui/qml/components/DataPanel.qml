@@ -49,10 +49,10 @@ GlassPanel {
     }
 
     function rawEntryText(row) {
-        if (!rawLogModel || row < 0) {
+        if (!rawLogFilterModel || row < 0) {
             return ""
         }
-        var entry = rawLogModel.get(row)
+        var entry = rawLogFilterModel.get(row)
         if (!entry || !entry.kind) {
             return ""
         }
@@ -67,10 +67,10 @@ GlassPanel {
     }
 
     function rawEntryContent(row) {
-        if (!rawLogModel || row < 0) {
+        if (!rawLogFilterModel || row < 0) {
             return ""
         }
-        var entry = rawLogModel.get(row)
+        var entry = rawLogFilterModel.get(row)
         if (!entry || !entry.kind) {
             return ""
         }
@@ -98,6 +98,50 @@ GlassPanel {
         }
     }
 
+    function rawFilterValues(values) {
+        return ["All"].concat(values || [])
+    }
+
+    function applyRawFilter(setter, value) {
+        if (!rawLogFilterModel) {
+            return
+        }
+        rawLogFilterModel[setter](value === "All" ? [] : [value])
+    }
+
+    // Rows evicted from the front of the bounded log shift the selection;
+    // a filter change selects nothing.
+    Connections {
+        target: rawLogFilterModel
+        function onRowsRemoved(parent, first, last) {
+            if (root.selectedRawIndex < first) {
+                return
+            }
+            root.selectedRawIndex = root.selectedRawIndex > last
+                    ? root.selectedRawIndex - (last - first + 1)
+                    : -1
+        }
+        function onModelReset() {
+            root.selectedRawIndex = -1
+        }
+    }
+
+    // The value lists grow as new kinds and messages arrive; the selection
+    // is kept across those model changes.
+    component RawFilterComboBox: ComboBox {
+        property string filterSetter: ""
+        property string selectedValue: "All"
+        implicitHeight: theme.controlHeight
+        implicitWidth: 110
+        font.family: theme.bodyFont
+        font.pixelSize: theme.labelSize
+        onModelChanged: currentIndex = Math.max(0, find(selectedValue))
+        onActivated: {
+            selectedValue = currentText
+            root.applyRawFilter(filterSetter, currentText)
+        }
+    }
+
     function clampTabIndex(index) {
         return Math.max(0, Math.min(tabEntries.length - 1, index))
     }
@@ -386,12 +430,78 @@ GlassPanel {
                     }
                 }
                 Label {
-                    text: rawLogModel && rawLogModel.count !== undefined ? (rawLogModel.count + " frames") : "No stream"
+                    text: rawLogModel && rawLogModel.count !== undefined
+                          ? ((rawLogFilterModel && rawLogFilterModel.active ? rawLogFilterModel.count + " of " : "")
+                             + rawLogModel.count + " frames, " + (rawLogModel.memoryBytes / 1048576).toFixed(1) + " MiB"
+                             + (rawLogModel.diskBytes > 0 ? ", " + (rawLogModel.diskBytes / 1048576).toFixed(1) + " MiB on disk" : ""))
+                          : "No stream"
                     color: theme.textSecondary
                     font.pixelSize: theme.labelSize
                 }
             }
 
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 8
+                visible: !!rawLogFilterModel
+
+                RawFilterComboBox {
+                    model: ["All", "RX", "TX"]
+                    filterSetter: "setDirectionFilter"
+                }
+                RawFilterComboBox {
+                    model: root.rawFilterValues(rawLogFilterModel ? rawLogFilterModel.kinds : [])
+                    filterSetter: "setKindFilter"
+                }
+                RawFilterComboBox {
+                    implicitWidth: 140
+                    model: root.rawFilterValues(rawLogFilterModel ? rawLogFilterModel.messages : [])
+                    filterSetter: "setMessageFilter"
+                }
+                TextField {
+                    id: rawSearchField
+                    Layout.fillWidth: true
+                    implicitHeight: theme.controlHeight
+                    placeholderText: rawHexSearch.checked ? "Search bytes, e.g. B5 62" : "Search payload text"
+                    font.family: theme.bodyFont
+                    font.pixelSize: theme.labelSize
+                    color: theme.textPrimary
+                    selectByMouse: true
+                    onAccepted: {
+                        if (rawLogFilterModel) {
+                            rawLogFilterModel.setSearch(text, rawHexSearch.checked)
+                        }
+                    }
+                    background: Rectangle {
+                        radius: theme.controlRadius
+                        color: theme.inputBg
+                        border.width: 1
+                        border.color: parent.activeFocus ? theme.inputBorderFocus : theme.inputBorder
+                    }
+                }
+                CheckBox {
+                    id: rawHexSearch
+                    text: "Hex"
+                    font.pixelSize: theme.labelSize
+                    onToggled: {
+                        if (rawLogFilterModel && rawSearchField.text.length > 0) {
+                            rawLogFilterModel.setSearch(rawSearchField.text, checked)
+                        }
+                    }
+                }
+                Label {
+                    visible: rawLogFilterModel && rawLogFilterModel.searching
+                    text: rawLogFilterModel ? "Searching " + Math.round(rawLogFilterModel.searchProgress * 100) + "%" : ""
+                    color: theme.textSecondary
+                    font.pixelSize: theme.labelSize
+                }
+                NeonButton {
+                    text: "Stop"
+                    visible: rawLogFilterModel && rawLogFilterModel.searching
+                    onClicked: rawLogFilterModel.cancelSearch()
+                }
+            }
+
             ContentFrame {
                 Layout.fillWidth: true
                 Layout.fillHeight: true
@@ -418,7 +528,7 @@ GlassPanel {
                     boundsMovement: Flickable.StopAtBounds
                     clip: true
                     spacing: 2
-                    model: rawLogModel ? rawLogModel : null
+                    model: rawLogFilterModel ? rawLogFilterModel : null
                     onCountChanged: {
                         Qt.callLater(function() {
                             rawList.scrollToBottom()
@@ -582,9 +692,11 @@ GlassPanel {
                 }
 
                 Label {
-                    visible: !rawLogModel || rawLogModel.count === 0
+                    visible: !rawLogFilterModel || rawLogFilterModel.count === 0
                     anchors.centerIn: parent
-                    text: "No RX/TX frames"
+                    text: rawLogFilterModel && rawLogFilterModel.active && rawLogModel.count > 0
+                          ? "No matching frames"
+                          : "No RX/TX frames"
                     color: theme.textSecondary
                     font.family: theme.bodyFont
                     font.pixelSize: theme.bodySize
@@ -1,14 +1,15 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
+import GnssView
 
 GlassPanel {
     id: root
     property string reservedTitle: "Deviation Map"
     title: reservedTitle
     accent: theme.accentStrong
-    readonly property int modelRevision: deviationMapModel ? deviationMapModel.revision : 0
     readonly property var statistics: deviationMapModel ? deviationMapModel.stats : ({})
+    readonly property real scaleDistance: maxDistanceValue()
 
     Theme { id: theme }
 
@@ -41,7 +42,9 @@ GlassPanel {
             : "Avg: " + avg
     }
 
-    onModelRevisionChanged: chart.requestPaint()
+    // Only the rings and their labels are painted; the points live in the
+    // scene graph and follow the center on their own.
+    onScaleDistanceChanged: chart.requestPaint()
 
     component StatLabel: Label {
         color: theme.textSecondary
@@ -72,7 +75,6 @@ GlassPanel {
                 anchors.fill: parent
                 anchors.margins: 10
                 onPaint: {
-                    void root.modelRevision
                     var ctx = getContext("2d")
                     ctx.reset()
                     var cx = width * 0.5
@@ -113,30 +115,16 @@ GlassPanel {
                 }
             }
 
-            Repeater {
+            DeviationPointCloud {
+                anchors.fill: chart
                 model: deviationMapModel ? deviationMapModel : null
-
-                Rectangle {
-                    required property double eastMeters
-                    required property double northMeters
-                    required property double distanceMeters
-                    required property bool latest
-
-                    readonly property real cx: chart.x + chart.width * 0.5
-                    readonly property real cy: chart.y + chart.height * 0.52
-                    readonly property real maxR: Math.min(chart.width, chart.height) * 0.40
-                    readonly property real scaleDistance: root.maxDistanceValue()
-
-                    width: latest ? 8 : 5
-                    height: width
-                    radius: width * 0.5
-                    color: latest ? theme.accentStrong : Qt.rgba(theme.accentStrong.r, theme.accentStrong.g, theme.accentStrong.b, 0.56)
-                    border.width: latest ? 1 : 0
-                    border.color: latest ? theme.textPrimary : "transparent"
-
-                    x: cx + maxR * (eastMeters / scaleDistance) - width * 0.5
-                    y: cy - maxR * (northMeters / scaleDistance) - height * 0.5
-                }
+                origin: Qt.point(width * 0.5, height * 0.52)
+                pixelsPerMeter: Math.min(width, height) * 0.40 / root.scaleDistance
+                pointSize: 5
+                latestPointSize: 8
+                color: Qt.rgba(theme.accentStrong.r, theme.accentStrong.g, theme.accentStrong.b, 0.56)
+                latestColor: theme.accentStrong
+                densityColor: theme.accentStrong
             }
 
             Item {
@@ -177,7 +165,14 @@ GlassPanel {
                     anchors.fill: parent
                     spacing: 3
 
-                    StatHeader { width: parent.width; text: "Horizontal (HPE)"; horizontalAlignment: Text.AlignRight }
+                    StatHeader {
+                        width: parent.width
+                        // Lifetime figures come from the density grid once old samples are evicted.
+                        text: root.statsValue("horizontal", "resolution") > 0
+                              ? "Horizontal (HPE) ±" + root.numberText(root.statsValue("horizontal", "resolution"), 3) + " m"
+                              : "Horizontal (HPE)"
+                        horizontalAlignment: Text.AlignRight
+                    }
                     StatLabel { width: parent.width; text: "Min: " + root.numberText(root.statsValue("horizontal", "min"), 2) + " m"; horizontalAlignment: Text.AlignRight }
                     StatLabel { width: parent.width; text: "Max: " + root.numberText(root.statsValue("horizontal", "max"), 2) + " m"; horizontalAlignment: Text.AlignRight }
                     StatLabel { width: parent.width; text: "Avg: " + root.numberText(root.statsValue("horizontal", "avg"), 2) + " m"; horizontalAlignment: Text.AlignRight }
@@ -227,6 +222,7 @@ GlassPanel {
 
                     StatHeader { width: parent.width; text: "Statistics"; horizontalAlignment: Text.AlignRight }
                     StatLabel { width: parent.width; text: "Points: " + Number(statistics.points || 0); horizontalAlignment: Text.AlignRight }
+                    StatLabel { width: parent.width; text: "Retained: " + Number(statistics.retainedPoints || 0); horizontalAlignment: Text.AlignRight }
                     StatLabel { width: parent.width; text: "Center: " + (statistics.centerMode || "Average"); horizontalAlignment: Text.AlignRight }
                     StatLabel { width: parent.width; text: "Lat: " + root.numberText(statistics.centerLatitude, 8); horizontalAlignment: Text.AlignRight }
                     StatLabel { width: parent.width; text: "Lon: " + root.numberText(statistics.centerLongitude, 8); horizontalAlignment: Text.AlignRight }
@@ -6,6 +6,8 @@ Rectangle {
     property bool active: false
     property string titleText: ""
     property string detailText: ""
+    // Optional C/N0 sparkline: points with x in [0, 1] and y in dB-Hz.
+    property var series: []
     property color accent: theme.accentStrong
 
     Theme { id: theme }
@@ -58,5 +60,42 @@ Rectangle {
             font.pixelSize: theme.labelSize
             font.family: theme.bodyFont
         }
+
+        Canvas {
+            id: sparkline
+            visible: root.series.length > 1
+            Layout.fillWidth: true
+            Layout.preferredHeight: visible ? 28 : 0
+            onPaint: {
+                var ctx = getContext("2d")
+                ctx.reset()
+                var points = root.series
+                if (points.length < 2) {
+                    return
+                }
+                var low = points[0].y
+                var high = points[0].y
+                for (var i = 1; i < points.length; ++i) {
+                    low = Math.min(low, points[i].y)
+                    high = Math.max(high, points[i].y)
+                }
+                var range = Math.max(1, high - low)
+                ctx.strokeStyle = root.accent
+                ctx.lineWidth = 1.2
+                ctx.beginPath()
+                for (var j = 0; j < points.length; ++j) {
+                    var x = points[j].x * (width - 1)
+                    var y = height - 1 - (points[j].y - low) / range * (height - 2)
+                    if (j === 0) {
+                        ctx.moveTo(x, y)
+                    } else {
+                        ctx.lineTo(x, y)
+                    }
+                }
+                ctx.stroke()
+            }
+        }
     }
+
+    onSeriesChanged: sparkline.requestPaint()
 }
@@ -600,6 +600,13 @@ Popup {
                                 checked: appSettings ? appSettings.recordDecodeLog : false
                                 onToggled: if (appSettings) appSettings.recordDecodeLog = checked
                             }
+
+                            SettingsCheckBox {
+                                text: "Record decode JSONL"
+                                enabled: appSettings ? appSettings.logDirectory.length > 0 : false
+                                checked: appSettings ? appSettings.recordDecodeJsonl : false
+                                onToggled: if (appSettings) appSettings.recordDecodeJsonl = checked
+                            }
                         }
 
                         FieldLabel {
@@ -624,7 +631,7 @@ Popup {
 
                         HelpLabel {
                             text: appSettings && appSettings.logDirectory.length > 0
-                                  ? "Raw data writes the binary stream capture. Decode log writes the parsed text log into the next recording session."
+                                  ? "Raw data writes the binary stream capture. Decode log writes the parsed text log, and decode JSONL writes one JSON object per decoded message, into the next recording session."
                                   : "Set a log root directory before enabling raw or decode logging."
                         }
                     }
@@ -869,6 +876,47 @@ Popup {
                             checked: appSettings ? appSettings.resetUiOnNewConnection : true
                             onToggled: if (appSettings) appSettings.resetUiOnNewConnection = checked
                         }
+
+                        GridLayout {
+                            width: parent.width
+                            columns: 2
+                            columnSpacing: 8
+                            rowSpacing: 8
+
+                            FieldLabel { text: "RawData rows kept" }
+                            DenseField {
+                                Layout.fillWidth: true
+                                text: appSettings ? String(appSettings.rawLogMaxRows) : "200000"
+                                validator: IntValidator { bottom: 1000; top: 10000000 }
+                                onEditingFinished: if (appSettings) appSettings.rawLogMaxRows = Number(text)
+                            }
+
+                            FieldLabel { text: "RawData memory (MiB)" }
+                            DenseField {
+                                Layout.fillWidth: true
+                                text: appSettings ? String(appSettings.rawLogMemoryBudgetMb) : "256"
+                                validator: IntValidator { bottom: 16; top: 8192 }
+                                onEditingFinished: if (appSettings) appSettings.rawLogMemoryBudgetMb = Number(text)
+                            }
+
+                            FieldLabel { text: "Signal history memory (MiB)" }
+                            DenseField {
+                                Layout.fillWidth: true
+                                text: appSettings ? String(appSettings.satelliteHistoryMemoryMb) : "32"
+                                validator: IntValidator { bottom: 4; top: 1024 }
+                                onEditingFinished: if (appSettings) appSettings.satelliteHistoryMemoryMb = Number(text)
+                            }
+                        }
+
+                        SettingsCheckBox {
+                            text: "Keep older RawData rows on disk for scrollback"
+                            checked: appSettings ? appSettings.rawLogScrollback : false
+                            onToggled: if (appSettings) appSettings.rawLogScrollback = checked
+                        }
+
+                        HelpLabel {
+                            text: "The RawData view drops its oldest rows once either limit is reached, or with scrollback moves them to a temporary file and reads them back while scrolling. Signal history keeps a C/N0 and elevation series per signal for the Signal Spectrum tooltips; its memory sets how far back each series reaches. Recorded logs are not affected."
+                        }
                     }
                 }
 
@@ -909,10 +957,18 @@ Popup {
                                 enabled: appSettings ? appSettings.useFixedDeviationCenter : false
                                 onEditingFinished: if (appSettings) appSettings.fixedDeviationLongitude = Number(text)
                             }
+
+                            FieldLabel { text: "Memory (MiB)" }
+                            DenseField {
+                                Layout.fillWidth: true
+                                text: appSettings ? String(appSettings.deviationMemoryMb) : "64"
+                                validator: IntValidator { bottom: 8; top: 4096 }
+                                onEditingFinished: if (appSettings) appSettings.deviationMemoryMb = Number(text)
+                            }
                         }
 
                         HelpLabel {
-                            text: "If disabled, the map uses the average of all recorded positions in the current session as the center."
+                            text: "If disabled, the map uses the average of all recorded positions in the current session as the center. Positions beyond the memory budget are kept only as per-interval averages and in the density map, and the horizontal figures become estimates."
                         }
                     }
                 }
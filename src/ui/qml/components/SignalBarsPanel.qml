@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
+import GnssView
 
 GlassPanel {
     id: root
@@ -20,17 +21,6 @@ GlassPanel {
         return theme.signalColor(constellationName, used, signalId)
     }
 
-    function constellationOrder(constellationName) {
-        if (constellationName === "GPS") return 0
-        if (constellationName === "GLONASS") return 1
-        if (constellationName === "GALILEO") return 2
-        if (constellationName === "BEIDOU") return 3
-        if (constellationName === "QZSS") return 4
-        if (constellationName === "SBAS") return 5
-        if (constellationName === "NAVIC" || constellationName === "IRNSS") return 6
-        return 9
-    }
-
     function constellationShortLabel(constellationName) {
         if (constellationName === "GPS") return "G"
         if (constellationName === "GLONASS") return "R"
@@ -42,47 +32,11 @@ GlassPanel {
         return "U"
     }
 
-    function groupedBandItems(items) {
-        var sorted = []
-        for (var i = 0; i < items.length; ++i) {
-            var item = items[i]
-            sorted.push(item)
-        }
-        sorted.sort(function(a, b) {
-            var orderDiff = root.constellationOrder(a.constellation || "GNSS") - root.constellationOrder(b.constellation || "GNSS")
-            if (orderDiff !== 0) {
-                return orderDiff
-            }
-            return String(a.label || "").localeCompare(String(b.label || ""))
-        })
-
-        for (var j = 0; j < sorted.length; ++j) {
-            var item = sorted[j]
-            var constellation = item.constellation || "GNSS"
-            sorted[j] = {
-                kind: "satellite",
-                label: item.label,
-                constellation: constellation,
-                bandGroup: item.bandGroup,
-                signalId: item.signalId,
-                svid: item.svid,
-                strength: item.strength,
-                usedInFix: item.usedInFix
-            }
-        }
-        return sorted
-    }
-
-    function prnText(modelData) {
-        if (modelData && modelData.label) {
-            return String(modelData.label)
+    function prnText(label, svid) {
+        if (label) {
+            return String(label)
         }
-        if (modelData && modelData.svid !== undefined) {
-            return String(modelData.svid)
-        }
-        var raw = String(modelData && modelData.label ? modelData.label : "")
-        var digits = raw.replace(/^\D+/, "")
-        return digits.length > 0 ? digits : raw
+        return String(svid)
     }
 
     function clampStrength(value) {
@@ -189,14 +143,8 @@ GlassPanel {
 
             readonly property string currentBand: root.bandKeyForIndex(tabs.currentIndex)
             readonly property string currentBandLabel: root.bandLabelForIndex(tabs.currentIndex)
-            readonly property int modelCount: signalModel ? signalModel.count : 0
-            readonly property int modelRevision: signalModel ? signalModel.revision : 0
-            readonly property var bandItems: {
-                void modelRevision
-                return signalModel && signalModel.itemsForBand ? signalModel.itemsForBand(currentBand) : []
-            }
-            readonly property var groupedItems: root.groupedBandItems(bandItems)
-            readonly property int satelliteCount: bandItems.length
+            readonly property int historyRevision: satelliteHistoryModel ? satelliteHistoryModel.revision : 0
+            readonly property int satelliteCount: bandSignals.count
             readonly property real slotSpacing: 1
             readonly property real plotTopPadding: 28
             readonly property real plotBottomPadding: 32
@@ -233,29 +181,17 @@ GlassPanel {
             property string hotLabel: ""
             property string hotConstellation: ""
             property bool hotUsed: false
-            readonly property real peakStrength: {
-                var peak = 0
-                for (var i = 0; i < bandItems.length; ++i) {
-                    var value = Number(bandItems[i].strength !== undefined ? bandItems[i].strength : 0)
-                    if (value > peak) {
-                        peak = value
-                    }
-                }
-                return peak
+            readonly property real peakStrength: bandSignals.peakStrength
+            readonly property string peakLabel: bandSignals.peakLabel
+            readonly property int usedCount: bandSignals.usedCount
+
+            // Bars keep their delegates across UI ticks: the filter passes
+            // the signal model's inserts, removes and dataChanged through.
+            SignalBandFilter {
+                id: bandSignals
+                sourceModel: signalModel
+                band: instrumentPanel.currentBand
             }
-            readonly property string peakLabel: {
-                var peak = -1
-                var best = "--"
-                for (var i = 0; i < bandItems.length; ++i) {
-                    var value = Number(bandItems[i].strength !== undefined ? bandItems[i].strength : 0)
-                    if (value > peak) {
-                        peak = value
-                        best = bandItems[i].label || "SV"
-                    }
-                }
-                return best
-            }
-            readonly property int usedCount: bandItems.filter(function(item) { return item.usedInFix === true }).length
 
             ColumnLayout {
                 anchors.fill: parent
@@ -276,7 +212,7 @@ GlassPanel {
                     Item { Layout.fillWidth: true }
 
                     Label {
-                        text: instrumentPanel.bandItems.length + " channels"
+                        text: instrumentPanel.satelliteCount + " channels"
                         color: theme.textSecondary
                         font.pixelSize: theme.labelSize
                     }
@@ -341,7 +277,7 @@ GlassPanel {
                                         ctx.stroke()
                                     }
 
-                                    if (instrumentPanel.bandItems.length > 0) {
+                                    if (instrumentPanel.satelliteCount > 0) {
                                         var peakDisplayStrength = root.clampStrength(instrumentPanel.peakStrength)
                                         var peakY = plotBottom - peakDisplayStrength / instrumentPanel.displayStrengthMax * plotHeight
                                         ctx.strokeStyle = theme.chartPeak
@@ -366,7 +302,7 @@ GlassPanel {
                             onHeightChanged: gridCanvas.requestPaint()
                             Connections {
                                 target: instrumentPanel
-                                function onBandItemsChanged() { gridCanvas.requestPaint() }
+                                function onSatelliteCountChanged() { gridCanvas.requestPaint() }
                                 function onPeakStrengthChanged() { gridCanvas.requestPaint() }
                                 function onCurrentBandChanged() { gridCanvas.requestPaint() }
                             }
@@ -393,27 +329,33 @@ GlassPanel {
                                     spacing: instrumentPanel.slotSpacing
 
                                     Repeater {
-                                        model: instrumentPanel.groupedItems
+                                        model: bandSignals
 
                                         Item {
-                                            required property var modelData
-                                            readonly property real strength: Number(modelData.strength !== undefined ? modelData.strength : 0)
+                                            required property string key
+                                            required property string label
+                                            required property string constellation
+                                            required property int signalId
+                                            required property int svid
+                                            required property int strength
+                                            required property bool usedInFix
+                                            required property bool stale
                                             readonly property real displayStrength: root.clampStrength(strength)
                                             readonly property bool hasSignal: displayStrength > 0
                                             readonly property real barHeight: hasSignal
                                                 ? Math.max(4, Math.min(instrumentPanel.plotHeight,
                                                                        displayStrength / instrumentPanel.displayStrengthMax * instrumentPanel.plotHeight))
                                                 : 4
-                                            readonly property bool used: modelData.usedInFix === true
-                                            readonly property string label: root.prnText(modelData)
-                                            readonly property string constellation: modelData.constellation || "GNSS"
-                                            readonly property int signalId: Number(modelData.signalId !== undefined ? modelData.signalId : 0)
+                                            readonly property bool used: usedInFix
+                                            readonly property string prn: root.prnText(label, svid)
                                             readonly property color fillColor: root.satColor(constellation, used, signalId)
                                             readonly property bool alternateSignal: signalId > 0
                                             readonly property bool isHot: hover.hovered
 
                                             width: instrumentPanel.barWidth
                                             height: parent.height
+                                            // Signals no longer reported fade until they expire.
+                                            opacity: stale ? 0.35 : 1.0
 
                                             Rectangle {
                                                 visible: true
@@ -512,11 +454,11 @@ GlassPanel {
 
                                             onIsHotChanged: {
                                                 if (isHot) {
-                                                    instrumentPanel.hotLabel = label
+                                                    instrumentPanel.hotLabel = prn
                                                     instrumentPanel.hotConstellation = constellation
                                                     instrumentPanel.hotStrength = strength
                                                     instrumentPanel.hotUsed = used
-                                                } else if (instrumentPanel.hotLabel === label && instrumentPanel.hotConstellation === constellation) {
+                                                } else if (instrumentPanel.hotLabel === prn && instrumentPanel.hotConstellation === constellation) {
                                                     instrumentPanel.hotLabel = ""
                                                     instrumentPanel.hotConstellation = ""
                                                     instrumentPanel.hotStrength = -1
@@ -526,8 +468,13 @@ GlassPanel {
 
                                             InstrumentToolTip {
                                                 active: parent.isHot
-                                                titleText: constellation + " " + label + "  " + instrumentPanel.currentBandLabel
+                                                titleText: constellation + " " + prn + "  " + instrumentPanel.currentBandLabel
                                                 detailText: "C/N0 " + Math.round(displayStrength) + " dB-Hz" + (used ? "  Used in fix" : "  Visible only")
+                                                series: {
+                                                    void instrumentPanel.historyRevision
+                                                    return active && satelliteHistoryModel && key
+                                                        ? satelliteHistoryModel.series(key) : []
+                                                }
                                                 accent: parent.fillColor
                                                 x: parent.x + parent.width * 0.5 - width * 0.5
                                                 y: parent.y - height - 10
@@ -543,13 +490,16 @@ GlassPanel {
                                     spacing: instrumentPanel.slotSpacing
 
                                     Repeater {
-                                        model: instrumentPanel.groupedItems
+                                        model: bandSignals
 
                                         Item {
-                                            required property var modelData
-                                            readonly property string label: root.prnText(modelData)
-                                            readonly property bool hot: instrumentPanel.hotLabel === label
-                                                && instrumentPanel.hotConstellation === (modelData.constellation || "GNSS")
+                                            required property int index
+                                            required property string label
+                                            required property string constellation
+                                            required property int svid
+                                            readonly property string prn: root.prnText(label, svid)
+                                            readonly property bool hot: instrumentPanel.hotLabel === prn
+                                                && instrumentPanel.hotConstellation === constellation
 
                                             width: instrumentPanel.barWidth
                                             height: parent.height
@@ -557,7 +507,7 @@ GlassPanel {
                                             Text {
                                                 visible: hot || instrumentPanel.labelStride === 1 || (index % instrumentPanel.labelStride === 0)
                                                 anchors.centerIn: parent
-                                                text: label
+                                                text: prn
                                                 color: hot ? theme.textPrimary : Qt.lighter(theme.textSecondary, 1.2)
                                                 font.family: theme.monoFont
                                                 font.pixelSize: Math.max(9, theme.labelSize - 2)
@@ -578,7 +528,7 @@ GlassPanel {
 
                             Label {
                                 anchors.centerIn: parent
-                                visible: instrumentPanel.bandItems.length === 0
+                                visible: instrumentPanel.satelliteCount === 0
                                 text: "No signal data on " + instrumentPanel.currentBandLabel
                                 color: theme.textSecondary
                                 font.pixelSize: theme.bodySize
@@ -6,7 +6,7 @@ GlassPanel {
     id: root
     title: "SkyView"
     accent: theme.accentStrong
-    readonly property int modelRevision: satelliteModel ? satelliteModel.revision : 0
+    readonly property int statsRevision: satelliteStatsModel ? satelliteStatsModel.revision : 0
     property string focusConstellation: ""
     property string focusId: ""
     property real focusAzimuth: 0
@@ -35,42 +35,19 @@ GlassPanel {
     }
 
     function satCount(constellationName) {
-        void root.modelRevision
-        if (!satelliteModel || satelliteModel.count === undefined) {
-            return 0
-        }
-        var count = 0
-        for (var i = 0; i < satelliteModel.count; ++i) {
-            var item = satelliteModel.get(i)
-            if (item && item.constellation === constellationName) {
-                count += 1
-            }
-        }
-        return count
-    }
-
-    function satelliteBandGroup(item) {
-        var groupName = String(item && item.bandGroup !== undefined ? item.bandGroup : "").toUpperCase()
-        return groupName.length > 0 ? groupName : "UN"
+        void root.statsRevision
+        return satelliteStatsModel ? satelliteStatsModel.visibleSignals(constellationName) : 0
     }
 
     function bandStats(groupName) {
-        void root.modelRevision
-        var stats = { used: 0, view: 0 }
-        if (!satelliteModel || satelliteModel.count === undefined) {
-            return stats
+        void root.statsRevision
+        if (!satelliteStatsModel) {
+            return { used: 0, view: 0 }
         }
-        for (var i = 0; i < satelliteModel.count; ++i) {
-            var item = satelliteModel.get(i)
-            if (groupName !== "ALL" && root.satelliteBandGroup(item) !== groupName) {
-                continue
-            }
-            stats.view += 1
-            if (item && item.usedInFix === true) {
-                stats.used += 1
-            }
+        return {
+            used: satelliteStatsModel.usedSignals(groupName),
+            view: satelliteStatsModel.visibleSignals(groupName)
         }
-        return stats
     }
 
     function statLabelText(label) {
@@ -427,6 +404,7 @@ GlassPanel {
                         required property int svid
                         required property int cn0
                         required property bool usedInFix
+                        required property bool stale
 
                         readonly property real az: azimuth
                         readonly property real el: elevation
@@ -443,11 +421,17 @@ GlassPanel {
                         border.color: isHot ? theme.textPrimary : (satUsed ? theme.tooltipText : theme.tooltipDetail)
                         color: root.satColor(satConstellation, satUsed)
                         z: isHot ? 6 : 3
+                        // Satellites no longer reported fade until they expire.
+                        opacity: stale && !isHot ? 0.35 : 1.0
 
                         Behavior on width {
                             NumberAnimation { duration: 100; easing.type: Easing.OutCubic }
                         }
 
+                        Behavior on opacity {
+                            NumberAnimation { duration: 400; easing.type: Easing.OutCubic }
+                        }
+
                         readonly property real cx: chart.x + chart.width * 0.5
                         readonly property real cy: chart.y + chart.height * 0.52
                         readonly property real maxR: Math.min(chart.width, chart.height) * 0.40
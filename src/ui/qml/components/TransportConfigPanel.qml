@@ -30,6 +30,8 @@ GlassPanel {
         property string tcpPort: "2101"
         property string udpAddr: "0.0.0.0"
         property string udpPort: "5000"
+        property string replayPath: ""
+        property string replaySpeed: "1x"
         property bool autoReconnect: false
         property string reconnectTransport: ""
     }
@@ -379,6 +381,8 @@ GlassPanel {
         tcpPort.text = transportSettings.tcpPort
         udpAddr.text = transportSettings.udpAddr
         udpPort.text = transportSettings.udpPort
+        replayPath.text = transportSettings.replayPath
+        applyComboValue(replaySpeed, transportSettings.replaySpeed)
         ensureCurrentTransport()
         settingsReady = true
     }
@@ -397,6 +401,8 @@ GlassPanel {
         transportSettings.tcpPort = tcpPort.text
         transportSettings.udpAddr = udpAddr.text
         transportSettings.udpPort = udpPort.text
+        transportSettings.replayPath = replayPath.text
+        transportSettings.replaySpeed = root.comboStoredValue(replaySpeed)
     }
 
     function rememberOpenTransport(name) {
@@ -451,6 +457,30 @@ GlassPanel {
         clearReconnectIfMatch("UDP")
     }
 
+    function replaySpeedValue() {
+        var text = root.comboStoredValue(replaySpeed)
+        return text === "Max" ? 0 : parseFloat(text)
+    }
+
+    function openReplayAction() {
+        persistSettings()
+        if (transportViewModel) {
+            transportViewModel.openReplay(replayPath.text, replaySpeedValue())
+        }
+    }
+
+    function closeReplayAction() {
+        invoke("closeReplay")
+    }
+
+    function formatReplayTime(ms) {
+        var totalSeconds = Math.floor(Math.max(0, ms) / 1000)
+        var hours = Math.floor(totalSeconds / 3600)
+        var minutes = Math.floor((totalSeconds % 3600) / 60)
+        var seconds = totalSeconds % 60
+        return hours + ":" + (minutes < 10 ? "0" : "") + minutes + ":" + (seconds < 10 ? "0" : "") + seconds
+    }
+
     function openPluginTransport(name) {
         if (!transportViewModel) {
             return
@@ -562,6 +592,11 @@ GlassPanel {
                 minButtonWidth: 60
                 enabled: !root.isTransportLockedOut("UDP")
             }
+            NeonTabButton {
+                text: "Replay"
+                minButtonWidth: 60
+                enabled: !root.isTransportLockedOut("Replay")
+            }
 
             Repeater {
                 model: root.pluginTransports()
@@ -859,6 +894,115 @@ GlassPanel {
                 }
             }
 
+            Item {
+                id: replayPane
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                clip: true
+
+                readonly property var replay: transportViewModel ? transportViewModel.replay : null
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    spacing: theme.sectionSpacing
+
+                    SectionTitle { text: "Capture Replay" }
+
+                    GridLayout {
+                        Layout.fillWidth: true
+                        columns: 2
+                        columnSpacing: 8
+                        rowSpacing: 8
+
+                        DenseLabel { text: "Capture" }
+                        DenseTextField {
+                            id: replayPath
+                            Layout.fillWidth: true
+                            placeholderText: "session.raw.bin"
+                            enabled: !root.isTransportOpenOrLocked("Replay")
+                            onTextEdited: root.persistSettings()
+                        }
+                        DenseLabel { text: "Speed" }
+                        DenseComboBox {
+                            id: replaySpeed
+                            Layout.fillWidth: true
+                            model: ["0.5x", "1x", "2x", "4x", "10x", "Max"]
+                            onActivated: {
+                                root.persistSettings()
+                                if (replayPane.replay && replayPane.replay.open) {
+                                    replayPane.replay.speed = root.replaySpeedValue()
+                                }
+                            }
+                        }
+                    }
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 8
+                        visible: !!(replayPane.replay && replayPane.replay.open)
+
+                        DenseLabel {
+                            text: replayPane.replay ? root.formatReplayTime(replayPane.replay.positionMs) : ""
+                        }
+                        Slider {
+                            id: replaySeek
+                            Layout.fillWidth: true
+                            from: 0
+                            to: Math.max(1, replayPane.replay ? replayPane.replay.durationMs : 1)
+                            onPressedChanged: {
+                                if (!pressed && replayPane.replay) {
+                                    replayPane.replay.seekToTime(value)
+                                }
+                            }
+                            Binding on value {
+                                when: !replaySeek.pressed
+                                value: replayPane.replay ? replayPane.replay.positionMs : 0
+                            }
+                        }
+                        DenseLabel {
+                            text: replayPane.replay ? root.formatReplayTime(replayPane.replay.durationMs) : ""
+                        }
+                    }
+
+                    HelpText {
+                        Layout.fillWidth: true
+                        text: root.statusTick >= 0 ? root.statusText(
+                            transportViewModel ? transportViewModel.transportStatus("Replay") : "",
+                            "Replays a recorded .raw.bin through the decoders. Timing comes from the .raw.idx written next to it.") : ""
+                    }
+
+                    Item { Layout.fillHeight: true }
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 8
+                        Item { Layout.fillWidth: true }
+                        NeonButton {
+                            text: "Play"
+                            accent: theme.ok
+                            enabled: !root.isTransportOpenOrLocked("Replay")
+                            onClicked: root.openReplayAction()
+                        }
+                        NeonButton {
+                            text: replayPane.replay && replayPane.replay.paused ? "Resume" : "Pause"
+                            enabled: root.isTransportOpenOrLocked("Replay")
+                            onClicked: {
+                                if (replayPane.replay) {
+                                    replayPane.replay.paused = !replayPane.replay.paused
+                                }
+                            }
+                        }
+                        NeonButton {
+                            text: "Stop"
+                            accent: theme.bad
+                            enabled: root.isTransportOpenOrLocked("Replay")
+                            onClicked: root.closeReplayAction()
+                        }
+                        Item { Layout.fillWidth: true }
+                    }
+                }
+            }
+
             Repeater {
                 model: root.pluginTransports()
 
@@ -380,6 +380,8 @@ Rectangle {
             height: mapBounds.contentHeight
             source: root.ionexOverlaySource
             visible: root.showIonex && root.ionexReady
+            // Each render gets a new image:// revision; older ones need not be kept.
+            cache: false
             fillMode: Image.PreserveAspectFit
             opacity: 0.42
             smooth: true
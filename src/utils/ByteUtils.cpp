@@ -2,10 +2,26 @@
 
 #include <QRegularExpression>
 
+#include <array>
+#include <cstring>
+
 namespace hdgnss::ByteUtils {
 
 namespace {
 
+// Both upper-case digits of every byte value, as the UTF-16 pair toHex()
+// copies in one go.
+constexpr std::array<std::array<char16_t, 2>, 256> makeHexPairs() {
+    constexpr char16_t digits[] = u"0123456789ABCDEF";
+    std::array<std::array<char16_t, 2>, 256> pairs{};
+    for (int value = 0; value < 256; ++value) {
+        pairs[value] = {digits[value >> 4], digits[value & 0x0F]};
+    }
+    return pairs;
+}
+
+constexpr auto kHexPairs = makeHexPairs();
+
 QString truncatedSuffix(qsizetype payloadSize, qsizetype previewSize) {
     if (previewSize >= payloadSize) {
         return {};
@@ -16,7 +32,31 @@ QString truncatedSuffix(qsizetype payloadSize, qsizetype previewSize) {
 }
 
 QString toHex(const QByteArray &payload, char separator) {
-    return QString::fromLatin1(payload.toHex(separator).toUpper());
+    return toHex(payload.constData(), payload.size(), separator);
+}
+
+QString toHex(const char *data, qsizetype size, char separator) {
+    if (size <= 0) {
+        return {};
+    }
+    const qsizetype stride = separator != '\0' ? 3 : 2;
+    QString out(size * stride - (stride - 2), Qt::Uninitialized);
+    char16_t *cursor = reinterpret_cast<char16_t *>(out.data());
+    const auto *bytes = reinterpret_cast<const uchar *>(data);
+    if (stride == 2) {
+        for (qsizetype index = 0; index < size; ++index, cursor += 2) {
+            std::memcpy(cursor, kHexPairs[bytes[index]].data(), sizeof(char16_t) * 2);
+        }
+        return out;
+    }
+    const char16_t separatorUnit = static_cast<uchar>(separator);
+    for (qsizetype index = 0; index < size; ++index, cursor += 3) {
+        std::memcpy(cursor, kHexPairs[bytes[index]].data(), sizeof(char16_t) * 2);
+        if (index + 1 < size) {
+            cursor[2] = separatorUnit;
+        }
+    }
+    return out;
 }
 
 QString toAscii(const QByteArray &payload) {
@@ -6,6 +6,9 @@
 namespace hdgnss::ByteUtils {
 
 QString toHex(const QByteArray &payload, char separator = ' ');
+// Upper-case hex of size bytes at data, formatted straight into one
+// allocation. A '\0' separator packs the digits.
+QString toHex(const char *data, qsizetype size, char separator = ' ');
 QString toAscii(const QByteArray &payload);
 QString toHexPreview(const QByteArray &payload, int maxBytes, char separator = ' ');
 QString toAsciiPreview(const QByteArray &payload, int maxBytes);
@@ -0,0 +1,862 @@
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTimeZone>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "src/core/SatelliteAgeing.h"
+#include "src/models/DeviationMapModel.h"
+#include "src/models/RawLogModel.h"
+#include "src/models/SatelliteModel.h"
+#include "src/models/SignalBandFilterModel.h"
+#include "src/models/SignalModel.h"
+#include "src/storage/DecodeJsonlExporter.h"
+#include "src/storage/SatelliteHistory.h"
+#include "src/transports/ReplayTransport.h"
+
+namespace {
+
+using hdgnss::DataDirection;
+using hdgnss::DecodeJsonlExporter;
+using hdgnss::DeviationMapModel;
+using hdgnss::ProtocolMessage;
+using hdgnss::RawLogModel;
+using hdgnss::ReplayTransport;
+using hdgnss::SatelliteAgeing;
+using hdgnss::SatelliteHistory;
+using hdgnss::SatelliteInfo;
+using hdgnss::SatelliteModel;
+using hdgnss::SignalBandFilterModel;
+using hdgnss::SignalModel;
+using hdgnss::StreamChunk;
+using hdgnss::StreamChunkKind;
+using hdgnss::StreamChunker;
+
+void report(const char *label, qint64 items, qint64 elapsedNs, const char *unit) {
+    const double seconds = static_cast<double>(qMax<qint64>(1, elapsedNs)) / 1e9;
+    std::cout << label << ": " << items << " " << unit << " in "
+              << seconds * 1e3 << " ms (" << static_cast<qint64>(items / seconds) << " " << unit << "/s)\n";
+}
+
+ProtocolMessage benchmarkGgaMessage(int index) {
+    ProtocolMessage message;
+    message.protocol = QStringLiteral("NMEA");
+    message.messageName = QStringLiteral("GGA");
+    message.rawFrame = QByteArrayLiteral("$GNGGA,021000.00,3110.4700,N,12129.1200,E,1,18,0.8,12.3,M,8.1,M,,*5B\r\n");
+    message.fields = {
+        {QStringLiteral("talker"), QStringLiteral("GN")},
+        {QStringLiteral("utcTime"), QDateTime::fromMSecsSinceEpoch(1776300000000LL + index * 100LL, QTimeZone::UTC)},
+        {QStringLiteral("latitude"), 31.174500 + index * 1e-9},
+        {QStringLiteral("longitude"), 121.486 - index * 1e-9},
+        {QStringLiteral("altitudeMeters"), 12.3},
+        {QStringLiteral("undulationMeters"), 8.1},
+        {QStringLiteral("quality"), 1},
+        {QStringLiteral("validFix"), true},
+        {QStringLiteral("satellitesUsed"), 18},
+        {QStringLiteral("hdop"), 0.8},
+        {QStringLiteral("fixType"), QStringLiteral("GPS")}
+    };
+    return message;
+}
+
+ProtocolMessage benchmarkGsvMessage() {
+    QVariantList satellites;
+    for (int svid = 1; svid <= 4; ++svid) {
+        satellites.append(QVariantMap{
+            {QStringLiteral("key"), QStringLiteral("GPS-1-%1").arg(svid)},
+            {QStringLiteral("constellation"), QStringLiteral("GPS")},
+            {QStringLiteral("band"), QStringLiteral("L1")},
+            {QStringLiteral("signalId"), 1},
+            {QStringLiteral("svid"), svid},
+            {QStringLiteral("elevation"), 10 * svid},
+            {QStringLiteral("azimuth"), 45 * svid},
+            {QStringLiteral("cn0"), 30 + svid},
+            {QStringLiteral("usedInFix"), svid % 2 == 0}
+        });
+    }
+
+    ProtocolMessage message;
+    message.protocol = QStringLiteral("NMEA");
+    message.messageName = QStringLiteral("GSV");
+    message.fields = {
+        {QStringLiteral("talker"), QStringLiteral("GP")},
+        {QStringLiteral("satellites"), satellites}
+    };
+    return message;
+}
+
+// Producer enqueues 200k decoded messages (GGA and 4-satellite GSV mixed 3:1)
+// as fast as it can; the measurement ends once the worker has written all of
+// them to disk. Target: >= 100k messages/s end to end.
+bool benchmarkDecodeJsonlExporter() {
+    constexpr int kMessageCount = 200000;
+    constexpr double kTargetMessagesPerSecond = 100000.0;
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        std::cerr << "jsonl-export: temporary directory unavailable\n";
+        return false;
+    }
+
+    QList<ProtocolMessage> messages;
+    messages.reserve(4);
+    for (int i = 0; i < 3; ++i) {
+        messages.append(benchmarkGgaMessage(i));
+    }
+    messages.append(benchmarkGsvMessage());
+
+    // The burst is enqueued faster than any disk drains it; lift the cap so
+    // the figure covers every message rather than the survivors.
+    DecodeJsonlExporter exporter;
+    exporter.setMaxQueuedMessages(kMessageCount);
+    const QString filePath = tempDir.filePath(QStringLiteral("bench.jsonl"));
+    if (!exporter.open(filePath)) {
+        std::cerr << "jsonl-export: failed to open " << filePath.toStdString() << "\n";
+        return false;
+    }
+
+    const qint64 baseTimestampMs = 1776300000000LL;
+    const QString transportName = QStringLiteral("UART");
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kMessageCount; ++i) {
+        exporter.enqueue(baseTimestampMs + i * 10LL, DataDirection::Rx, transportName, messages.at(i & 3));
+    }
+    const qint64 enqueueNs = timer.nsecsElapsed();
+    exporter.flush();
+    const qint64 totalNs = timer.nsecsElapsed();
+    const qint64 dropped = exporter.messagesDropped();
+    exporter.close();
+    if (dropped != 0) {
+        std::cerr << "jsonl-export: dropped " << dropped << " messages\n";
+        return false;
+    }
+
+    report("jsonl-export enqueue", kMessageCount, enqueueNs, "messages");
+    report("jsonl-export end-to-end", kMessageCount, totalNs, "messages");
+    std::cout << "jsonl-export file size: " << QFileInfo(filePath).size() << " bytes\n";
+
+    const double rate = kMessageCount / (static_cast<double>(qMax<qint64>(1, totalNs)) / 1e9);
+    if (rate < kTargetMessagesPerSecond) {
+        std::cerr << "jsonl-export: below target of " << kTargetMessagesPerSecond << " messages/s\n";
+        return false;
+    }
+    return true;
+}
+
+// Replays a 256 MiB un-indexed capture as fast as possible into a receiver
+// that only counts bytes, so the figure is the transport's own ceiling.
+// Target: >= 300 MB/s.
+bool benchmarkReplayTransport() {
+    constexpr qint64 kCaptureBytes = 256LL * 1024 * 1024;
+    constexpr double kTargetBytesPerSecond = 300.0 * 1000 * 1000;
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        std::cerr << "replay: temporary directory unavailable\n";
+        return false;
+    }
+
+    const QString capturePath = tempDir.filePath(QStringLiteral("bench.raw.bin"));
+    {
+        QFile capture(capturePath);
+        if (!capture.open(QIODevice::WriteOnly)) {
+            std::cerr << "replay: failed to create " << capturePath.toStdString() << "\n";
+            return false;
+        }
+        const QByteArray sentence = benchmarkGgaMessage(0).rawFrame;
+        QByteArray block;
+        while (block.size() < 1024 * 1024) {
+            block += sentence;
+        }
+        for (qint64 written = 0; written < kCaptureBytes; written += block.size()) {
+            capture.write(block.constData(), qMin<qint64>(block.size(), kCaptureBytes - written));
+        }
+    }
+
+    ReplayTransport replay;
+    qint64 receivedBytes = 0;
+    QObject::connect(&replay, &ReplayTransport::dataReceived, [&receivedBytes](const QByteArray &bytes) {
+        receivedBytes += bytes.size();
+    });
+    QEventLoop loop;
+    QObject::connect(&replay, &ReplayTransport::finished, &loop, &QEventLoop::quit);
+
+    QElapsedTimer timer;
+    timer.start();
+    if (!replay.openWithSettings({{QStringLiteral("path"), capturePath},
+                                  {QStringLiteral("speed"), 0.0}})) {
+        std::cerr << "replay: failed to open capture\n";
+        return false;
+    }
+    loop.exec();
+    const qint64 elapsedNs = timer.nsecsElapsed();
+    replay.close();
+
+    report("replay as-fast-as-possible", receivedBytes, elapsedNs, "bytes");
+    if (receivedBytes != kCaptureBytes) {
+        std::cerr << "replay: emitted " << receivedBytes << " of " << kCaptureBytes << " bytes\n";
+        return false;
+    }
+    const double rate = receivedBytes / (static_cast<double>(qMax<qint64>(1, elapsedNs)) / 1e9);
+    if (rate < kTargetBytesPerSecond) {
+        std::cerr << "replay: below target of " << kTargetBytesPerSecond << " bytes/s\n";
+        return false;
+    }
+    return true;
+}
+
+struct TickTimes {
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+    int insertNotifications = 0;
+    qint64 touchedChars = 0;
+};
+
+void reportTicks(const char *label, int ticks, int chunksPerTick, const TickTimes &times) {
+    report(label, qint64(ticks) * chunksPerTick, times.totalNs, "rows");
+    std::cout << label << ": " << times.totalNs / ticks / 1e6 << " ms mean, " << times.maxNs / 1e6
+              << " ms max per tick, " << times.insertNotifications << " insert notifications\n";
+}
+
+// One UI tick's worth of appends into a full ring, followed by whatever the
+// attached view does with the inserted rows. publishPerRow mimics the old
+// behaviour of one insert notification per chunk.
+TickTimes runRawLogTicks(bool publishPerRow, int ticks, int chunksPerTick) {
+    RawLogModel model;
+    model.setRetention(20000, 0);
+    TickTimes times;
+    // Stands in for the ListView delegate: every inserted row is read once.
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+                     [&model, &times](const QModelIndex &, int first, int last) {
+                         ++times.insertNotifications;
+                         for (int row = first; row <= last; ++row) {
+                             times.touchedChars += model.data(model.index(row), RawLogModel::DisplayRole).toString().size();
+                         }
+                     });
+
+    const QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(1776300000000LL, QTimeZone::UTC);
+    const QString transportName = QStringLiteral("UART");
+    const StreamChunk sentence{StreamChunkKind::Nmea, benchmarkGgaMessage(0).rawFrame};
+    const auto runTick = [&]() {
+        for (int chunk = 0; chunk < chunksPerTick; ++chunk) {
+            model.appendChunk(timestamp, DataDirection::Rx, transportName, sentence);
+            if (publishPerRow) {
+                model.publishPending();
+            }
+        }
+        model.publishPending();
+    };
+    // Fill the ring first so every measured tick also evicts.
+    while (model.rowCount() < model.maxRows()) {
+        runTick();
+    }
+    times.insertNotifications = 0;
+
+    QElapsedTimer timer;
+    for (int tick = 0; tick < ticks; ++tick) {
+        timer.start();
+        runTick();
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        times.totalNs += elapsedNs;
+        times.maxNs = qMax(times.maxNs, elapsedNs);
+    }
+    return times;
+}
+
+// Saturated stream into the RawData view: 2000 chunks per 50 ms UI tick,
+// well above what a 921600 baud receiver produces. Publishing once per tick
+// must cost the view one insert notification per tick and must not be slower
+// than publishing every chunk.
+bool benchmarkRawLogModelInsertBatching() {
+    constexpr int kTicks = 200;
+    constexpr int kChunksPerTick = 2000;
+
+    const TickTimes perRow = runRawLogTicks(true, kTicks, kChunksPerTick);
+    const TickTimes perTick = runRawLogTicks(false, kTicks, kChunksPerTick);
+    reportTicks("raw-log per-row publish", kTicks, kChunksPerTick, perRow);
+    reportTicks("raw-log per-tick publish", kTicks, kChunksPerTick, perTick);
+
+    if (perTick.insertNotifications != kTicks) {
+        std::cerr << "raw-log: expected one insert notification per tick, got " << perTick.insertNotifications << "\n";
+        return false;
+    }
+    if (perTick.totalNs > perRow.totalNs) {
+        std::cerr << "raw-log: per-tick publishing slower than per-row publishing\n";
+        return false;
+    }
+    return true;
+}
+
+// Row layout RawLogModel used before its columns were split out: one struct
+// per row holding its own names, QDateTime and preview.
+struct LegacyRawLogRow {
+    QDateTime timestampUtc;
+    DataDirection direction = DataDirection::Rx;
+    QString transportName;
+    QString kind;
+    QString messageName;
+    QByteArray payloadPreview;
+    int payloadSize = 0;
+};
+
+// 200000 rows of a typical session: NMEA sentences plus short binary frames
+// with message names. The fixed cost per row, everything but the preview
+// bytes themselves, has to be at least 5x below the legacy layout's
+// struct-plus-allocation-header cost.
+bool benchmarkRawLogModelMemory() {
+    constexpr int kRows = 200000;
+    constexpr double kTargetReduction = 5.0;
+    constexpr qint64 kArrayHeaderBytes = 24;
+
+    RawLogModel model;
+    model.setRetention(kRows, 0);
+    const QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(1776300000000LL, QTimeZone::UTC);
+    const QString transportName = QStringLiteral("UART");
+    ProtocolMessage binaryMessage;
+    binaryMessage.messageName = QStringLiteral("NAV-PVT");
+    binaryMessage.rawFrame = QByteArray(24, '\x5A');
+    const StreamChunk binaryChunk{StreamChunkKind::Binary, binaryMessage.rawFrame};
+    const QList<ProtocolMessage> binaryMessages{binaryMessage};
+    const StreamChunk sentence{StreamChunkKind::Nmea, benchmarkGgaMessage(0).rawFrame};
+
+    qint64 previewTotal = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int row = 0; row < kRows; ++row) {
+        if (row % 4 == 3) {
+            model.appendChunk(timestamp.addMSecs(row), DataDirection::Rx, transportName, binaryChunk, binaryMessages);
+            previewTotal += binaryMessage.rawFrame.size();
+        } else {
+            model.appendChunk(timestamp.addMSecs(row), DataDirection::Rx, transportName, sentence);
+            previewTotal += sentence.payload.size();
+        }
+        if (row % 2000 == 1999) {
+            model.publishPending();
+        }
+    }
+    model.publishPending();
+    const qint64 elapsedNs = timer.nsecsElapsed();
+    report("raw-log append", kRows, elapsedNs, "rows");
+
+    const qint64 legacyFixed = sizeof(LegacyRawLogRow) + kArrayHeaderBytes;
+    const double legacyPerRow = legacyFixed + static_cast<double>(previewTotal) / kRows;
+    const double compactPerRow = static_cast<double>(model.memoryBytes()) / kRows;
+    const double compactFixed = static_cast<double>(model.memoryBytes() - model.previewBytes()) / kRows;
+    std::cout << "raw-log bytes per row: legacy " << legacyPerRow << " (fixed " << legacyFixed << "), compact "
+              << compactPerRow << " (fixed " << compactFixed << ")\n";
+
+    if (model.rowCount() != kRows) {
+        std::cerr << "raw-log: expected " << kRows << " rows, got " << model.rowCount() << "\n";
+        return false;
+    }
+    if (legacyFixed < kTargetReduction * compactFixed) {
+        std::cerr << "raw-log: fixed row cost below the " << kTargetReduction << "x reduction target\n";
+        return false;
+    }
+    return true;
+}
+
+// Scrolls a 1M-row log: a 40-row viewport moves 12 rows per frame down and
+// back up, and every frame recreates the delegates of the rows it shows, as
+// ListView does when reuseItems is off. Target: no frame over 16 ms.
+bool benchmarkRawLogModelScrolling() {
+    constexpr int kRows = 1000000;
+    constexpr int kViewportRows = 40;
+    constexpr int kRowsPerFrame = 12;
+    constexpr int kFrames = 4000;
+    constexpr qint64 kFrameBudgetNs = 16LL * 1000 * 1000;
+
+    RawLogModel model;
+    model.setRetention(kRows, 0);
+    const QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(1776300000000LL, QTimeZone::UTC);
+    const QString transportName = QStringLiteral("UART");
+    const StreamChunk sentence{StreamChunkKind::Nmea, benchmarkGgaMessage(0).rawFrame};
+    const StreamChunk frame{StreamChunkKind::Binary, QByteArray(180, '\x5A')};
+    for (int row = 0; row < kRows; ++row) {
+        model.appendChunk(timestamp.addMSecs(row), DataDirection::Rx, transportName, row % 3 == 0 ? frame : sentence);
+        if (row % 10000 == 9999) {
+            model.publishPending();
+        }
+    }
+    model.publishPending();
+
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+    qint64 characters = 0;
+    int top = 0;
+    int step = kRowsPerFrame;
+    QElapsedTimer timer;
+    for (int frameIndex = 0; frameIndex < kFrames; ++frameIndex) {
+        if (frameIndex == kFrames / 2) {
+            step = -kRowsPerFrame;
+        }
+        top += step;
+        timer.start();
+        for (int row = top; row < top + kViewportRows; ++row) {
+            const QModelIndex index = model.index(row);
+            for (const int role : {RawLogModel::TimestampRole, RawLogModel::DirectionRole, RawLogModel::KindRole,
+                                   RawLogModel::MessageRole, RawLogModel::SizeRole, RawLogModel::DisplayRole}) {
+                characters += model.data(index, role).toString().size();
+            }
+        }
+        // The detail pane follows the selected row.
+        characters += model.get(top).value(QStringLiteral("hex")).toString().size();
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        totalNs += elapsedNs;
+        maxNs = qMax(maxNs, elapsedNs);
+    }
+    report("raw-log scroll", qint64(kFrames) * kViewportRows, totalNs, "rows");
+    std::cout << "raw-log scroll: " << totalNs / kFrames / 1e3 << " us mean, " << maxNs / 1e3
+              << " us max per frame (" << characters << " characters)\n";
+
+    if (maxNs > kFrameBudgetNs) {
+        std::cerr << "raw-log: scroll frame took " << maxNs / 1e6 << " ms\n";
+        return false;
+    }
+    return true;
+}
+
+// Streams 4M rows through a 50000-row ring with scrollback on, then reads
+// rows at random offsets so nearly every read faults a page in from disk.
+// Targets: memory at 4M rows within 10% of memory at 2M rows, and no page
+// fault over 16 ms. The archive was just written, so the OS file cache is
+// warm; a cold cache adds one disk read per fault.
+bool benchmarkRawLogModelScrollback() {
+    constexpr int kRows = 4000000;
+    constexpr int kResidentRows = 50000;
+    constexpr int kReads = 2000;
+    constexpr qint64 kFaultBudgetNs = 16LL * 1000 * 1000;
+
+    RawLogModel model;
+    model.setRetention(kResidentRows, 0);
+    model.setScrollbackEnabled(true);
+    if (!model.scrollbackEnabled()) {
+        std::cerr << "raw-log scrollback: archive unavailable\n";
+        return false;
+    }
+    const QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(1776300000000LL, QTimeZone::UTC);
+    const QString transportName = QStringLiteral("UART");
+    const StreamChunk sentence{StreamChunkKind::Nmea, benchmarkGgaMessage(0).rawFrame};
+
+    qint64 halfwayMemory = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int row = 0; row < kRows; ++row) {
+        model.appendChunk(timestamp.addMSecs(row), DataDirection::Rx, transportName, sentence);
+        if (row % 2000 == 1999) {
+            model.publishPending();
+        }
+        if (row == kRows / 2) {
+            halfwayMemory = model.memoryBytes();
+        }
+    }
+    model.publishPending();
+    report("raw-log scrollback append", kRows, timer.nsecsElapsed(), "rows");
+    const qint64 finalMemory = model.memoryBytes();
+    std::cout << "raw-log scrollback: " << halfwayMemory / 1048576.0 << " MiB at " << kRows / 2 << " rows, "
+              << finalMemory / 1048576.0 << " MiB at " << kRows << " rows, " << model.diskBytes() / 1048576.0
+              << " MiB on disk\n";
+
+    quint32 state = 12345;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+    qint64 characters = 0;
+    for (int read = 0; read < kReads; ++read) {
+        state = state * 1664525u + 1013904223u;
+        const int row = static_cast<int>(state % static_cast<quint32>(kRows - kResidentRows));
+        timer.start();
+        characters += model.data(model.index(row), RawLogModel::DisplayRole).toString().size();
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        totalNs += elapsedNs;
+        maxNs = qMax(maxNs, elapsedNs);
+    }
+    std::cout << "raw-log scrollback page-in: " << totalNs / kReads / 1e3 << " us mean, " << maxNs / 1e3
+              << " us max (" << characters << " characters)\n";
+
+    if (model.rowCount() != kRows) {
+        std::cerr << "raw-log scrollback: expected " << kRows << " rows, got " << model.rowCount() << "\n";
+        return false;
+    }
+    if (finalMemory > halfwayMemory + halfwayMemory / 10) {
+        std::cerr << "raw-log scrollback: memory grew with the session\n";
+        return false;
+    }
+    if (maxNs > kFaultBudgetNs) {
+        std::cerr << "raw-log scrollback: page fault took " << maxNs / 1e6 << " ms\n";
+        return false;
+    }
+    return true;
+}
+
+// Counts the bytes handed to one stream's chunker.
+struct CountingChunker {
+    StreamChunker chunker;
+    qint64 bytes = 0;
+
+    QList<StreamChunk> feed(const QByteArray &read) {
+        bytes += read.size();
+        chunker.append(read);
+        return chunker.takeAvailableChunks();
+    }
+};
+
+// Feeds one NMEA stream in 4 KiB reads through the shared chunker into the
+// RawData log, against the old path where the log re-chunked every read with
+// a chunker of its own. The single path must scan each byte exactly once and
+// produce the same rows.
+bool benchmarkRawLogIngestion() {
+    constexpr qint64 kStreamBytes = 32LL * 1024 * 1024;
+    constexpr int kReadBytes = 4096;
+    constexpr int kReadsPerTick = 64;
+
+    QByteArray stream;
+    stream.reserve(kStreamBytes);
+    const QByteArray sentence = benchmarkGgaMessage(0).rawFrame;
+    while (stream.size() < kStreamBytes) {
+        stream += sentence;
+    }
+    const QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(1776300000000LL, QTimeZone::UTC);
+    const QString transportName = QStringLiteral("UART");
+
+    const auto run = [&](bool rechunkInModel, qint64 *chunkedBytes, qint64 *rows) {
+        RawLogModel model;
+        CountingChunker pipeline;
+        CountingChunker modelChunker;
+        qint64 appended = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (qint64 offset = 0, read = 0; offset < stream.size(); offset += kReadBytes, ++read) {
+            const QByteArray bytes = stream.mid(offset, kReadBytes);
+            const QList<StreamChunk> chunks = pipeline.feed(bytes);
+            const QList<StreamChunk> logged = rechunkInModel ? modelChunker.feed(bytes) : chunks;
+            for (const StreamChunk &chunk : logged) {
+                model.appendChunk(timestamp, DataDirection::Rx, transportName, chunk);
+            }
+            appended += logged.size();
+            if (read % kReadsPerTick == kReadsPerTick - 1) {
+                model.publishPending();
+            }
+        }
+        model.publishPending();
+        *chunkedBytes = pipeline.bytes + modelChunker.bytes;
+        *rows = appended;
+        return timer.nsecsElapsed();
+    };
+
+    qint64 legacyChunked = 0;
+    qint64 legacyRows = 0;
+    const qint64 legacyNs = run(true, &legacyChunked, &legacyRows);
+    qint64 singleChunked = 0;
+    qint64 singleRows = 0;
+    const qint64 singleNs = run(false, &singleChunked, &singleRows);
+    report("raw-log ingestion, chunked twice", stream.size(), legacyNs, "bytes");
+    report("raw-log ingestion, chunked once", stream.size(), singleNs, "bytes");
+    std::cout << "raw-log ingestion: chunker bytes per stream byte " << static_cast<double>(legacyChunked) / stream.size()
+              << " -> " << static_cast<double>(singleChunked) / stream.size() << "\n";
+
+    if (singleChunked != stream.size()) {
+        std::cerr << "raw-log ingestion: chunker scanned " << singleChunked << " bytes for a " << stream.size()
+                  << "-byte stream\n";
+        return false;
+    }
+    if (singleRows != legacyRows) {
+        std::cerr << "raw-log ingestion: " << singleRows << " rows, expected " << legacyRows << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Stands in for a view over a satellite model, or over the band filter the
+// signal bars use: a created delegate reads every role of its row, a
+// dataChanged re-reads only the roles it names.
+struct DelegateChurn {
+    qint64 created = 0;
+    qint64 destroyed = 0;
+    qint64 reads = 0;
+};
+
+void attachDelegates(QAbstractItemModel *model, DelegateChurn *churn) {
+    const QList<int> roles = model->roleNames().keys();
+    QObject::connect(model, &QAbstractItemModel::rowsInserted,
+                     [model, churn, roles](const QModelIndex &, int first, int last) {
+                         for (int row = first; row <= last; ++row) {
+                             ++churn->created;
+                             for (const int role : roles) {
+                                 churn->reads += model->data(model->index(row, 0), role).isValid();
+                             }
+                         }
+                     });
+    QObject::connect(model, &QAbstractItemModel::rowsRemoved,
+                     [churn](const QModelIndex &, int first, int last) { churn->destroyed += last - first + 1; });
+    QObject::connect(model, &QAbstractItemModel::dataChanged,
+                     [model, churn](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &changed) {
+                         for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                             for (const int role : changed) {
+                                 churn->reads += model->data(model->index(row, 0), role).isValid();
+                             }
+                         }
+                     });
+}
+
+// 160 tracked signals refreshed once per 50 ms UI tick: a third of them
+// change C/N0 every tick and four set or rise every 20 ticks. The old
+// per-tick rebuild is reproduced by emptying both models before each update,
+// which destroys and recreates every delegate the way a reset did. The sky
+// plot reads SatelliteModel directly; the signal bars read SignalModel
+// through the L1 and L5 tabs of SignalBandFilterModel, as SignalBarsPanel.qml
+// does.
+bool benchmarkSatelliteModelDiffs() {
+    constexpr int kSignals = 160;
+    constexpr int kTicks = 1200;
+
+    const auto signalAt = [](int index) {
+        static const QStringList constellations = {QStringLiteral("GPS"), QStringLiteral("GLONASS"),
+                                                   QStringLiteral("GALILEO"), QStringLiteral("BEIDOU")};
+        static const QStringList bands = {QStringLiteral("L1"), QStringLiteral("L5")};
+        SatelliteInfo sat;
+        sat.constellation = constellations.at(index % constellations.size());
+        sat.band = bands.at((index / constellations.size()) % bands.size());
+        sat.svid = index + 1;
+        sat.signalId = 1;
+        sat.key = QStringLiteral("%1-%2-%3").arg(sat.constellation, sat.band).arg(sat.svid);
+        sat.azimuth = (index * 37) % 360;
+        sat.elevation = 5 + index % 80;
+        sat.cn0 = 30 + index % 15;
+        sat.usedInFix = index % 3 != 0;
+        return sat;
+    };
+
+    const auto run = [&](bool rebuildEveryTick, DelegateChurn *churn, qint64 *meanNs, qint64 *maxNs) {
+        SatelliteModel skyModel;
+        SignalModel signalModel;
+        SignalBandFilterModel l1Bars;
+        SignalBandFilterModel l5Bars;
+        l1Bars.setSourceModel(&signalModel);
+        l1Bars.setBand(QStringLiteral("L1"));
+        l5Bars.setSourceModel(&signalModel);
+        l5Bars.setBand(QStringLiteral("L5"));
+        attachDelegates(&skyModel, churn);
+        attachDelegates(&l1Bars, churn);
+        attachDelegates(&l5Bars, churn);
+        QHash<QString, SatelliteInfo> tracked;
+        for (int index = 0; index < kSignals; ++index) {
+            const SatelliteInfo sat = signalAt(index);
+            tracked.insert(sat.key, sat);
+        }
+        int nextIndex = kSignals;
+        qint64 totalNs = 0;
+        *maxNs = 0;
+        QElapsedTimer timer;
+        for (int tick = 0; tick < kTicks; ++tick) {
+            for (auto it = tracked.begin(); it != tracked.end(); ++it) {
+                if ((it->svid + tick) % 3 == 0) {
+                    it->cn0 = 30 + (it->svid * 7 + tick) % 20;
+                }
+            }
+            if (tick % 20 == 19) {
+                for (int i = 0; i < 4; ++i) {
+                    tracked.erase(tracked.begin());
+                    const SatelliteInfo sat = signalAt(nextIndex++);
+                    tracked.insert(sat.key, sat);
+                }
+            }
+            timer.start();
+            if (rebuildEveryTick) {
+                skyModel.setSatellites(QList<SatelliteInfo>());
+                signalModel.setSatellites(QList<SatelliteInfo>());
+            }
+            skyModel.setSatellites(tracked);
+            signalModel.setSatellites(tracked);
+            const qint64 elapsedNs = timer.nsecsElapsed();
+            totalNs += elapsedNs;
+            *maxNs = qMax(*maxNs, elapsedNs);
+        }
+        *meanNs = totalNs / kTicks;
+    };
+
+    DelegateChurn rebuilt;
+    DelegateChurn diffed;
+    qint64 rebuiltMeanNs = 0;
+    qint64 rebuiltMaxNs = 0;
+    qint64 diffedMeanNs = 0;
+    qint64 diffedMaxNs = 0;
+    run(true, &rebuilt, &rebuiltMeanNs, &rebuiltMaxNs);
+    run(false, &diffed, &diffedMeanNs, &diffedMaxNs);
+    std::cout << "satellite models, rebuild per tick: " << rebuiltMeanNs / 1e3 << " us mean, " << rebuiltMaxNs / 1e3
+              << " us max, " << rebuilt.created << " delegates created, " << rebuilt.reads << " role reads\n";
+    std::cout << "satellite models, keyed diff: " << diffedMeanNs / 1e3 << " us mean, " << diffedMaxNs / 1e3
+              << " us max, " << diffed.created << " delegates created, " << diffed.reads << " role reads\n";
+
+    // The sky plot and the two bar tabs, which split the signals between
+    // them, each create every initial row once plus four per churn.
+    const qint64 expectedCreated = 2LL * (kSignals + 4 * (kTicks / 20));
+    if (diffed.created != expectedCreated || diffed.destroyed != 2LL * 4 * (kTicks / 20)) {
+        std::cerr << "satellite models: " << diffed.created << " delegates created, expected " << expectedCreated
+                  << "\n";
+        return false;
+    }
+    if (diffedMeanNs >= rebuiltMeanNs) {
+        std::cerr << "satellite models: keyed diff is not faster than a rebuild\n";
+        return false;
+    }
+    return true;
+}
+
+// A long drive with 192 tracked signals at 1 Hz: every epoch appends one
+// sample per signal, and a UI refresh then aggregates and decimates a
+// five-minute window for each of them.
+bool benchmarkSatelliteHistory() {
+    constexpr int kSignals = SatelliteHistory::kPlannedTracks;
+    constexpr int kEpochs = 4 * 3600;
+    constexpr qint64 kWindowMs = 300 * 1000;
+
+    SatelliteHistory history;
+    QHash<QString, SatelliteInfo> satellites;
+    for (int index = 0; index < kSignals; ++index) {
+        SatelliteInfo sat;
+        sat.key = QStringLiteral("SIG-%1").arg(index);
+        sat.constellation = QStringLiteral("GPS");
+        sat.svid = index + 1;
+        sat.cn0 = 35;
+        satellites.insert(sat.key, sat);
+    }
+
+    QElapsedTimer timer;
+    qint64 appendNs = 0;
+    for (int epoch = 0; epoch < kEpochs; ++epoch) {
+        for (auto it = satellites.begin(); it != satellites.end(); ++it) {
+            it->cn0 = 25 + (it->svid * 13 + epoch) % 25;
+            it->elevation = (it->svid + epoch / 60) % 90;
+        }
+        timer.start();
+        history.appendEpoch(epoch * 1000LL, satellites);
+        appendNs += timer.nsecsElapsed();
+    }
+    report("satellite history append", qint64(kEpochs) * kSignals, appendNs, "samples");
+
+    const qint64 toMs = history.latestTimestampMs();
+    qint64 samples = 0;
+    qint64 points = 0;
+    timer.start();
+    for (const QString &key : history.keys()) {
+        samples += history.windowStats(key, toMs - kWindowMs, toMs).samples;
+        points += history.decimatedCn0(key, toMs - kWindowMs, toMs, 60).size();
+    }
+    const qint64 queryNs = timer.nsecsElapsed();
+    std::cout << "satellite history window refresh: " << queryNs / 1e6 << " ms for " << kSignals << " signals, "
+              << samples << " samples to " << points << " points, " << history.memoryBytes() / (1024 * 1024)
+              << " MiB of " << history.memoryBudget() / (1024 * 1024) << " MiB\n";
+
+    // QList may round each capacity up to its alignment, so allow 1%.
+    if (history.trackCount() != kSignals || history.memoryBytes() > history.memoryBudget() * 101 / 100) {
+        std::cerr << "satellite history: " << history.trackCount() << " signals in " << history.memoryBytes()
+                  << " bytes, budget " << history.memoryBudget() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool benchmarkSatelliteAgeing() {
+    constexpr int kEpochs = 3600;
+    constexpr int kReported = 300;
+    constexpr int kChurnPerEpoch = 5;
+    constexpr int kBurst = 20000;
+
+    QStringList keys;
+    keys.reserve(kEpochs * kChurnPerEpoch + kReported + kBurst);
+    for (int index = 0; index < kEpochs * kChurnPerEpoch + kReported + kBurst; ++index) {
+        keys.append(QStringLiteral("SIG-%1").arg(index));
+    }
+
+    // A burst of one-off signals expiring together, then a sky whose
+    // reported set slides by a few signals every epoch.
+    SatelliteAgeing ageing;
+    QElapsedTimer timer;
+    timer.start();
+    for (int index = 0; index < kBurst; ++index) {
+        ageing.touch(keys.at(kEpochs * kChurnPerEpoch + kReported + index), 0);
+    }
+    qint64 stale = 0;
+    qint64 expired = 0;
+    qint64 touches = kBurst;
+    for (int epoch = 0; epoch < kEpochs; ++epoch) {
+        const qint64 nowMs = epoch * 1000LL;
+        for (int index = epoch * kChurnPerEpoch; index < epoch * kChurnPerEpoch + kReported; ++index) {
+            ageing.touch(keys.at(index), nowMs);
+        }
+        touches += kReported;
+        const SatelliteAgeing::Transitions transitions = ageing.advance(nowMs);
+        stale += transitions.stale.size();
+        expired += transitions.expired.size();
+    }
+    const qint64 elapsedNs = timer.nsecsElapsed();
+    report("satellite ageing touch and advance", touches, elapsedNs, "touches");
+    std::cout << "satellite ageing: " << stale << " stale, " << expired << " expired, " << ageing.trackedCount()
+              << " tracked after " << kEpochs << " epochs\n";
+
+    // Everything not reported in the last minute is gone.
+    const int expectedTracked = kReported + 60 * kChurnPerEpoch;
+    if (ageing.trackedCount() > expectedTracked || expired < kBurst) {
+        std::cerr << "satellite ageing: " << ageing.trackedCount() << " tracked, expected at most "
+                  << expectedTracked << ", " << expired << " expired\n";
+        return false;
+    }
+    return true;
+}
+
+bool benchmarkDeviationMapModel() {
+    // Eight hours of a static 10 Hz receiver, centered on the running average.
+    constexpr int kSamples = 8 * 3600 * 10;
+    DeviationMapModel model;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kSamples; ++i) {
+        model.addSample(31.230400 + 2e-5 * std::sin(i * 12.9898), 121.473700 + 2e-5 * std::cos(i * 78.233));
+    }
+    const qint64 elapsedNs = timer.nsecsElapsed();
+    report("deviation map append", kSamples, elapsedNs, "samples");
+
+    const QVariantMap horizontal = model.stats().value(QStringLiteral("horizontal")).toMap();
+    const double cep50 = horizontal.value(QStringLiteral("cep50")).toDouble();
+    const double cep95 = horizontal.value(QStringLiteral("cep95")).toDouble();
+    std::cout << "deviation map after " << kSamples << " samples: CEP50 " << cep50 << " m, CEP95 " << cep95
+              << " m\n";
+    if (model.rowCount() != kSamples || !(cep50 > 0.0 && cep50 < cep95)) {
+        std::cerr << "deviation map: " << model.rowCount() << " rows, CEP50 " << cep50 << ", CEP95 " << cep95 << "\n";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("GnssViewBenchmark"));
+    QCoreApplication::setOrganizationName(QStringLiteral("hdgnss"));
+
+    bool ok = true;
+    ok = benchmarkDecodeJsonlExporter() && ok;
+    ok = benchmarkReplayTransport() && ok;
+    ok = benchmarkRawLogModelInsertBatching() && ok;
+    ok = benchmarkRawLogModelMemory() && ok;
+    ok = benchmarkRawLogModelScrolling() && ok;
+    ok = benchmarkRawLogModelScrollback() && ok;
+    ok = benchmarkRawLogIngestion() && ok;
+    ok = benchmarkSatelliteModelDiffs() && ok;
+    ok = benchmarkSatelliteHistory() && ok;
+    ok = benchmarkSatelliteAgeing() && ok;
+    ok = benchmarkDeviationMapModel() && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -13,38 +13,84 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QFile>
+#include <QFileInfo>
 #include <QStringList>
+#include <QTime>
 #include <QVariantList>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <iostream>
+#include <utility>
 
+#include "src/batch/BatchDecoder.h"
+#include "src/batch/CaptureStream.h"
+#include "src/batch/ParallelCaptureDecoder.h"
 #include "src/core/AppController.h"
 #include "src/core/AppSettings.h"
+#include "src/core/CaptureDecoder.h"
+#include "src/core/ReceiverKeyframe.h"
+#include "src/core/SatelliteAgeing.h"
 #include "src/core/UpdateChecker.h"
 #include "src/models/CommandButtonModel.h"
 #include "src/tec/TecMapOverlayModel.h"
 #include "src/models/DeviationMapModel.h"
+#include "src/models/RawLogFilterModel.h"
+#include "src/models/RawLogModel.h"
+#include "src/models/SatelliteHistoryModel.h"
 #include "src/models/SatelliteModel.h"
+#include "src/models/SatelliteStatsModel.h"
+#include "src/models/SignalBandFilterModel.h"
 #include "src/models/SignalModel.h"
 #include "src/protocols/NmeaProtocolPlugin.h"
+#include "src/storage/CaptureIndex.h"
+#include "src/storage/CaptureKeyframes.h"
+#include "src/storage/DecodeJsonlExporter.h"
+#include "src/storage/JsonStreamWriter.h"
 #include "src/storage/RawRecorder.h"
 #include "src/tec/TecMapRenderer.h"
+#include "src/transports/ReplayTransport.h"
+#include "src/utils/ByteUtils.h"
 
 namespace {
 
 using hdgnss::AppController;
 using hdgnss::AppSettings;
+using hdgnss::BatchDecoder;
+using hdgnss::CaptureDecoder;
+using hdgnss::CaptureStream;
+using hdgnss::CaptureSummary;
+using hdgnss::CaptureIndex;
+using hdgnss::CaptureKeyframe;
+using hdgnss::CaptureKeyframes;
 using hdgnss::CommandButtonModel;
+using hdgnss::DecodeJsonlExporter;
+using hdgnss::DeviationDensityGrid;
+using hdgnss::DeviationInterval;
 using hdgnss::DeviationMapModel;
+using hdgnss::DeviationStatistics;
 using hdgnss::NmeaProtocolPlugin;
+using hdgnss::ParallelCaptureDecoder;
 using hdgnss::ProtocolMessage;
 using hdgnss::RawLogEntry;
+using hdgnss::RawLogFilterModel;
+using hdgnss::RawLogModel;
 using hdgnss::RawRecorder;
+using hdgnss::ReceiverKeyframe;
+using hdgnss::ReplayTransport;
+using hdgnss::SatelliteAgeing;
+using hdgnss::SatelliteHistory;
+using hdgnss::SatelliteHistoryModel;
 using hdgnss::SatelliteInfo;
 using hdgnss::SatelliteModel;
+using hdgnss::SatelliteStatsModel;
+using hdgnss::SignalBandFilterModel;
+using hdgnss::SignalGroup;
 using hdgnss::SignalModel;
+using hdgnss::StreamChunk;
+using hdgnss::StreamChunkKind;
 using hdgnss::TecMapOverlayModel;
 using hdgnss::UpdateChecker;
 
@@ -193,6 +239,657 @@ bool expectRawRecorderRequiresExplicitLogDirectory() {
                   "raw recorder should write after a log directory is configured");
 }
 
+bool expectRawRecorderWritesDecodeJsonl() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary log directory should be valid")) {
+        return false;
+    }
+
+    const QDateTime timestamp = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:01.250Z"), Qt::ISODateWithMs);
+    ProtocolMessage message;
+    message.protocol = QStringLiteral("NMEA");
+    message.messageName = QStringLiteral("GGA");
+    message.fields = {
+        {QStringLiteral("latitude"), 31.2345678},
+        {QStringLiteral("hdop"), std::numeric_limits<double>::quiet_NaN()},
+        {QStringLiteral("validFix"), true},
+        {QStringLiteral("quality"), 4},
+        {QStringLiteral("status"), QStringLiteral("quote\"tab\t")},
+        {QStringLiteral("satellites"), QVariantList{QVariantMap{{QStringLiteral("svid"), 7}}}}
+    };
+
+    RawRecorder recorder;
+    recorder.setLogRootDirectory(tempDir.path());
+    recorder.recordMessage(timestamp, hdgnss::DataDirection::Rx, QStringLiteral("UART"), message);
+    if (!expect(recorder.jsonlFilePath().isEmpty(),
+                "decode JSONL should stay closed until it is enabled for a session")) {
+        return false;
+    }
+
+    recorder.setRecordJsonlEnabled(true);
+    recorder.startSession(QStringLiteral("session"), timestamp, QStringLiteral("unit"));
+    const QString jsonlPath = recorder.jsonlFilePath();
+    if (!expect(jsonlPath.endsWith(QStringLiteral(".jsonl")), "decode JSONL should open with the session")) {
+        return false;
+    }
+    recorder.recordMessage(timestamp, hdgnss::DataDirection::Rx, QStringLiteral("UART"), message);
+    recorder.recordMessage(timestamp.addMSecs(100), hdgnss::DataDirection::Tx, QStringLiteral("UART"), message);
+    recorder.setLogRootDirectory(QString());
+
+    QFile file(jsonlPath);
+    if (!expect(file.open(QIODevice::ReadOnly), "decode JSONL file should be readable")) {
+        return false;
+    }
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    if (!expect(lines.size() == 3 && lines.last().isEmpty(), "decode JSONL should hold one line per message")) {
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonObject first = QJsonDocument::fromJson(lines.at(0), &parseError).object();
+    const QJsonObject second = QJsonDocument::fromJson(lines.at(1)).object();
+    const QJsonObject fields = first.value(QStringLiteral("fields")).toObject();
+    return expect(parseError.error == QJsonParseError::NoError, "decode JSONL lines should be valid JSON")
+        && expect(first.value(QStringLiteral("timestamp")).toString() == QStringLiteral("2026-04-27T00:00:01.250Z"),
+                  "decode JSONL should write ISO UTC timestamps with milliseconds")
+        && expect(first.value(QStringLiteral("direction")).toString() == QStringLiteral("RX")
+                      && second.value(QStringLiteral("direction")).toString() == QStringLiteral("TX"),
+                  "decode JSONL should keep message direction")
+        && expect(first.value(QStringLiteral("protocol")).toString() == QStringLiteral("NMEA")
+                      && first.value(QStringLiteral("message")).toString() == QStringLiteral("GGA"),
+                  "decode JSONL should name protocol and message")
+        && expect(std::abs(fields.value(QStringLiteral("latitude")).toDouble() - 31.2345678) < 1e-12,
+                  "decode JSONL should round-trip doubles")
+        && expect(fields.value(QStringLiteral("hdop")).isNull(), "decode JSONL should write NaN as null")
+        && expect(fields.value(QStringLiteral("validFix")).toBool()
+                      && fields.value(QStringLiteral("quality")).toInt() == 4,
+                  "decode JSONL should keep bool and integer fields")
+        && expect(fields.value(QStringLiteral("status")).toString() == QStringLiteral("quote\"tab\t"),
+                  "decode JSONL should escape strings")
+        && expect(fields.value(QStringLiteral("satellites")).toArray().first().toObject()
+                          .value(QStringLiteral("svid")).toInt() == 7,
+                  "decode JSONL should serialize nested lists and maps");
+}
+
+bool expectDecodeJsonlQueueDropsOldestWhenFull() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary log directory should be valid")) {
+        return false;
+    }
+
+    const QString path = tempDir.filePath(QStringLiteral("bounded.jsonl"));
+    DecodeJsonlExporter exporter;
+    exporter.setMaxQueuedMessages(4);
+    if (!expect(exporter.open(path), "bounded decode JSONL should open")) {
+        return false;
+    }
+
+    exporter.regressionPauseWriter(true);
+    ProtocolMessage message;
+    message.protocol = QStringLiteral("NMEA");
+    message.messageName = QStringLiteral("GGA");
+    for (int index = 0; index < 10; ++index) {
+        message.fields = {{QStringLiteral("sequence"), index}};
+        exporter.enqueue(1000 + index, hdgnss::DataDirection::Rx, QStringLiteral("UART"), message);
+    }
+    if (!expect(exporter.messagesDropped() == 6,
+                "a stalled decode JSONL writer should drop the oldest messages past its cap")) {
+        return false;
+    }
+    exporter.regressionPauseWriter(false);
+    exporter.flush();
+    const qint64 written = exporter.messagesWritten();
+    exporter.close();
+
+    QFile file(path);
+    if (!expect(file.open(QIODevice::ReadOnly), "bounded decode JSONL file should be readable")) {
+        return false;
+    }
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    if (!expect(written == 4 && lines.size() == 5 && lines.last().isEmpty(),
+                "bounded decode JSONL should write only the queued messages")) {
+        return false;
+    }
+    for (int line = 0; line < 4; ++line) {
+        const QJsonObject fields = QJsonDocument::fromJson(lines.at(line)).object()
+                                       .value(QStringLiteral("fields")).toObject();
+        if (!expect(fields.value(QStringLiteral("sequence")).toInt() == 6 + line,
+                    "bounded decode JSONL should keep the newest messages in order")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool expectReplayTransportFollowsRecordedIndex() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary log directory should be valid")) {
+        return false;
+    }
+
+    const QDateTime start = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    RawRecorder recorder;
+    recorder.setLogRootDirectory(tempDir.path());
+    recorder.setRecordRawEnabled(true);
+    recorder.startSession(QStringLiteral("replay"), start, QStringLiteral("unit"));
+    const QList<QPair<hdgnss::DataDirection, QByteArray>> writes{
+        {hdgnss::DataDirection::Rx, QByteArrayLiteral("AAAA")},
+        {hdgnss::DataDirection::Tx, QByteArrayLiteral("tx")},
+        {hdgnss::DataDirection::Rx, QByteArrayLiteral("BBB")},
+        {hdgnss::DataDirection::Rx, QByteArrayLiteral("CC")}
+    };
+    for (int i = 0; i < writes.size(); ++i) {
+        RawLogEntry entry;
+        entry.timestampUtc = start.addMSecs(i * 40);
+        entry.direction = writes.at(i).first;
+        entry.payload = writes.at(i).second;
+        recorder.recordRaw(entry);
+    }
+    const QString capturePath = recorder.binaryFilePath();
+    if (!expect(QFileInfo(CaptureIndex::indexPathForCapture(capturePath)).size() == 0,
+                "raw recorder should batch index records instead of flushing every write")) {
+        return false;
+    }
+    recorder.setLogRootDirectory(QString());
+
+    if (!expect(QFileInfo(CaptureIndex::indexPathForCapture(capturePath)).size() == 4 * CaptureIndex::kRecordSize,
+                "raw recorder should write a timing index next to the capture on close")) {
+        return false;
+    }
+
+    ReplayTransport replay;
+    QByteArray received;
+    int seekCount = 0;
+    QObject::connect(&replay, &ReplayTransport::dataReceived, [&received](const QByteArray &bytes) {
+        received += bytes;
+    });
+    QObject::connect(&replay, &ReplayTransport::seeked, [&seekCount]() {
+        ++seekCount;
+    });
+    if (!expect(replay.openWithSettings({{QStringLiteral("path"), capturePath},
+                                         {QStringLiteral("speed"), 0.0}}),
+                "replay should open a recorded capture")
+        || !expect(replay.isTimed(), "replay should load the recorded timing index")
+        || !expect(replay.durationMs() == 120, "replay duration should span the indexed writes")
+        || !expect(waitUntil([&replay]() { return replay.isFinished(); }, 2000),
+                   "as-fast-as-possible replay should reach the end of the capture")
+        || !expect(received == QByteArrayLiteral("AAAABBBCC"),
+                   "replay should emit RX bytes in order and skip recorded TX writes")) {
+        return false;
+    }
+
+    received.clear();
+    replay.seekToTime(80);
+    if (!expect(seekCount == 1, "seeking should announce a stream discontinuity")
+        || !expect(waitUntil([&replay]() { return replay.isFinished(); }, 2000),
+                   "replay should finish again after a seek")
+        || !expect(received == QByteArrayLiteral("BBBCC"),
+                   "seeking by time should resume at the first write at or after that time")) {
+        return false;
+    }
+
+    received.clear();
+    replay.setPaused(true);
+    replay.seek(0);
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    if (!expect(received.isEmpty(), "a paused replay should not emit after seeking")) {
+        return false;
+    }
+    replay.setPaused(false);
+    if (!expect(waitUntil([&replay]() { return replay.isFinished(); }, 2000),
+                "resumed replay should reach the end of the capture")
+        || !expect(received == QByteArrayLiteral("AAAABBBCC"),
+                   "resumed replay should emit the whole capture after seeking to the start")) {
+        return false;
+    }
+
+    // Original timing: the last write lands ~120 ms after the first one.
+    received.clear();
+    replay.setSpeed(1.0);
+    QElapsedTimer timer;
+    timer.start();
+    replay.seek(0);
+    if (!expect(waitUntil([&replay]() { return replay.isFinished(); }, 2000),
+                "real-time replay should reach the end of the capture")) {
+        return false;
+    }
+    const qint64 elapsedMs = timer.elapsed();
+    replay.close();
+    if (!expect(received == QByteArrayLiteral("AAAABBBCC"),
+                "real-time replay should emit the whole capture")
+        || !expect(elapsedMs >= 100, "real-time replay should honour the recorded write spacing")) {
+        return false;
+    }
+
+    // A recorder that stopped mid-write leaves bytes past the last index
+    // record; they are still replayed, a bounded chunk at a time.
+    const QByteArray tail(200 * 1024, 'T');
+    QFile capture(capturePath);
+    if (!expect(capture.open(QIODevice::Append) && capture.write(tail) == tail.size(),
+                "the capture should accept an unindexed tail")) {
+        return false;
+    }
+    capture.close();
+    received.clear();
+    qsizetype largestEmission = 0;
+    QObject::connect(&replay, &ReplayTransport::dataReceived, [&largestEmission](const QByteArray &bytes) {
+        largestEmission = std::max(largestEmission, bytes.size());
+    });
+    const bool reopened = replay.openWithSettings({{QStringLiteral("path"), capturePath},
+                                                   {QStringLiteral("speed"), 0.0}});
+    const bool reopenedTimed = reopened && replay.isTimed();
+    const bool tailFinished = waitUntil([&replay]() { return replay.isFinished(); }, 2000);
+    replay.close();
+    return expect(reopenedTimed, "replay should keep the index of a capture with an unindexed tail")
+        && expect(tailFinished && received == QByteArrayLiteral("AAAABBBCC") + tail,
+                  "replay should emit the bytes written after the last index record")
+        && expect(largestEmission <= 64 * 1024, "replay should emit an unindexed tail in bounded chunks");
+}
+
+bool expectReplaySeekResumesFromKeyframe() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary log directory should be valid")) {
+        return false;
+    }
+
+    // One GGA per second, written in slices that do not line up with the
+    // sentences so keyframes land mid-sentence.
+    QByteArray stream;
+    for (int second = 0; second < 80; ++second) {
+        const QByteArray utc = QTime(12, 0).addSecs(second).toString(QStringLiteral("hhmmss")).toLatin1();
+        stream += withChecksum("GPGGA," + utc + ".000,3112.4640,N,12135.2000,E,1,08,0.9,10.0,M,0.0,M,,");
+    }
+    const int sentenceBytes = stream.size() / 80;
+    const int writeBytes = sentenceBytes + 5;
+
+    const QDateTime start = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    RawRecorder recorder;
+    recorder.setLogRootDirectory(tempDir.path());
+    recorder.setRecordRawEnabled(true);
+    recorder.startSession(QStringLiteral("keyframe"), start, QStringLiteral("unit"));
+    NmeaProtocolPlugin live;
+    QByteArray capture;
+    QList<qint64> keyframeOffsets;
+    for (int write = 0; write < 70; ++write) {
+        RawLogEntry entry;
+        entry.timestampUtc = start.addSecs(write);
+        entry.direction = hdgnss::DataDirection::Rx;
+        entry.payload = stream.mid(write * writeBytes, writeBytes);
+        if (recorder.keyframeDue(entry.timestampUtc)) {
+            ReceiverKeyframe keyframe;
+            keyframe.nmeaState = live.saveState();
+            recorder.recordKeyframe(entry.timestampUtc, keyframe.serialize());
+            keyframeOffsets.append(capture.size());
+        }
+        recorder.recordRaw(entry);
+        live.feed(entry.payload);
+        capture += entry.payload;
+    }
+    const QString capturePath = recorder.binaryFilePath();
+    recorder.setLogRootDirectory(QString());
+
+    QFile keyframeFile(CaptureKeyframes::keyframePathForCapture(capturePath));
+    const QList<CaptureKeyframe> keyframes = keyframeFile.open(QIODevice::ReadOnly)
+        ? CaptureKeyframes::parse(keyframeFile.readAll())
+        : QList<CaptureKeyframe>{};
+    if (!expect(keyframeOffsets.size() == 2, "raw recorder should ask for a keyframe every interval")
+        || !expect(keyframes.size() == 2
+                       && keyframes.at(0).offset == keyframeOffsets.at(0)
+                       && keyframes.at(1).offset == keyframeOffsets.at(1),
+                   "keyframes should record the capture offset they are valid at")
+        || !expect(keyframes.at(1).timestampMs == start.addSecs(60).toMSecsSinceEpoch(),
+                   "keyframes should record the write time")
+        || !expect(capture.at(keyframes.at(1).offset - 1) != '\n',
+                   "keyframe fixture should split a sentence")) {
+        return false;
+    }
+
+    ReplayTransport replay;
+    QByteArray received;
+    QByteArray seekState;
+    QObject::connect(&replay, &ReplayTransport::dataReceived, [&received](const QByteArray &bytes) {
+        received += bytes;
+    });
+    QObject::connect(&replay, &ReplayTransport::seeked, [&seekState](const QByteArray &keyframeState) {
+        seekState = keyframeState;
+    });
+    if (!expect(replay.openWithSettings({{QStringLiteral("path"), capturePath},
+                                         {QStringLiteral("speed"), 0.0},
+                                         {QStringLiteral("paused"), true}}),
+                "replay should open a capture with keyframes")) {
+        return false;
+    }
+
+    // A paused seek still decodes up to the target so the UI shows its state.
+    const qint64 target = keyframes.at(1).offset + 2 * writeBytes + 3;
+    replay.seek(target);
+    if (!expect(seekState == keyframes.at(1).state, "seeking should hand out the nearest earlier keyframe")
+        || !expect(waitUntil([&replay, target]() { return replay.position() >= target; }, 2000),
+                   "a paused replay should catch up from the keyframe to the seek target")) {
+        return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    const qint64 caughtUpTo = replay.position();
+    if (!expect(received == capture.mid(keyframes.at(1).offset, caughtUpTo - keyframes.at(1).offset),
+                "catch-up should replay the bytes between the keyframe and the target")
+        || !expect(caughtUpTo < capture.size() && !replay.isFinished(),
+                   "catch-up should stop at the write holding the target")) {
+        return false;
+    }
+    replay.setPaused(false);
+    if (!expect(waitUntil([&replay]() { return replay.isFinished(); }, 2000),
+                "replay should finish after resuming from a keyframe")
+        || !expect(received == capture.mid(keyframes.at(1).offset),
+                   "replay should continue seamlessly after the catch-up")) {
+        return false;
+    }
+
+    received.clear();
+    replay.seek(keyframes.at(0).offset - 1);
+    const bool seekBeforeFirstKeyframe = seekState.isEmpty();
+    waitUntil([&replay]() { return replay.isFinished(); }, 2000);
+    replay.close();
+    if (!expect(seekBeforeFirstKeyframe, "seeking before the first keyframe should reset state")
+        || !expect(received == capture.mid(keyframes.at(0).offset - 1),
+                   "seeking before the first keyframe should resume at the target")) {
+        return false;
+    }
+
+    // The restored parser finishes the sentence the keyframe split.
+    ReceiverKeyframe restored;
+    NmeaProtocolPlugin resumed;
+    if (!expect(ReceiverKeyframe::deserialize(keyframes.at(1).state, &restored), "keyframe state should deserialize")
+        || !expect(resumed.restoreState(restored.nmeaState), "NMEA state should restore from a keyframe")) {
+        return false;
+    }
+    const qsizetype completeBefore = capture.left(keyframes.at(1).offset).count('\n');
+    const qsizetype completeTotal = capture.count('\n');
+    return expect(resumed.feed(capture.mid(keyframes.at(1).offset)).size() == completeTotal - completeBefore,
+                  "a restored NMEA parser should decode every sentence after the keyframe")
+        && expect(!ReceiverKeyframe::deserialize(QByteArrayLiteral("junk"), &restored),
+                  "a foreign keyframe blob should be rejected");
+}
+
+bool expectBatchDecoderSummarizesCaptures() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary capture directory should be valid")) {
+        return false;
+    }
+
+    // Three epochs: fix, no fix, RTK fix. GGA and RMC of one epoch count once.
+    QByteArray capture;
+    for (const QByteArray &body : {
+             QByteArrayLiteral("GPGGA,123519.000,3112.4640,N,12135.2000,E,1,08,0.9,10.0,M,0.0,M,,"),
+             QByteArrayLiteral("GPRMC,123519.000,A,3112.4640,N,12135.2000,E,0.0,0.0,270426,,,A"),
+             QByteArrayLiteral("GPGSA,A,3,04,09,,,,,,,,,,,1.6,0.8,1.4"),
+             QByteArrayLiteral("GPGSV,1,1,02,04,40,083,42,09,17,273,38"),
+             QByteArrayLiteral("GPGGA,123520.000,,,,,0,00,,,M,,M,,"),
+             QByteArrayLiteral("GPRMC,123520.000,V,,,,,,,270426,,,N"),
+             QByteArrayLiteral("GPGGA,123521.000,3112.4650,N,12135.2010,E,4,10,1.1,12.5,M,0.0,M,,")}) {
+        capture += withChecksum(body);
+    }
+    const QDir root(tempDir.path());
+    if (!expect(root.mkpath(QStringLiteral("a/b")), "capture subdirectory should be created")) {
+        return false;
+    }
+    const QList<QPair<QString, QByteArray>> files{
+        {root.filePath(QStringLiteral("a/b/second.raw.bin")), capture},
+        {root.filePath(QStringLiteral("a/first.raw.bin")), capture},
+        {root.filePath(QStringLiteral("a/notes.txt")), QByteArrayLiteral("not a capture")},
+        {root.filePath(QStringLiteral("empty.raw.bin")), QByteArray()}
+    };
+    for (const auto &entry : files) {
+        QFile file(entry.first);
+        if (!expect(file.open(QIODevice::WriteOnly) && file.write(entry.second) == entry.second.size(),
+                    "batch capture fixture should be written")) {
+            return false;
+        }
+    }
+
+    const QStringList captures = BatchDecoder::collectCaptures({root.filePath(QStringLiteral("a")),
+                                                                root.filePath(QStringLiteral("empty.raw.bin")),
+                                                                root.filePath(QStringLiteral("missing.raw.bin"))});
+    if (!expect(captures.size() == 4, "batch collection should match captures and keep explicit files")
+        || !expect(captures.first().endsWith(QStringLiteral("a/b/second.raw.bin")),
+                   "batch collection should list directory matches in path order")) {
+        return false;
+    }
+
+    BatchDecoder decoder;
+    if (!expect(decoder.parallelSafe() && decoder.workerCount(4, captures.size()) == 4,
+                "the built-in parser alone should allow one worker per file")) {
+        return false;
+    }
+    const std::vector<CaptureSummary> summaries = decoder.run(captures, 4);
+    if (!expect(summaries.size() == 4, "batch decoding should report every capture in input order")) {
+        return false;
+    }
+    for (int index = 0; index < 2; ++index) {
+        const CaptureSummary &summary = summaries.at(static_cast<size_t>(index));
+        if (!expect(summary.error.isEmpty() && summary.bytes == capture.size(), "batch decoding should read the whole capture")
+            || !expect(summary.messages == 7, "batch decoding should decode every sentence")
+            || !expect(summary.messageCounts.value(QStringLiteral("NMEA/GGA")) == 3, "batch summary should count messages by type")
+            || !expect(summary.epochs == 3 && summary.fixEpochs == 2, "batch summary should count each position epoch once")
+            || !expect(summary.firstFixUtc == QDateTime::fromString(QStringLiteral("2026-04-27T12:35:19Z"), Qt::ISODate),
+                       "batch summary should date GGA fixes from RMC")
+            || !expect(summary.lastFixUtc.time() == QTime(12, 35, 21), "batch summary should keep the last fix time")
+            || !expect(std::abs(summary.lastAltitudeMeters - 12.5) < 1e-9, "batch summary should keep the last fix position")
+            || !expect(summary.hdop.count == 3 && std::abs(summary.hdop.max - 1.1) < 1e-9,
+                       "batch summary should skip empty DOP fields")
+            || !expect(summary.pdop.count == 1 && summary.vdop.count == 1, "batch summary should collect GSA DOP")
+            || !expect(summary.satelliteKeys.size() == 2, "batch summary should count distinct satellites")) {
+            return false;
+        }
+    }
+    const CaptureSummary &empty = summaries.at(2);
+    const CaptureSummary &missing = summaries.at(3);
+    if (!expect(empty.error.isEmpty() && empty.messages == 0, "an empty capture should decode to an empty summary")
+        || !expect(!missing.error.isEmpty(), "a missing capture should be reported per file")) {
+        return false;
+    }
+
+    const QByteArray row = summaries.front().toCsvRow();
+    const QJsonDocument json = QJsonDocument::fromJson(summaries.front().toJsonLine());
+    return expect(row.count(',') == CaptureSummary::csvHeader().count(','), "CSV rows should match the header columns")
+        && expect(json.object().value(QStringLiteral("fixEpochs")).toInt() == 2
+                      && json.object().value(QStringLiteral("messageCounts")).toObject()
+                             .value(QStringLiteral("NMEA/RMC")).toInt() == 2,
+                  "JSONL summaries should carry the same counts");
+}
+
+bool expectBatchDecoderSkipsRecordedTxWrites() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary capture directory should be valid")) {
+        return false;
+    }
+
+    // A GGA poll goes out between fixes, once in the middle of a GGA the
+    // receiver was still sending; the poll is valid NMEA and would decode.
+    const QByteArray gga = withChecksum("GPGGA,123519.000,3112.4640,N,12135.2000,E,1,08,0.9,10.0,M,0.0,M,,");
+    const QByteArray rmc = withChecksum("GPRMC,123519.000,A,3112.4640,N,12135.2000,E,0.0,0.0,270426,,,A");
+    const QByteArray poll = withChecksum("EIGPQ,GGA");
+    const QList<QPair<hdgnss::DataDirection, QByteArray>> writes{
+        {hdgnss::DataDirection::Tx, poll},
+        {hdgnss::DataDirection::Rx, gga.left(20)},
+        {hdgnss::DataDirection::Tx, poll},
+        {hdgnss::DataDirection::Rx, gga.mid(20)},
+        {hdgnss::DataDirection::Rx, rmc},
+        {hdgnss::DataDirection::Tx, poll}
+    };
+
+    const QDateTime start = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    RawRecorder recorder;
+    recorder.setLogRootDirectory(tempDir.path());
+    recorder.setRecordRawEnabled(true);
+    recorder.startSession(QStringLiteral("batch"), start, QStringLiteral("unit"));
+    QByteArray recorded;
+    for (int i = 0; i < writes.size(); ++i) {
+        RawLogEntry entry;
+        entry.timestampUtc = start.addMSecs(i * 10);
+        entry.direction = writes.at(i).first;
+        entry.payload = writes.at(i).second;
+        recorder.recordRaw(entry);
+        recorded += entry.payload;
+    }
+    const QString capturePath = recorder.binaryFilePath();
+    recorder.setLogRootDirectory(QString());
+
+    const CaptureSummary indexed = BatchDecoder::decodeFile(capturePath);
+    if (!expect(indexed.error.isEmpty() && indexed.bytes == recorded.size(),
+                "batch decoding should still report the capture size")
+        || !expect(indexed.messages == 2 && indexed.messageCounts.value(QStringLiteral("NMEA/GGA")) == 1
+                       && indexed.messageCounts.value(QStringLiteral("NMEA/RMC")) == 1,
+                   "batch decoding should decode only RX writes and rejoin a sentence split by TX")
+        || !expect(indexed.messageCounts.value(QStringLiteral("NMEA/GPQ")) == 0,
+                   "batch decoding should not count commands sent to the receiver")) {
+        return false;
+    }
+
+    // Without the index the direction is unknown and the whole file is read.
+    if (!expect(QFile::remove(CaptureIndex::indexPathForCapture(capturePath)), "capture index should be removable")) {
+        return false;
+    }
+    const CaptureSummary unindexed = BatchDecoder::decodeFile(capturePath);
+    return expect(unindexed.bytes == recorded.size() && unindexed.messageCounts.value(QStringLiteral("NMEA/GPQ")) > 0,
+                  "an unindexed capture should be decoded whole");
+}
+
+// Satellites come and go between epochs so GSA/GSV output depends on parser
+// state, and binary noise sits between some sentences.
+QByteArray parallelDecodeCapture() {
+    QByteArray capture;
+    for (int epoch = 0; epoch < 2400; ++epoch) {
+        const QByteArray time = QTime(12, 0).addSecs(epoch).toString(QStringLiteral("HHmmss")).toLatin1() + ".00";
+        const int visible = 4 + epoch % 5;
+        capture += withChecksum("GPGGA," + time + ",3112.4640,N,12135.2000,E," + (epoch % 7 ? "1" : "0")
+                                + ",08,0.9,10.0,M,0.0,M,,");
+        QByteArray gsa = "GPGSA,A,3";
+        for (int slot = 0; slot < 12; ++slot) {
+            gsa += slot < visible - 1 ? "," + QByteArray::number(2 + (epoch + slot) % 30) : QByteArray(",");
+        }
+        capture += withChecksum(gsa + ",1.6,0.8,1.4");
+        const int sentences = (visible + 3) / 4;
+        for (int sentence = 0; sentence < sentences; ++sentence) {
+            QByteArray gsv = "GPGSV," + QByteArray::number(sentences) + "," + QByteArray::number(sentence + 1)
+                + "," + QByteArray::number(visible);
+            for (int slot = sentence * 4; slot < std::min(visible, sentence * 4 + 4); ++slot) {
+                gsv += "," + QByteArray::number(2 + (epoch + slot) % 30) + ",40,083," + QByteArray::number(30 + slot);
+            }
+            capture += withChecksum(gsv);
+        }
+        if (epoch % 37 == 0) {
+            capture += QByteArray("\xB5\x62\x01\x07\x5C\x00\x00\x24\x0A\x0D\xFF\xFE", 12);
+        }
+    }
+    return capture;
+}
+
+QList<QByteArray> sequentialDecodeFingerprints(const QByteArray &capture) {
+    QList<QByteArray> sequential;
+    CaptureDecoder decoder;
+    for (qint64 offset = 0; offset < capture.size(); offset += CaptureDecoder::kSliceBytes) {
+        for (const ProtocolMessage &message : decoder.decode(capture.mid(offset, CaptureDecoder::kSliceBytes))) {
+            sequential.append(ParallelCaptureDecoder::messageFingerprint(message));
+        }
+    }
+    return sequential;
+}
+
+bool expectParallelCaptureDecodeMatchesSequential() {
+    const QByteArray capture = parallelDecodeCapture();
+    const QList<QByteArray> sequential = sequentialDecodeFingerprints(capture);
+
+    ParallelCaptureDecoder parallel;
+    parallel.setJobs(4);
+    parallel.setRegionBytes(16 * 1024);
+    parallel.setWarmupBytes(4 * 1024);
+    const QList<qint64> starts = parallel.regionStarts(capture.constData(), capture.size());
+    bool startsAtSentences = starts.size() > 8 && starts.first() == 0;
+    for (qsizetype index = 1; index < starts.size(); ++index) {
+        startsAtSentences = startsAtSentences && capture.at(starts.at(index)) == '$'
+            && capture.at(starts.at(index) - 1) == '\n';
+    }
+    if (!expect(startsAtSentences, "parallel decode should split a capture at NMEA sentence starts")) {
+        return false;
+    }
+
+    QList<QByteArray> stitched;
+    parallel.decode(capture.constData(), capture.size(), [&stitched](const ProtocolMessage &message) {
+        stitched.append(ParallelCaptureDecoder::messageFingerprint(message));
+    });
+    return expect(!sequential.isEmpty() && stitched.size() == sequential.size(),
+                  "parallel decode should emit each message exactly once")
+        && expect(stitched == sequential, "parallel decode should match the sequential decode exactly");
+}
+
+
+bool expectParallelCaptureDecodeSkipsTxWrites() {
+    QTemporaryDir tempDir;
+    if (!expect(tempDir.isValid(), "temporary capture directory should be valid")) {
+        return false;
+    }
+
+    // The receiver output is cut into uneven writes with a poll sent between
+    // every few of them, some of which land mid-sentence.
+    const QByteArray rx = parallelDecodeCapture();
+    const QByteArray poll = withChecksum("EIGPQ,GSV");
+    QByteArray file;
+    QByteArray index;
+    qint64 timestampMs = 0;
+    auto appendWrite = [&](hdgnss::DataDirection direction, const QByteArray &bytes) {
+        CaptureIndex::appendRecord(index, {file.size(), timestampMs += 10, static_cast<quint32>(bytes.size()), direction});
+        file += bytes;
+    };
+    for (qint64 offset = 0, write = 0; offset < rx.size(); ++write) {
+        const qint64 length = std::min<qint64>(rx.size() - offset, 300 + (write * 97) % 900);
+        appendWrite(hdgnss::DataDirection::Rx, rx.mid(offset, length));
+        offset += length;
+        if (write % 3 == 0) {
+            appendWrite(hdgnss::DataDirection::Tx, poll);
+        }
+    }
+    const QString capturePath = tempDir.filePath(QStringLiteral("interleaved.raw.bin"));
+    QFile captureFile(capturePath);
+    QFile indexFile(CaptureIndex::indexPathForCapture(capturePath));
+    if (!expect(captureFile.open(QIODevice::WriteOnly) && captureFile.write(file) == file.size()
+                    && indexFile.open(QIODevice::WriteOnly) && indexFile.write(index) == index.size(),
+                "interleaved capture fixture should be written")) {
+        return false;
+    }
+    captureFile.close();
+    indexFile.close();
+
+    const CaptureStream stream = CaptureStream::fromCapture(capturePath, file.size());
+    if (!expect(stream.size() == rx.size() && stream.skippedBytes() == file.size() - rx.size(),
+                "the capture stream should hold exactly the RX writes")
+        || !expect(stream.slice(file.constData(), 0, stream.size()) == rx,
+                   "the capture stream should read the RX writes back in order")) {
+        return false;
+    }
+
+    ParallelCaptureDecoder parallel;
+    parallel.setJobs(4);
+    parallel.setRegionBytes(16 * 1024);
+    parallel.setWarmupBytes(4 * 1024);
+    const QList<qint64> starts = parallel.regionStarts(file.constData(), stream);
+    bool startsAtSentences = starts.size() > 8;
+    for (qsizetype region = 1; region < starts.size(); ++region) {
+        startsAtSentences = startsAtSentences && rx.at(starts.at(region)) == '$';
+    }
+    if (!expect(startsAtSentences, "parallel decode should split the RX stream at sentence starts")) {
+        return false;
+    }
+
+    const QList<QByteArray> sequential = sequentialDecodeFingerprints(rx);
+    QList<QByteArray> stitched;
+    parallel.decode(file.constData(), stream, [&stitched](const ProtocolMessage &message) {
+        stitched.append(ParallelCaptureDecoder::messageFingerprint(message));
+    });
+    const CaptureSummary summary = BatchDecoder::decodeFile(capturePath);
+    return expect(stitched == sequential, "parallel decode of an interleaved capture should match the RX-only decode")
+        && expect(summary.messages == sequential.size() && summary.messageCounts.value(QStringLiteral("NMEA/GPQ")) == 0,
+                  "batch decoding of an interleaved capture should skip every TX write");
+}
 bool expectBeidouGsaUsesRawPrnWithoutRemap() {
     NmeaProtocolPlugin plugin;
 
@@ -447,57 +1144,661 @@ bool expectNcTalkerMapsToNavicL5() {
         return false;
     }
 
-    const QVariantList satellites = gsa.first().fields.value(QStringLiteral("satellites")).toList();
-    if (!expect(satellites.size() == 2, "NCGSV should expose two NavIC satellites")) {
+    const QVariantList satellites = gsa.first().fields.value(QStringLiteral("satellites")).toList();
+    if (!expect(satellites.size() == 2, "NCGSV should expose two NavIC satellites")) {
+        return false;
+    }
+
+    QVariantMap sat10, sat2;
+    for (const QVariant &v : satellites) {
+        const QVariantMap sat = v.toMap();
+        const int svid = sat.value(QStringLiteral("svid")).toInt();
+        if (svid == 10) sat10 = sat;
+        else if (svid == 2) sat2 = sat;
+    }
+    return expect(!sat10.isEmpty(), "NCGSV should keep the raw NavIC PRN 10")
+        && expect(!sat2.isEmpty(), "NCGSA should match the raw NavIC PRN 2")
+        && expect(sat10.value(QStringLiteral("constellation")).toString() == QStringLiteral("NAVIC"),
+                  "NC talker should map to NAVIC rather than GNSS/GPS")
+        && expect(sat10.value(QStringLiteral("band")).toString() == QStringLiteral("L5"),
+                  "NC signal id 1 should render in the L5/E5/B2 bucket")
+        && expect(!sat10.value(QStringLiteral("usedInFix")).toBool(),
+                  "non-selected NavIC satellite should stay visible-only")
+        && expect(sat2.value(QStringLiteral("constellation")).toString() == QStringLiteral("NAVIC"),
+                  "all NC satellites should map to NAVIC")
+        && expect(sat2.value(QStringLiteral("band")).toString() == QStringLiteral("L5"),
+                  "all NC signal id 1 satellites should render in L5")
+        && expect(sat2.value(QStringLiteral("usedInFix")).toBool(),
+                  "selected NavIC satellite should be highlighted as used");
+}
+
+bool expectByteUtilsHexFormatting() {
+    const QByteArray bytes("\x01\xAB\xFF\x00", 4);
+    return expect(hdgnss::ByteUtils::toHex(bytes) == QStringLiteral("01 AB FF 00"),
+                  "hex formatter should separate upper-case byte pairs")
+        && expect(hdgnss::ByteUtils::toHex(bytes, '\0') == QStringLiteral("01ABFF00"),
+                  "hex formatter should pack digits without a separator")
+        && expect(hdgnss::ByteUtils::toHex(bytes.constData(), 2, ':') == QStringLiteral("01:AB"),
+                  "hex formatter should format a byte range")
+        && expect(hdgnss::ByteUtils::toHex(QByteArray()).isEmpty(), "hex formatter should accept empty input");
+}
+
+bool expectRawLogModelEvictsOldestRows() {
+    RawLogModel model;
+    model.setRetention(5, 0);
+    int removedRows = 0;
+    int insertNotifications = 0;
+    QObject::connect(&model, &QAbstractItemModel::rowsRemoved,
+                     [&removedRows](const QModelIndex &, int first, int last) {
+                         removedRows += last - first + 1;
+                     });
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+                     [&insertNotifications](const QModelIndex &, int, int) { ++insertNotifications; });
+
+    const QDateTime timestamp = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    for (int i = 0; i < 4; ++i) {
+        model.appendChunk(timestamp.addMSecs(i), hdgnss::DataDirection::Rx, QStringLiteral("UART"),
+                          StreamChunk{StreamChunkKind::Text, QByteArray("line-") + QByteArray::number(i)});
+    }
+    if (!expect(model.rowCount() == 0 && model.pendingCount() == 4,
+                "raw log appends should stay staged until the next publish")) {
+        return false;
+    }
+    model.publishPending();
+    for (int i = 4; i < 8; ++i) {
+        model.appendChunk(timestamp.addMSecs(i), hdgnss::DataDirection::Rx, QStringLiteral("UART"),
+                          StreamChunk{StreamChunkKind::Text, QByteArray("line-") + QByteArray::number(i)});
+    }
+    model.publishPending();
+    const auto display = [&model](int row) {
+        return model.data(model.index(row), RawLogModel::DisplayRole).toString();
+    };
+    if (!expect(model.rowCount() == 5, "raw log should hold at most its row limit")
+        || !expect(removedRows == 3, "raw log should announce each evicted row")
+        || !expect(insertNotifications == 2, "raw log should insert each publish as one range")
+        || !expect(display(0) == QStringLiteral("line-3") && display(4) == QStringLiteral("line-7"),
+                   "raw log should keep the newest rows in order across the ring wrap")
+        || !expect(model.get(0).value(QStringLiteral("display")).toString() == QStringLiteral("line-3"),
+                   "raw log get() should follow the ring order")
+        || !expect(model.memoryBytes() > 0, "raw log should report its memory footprint")) {
+        return false;
+    }
+
+    model.setRetention(3, 0);
+    if (!expect(model.rowCount() == 3 && removedRows == 5 && display(0) == QStringLiteral("line-5"),
+                "shrinking the row limit should evict the oldest rows")) {
+        return false;
+    }
+
+    // A budget below one row's footprint keeps only the newest row.
+    model.setRetention(100, 1);
+    model.appendChunk(timestamp, hdgnss::DataDirection::Tx, QStringLiteral("UART"),
+                      StreamChunk{StreamChunkKind::Binary, QByteArray(64, '\xAA')});
+    model.publishPending();
+    const qint64 oneRowBytes = model.memoryBytes();
+    for (int i = 0; i < 1000; ++i) {
+        model.appendChunk(timestamp, hdgnss::DataDirection::Tx, QStringLiteral("UART"),
+                          StreamChunk{StreamChunkKind::Binary, QByteArray(64, '\xAA')});
+        if (i % 100 == 0) {
+            model.publishPending();
+        }
+    }
+    model.publishPending();
+    const bool boundedByBudget = model.rowCount() == 1 && model.memoryBytes() == oneRowBytes;
+    const QString expectedHex = QStringLiteral("AA ").repeated(29).chopped(1) + QStringLiteral(" (64 B)");
+    if (!expect(display(0) == expectedHex,
+                "raw log should render binary rows as hex cut to the column width")
+        || !expect(model.get(0).value(QStringLiteral("ascii")).toString() == QString(64, QLatin1Char('.')),
+                   "raw log should render non-printable bytes as dots")) {
+        return false;
+    }
+    model.clear();
+    return expect(boundedByBudget, "a memory budget should bound the raw log at constant size")
+        && expect(model.rowCount() == 0 && model.memoryBytes() == 0, "clearing the raw log should release its rows");
+}
+
+bool expectRawLogModelStaysWithinMemoryBudget() {
+    constexpr qint64 kBudget = 256 * 1024;
+    // The interned transport and kind names are held on top of the budget.
+    constexpr qint64 kStringBytes = 4096;
+    RawLogModel model;
+    model.setRetention(100000, kBudget);
+    const QDateTime timestamp = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    qint64 streamed = 0;
+    qint64 peakBytes = 0;
+    for (int tick = 0; streamed < 8 * kBudget; ++tick) {
+        for (int i = 0; i < 16; ++i) {
+            const QByteArray payload(16 + (tick * 16 + i) % 240, '\x55');
+            model.appendChunk(timestamp.addMSecs(tick), hdgnss::DataDirection::Rx, QStringLiteral("UART"),
+                              StreamChunk{StreamChunkKind::Binary, payload});
+            streamed += payload.size();
+        }
+        model.publishPending();
+        peakBytes = std::max(peakBytes, model.memoryBytes());
+    }
+    if (!expect(peakBytes <= kBudget + kStringBytes, "raw log should stay within its memory budget")) {
+        std::cerr << peakBytes << " bytes held, budget " << kBudget << "\n";
+        return false;
+    }
+    if (!expect(model.previewBytes() > kBudget / 2 && model.rowCount() > 0,
+                "raw log should spend its memory budget on previews")) {
+        return false;
+    }
+    // Shrinking the budget gives the arena back at once.
+    model.setRetention(100000, kBudget / 4);
+    return expect(model.memoryBytes() <= kBudget / 4 + kStringBytes,
+                  "shrinking the raw log budget should release memory");
+}
+
+bool expectRawLogModelScrollback() {
+    RawLogModel model;
+    model.setRetention(5, 0);
+    model.setScrollbackEnabled(true);
+    if (!expect(model.scrollbackEnabled(), "raw log scrollback should open its archive")) {
+        return false;
+    }
+    int removedRows = 0;
+    QObject::connect(&model, &QAbstractItemModel::rowsRemoved,
+                     [&removedRows](const QModelIndex &, int first, int last) {
+                         removedRows += last - first + 1;
+                     });
+
+    const QDateTime timestamp = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    for (int i = 0; i < 12; ++i) {
+        model.appendChunk(timestamp.addMSecs(i), i % 2 == 0 ? hdgnss::DataDirection::Rx : hdgnss::DataDirection::Tx,
+                          QStringLiteral("UART"), StreamChunk{StreamChunkKind::Text, QByteArray("line-") + QByteArray::number(i)});
+        if (i % 3 == 2) {
+            model.publishPending();
+        }
+    }
+    // Eight staged rows in one tick exceed the ring on their own.
+    for (int i = 12; i < 20; ++i) {
+        model.appendChunk(timestamp.addMSecs(i), hdgnss::DataDirection::Rx, QStringLiteral("UART"),
+                          StreamChunk{StreamChunkKind::Text, QByteArray("line-") + QByteArray::number(i)});
+    }
+    model.publishPending();
+
+    const auto display = [&model](int row) {
+        return model.data(model.index(row), RawLogModel::DisplayRole).toString();
+    };
+    bool ordered = true;
+    for (int row = 0; row < 20; ++row) {
+        ordered = ordered && display(row) == QStringLiteral("line-%1").arg(row);
+    }
+    if (!expect(model.rowCount() == 20 && removedRows == 0, "raw log scrollback should keep every row in the view")
+        || !expect(ordered, "raw log scrollback should page archived rows back in order")
+        || !expect(model.get(1).value(QStringLiteral("direction")).toString() == QStringLiteral("TX")
+                       && model.get(1).value(QStringLiteral("timestamp")).toString()
+                              == QStringLiteral("2026-04-27T00:00:00.001Z"),
+                   "archived rows should keep their fields")
+        || !expect(model.diskBytes() > 0, "raw log scrollback should report its archive size")) {
+        return false;
+    }
+
+    model.setScrollbackEnabled(false);
+    return expect(model.rowCount() == 5 && removedRows == 15 && display(0) == QStringLiteral("line-15"),
+                  "turning scrollback off should drop the archived rows");
+}
+
+bool expectRawLogFilterModel() {
+    RawLogModel model;
+    model.setRetention(8, 0);
+    RawLogFilterModel filter(&model);
+    const QDateTime timestamp = QDateTime::fromString(QStringLiteral("2026-04-27T00:00:00Z"), Qt::ISODate);
+    const auto append = [&model, &timestamp](hdgnss::DataDirection direction, StreamChunkKind kind, const QByteArray &payload) {
+        model.appendChunk(timestamp, direction, QStringLiteral("UART"), StreamChunk{kind, payload});
+    };
+    append(hdgnss::DataDirection::Rx, StreamChunkKind::Nmea, QByteArray("$GPGGA,1"));
+    append(hdgnss::DataDirection::Tx, StreamChunkKind::Text, QByteArray("hello"));
+    append(hdgnss::DataDirection::Rx, StreamChunkKind::Binary, QByteArray::fromHex("b5620107"));
+    append(hdgnss::DataDirection::Rx, StreamChunkKind::Nmea, QByteArray("$GPRMC,1"));
+    model.publishPending();
+
+    const auto display = [&filter](int row) {
+        return filter.data(filter.index(row), RawLogModel::DisplayRole).toString();
+    };
+    if (!expect(filter.rowCount() == 4 && !filter.isActive(), "raw log filter should pass rows through while idle")
+        || !expect(filter.kinds() == QStringList({QStringLiteral("ASCII"), QStringLiteral("BIN"), QStringLiteral("NMEA")}),
+                   "raw log filter should list the kinds it has seen")) {
+        return false;
+    }
+
+    filter.setDirectionFilter({QStringLiteral("RX")});
+    filter.setKindFilter({QStringLiteral("NMEA")});
+    if (!expect(filter.rowCount() == 2 && display(0) == QStringLiteral("$GPGGA,1") && display(1) == QStringLiteral("$GPRMC,1"),
+                "raw log filter should intersect direction and kind")) {
+        return false;
+    }
+    append(hdgnss::DataDirection::Tx, StreamChunkKind::Nmea, QByteArray("$PQTMCFG"));
+    append(hdgnss::DataDirection::Rx, StreamChunkKind::Nmea, QByteArray("$GNGSA,1"));
+    model.publishPending();
+    if (!expect(filter.rowCount() == 3 && display(2) == QStringLiteral("$GNGSA,1"),
+                "raw log filter should match rows as they are published")) {
+        return false;
+    }
+
+    filter.setSearch(QStringLiteral("rmc"), false);
+    filter.waitForSearch();
+    append(hdgnss::DataDirection::Rx, StreamChunkKind::Nmea, QByteArray("$GPRMC,2"));
+    model.publishPending();
+    if (!expect(!filter.searching() && filter.searchProgress() == 1.0, "raw log search should finish")
+        || !expect(filter.rowCount() == 2 && display(0) == QStringLiteral("$GPRMC,1") && display(1) == QStringLiteral("$GPRMC,2"),
+                   "raw log search should narrow the filtered rows case-insensitively")) {
+        return false;
+    }
+
+    filter.clearFilters();
+    filter.setSearch(QStringLiteral("B5 62"), true);
+    filter.waitForSearch();
+    if (!expect(filter.rowCount() == 1 && filter.get(0).value(QStringLiteral("kind")).toString() == QStringLiteral("BIN"),
+                "raw log hex search should match payload bytes")) {
+        return false;
+    }
+
+    // Evicting the three oldest rows drops the BIN match from the front.
+    for (int i = 0; i < 4; ++i) {
+        append(hdgnss::DataDirection::Rx, StreamChunkKind::Text, QByteArray("filler"));
+    }
+    model.publishPending();
+    filter.clearFilters();
+    filter.setKindFilter({QStringLiteral("BIN")});
+    if (!expect(model.rowCount() == 8 && filter.rowCount() == 0, "raw log filter should forget evicted rows")) {
+        return false;
+    }
+
+    // The worker pages archived rows in through its own reader.
+    RawLogModel scrollback;
+    scrollback.setRetention(3, 0);
+    scrollback.setScrollbackEnabled(true);
+    RawLogFilterModel archivedFilter(&scrollback);
+    for (int i = 0; i < 10; ++i) {
+        scrollback.appendChunk(timestamp, hdgnss::DataDirection::Rx, QStringLiteral("UART"),
+                               StreamChunk{StreamChunkKind::Text, QByteArray("line-") + QByteArray::number(i)});
+        scrollback.publishPending();
+    }
+    archivedFilter.setSearch(QStringLiteral("LINE-1"), false);
+    archivedFilter.waitForSearch();
+    if (!expect(archivedFilter.rowCount() == 1 && archivedFilter.sourceRow(0) == 1,
+                "raw log search should reach archived rows")) {
+        return false;
+    }
+
+    // A filter created over existing scrollback indexes the archived rows on
+    // its worker and filters them once they are merged.
+    scrollback.appendChunk(timestamp, hdgnss::DataDirection::Tx, QStringLiteral("TCP"),
+                           StreamChunk{StreamChunkKind::Text, QByteArrayLiteral("poll")});
+    scrollback.publishPending();
+    RawLogFilterModel lateFilter(&scrollback);
+    lateFilter.setTransportFilter({QStringLiteral("UART")});
+    if (!expect(scrollback.archivedRows() == 8 && lateFilter.indexing(),
+                "raw log filter should index archived rows off the GUI thread")
+        || !expect(lateFilter.rowCount() == 2, "raw log filter should match in-memory rows before indexing ends")) {
+        return false;
+    }
+    lateFilter.waitForIndexing();
+    return expect(!lateFilter.indexing() && lateFilter.rowCount() == 10 && lateFilter.sourceRow(0) == 0,
+                  "raw log filter should merge archived postings in front once indexed");
+}
+
+bool expectDeviationMapStats() {
+    DeviationMapModel model;
+    model.addSample(31.230400, 121.473700);
+    model.addSample(31.230410, 121.473715);
+
+    const QVariantMap averageStats = model.stats();
+    if (!expect(model.rowCount() == 2, "deviation map should keep two samples")) {
+        return false;
+    }
+    if (!expect(averageStats.value(QStringLiteral("points")).toInt() == 2, "deviation map points stat mismatch")) {
+        return false;
+    }
+    if (!expect(averageStats.value(QStringLiteral("centerMode")).toString() == QStringLiteral("Average"), "deviation map should default to average center")) {
+        return false;
+    }
+
+    model.setFixedCenterEnabled(true);
+    model.setFixedCenter(31.230400, 121.473700);
+    const QVariantMap fixedStats = model.stats();
+    return expect(fixedStats.value(QStringLiteral("centerMode")).toString() == QStringLiteral("Fixed"), "deviation map should switch to fixed center mode")
+        && expect(std::abs(fixedStats.value(QStringLiteral("centerLatitude")).toDouble() - 31.230400) < 1e-9, "fixed center latitude mismatch")
+        && expect(std::abs(fixedStats.value(QStringLiteral("centerLongitude")).toDouble() - 121.473700) < 1e-9, "fixed center longitude mismatch")
+        && expect(fixedStats.value(QStringLiteral("maxDistance")).toDouble() > 0.0, "deviation map max distance should be positive");
+}
+
+bool expectDeviationMapRowsStayFixedAsCenterMoves() {
+    constexpr double kMetersPerDegree = 3.14159265358979323846 / 180.0 * 6378137.0;
+    DeviationMapModel model;
+    int movedRows = 0;
+    int offsetChanges = 0;
+    QObject::connect(&model, &QAbstractItemModel::dataChanged,
+                     [&model, &movedRows](const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                          const QList<int> &roles) {
+                         if (roles.contains(DeviationMapModel::EastMetersRole)
+                             && (topLeft.row() != bottomRight.row() || topLeft.row() != model.rowCount() - 1)) {
+                             ++movedRows;
+                         }
+                     });
+    QObject::connect(&model, &DeviationMapModel::centerOffsetChanged, [&offsetChanges]() { ++offsetChanges; });
+
+    QList<QPointF> samples;
+    for (int i = 0; i < 200; ++i) {
+        // A slow walk, so the average center moves with nearly every sample.
+        samples.append(QPointF(31.230400 + i * 2e-7 + 1e-6 * std::sin(i * 0.7),
+                               121.473700 + i * 3e-7 + 1e-6 * std::cos(i * 1.3)));
+        model.addSample(samples.last().x(), samples.last().y());
+        if (i % 4 == 3) {
+            samples.last() += QPointF(5e-7, -5e-7);
+            model.updateLastSample(samples.last().x(), samples.last().y());
+        }
+    }
+    if (!expect(movedRows == 0, "deviation map should only rewrite the newest row")
+        || !expect(offsetChanges >= 150, "deviation map should publish the moving center offset")
+        || !expect(model.localPoint(0).isNull(), "deviation map rows should be relative to the first sample")) {
+        return false;
+    }
+
+    const QVariantMap stats = model.stats();
+    const double centerLatitude = stats.value(QStringLiteral("centerLatitude")).toDouble();
+    const double centerLongitude = stats.value(QStringLiteral("centerLongitude")).toDouble();
+    const double eastScale = kMetersPerDegree * std::cos(centerLatitude * 3.14159265358979323846 / 180.0);
+    for (int row = 0; row < samples.size(); ++row) {
+        const QPointF drawn = model.localPoint(row) - model.centerOffset();
+        const double east = (samples.at(row).y() - centerLongitude) * eastScale;
+        const double north = (samples.at(row).x() - centerLatitude) * kMetersPerDegree;
+        if (!expect(std::abs(drawn.x() - east) < 1e-6 && std::abs(drawn.y() - north) < 1e-6,
+                    "deviation map row minus center offset should match the centered deviation")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool expectDeviationDensityGridCountsEveryLevel() {
+    const auto levelTotal = [](const DeviationDensityGrid &grid, int level) {
+        qint64 total = 0;
+        for (const quint32 count : grid.bins(level)) {
+            total += count;
+        }
+        return total;
+    };
+
+    DeviationDensityGrid grid;
+    // 600 x 600 samples a millimetre apart: too many bins for the finest
+    // level, a quarter as many for the next.
+    constexpr int kSide = 600;
+    for (int i = 0; i < kSide * kSide; ++i) {
+        grid.add((i % kSide) * 0.001 + 0.0005, (i / kSide) * 0.001 - 0.2995);
+    }
+    if (!expect(!grid.hasLevel(0), "density grid should drop a level with too many bins")
+        || !expect(grid.hasLevel(1) && grid.bins(1).size() == (kSide / 2) * (kSide / 2),
+                   "density grid should keep 2 mm bins")
+        || !expect(grid.bounds(1) == QRect(0, -150, kSide / 2, kSide / 2), "density grid bounds mismatch")) {
+        return false;
+    }
+    for (int level = 1; level < DeviationDensityGrid::kLevels; ++level) {
+        if (!expect(levelTotal(grid, level) == kSide * kSide, "density grid level should count every sample")) {
+            return false;
+        }
+    }
+    grid.remove(0.0005, -0.2995);
+    if (!expect(grid.sampleCount() == kSide * kSide - 1 && levelTotal(grid, 1) == kSide * kSide - 1
+                    && grid.bins(1).value(DeviationDensityGrid::binKey(0, -150)) == 3,
+                "density grid should forget a removed sample")) {
+        return false;
+    }
+
+    DeviationMapModel model;
+    model.addSample(31.230400, 121.473700);
+    model.addSample(31.230410, 121.473715);
+    model.updateLastSample(31.230420, 121.473725);
+    const QPointF latest = model.localPoint(1);
+    const double finest = DeviationDensityGrid::binMeters(0);
+    const quint64 latestKey = DeviationDensityGrid::binKey(static_cast<int>(std::floor(latest.x() / finest)),
+                                                           static_cast<int>(std::floor(latest.y() / finest)));
+    if (!expect(model.densityGrid().sampleCount() == 2 && levelTotal(model.densityGrid(), 0) == 2
+                    && model.densityGrid().bins(0).value(latestKey) == 1,
+                "deviation map should bin the replaced sample where it now is")) {
+        return false;
+    }
+    model.clear();
+    return expect(model.densityGrid().sampleCount() == 0 && model.densityGrid().bins(0).isEmpty(),
+                  "deviation map clear should empty the density grid");
+}
+
+// Deviation statistics computed from scratch with a full sort, as the map did
+// before it kept them incrementally.
+QVariantMap exactDeviationStats(const QList<QPointF> &samples, bool fixedCenter, double centerLatitude,
+                                double centerLongitude) {
+    constexpr double kMetersPerDegree = 3.14159265358979323846 / 180.0 * 6378137.0;
+    if (!fixedCenter) {
+        centerLatitude = 0.0;
+        centerLongitude = 0.0;
+        for (const QPointF &sample : samples) {
+            centerLatitude += sample.x();
+            centerLongitude += sample.y();
+        }
+        centerLatitude /= samples.size();
+        centerLongitude /= samples.size();
+    }
+    QList<double> north;
+    QList<double> east;
+    QList<double> distances;
+    for (const QPointF &sample : samples) {
+        north.append((sample.x() - centerLatitude) * kMetersPerDegree);
+        east.append((sample.y() - centerLongitude) * kMetersPerDegree
+                    * std::cos(centerLatitude * 3.14159265358979323846 / 180.0));
+        distances.append(std::hypot(east.last(), north.last()));
+    }
+    const auto axis = [](const QList<double> &values) {
+        double sum = 0.0;
+        for (const double value : values) {
+            sum += value;
+        }
+        const double average = sum / values.size();
+        double variance = 0.0;
+        for (const double value : values) {
+            variance += (value - average) * (value - average);
+        }
+        return QVariantMap{
+            {QStringLiteral("min"), *std::min_element(values.cbegin(), values.cend())},
+            {QStringLiteral("max"), *std::max_element(values.cbegin(), values.cend())},
+            {QStringLiteral("avg"), average},
+            {QStringLiteral("stdDev"), std::sqrt(variance / values.size())}
+        };
+    };
+    QVariantMap horizontal = axis(distances);
+    QList<double> sorted = distances;
+    std::sort(sorted.begin(), sorted.end());
+    for (const auto &[name, ratio] : {std::pair{"cep50", 0.50}, std::pair{"cep68", 0.68}, std::pair{"cep95", 0.95}}) {
+        const double position = ratio * (sorted.size() - 1);
+        const qsizetype lower = static_cast<qsizetype>(std::floor(position));
+        const qsizetype upper = static_cast<qsizetype>(std::ceil(position));
+        const double weight = position - lower;
+        horizontal.insert(QString::fromLatin1(name), sorted.at(lower) * (1.0 - weight) + sorted.at(upper) * weight);
+    }
+    return {
+        {QStringLiteral("horizontal"), horizontal},
+        {QStringLiteral("latitude"), axis(north)},
+        {QStringLiteral("longitude"), axis(east)}
+    };
+}
+
+bool expectDeviationStatsStreamWithinTolerance() {
+    for (const bool fixedCenter : {false, true}) {
+        DeviationMapModel model;
+        model.setFixedCenter(31.230400, 121.473700);
+        model.setFixedCenterEnabled(fixedCenter);
+        QList<QPointF> samples;
+        for (int i = 0; i < 4000; ++i) {
+            // A slow walk plus jitter, so the average center keeps moving.
+            const double latitude = 31.230400 + 2e-5 * std::sin(i * 12.9898) + 1e-8 * i;
+            const double longitude = 121.473700 + 2e-5 * std::cos(i * 78.233);
+            if (i % 5 == 4) {
+                model.updateLastSample(latitude, longitude);
+                samples.last() = QPointF(latitude, longitude);
+            } else {
+                model.addSample(latitude, longitude);
+                samples.append(QPointF(latitude, longitude));
+            }
+            if (i % 250 != 249) {
+                continue;
+            }
+
+            const QVariantMap exact = exactDeviationStats(samples, fixedCenter, 31.230400, 121.473700);
+            const QVariantMap streamed = model.stats();
+            const auto value = [](const QVariantMap &stats, const char *group, const char *key) {
+                return stats.value(QString::fromLatin1(group)).toMap().value(QString::fromLatin1(key)).toDouble();
+            };
+            const double drms = std::hypot(value(exact, "latitude", "stdDev"), value(exact, "longitude", "stdDev"));
+            // Horizontal figures are measured from a projection center that
+            // trails the average by at most this much.
+            const double tolerance = std::max(DeviationStatistics::kMinCenterDriftMeters,
+                                              DeviationStatistics::kCenterDriftRatio * drms) + 1e-9;
+            for (const char *key : {"min", "max", "avg", "stdDev", "cep50", "cep68", "cep95"}) {
+                if (!expect(std::abs(value(streamed, "horizontal", key) - value(exact, "horizontal", key)) <= tolerance,
+                            "streamed horizontal deviation stats should match the exact ones within the center drift tolerance")) {
+                    std::cerr << (fixedCenter ? "fixed" : "average") << " center, " << samples.size() << " samples, "
+                              << key << ": " << value(streamed, "horizontal", key) << " vs "
+                              << value(exact, "horizontal", key) << "\n";
+                    return false;
+                }
+            }
+            for (const char *group : {"latitude", "longitude"}) {
+                for (const char *key : {"min", "max", "avg", "stdDev"}) {
+                    if (!expect(std::abs(value(streamed, group, key) - value(exact, group, key)) < 1e-6,
+                                "streamed per-axis deviation stats should match the exact ones")) {
+                        return false;
+                    }
+                }
+            }
+        }
+        if (!expect(model.rowCount() == samples.size(), "deviation map should keep one row per sample")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool expectDeviationRetentionKeepsLifetimeFigures() {
+    DeviationInterval first;
+    DeviationInterval second;
+    DeviationInterval whole;
+    for (int i = 0; i < 50; ++i) {
+        const double east = std::sin(i * 12.9898) + 0.01 * i;
+        const double north = std::cos(i * 78.233);
+        (i < 20 ? first : second).add(east, north);
+        whole.add(east, north);
+    }
+    first.merge(second);
+    if (!expect(first.count == whole.count && std::abs(first.eastMean - whole.eastMean) < 1e-12
+                    && std::abs(first.eastVariance() - whole.eastVariance()) < 1e-12
+                    && std::abs(first.covariance() - whole.covariance()) < 1e-12
+                    && first.maxRadius >= whole.maxRadius - 1e-12,
+                "merged deviation intervals should match one interval over both")) {
         return false;
     }
 
-    QVariantMap sat10, sat2;
-    for (const QVariant &v : satellites) {
-        const QVariantMap sat = v.toMap();
-        const int svid = sat.value(QStringLiteral("svid")).toInt();
-        if (svid == 10) sat10 = sat;
-        else if (svid == 2) sat2 = sat;
+    DeviationMapModel model;
+    // The smallest window the model allows.
+    model.setMemoryBudget(0);
+    QList<QPointF> samples;
+    int checks = 0;
+    // The lifetime horizontal estimate is cached between refreshes, so it is
+    // held to the exact figures of the samples it was last refreshed from.
+    QVariantMap estimatedHorizontal;
+    QVariantMap exactAtRefresh;
+    qsizetype refreshedAt = 0;
+    for (int i = 0; i < 6000; ++i) {
+        const double latitude = 31.230400 + 2e-5 * std::sin(i * 12.9898) + 1e-8 * i;
+        const double longitude = 121.473700 + 2e-5 * std::cos(i * 78.233);
+        if (i % 5 == 4) {
+            model.updateLastSample(latitude, longitude);
+            samples.last() = QPointF(latitude, longitude);
+        } else {
+            model.addSample(latitude, longitude);
+            samples.append(QPointF(latitude, longitude));
+            if (!expect(model.rowCount() <= model.windowSize() + model.windowSize() / 16,
+                        "deviation map should stay within its window")) {
+                return false;
+            }
+        }
+        // Until the first eviction the horizontal figures are the exact
+        // retained ones, covered by expectDeviationStatsStreamWithinTolerance().
+        if (model.rowCount() == samples.size()) {
+            continue;
+        }
+        ++checks;
+        const QVariantMap exact = exactDeviationStats(samples, false, 0.0, 0.0);
+        const QVariantMap streamed = model.stats();
+        const QVariantMap horizontal = streamed.value(QStringLiteral("horizontal")).toMap();
+        if (horizontal != estimatedHorizontal) {
+            estimatedHorizontal = horizontal;
+            exactAtRefresh = exact;
+            refreshedAt = samples.size();
+        }
+        const auto value = [](const QVariantMap &stats, const char *group, const char *key) {
+            return stats.value(QString::fromLatin1(group)).toMap().value(QString::fromLatin1(key)).toDouble();
+        };
+        const double resolution = value(streamed, "horizontal", "resolution");
+        if (!expect(resolution > 0.0 && resolution < 0.1, "lifetime deviation stats should report their resolution")
+            || !expect(samples.size() - refreshedAt < DeviationStatistics::kEstimateRefreshSamples,
+                       "lifetime deviation estimate should be refreshed every kEstimateRefreshSamples samples")
+            || !expect(streamed.value(QStringLiteral("points")).toLongLong() == samples.size()
+                           && streamed.value(QStringLiteral("retainedPoints")).toInt() == model.rowCount(),
+                       "deviation map should count lifetime and retained points")
+            || !expect(model.get(0).value(QStringLiteral("sequence")).toLongLong()
+                           == samples.size() - model.rowCount() + 1,
+                       "deviation map sequence should count evicted samples")) {
+            return false;
+        }
+        for (const char *key : {"min", "max", "avg", "stdDev", "cep50", "cep68", "cep95"}) {
+            if (!expect(std::abs(value(streamed, "horizontal", key) - value(exactAtRefresh, "horizontal", key))
+                            <= resolution + 1e-5,
+                        "lifetime horizontal deviation stats should be within their resolution")) {
+                std::cerr << samples.size() << " samples, refreshed at " << refreshedAt << ", " << key << ": "
+                          << value(streamed, "horizontal", key) << " vs " << value(exactAtRefresh, "horizontal", key)
+                          << " +- " << resolution << "\n";
+                return false;
+            }
+        }
+        for (const char *group : {"latitude", "longitude"}) {
+            for (const char *key : {"min", "max", "avg", "stdDev"}) {
+                if (!expect(std::abs(value(streamed, group, key) - value(exact, group, key)) < 1e-6,
+                            "per-axis deviation stats should stay exact after eviction")) {
+                    return false;
+                }
+            }
+        }
+        qint64 folded = 0;
+        for (const QVariant &interval : model.intervals()) {
+            folded += interval.toMap().value(QStringLiteral("count")).toLongLong();
+        }
+        if (!expect(folded == samples.size() - model.rowCount(), "deviation intervals should hold every evicted sample")) {
+            return false;
+        }
     }
-    return expect(!sat10.isEmpty(), "NCGSV should keep the raw NavIC PRN 10")
-        && expect(!sat2.isEmpty(), "NCGSA should match the raw NavIC PRN 2")
-        && expect(sat10.value(QStringLiteral("constellation")).toString() == QStringLiteral("NAVIC"),
-                  "NC talker should map to NAVIC rather than GNSS/GPS")
-        && expect(sat10.value(QStringLiteral("band")).toString() == QStringLiteral("L5"),
-                  "NC signal id 1 should render in the L5/E5/B2 bucket")
-        && expect(!sat10.value(QStringLiteral("usedInFix")).toBool(),
-                  "non-selected NavIC satellite should stay visible-only")
-        && expect(sat2.value(QStringLiteral("constellation")).toString() == QStringLiteral("NAVIC"),
-                  "all NC satellites should map to NAVIC")
-        && expect(sat2.value(QStringLiteral("band")).toString() == QStringLiteral("L5"),
-                  "all NC signal id 1 satellites should render in L5")
-        && expect(sat2.value(QStringLiteral("usedInFix")).toBool(),
-                  "selected NavIC satellite should be highlighted as used");
+    return expect(checks > 0, "deviation map should have evicted samples");
 }
 
-bool expectDeviationMapStats() {
+bool expectDeviationMapStaysWithinMemoryBudget() {
+    constexpr qint64 kBudget = 8LL * 1024 * 1024;
     DeviationMapModel model;
-    model.addSample(31.230400, 121.473700);
-    model.addSample(31.230410, 121.473715);
-
-    const QVariantMap averageStats = model.stats();
-    if (!expect(model.rowCount() == 2, "deviation map should keep two samples")) {
-        return false;
-    }
-    if (!expect(averageStats.value(QStringLiteral("points")).toInt() == 2, "deviation map points stat mismatch")) {
-        return false;
-    }
-    if (!expect(averageStats.value(QStringLiteral("centerMode")).toString() == QStringLiteral("Average"), "deviation map should default to average center")) {
+    model.setMemoryBudget(kBudget);
+    // Three trips through the window, so the sample list has been refilled
+    // after evictions at least twice.
+    const qint64 samples = 3LL * (model.windowSize() + model.windowSize() / 16);
+    qint64 peakBytes = 0;
+    for (qint64 i = 0; i < samples; ++i) {
+        model.addSample(31.230400 + 2e-5 * std::sin(i * 12.9898) + 1e-10 * i,
+                        121.473700 + 2e-5 * std::cos(i * 78.233));
+        peakBytes = std::max(peakBytes, model.memoryBytes());
+    }
+    if (!expect(peakBytes <= model.memoryBudget(), "deviation map should stay within its memory budget")) {
+        std::cerr << peakBytes << " bytes held, budget " << model.memoryBudget() << "\n";
         return false;
     }
-
-    model.setFixedCenterEnabled(true);
-    model.setFixedCenter(31.230400, 121.473700);
-    const QVariantMap fixedStats = model.stats();
-    return expect(fixedStats.value(QStringLiteral("centerMode")).toString() == QStringLiteral("Fixed"), "deviation map should switch to fixed center mode")
-        && expect(std::abs(fixedStats.value(QStringLiteral("centerLatitude")).toDouble() - 31.230400) < 1e-9, "fixed center latitude mismatch")
-        && expect(std::abs(fixedStats.value(QStringLiteral("centerLongitude")).toDouble() - 121.473700) < 1e-9, "fixed center longitude mismatch")
-        && expect(fixedStats.value(QStringLiteral("maxDistance")).toDouble() > 0.0, "deviation map max distance should be positive");
+    return expect(peakBytes > kBudget / 4 && model.rowCount() <= model.windowSize() + model.windowSize() / 16,
+                  "deviation map should use its memory budget for the window");
 }
 
 bool expectCommandButtonsRoundTripJson() {
@@ -822,6 +2123,415 @@ bool expectSatelliteBandGroupsDriveSkyAndSignalModels() {
                   "Signal Spectrum L6/E6/B3 tab should use the shared B3 grouping");
 }
 
+bool expectSignalGroupsAreClassifiedOnIngest() {
+    SatelliteInfo beidou = signalSatellite(QStringLiteral("beidou"), QStringLiteral(" l5 "), 5, 202);
+    const bool startsUnresolved = beidou.signalGroup == SignalGroup::Unresolved;
+    hdgnss::resolveSignalGroup(beidou);
+
+    QList<SatelliteInfo> satellites = {
+        signalSatellite(QStringLiteral("QZSS"), QStringLiteral("L1"), 2, 193),
+        signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 1),
+        signalSatellite(QStringLiteral("GALILEO"), QStringLiteral("L1"), 7, 301)
+    };
+    SignalModel signalModel;
+    signalModel.setSatellites(satellites);
+    QStringList l1Labels;
+    for (const QVariant &item : signalModel.itemsForBand(QStringLiteral("l1"))) {
+        l1Labels.append(item.toMap().value(QStringLiteral("label")).toString());
+    }
+    const qsizetype l1cBefore = signalModel.itemsForBand(QStringLiteral("L1C")).size();
+
+    QList<int> roles;
+    QObject::connect(&signalModel, &QAbstractItemModel::dataChanged,
+                     [&roles](const QModelIndex &, const QModelIndex &, const QList<int> &changed) { roles = changed; });
+    satellites[0].signalId = 1;
+    signalModel.setSatellites(satellites);
+    const qsizetype l1cAfter = signalModel.itemsForBand(QStringLiteral("L1C")).size();
+    const qsizetype l1After = signalModel.itemsForBand(QStringLiteral("L1")).size();
+
+    // Removing a row renumbers the ones after it; putting it back appends it.
+    const auto l1LabelsNow = [&signalModel]() {
+        QStringList labels;
+        for (const QVariant &item : signalModel.itemsForBand(QStringLiteral("L1"))) {
+            labels.append(item.toMap().value(QStringLiteral("label")).toString());
+        }
+        return labels;
+    };
+    const SatelliteInfo gps = satellites.takeAt(1);
+    signalModel.setSatellites(satellites);
+    const QStringList afterRemoval = l1LabelsNow();
+    satellites.append(gps);
+    signalModel.setSatellites(satellites);
+    const QStringList afterReinsert = l1LabelsNow();
+
+    return expect(startsUnresolved && beidou.signalGroup == SignalGroup::B2,
+                  "signal groups should be classified once, ignoring case and padding")
+        && expect((hdgnss::signalTabGroups(u"L1") & hdgnss::signalGroupBit(SignalGroup::E1)) != 0
+                      && hdgnss::signalTabGroups(u"L6") == hdgnss::signalGroupBit(SignalGroup::B3)
+                      && hdgnss::signalTabGroups(u"S") == 0,
+                  "signal tabs should map to fixed group bitmasks")
+        && expect(l1Labels == QStringList({QStringLiteral("J193"), QStringLiteral("G01"), QStringLiteral("E301")}),
+                  "a tab spanning several groups should list rows in model order")
+        && expect(l1cBefore == 1 && l1cAfter == 0 && l1After == 3,
+                  "the per-band index should follow a satellite that changes group")
+        && expect(afterRemoval == QStringList({QStringLiteral("J193"), QStringLiteral("E301")})
+                      && afterReinsert == QStringList({QStringLiteral("J193"), QStringLiteral("E301"),
+                                                       QStringLiteral("G01")}),
+                  "the per-band index should follow removed and inserted rows")
+        && expect(roles.contains(SignalModel::BandGroupRole) && roles.contains(SignalModel::SignalIdRole),
+                  "a signal id that moves a satellite to another group should report the band group role");
+}
+
+bool expectSatelliteStatsModelCountsIncrementally() {
+    SatelliteInfo gpsL1 = signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 1);
+    const SatelliteInfo gpsL5 = signalSatellite(QStringLiteral("GPS"), QStringLiteral("L5"), 7, 1);
+    SatelliteInfo galileo = signalSatellite(QStringLiteral("GALILEO"), QStringLiteral("L1"), 7, 3);
+    galileo.usedInFix = false;
+    const SatelliteInfo qzss = signalSatellite(QStringLiteral("QZSS"), QStringLiteral("L1"), 1, 193);
+    SatelliteInfo silent = signalSatellite(QStringLiteral("SBAS"), QStringLiteral("L1"), 1, 40);
+    silent.cn0 = 0;
+
+    SatelliteStatsModel stats;
+    int changedRows = 0;
+    QObject::connect(&stats, &QAbstractItemModel::dataChanged,
+                     [&changedRows](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+                         changedRows += bottomRight.row() - topLeft.row() + 1;
+                     });
+    for (const SatelliteInfo &sat : {gpsL1, gpsL5, galileo, qzss, silent}) {
+        stats.addSatellite(sat);
+    }
+    const bool firstPublish = stats.publish();
+    const bool counted = stats.usageText(QStringLiteral("ALL")) == QStringLiteral("2 / 3")
+        && stats.visibleSignals(QStringLiteral("ALL")) == 4
+        && stats.usageText(QStringLiteral("GPS")) == QStringLiteral("1 / 1")
+        && stats.visibleSignals(QStringLiteral("GPS")) == 2
+        && stats.usageText(QStringLiteral("OTHER")) == QStringLiteral("1 / 1")
+        && stats.visibleSignals(QStringLiteral("SBAS")) == 0
+        && stats.visibleSignals(QStringLiteral("L1")) == 2
+        && stats.usedSignals(QStringLiteral("E1")) == 0
+        && stats.visibleSignals(QStringLiteral("E1")) == 1;
+
+    changedRows = 0;
+    stats.removeSatellite(gpsL1);
+    stats.addSatellite(gpsL1);
+    const bool unchangedPublish = stats.publish();
+
+    stats.removeSatellite(gpsL1);
+    gpsL1.usedInFix = false;
+    stats.addSatellite(gpsL1);
+    stats.removeSatellite(gpsL5);
+    stats.publish();
+
+    return expect(firstPublish && counted,
+                  "satellite stats should count visible signals and distinct satellites per constellation and band")
+        && expect(!unchangedPublish && changedRows == 0,
+                  "re-ingesting an unchanged satellite should not announce any stats row")
+        && expect(stats.usageText(QStringLiteral("GPS")) == QStringLiteral("0 / 1")
+                      && stats.usageText(QStringLiteral("ALL")) == QStringLiteral("1 / 3")
+                      && stats.visibleSignals(QStringLiteral("L5")) == 0,
+                  "satellite stats should follow a satellite losing its fix and a signal going away")
+        && expect(changedRows > 0 && changedRows < stats.rowCount(),
+                  "satellite stats should announce only the rows whose counts changed");
+}
+
+bool expectSatelliteHistoryKeepsRingsPerSignal() {
+    SatelliteHistory history;
+    history.setMemoryBudget(SatelliteHistory::kMinTrackSamples * SatelliteHistory::kSampleBytes * 2);
+    SatelliteInfo first = signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 1);
+    for (int epoch = 0; epoch < 100; ++epoch) {
+        first.cn0 = 30 + epoch % 10;
+        first.elevation = epoch % 90;
+        first.usedInFix = epoch % 2 == 0;
+        history.append(epoch * 1000LL, first);
+    }
+    const int wrappedSamples = history.sampleCount(first.key);
+    const hdgnss::SatelliteHistoryStats all = history.windowStats(first.key, 0, 99000);
+    const hdgnss::SatelliteHistoryStats lastTen = history.windowStats(first.key, 90000, 99000);
+
+    first.cn0 = 55;
+    history.append(99000, first);
+    const bool replaced = history.sampleCount(first.key) == wrappedSamples
+        && history.windowStats(first.key, 99000, 99000).maxCn0 == 55;
+
+    const QList<QPointF> decimated = history.decimatedCn0(first.key, 36000, 99000, 4);
+    bool timeOrdered = true;
+    bool keepsPeak = false;
+    for (int i = 0; i < decimated.size(); ++i) {
+        timeOrdered = timeOrdered && (i == 0 || decimated.at(i - 1).x() < decimated.at(i).x());
+        keepsPeak = keepsPeak || decimated.at(i).y() == 55;
+    }
+
+    SatelliteInfo second = signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 2);
+    SatelliteInfo third = signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 3);
+    history.append(100000, second);
+    history.append(101000, third);
+    const QStringList keptKeys = history.keys();
+    history.append(50000, second);
+
+    SatelliteHistoryModel model;
+    QHash<QString, SatelliteInfo> epoch{{second.key, second}, {third.key, third}};
+    model.appendEpoch(1000, epoch);
+    second.cn0 = 20;
+    epoch.insert(second.key, second);
+    model.appendEpoch(2000, epoch);
+    model.publish();
+    const QVariantList series = model.series(second.key);
+
+    return expect(wrappedSamples == SatelliteHistory::kMinTrackSamples && all.samples == wrappedSamples,
+                  "satellite history should keep a fixed-size ring per signal")
+        && expect(lastTen.samples == 10 && lastTen.minCn0 == 30 && lastTen.maxCn0 == 39
+                      && std::abs(lastTen.meanCn0 - 34.5) < 1e-9 && lastTen.usedSamples == 5,
+                  "satellite history windows should report min, mean and max over their samples")
+        && expect(replaced, "a sample at the newest timestamp should replace that epoch's sample")
+        && expect(!decimated.isEmpty() && decimated.size() <= 8 && timeOrdered && keepsPeak,
+                  "decimated series should keep each slice's extremes in time order")
+        && expect(keptKeys.size() == 2 && !keptKeys.contains(first.key),
+                  "satellite history should drop the stalest signal once the budget is full")
+        && expect(history.trackCount() == 1 && history.sampleCount(second.key) == 1,
+                  "a sample older than the newest should restart the history")
+        && expect(model.rowCount() == 2 && model.revision() == 1 && series.size() == 2
+                      && series.first().toPointF().y() == 40.0 && series.first().toPointF().x() < 1.0
+                      && series.last().toPointF() == QPointF(1.0, 20.0),
+                  "the history model should expose window-relative C/N0 series per signal");
+}
+
+bool expectSatelliteHistoryFollowsReplayClockBackwards() {
+    // An epoch stamped with the wall clock, then a replayed capture from
+    // months earlier.
+    SatelliteHistoryModel model;
+    SatelliteInfo sat = signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 5);
+    const QHash<QString, SatelliteInfo> epoch{{sat.key, sat}};
+    model.appendEpoch(QDateTime::currentMSecsSinceEpoch(), epoch);
+    const qint64 replayStartMs =
+        QDateTime::fromString(QStringLiteral("2026-04-15T06:00:00Z"), Qt::ISODate).toMSecsSinceEpoch();
+    for (int second = 0; second < 20; ++second) {
+        model.appendEpoch(replayStartMs + second * 1000LL, epoch);
+    }
+    model.publish();
+    const QVariantMap stats = model.stats(sat.key);
+    if (!expect(model.history().latestTimestampMs() == replayStartMs + 19000,
+                "satellite history should follow the clock when it goes back")
+        || !expect(stats.value(QStringLiteral("samples")).toInt() == 20 && model.series(sat.key).size() >= 2,
+                   "replayed epochs after a wall-clock epoch should stay inside the window")) {
+        return false;
+    }
+
+    // A seek back within the replay restarts the window the same way.
+    model.appendEpoch(replayStartMs + 5000, epoch);
+    model.publish();
+    return expect(model.history().latestTimestampMs() == replayStartMs + 5000
+                      && model.stats(sat.key).value(QStringLiteral("samples")).toInt() == 1,
+                  "a replay seek should restart the satellite history window");
+}
+
+bool expectSatelliteAgeingMarksStaleThenExpires() {
+    const qint64 baseMs = 1700000000000LL;
+    SatelliteAgeing ageing;
+    ageing.touch(QStringLiteral("a"), baseMs);
+    ageing.touch(QStringLiteral("b"), baseMs);
+    bool quietWhileReported = true;
+    for (int second = 1; second < 10; ++second) {
+        ageing.touch(QStringLiteral("a"), baseMs + second * 1000);
+        const SatelliteAgeing::Transitions transitions = ageing.advance(baseMs + second * 1000);
+        quietWhileReported = quietWhileReported && transitions.stale.isEmpty() && transitions.expired.isEmpty();
+    }
+    const SatelliteAgeing::Transitions firstStale = ageing.advance(baseMs + 10000);
+    ageing.touch(QStringLiteral("b"), baseMs + 12000);
+    const bool revived = !ageing.isStale(QStringLiteral("b"));
+
+    QStringList stale;
+    QStringList expired;
+    for (int second = 13; second <= 80; ++second) {
+        const SatelliteAgeing::Transitions transitions = ageing.advance(baseMs + second * 1000);
+        stale.append(transitions.stale);
+        expired.append(transitions.expired);
+    }
+    const int trackedAfterExpiry = ageing.trackedCount();
+
+    ageing.touch(QStringLiteral("c"), baseMs + 100000);
+    const SatelliteAgeing::Transitions jumped = ageing.advance(baseMs + 10LL * 60 * 60 * 1000);
+    ageing.touch(QStringLiteral("d"), baseMs + 10LL * 60 * 60 * 1000);
+    const SatelliteAgeing::Transitions rewound = ageing.advance(baseMs);
+    const int trackedAfterRewind = ageing.trackedCount();
+    QStringList staleAfterRewind;
+    QStringList expiredAfterRewind;
+    for (int second = 1; second <= 61; ++second) {
+        const SatelliteAgeing::Transitions transitions = ageing.advance(baseMs + second * 1000);
+        staleAfterRewind.append(transitions.stale);
+        expiredAfterRewind.append(transitions.expired);
+    }
+
+    AppSettings settings;
+    AppController controller(&settings);
+    const QDateTime epoch = QDateTime::fromString(QStringLiteral("2026-04-27T12:00:00Z"), Qt::ISODate);
+    const auto apply = [&controller, &epoch](int second, const QVariantList &satellites) {
+        ProtocolMessage message;
+        message.fields = {
+            {QStringLiteral("utcTime"), epoch.addSecs(second)},
+            {QStringLiteral("satellites"), satellites}
+        };
+        controller.regressionApplyProtocolMessage(message);
+        controller.regressionFlushUiRefresh();
+    };
+    const QVariantMap gps1 = satellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 42);
+    const QVariantMap gps2 = satellite(QStringLiteral("GPS"), QStringLiteral("L1"), 2, 38);
+    apply(0, {gps1, gps2});
+    apply(15, {gps1});
+    const SatelliteModel *sky = controller.satelliteModel();
+    int staleRows = 0;
+    for (int row = 0; row < sky->rowCount(); ++row) {
+        staleRows += sky->data(sky->index(row), SatelliteModel::StaleRole).toBool() ? 1 : 0;
+    }
+    const bool fadedNotCounted = controller.regressionSatelliteCacheSize() == 2 && sky->rowCount() == 2
+        && staleRows == 1 && controller.satellitesInView() == 1;
+    apply(75, {gps1});
+
+    return expect(quietWhileReported, "signals reported within the stale timeout should stay fresh")
+        && expect(firstStale.stale == QStringList{QStringLiteral("b")} && firstStale.expired.isEmpty(),
+                  "a signal silent for the stale timeout should be marked stale")
+        && expect(revived, "a stale signal reported again should be fresh")
+        && expect(stale == QStringList({QStringLiteral("a"), QStringLiteral("b")})
+                      && expired == QStringList({QStringLiteral("a"), QStringLiteral("b")})
+                      && trackedAfterExpiry == 0,
+                  "silent signals should go stale and then expire in deadline order")
+        && expect(jumped.stale == QStringList{QStringLiteral("c")}
+                      && jumped.expired == QStringList{QStringLiteral("c")},
+                  "a clock jump should settle every deadline it passed")
+        && expect(rewound.stale.isEmpty() && rewound.expired.isEmpty() && trackedAfterRewind == 1,
+                  "a clock going back should not expire signals")
+        && expect(staleAfterRewind == QStringList{QStringLiteral("d")}
+                      && expiredAfterRewind == QStringList{QStringLiteral("d")} && ageing.trackedCount() == 0,
+                  "signals reported before a clock went back should still age from the new time")
+        && expect(fadedNotCounted, "the controller should keep stale satellites listed but out of the counts")
+        && expect(controller.regressionSatelliteCacheSize() == 1 && sky->rowCount() == 1
+                      && controller.signalModel()->rowCount() == 1,
+                  "the controller should drop satellites once they expire");
+}
+
+bool expectSatelliteModelsApplyKeyedDiffs() {
+    QList<SatelliteInfo> satellites = {
+        signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 1),
+        signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 2),
+        signalSatellite(QStringLiteral("GALILEO"), QStringLiteral("L1"), 1, 3)
+    };
+    SatelliteModel skyModel;
+    SignalModel signalModel;
+    skyModel.setSatellites(satellites);
+    signalModel.setSatellites(satellites);
+
+    int resets = 0;
+    int inserted = 0;
+    int removed = 0;
+    QList<int> changedRows;
+    QList<int> skyRoles;
+    QList<int> signalRoles;
+    QObject::connect(&skyModel, &QAbstractItemModel::modelReset, [&resets]() { ++resets; });
+    QObject::connect(&skyModel, &QAbstractItemModel::rowsInserted,
+                     [&inserted](const QModelIndex &, int first, int last) { inserted += last - first + 1; });
+    QObject::connect(&skyModel, &QAbstractItemModel::rowsRemoved,
+                     [&removed](const QModelIndex &, int first, int last) { removed += last - first + 1; });
+    QObject::connect(&skyModel, &QAbstractItemModel::dataChanged,
+                     [&changedRows, &skyRoles](const QModelIndex &topLeft, const QModelIndex &, const QList<int> &roles) {
+                         changedRows.append(topLeft.row());
+                         skyRoles = roles;
+                     });
+    QObject::connect(&signalModel, &QAbstractItemModel::dataChanged,
+                     [&signalRoles](const QModelIndex &, const QModelIndex &, const QList<int> &roles) {
+                         signalRoles = roles;
+                     });
+
+    const int revision = skyModel.revision();
+    skyModel.setSatellites(satellites);
+    if (!expect(skyModel.revision() == revision && changedRows.isEmpty(),
+                "an unchanged satellite update should not notify")) {
+        return false;
+    }
+
+    satellites[1].cn0 = 33;
+    skyModel.setSatellites(satellites);
+    signalModel.setSatellites(satellites);
+    if (!expect(changedRows == QList<int>({1}) && skyRoles == QList<int>({SatelliteModel::Cn0Role}),
+                "a C/N0 change should update only that row's C/N0 role")
+        || !expect(signalRoles == QList<int>({SignalModel::Cn0Role, SignalModel::StrengthRole}),
+                   "the signal model should report C/N0 and strength")) {
+        return false;
+    }
+
+    // One satellite sets, one rises; the survivors keep their rows.
+    satellites.removeAt(0);
+    satellites.append(signalSatellite(QStringLiteral("BEIDOU"), QStringLiteral("B1"), 1, 4));
+    skyModel.setSatellites(satellites);
+    return expect(resets == 0 && removed == 1 && inserted == 1, "satellite churn should insert and remove rows")
+        && expect(skyModel.rowCount() == 3
+                      && skyModel.get(0).value(QStringLiteral("svid")).toInt() == 2
+                      && skyModel.get(2).value(QStringLiteral("svid")).toInt() == 4,
+                  "surviving satellites should keep their order");
+}
+
+bool expectSignalBandFilterKeepsBarRows() {
+    QList<SatelliteInfo> satellites = {
+        signalSatellite(QStringLiteral("GALILEO"), QStringLiteral("L1"), 1, 3),
+        signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 12),
+        signalSatellite(QStringLiteral("GPS"), QStringLiteral("L5"), 7, 12),
+        signalSatellite(QStringLiteral("GPS"), QStringLiteral("L1"), 1, 2)
+    };
+    satellites[0].usedInFix = false;
+    satellites[1].cn0 = 45;
+    SignalModel signalModel;
+    signalModel.setSatellites(satellites);
+    SignalBandFilterModel bars;
+    bars.setSourceModel(&signalModel);
+    bars.setBand(QStringLiteral("L1"));
+    const auto labels = [&bars]() {
+        QStringList labels;
+        for (int row = 0; row < bars.rowCount(); ++row) {
+            labels.append(bars.index(row, 0).data(SignalModel::LabelRole).toString());
+        }
+        return labels;
+    };
+    if (!expect(labels() == QStringList({QStringLiteral("G02"), QStringLiteral("G12"), QStringLiteral("E03")}),
+                "the band filter should list the tab's signals by constellation and label")
+        || !expect(bars.count() == 3 && bars.usedCount() == 2 && bars.peakStrength() == 45
+                       && bars.peakLabel() == QStringLiteral("G12"),
+                   "the band filter should summarize the tab")) {
+        return false;
+    }
+
+    int inserted = 0;
+    int removed = 0;
+    int resets = 0;
+    int layouts = 0;
+    QList<int> changedRows;
+    QObject::connect(&bars, &QAbstractItemModel::rowsInserted,
+                     [&inserted](const QModelIndex &, int first, int last) { inserted += last - first + 1; });
+    QObject::connect(&bars, &QAbstractItemModel::rowsRemoved,
+                     [&removed](const QModelIndex &, int first, int last) { removed += last - first + 1; });
+    QObject::connect(&bars, &QAbstractItemModel::modelReset, [&resets]() { ++resets; });
+    QObject::connect(&bars, &QAbstractItemModel::layoutChanged, [&layouts]() { ++layouts; });
+    QObject::connect(&bars, &QAbstractItemModel::dataChanged,
+                     [&changedRows](const QModelIndex &topLeft, const QModelIndex &, const QList<int> &) {
+                         changedRows.append(topLeft.row());
+                     });
+
+    satellites[0].cn0 = 50;
+    satellites[2].cn0 = 20;
+    signalModel.setSatellites(satellites);
+    if (!expect(inserted == 0 && removed == 0 && resets == 0 && layouts == 0 && changedRows == QList<int>({2}),
+                "a C/N0 update should reach only that bar, as a dataChanged")
+        || !expect(bars.peakStrength() == 50 && bars.peakLabel() == QStringLiteral("E03"),
+                   "the band filter summary should follow C/N0 updates")) {
+        return false;
+    }
+
+    // G02 sets and a BeiDou signal rises on the tab; the other bars stay.
+    satellites.removeAt(3);
+    satellites.append(signalSatellite(QStringLiteral("BEIDOU"), QStringLiteral("B1"), 1, 6));
+    signalModel.setSatellites(satellites);
+    return expect(resets == 0 && inserted == 1 && removed == 1
+                      && labels() == QStringList({QStringLiteral("G12"), QStringLiteral("E03"), QStringLiteral("C06")}),
+                  "satellite churn should insert and remove only the bars that came and went");
+}
+
 bool expectNmeaPositionEpochDedupKeepsFiveHzAndPrefersRmc() {
     NmeaProtocolPlugin plugin;
     AppSettings settings;
@@ -1078,6 +2788,162 @@ bool expectTecMapRendererPaintsGrid() {
     return expect(coloredPixels > 0, "TEC renderer should paint at least one visible pixel");
 }
 
+bool expectTecMapRendererTilesGridWithoutSeams() {
+    hdgnss::TecGridData dataset;
+    dataset.timestampUtc = QDateTime::fromString(QStringLiteral("2026-04-16T21:35:00Z"), Qt::ISODate);
+    dataset.sourceId = QStringLiteral("test-tec");
+    dataset.longitudeStepDegrees = 5.0;
+    dataset.latitudeStepDegrees = 2.5;
+    // A full 73 x 71 IONEX-style grid with one hot cell on the equator at 0 E.
+    for (int row = 0; row < 71; ++row) {
+        for (int column = 0; column < 73; ++column) {
+            const double longitude = -180.0 + 5.0 * column;
+            const double latitude = 87.5 - 2.5 * row;
+            const bool hot = longitude == 0.0 && latitude == 0.0;
+            dataset.samples.append({longitude, latitude, hot ? 100.0 : 10.0 + (row + column) % 7, 0});
+        }
+    }
+    dataset.minTec = 10.0;
+    dataset.maxTec = 100.0;
+
+    const QImage image = hdgnss::TecMapRenderer::render(dataset, hdgnss::TecMapRenderer::defaultOverlaySize());
+    int seamPixels = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        int first = -1;
+        int last = -1;
+        for (int x = 0; x < image.width(); ++x) {
+            if (qAlpha(image.pixel(x, y)) > 0) {
+                first = first < 0 ? x : first;
+                last = x;
+            }
+        }
+        for (int x = std::max(first, 0); x <= last; ++x) {
+            if (qAlpha(image.pixel(x, y)) != 192) {
+                ++seamPixels;
+            }
+        }
+    }
+    if (!expect(seamPixels == 0, "TEC renderer should tile neighbouring cells without gaps or blending")) {
+        std::cerr << seamPixels << " seam pixels\n";
+        return false;
+    }
+    // The canvas center is the projection of 0 E, 0 N.
+    return expect(image.pixel(image.width() / 2, image.height() / 2) == qPremultiply(qRgba(213, 38, 61, 192)),
+                  "TEC renderer should color the hottest cell with the top of the scale");
+}
+
+bool expectTecSampleLookupIndexesFullGrid() {
+    hdgnss::TecGridData dataset;
+    dataset.timestampUtc = QDateTime::fromString(QStringLiteral("2026-04-17T04:45:00Z"), Qt::ISODate);
+    dataset.sourceName = QStringLiteral("IONEX");
+    dataset.longitudeStepDegrees = 5.0;
+    dataset.latitudeStepDegrees = 2.5;
+    for (int row = 0; row < 71; ++row) {
+        for (int column = 0; column < 73; ++column) {
+            dataset.samples.append({-180.0 + 5.0 * column, 87.5 - 2.5 * row, row * 100.0 + column, 0});
+        }
+    }
+
+    AppSettings settings;
+    TecMapOverlayModel model(&settings);
+    model.setTestDataset(dataset);
+    for (const hdgnss::TecSample &expected : std::as_const(dataset.samples)) {
+        // About a quarter of a cell off the center, towards the map's inside.
+        const QPointF point = projectedCanvasPointForTest(964.0, 488.0,
+                                                          expected.longitude + (expected.longitude < 0.0 ? 1.2 : -1.2),
+                                                          expected.latitude - 0.6);
+        const QVariantMap sample = model.sampleAtCanvasPoint(point.x(), point.y(), 964.0, 488.0);
+        if (!expect(sample.value(QStringLiteral("valid")).toBool()
+                        && sample.value(QStringLiteral("tec")).toDouble() == expected.tec,
+                    "TEC sample lookup should find the cell under the point")) {
+            std::cerr << expected.longitude << ", " << expected.latitude << "\n";
+            return false;
+        }
+    }
+
+    const QPointF westEdge = projectedCanvasPointForTest(964.0, 488.0, -180.0, 0.0);
+    const QVariantMap nearEdge = model.sampleAtCanvasPoint(westEdge.x() - 6.0, westEdge.y(), 964.0, 488.0);
+    return expect(nearEdge.value(QStringLiteral("valid")).toBool()
+                      && nearEdge.value(QStringLiteral("longitude")).toDouble() == -180.0
+                      && nearEdge.value(QStringLiteral("latitude")).toDouble() == 0.0,
+                  "TEC sample lookup off the map should fall back to a nearby sample center")
+        && expect(!model.sampleAtCanvasPoint(0.0, 0.0, 964.0, 488.0).value(QStringLiteral("valid")).toBool(),
+                  "TEC sample lookup far from every sample should find nothing");
+}
+
+bool expectTecOverlayServedFromMemory() {
+    hdgnss::TecGridData dataset;
+    dataset.timestampUtc = QDateTime::fromString(QStringLiteral("2026-04-17T04:45:00Z"), Qt::ISODate);
+    dataset.sourceId = QStringLiteral("noaa-glotec-geojson");
+    dataset.sourceName = QStringLiteral("GloTEC");
+    dataset.longitudeStepDegrees = 5.0;
+    dataset.latitudeStepDegrees = 2.5;
+    dataset.samples = {
+        {122.5, 31.25, 40.38, 0},
+        {142.5, 21.25, 74.27, 1}
+    };
+
+    AppSettings settings;
+    TecMapOverlayModel model(&settings);
+    model.setTestDataset(dataset, QStringLiteral("tec.memory"));
+    const QUrl first = model.overlaySource();
+    if (!expect(model.ready() && first.scheme() == QStringLiteral("image")
+                    && first.host() == QLatin1String(TecMapOverlayModel::kOverlayImageProviderId)
+                    && first.path().startsWith(QStringLiteral("/tec.memory/")),
+                "TEC overlay should be served through the image provider")
+        || !expect(model.overlayLatencyMs() < 0, "TEC overlay latency should be unset before the overlay is served")) {
+        return false;
+    }
+    const QImage image = model.serveOverlayImage(QStringLiteral("tec.memory"));
+    if (!expect(image.size() == hdgnss::TecMapRenderer::defaultOverlaySize(), "TEC overlay image should be kept in memory")
+        || !expect(model.overlayLatencyMs() >= 0, "serving a TEC overlay should record its latency")) {
+        return false;
+    }
+    model.setTestDataset(dataset, QStringLiteral("tec.memory"));
+    return expect(model.overlaySource() != first, "a new TEC render should get a new overlay revision")
+        && expect(model.serveOverlayImage(QStringLiteral("tec.missing")).isNull(),
+                  "unknown TEC sources should serve no overlay");
+}
+
+bool expectTecRendersCoalesceInBackground() {
+    const auto datasetWithTec = [](double tec) {
+        hdgnss::TecGridData dataset;
+        dataset.timestampUtc = QDateTime::fromString(QStringLiteral("2026-04-17T04:45:00Z"), Qt::ISODate);
+        dataset.sourceName = QStringLiteral("GloTEC");
+        dataset.longitudeStepDegrees = 5.0;
+        dataset.latitudeStepDegrees = 2.5;
+        dataset.samples = {{122.5, 31.25, tec, 0}};
+        return dataset;
+    };
+    const auto renderStat = [](const TecMapOverlayModel &model, const char *key) {
+        return model.renderStats().value(QString::fromLatin1(key)).toInt();
+    };
+
+    AppSettings settings;
+    TecMapOverlayModel model(&settings);
+    model.setTestDataset(datasetWithTec(10.0), QStringLiteral("tec.async"));
+    const QUrl first = model.overlaySource();
+    model.regressionQueueDataset(datasetWithTec(20.0), QStringLiteral("tec.async"));
+    model.regressionQueueDataset(datasetWithTec(30.0), QStringLiteral("tec.async"));
+    if (!expect(model.overlaySource() == first && renderStat(model, "pendingRenders") == 2,
+                "queued TEC renders should leave the current overlay in place")) {
+        return false;
+    }
+    if (!expect(waitUntil([&]() { return renderStat(model, "pendingRenders") == 0; }, 10000),
+                "background TEC renders should finish")) {
+        return false;
+    }
+
+    const QPointF point = projectedCanvasPointForTest(964.0, 488.0, 122.5, 31.25);
+    const QVariantMap sample = model.sampleAtCanvasPoint(point.x(), point.y(), 964.0, 488.0);
+    return expect(renderStat(model, "completedRenders") == 2 && renderStat(model, "droppedRenders") == 1,
+                  "a superseded TEC render should be dropped")
+        && expect(model.overlaySource() != first && std::abs(sample.value(QStringLiteral("tec")).toDouble() - 30.0) < 1e-9,
+                  "the overlay should swap to the newest TEC render")
+        && expect(model.renderStats().value(QStringLiteral("lastRenderMs")).toLongLong() >= 0,
+                  "TEC render timings should be exposed");
+}
+
 bool expectTecSampleLookupByCanvasPoint() {
     hdgnss::TecGridData dataset;
     dataset.timestampUtc = QDateTime::fromString(QStringLiteral("2026-04-17T04:45:00Z"), Qt::ISODate);
@@ -1145,9 +3011,63 @@ int main(int argc, char *argv[]) {
     if (!expectRawRecorderRequiresExplicitLogDirectory()) {
         return EXIT_FAILURE;
     }
+    if (!expectRawRecorderWritesDecodeJsonl()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectDecodeJsonlQueueDropsOldestWhenFull()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectReplayTransportFollowsRecordedIndex()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectReplaySeekResumesFromKeyframe()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectBatchDecoderSummarizesCaptures()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectBatchDecoderSkipsRecordedTxWrites()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectParallelCaptureDecodeMatchesSequential()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectParallelCaptureDecodeSkipsTxWrites()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectByteUtilsHexFormatting()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectRawLogModelEvictsOldestRows()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectRawLogModelStaysWithinMemoryBudget()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectRawLogFilterModel()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectRawLogModelScrollback()) {
+        return EXIT_FAILURE;
+    }
     if (!expectDeviationMapStats()) {
         return EXIT_FAILURE;
     }
+    if (!expectDeviationMapRowsStayFixedAsCenterMoves()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectDeviationDensityGridCountsEveryLevel()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectDeviationStatsStreamWithinTolerance()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectDeviationRetentionKeepsLifetimeFigures()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectDeviationMapStaysWithinMemoryBudget()) {
+        return EXIT_FAILURE;
+    }
     if (!expectCommandButtonsRoundTripJson()) {
         return EXIT_FAILURE;
     }
@@ -1163,6 +3083,27 @@ int main(int argc, char *argv[]) {
     if (!expectSatelliteBandGroupsDriveSkyAndSignalModels()) {
         return EXIT_FAILURE;
     }
+    if (!expectSignalGroupsAreClassifiedOnIngest()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectSatelliteModelsApplyKeyedDiffs()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectSignalBandFilterKeepsBarRows()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectSatelliteStatsModelCountsIncrementally()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectSatelliteHistoryKeepsRingsPerSignal()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectSatelliteHistoryFollowsReplayClockBackwards()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectSatelliteAgeingMarksStaleThenExpires()) {
+        return EXIT_FAILURE;
+    }
     if (!expectNmeaPositionEpochDedupKeepsFiveHzAndPrefersRmc()) {
         return EXIT_FAILURE;
     }
@@ -1184,8 +3125,20 @@ int main(int argc, char *argv[]) {
     if (!expectTecMapRendererPaintsGrid()) {
         return EXIT_FAILURE;
     }
+    if (!expectTecMapRendererTilesGridWithoutSeams()) {
+        return EXIT_FAILURE;
+    }
     if (!expectTecSampleLookupByCanvasPoint()) {
         return EXIT_FAILURE;
     }
+    if (!expectTecSampleLookupIndexesFullGrid()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectTecOverlayServedFromMemory()) {
+        return EXIT_FAILURE;
+    }
+    if (!expectTecRendersCoalesceInBackground()) {
+        return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
 }